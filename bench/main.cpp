@@ -0,0 +1,718 @@
+#include "slimlog/common.h"
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/pattern.h"
+#include "slimlog/seek_index.h"
+#include "slimlog/sinks/binary_file_sink.h"
+#include "slimlog/sinks/buffered_file_sink.h"
+#include "slimlog/sinks/category_file_sink.h"
+#include "slimlog/sinks/compressed_file_sink.h"
+#include "slimlog/sinks/direct_file_sink.h"
+#include "slimlog/sinks/file_sink.h"
+#include "slimlog/sinks/io_uring_file_sink.h"
+#include "slimlog/sinks/mapped_file_sink.h"
+#include "slimlog/sinks/null_sink.h"
+#include "slimlog/sinks/ostream_sink.h"
+#include "slimlog/threading.h"
+#include "slimlog/util/os.h"
+#include "slimlog/util/unicode.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace slimlog;
+
+/** @brief Pattern used by formatting sinks, close to a typical production one. */
+constexpr std::string_view SinkPattern
+    = "{time}.{msec:03} [{level:<7}] {category}: {file}|{line}: {message}";
+
+/** @brief Benchmark settings, configurable from the command line. */
+struct Options {
+    std::size_t max_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    std::size_t iterations = 1'000'000;
+    std::string_view scenario = "all";
+    std::string_view json;
+    std::filesystem::path directory
+        = std::filesystem::exists("/dev/shm") ? "/dev/shm" : std::filesystem::temp_directory_path();
+};
+
+/** @brief Per-call latency percentiles in nanoseconds. */
+struct Latency {
+    double p50 = 0;
+    double p99 = 0;
+    double p999 = 0;
+};
+
+/** @brief Result of a single benchmark run. */
+struct Result {
+    std::string scenario;
+    std::string name;
+    std::string_view char_type;
+    std::size_t threads = 1;
+    std::size_t messages = 0;
+    double seconds = 0;
+    Latency latency;
+    std::uint64_t syscalls = 0; ///< Write system calls, if reported by the sink.
+    std::uint64_t bytes = 0; ///< Bytes written by the system calls.
+    double ratio = 0; ///< Compression ratio, if reported by the sink.
+    double compress_rate = 0; ///< Compressed megabytes per second of the compressing thread.
+};
+
+/**
+ * @brief Stream buffer discarding all output.
+ *
+ * Unlike a stream without a buffer, the stream stays in good state,
+ * so the sink does all the work up to the actual write.
+ *
+ * @tparam Char Character type.
+ */
+template<typename Char>
+class NullStreamBuf final : public std::basic_streambuf<Char> {
+protected:
+    auto xsputn(const Char* /*str*/, std::streamsize count) -> std::streamsize override
+    {
+        return count;
+    }
+
+    auto overflow(typename std::basic_streambuf<Char>::int_type chr) ->
+        typename std::basic_streambuf<Char>::int_type override
+    {
+        return std::basic_streambuf<Char>::traits_type::not_eof(chr);
+    }
+};
+
+/**
+ * @brief Converts an ASCII string literal to a character array at compile time.
+ *
+ * Used to get format strings of any character type.
+ */
+template<typename Char, std::size_t N>
+consteval auto literal(const char (&str)[N]) -> std::array<Char, N> // NOLINT(*-avoid-c-arrays)
+{
+    std::array<Char, N> result{};
+    std::copy(std::begin(str), std::end(str), result.begin());
+    return result;
+}
+
+/** @brief Benchmark message format string. */
+template<typename Char>
+constexpr auto BenchFormat = literal<Char>("Benchmark message #{}");
+
+template<typename Char>
+auto widen(std::string_view str) -> std::basic_string<Char>
+{
+    return util::unicode::from_utf8<Char>(str);
+}
+
+template<typename Char>
+constexpr auto char_name() -> std::string_view
+{
+    if constexpr (std::is_same_v<Char, wchar_t>) {
+        return "wchar_t";
+    } else {
+        return "char";
+    }
+}
+
+/**
+ * @brief Calculates latency percentiles, reordering the samples.
+ *
+ * @param samples Per-call latencies in nanoseconds.
+ * @return Latency percentiles.
+ */
+auto percentiles(std::vector<std::uint32_t>& samples) -> Latency
+{
+    if (samples.empty()) {
+        return {};
+    }
+
+    const auto at = [&samples](double quantile) {
+        const auto index = std::min(
+            static_cast<std::size_t>(quantile * static_cast<double>(samples.size())),
+            samples.size() - 1);
+        const auto nth = samples.begin() + static_cast<std::ptrdiff_t>(index);
+        std::nth_element(samples.begin(), nth, samples.end());
+        return static_cast<double>(*nth);
+    };
+    return {at(0.5), at(0.99), at(0.999)};
+}
+
+/**
+ * @brief Calls the function from the given number of threads and measures it.
+ *
+ * Each call is timed individually for latency percentiles. The clock is read
+ * once per call, so its overhead is included both in latency and in throughput.
+ *
+ * @param num_threads Number of threads.
+ * @param iterations Number of calls per thread.
+ * @param func Function to call, takes the iteration number.
+ * @return Result with elapsed time, message count and latency.
+ */
+template<typename Func>
+auto measure(std::size_t num_threads, std::size_t iterations, const Func& func) -> Result
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<std::vector<std::uint32_t>> samples(num_threads);
+    std::vector<std::pair<Clock::time_point, Clock::time_point>> spans(num_threads);
+    std::latch start_latch(static_cast<std::ptrdiff_t>(num_threads));
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&, thread_samples = &samples[i], span = &spans[i]]() {
+            thread_samples->resize(iterations);
+            start_latch.arrive_and_wait();
+            auto prev = Clock::now();
+            span->first = prev;
+            for (std::size_t j = 0; j < iterations; ++j) {
+                func(j);
+                const auto now = Clock::now();
+                (*thread_samples)[j] = static_cast<std::uint32_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(now - prev).count());
+                prev = now;
+            }
+            span->second = prev;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Wall time from the first thread start to the last thread finish
+    const auto start = std::ranges::min(spans, {}, [](const auto& span) { return span.first; });
+    const auto end = std::ranges::max(spans, {}, [](const auto& span) { return span.second; });
+    const std::chrono::duration<double> elapsed = end.second - start.first;
+
+    std::vector<std::uint32_t> all_samples;
+    all_samples.reserve(num_threads * iterations);
+    for (const auto& thread_samples : samples) {
+        all_samples.insert(all_samples.end(), thread_samples.begin(), thread_samples.end());
+    }
+
+    Result result;
+    result.threads = num_threads;
+    result.messages = num_threads * iterations;
+    result.seconds = elapsed.count();
+    result.latency = percentiles(all_samples);
+    return result;
+}
+
+/**
+ * @brief Logs a formatted message from the given number of threads.
+ *
+ * @param log Logger to log to.
+ * @param num_threads Number of threads.
+ * @param iterations Number of messages per thread.
+ * @return Benchmark result.
+ */
+template<typename LoggerType>
+auto run_logger(const LoggerType& log, std::size_t num_threads, std::size_t iterations) -> Result
+{
+    using Char = typename LoggerType::StringViewType::value_type;
+    auto result = measure(num_threads, iterations, [&log](std::size_t number) {
+        log.info(BenchFormat<Char>.data(), number);
+    });
+    result.char_type = char_name<Char>();
+    return result;
+}
+
+/**
+ * @brief Flushes the sink and copies its write or compression statistics to the result,
+ *        if it has any.
+ *
+ * @param result Benchmark result.
+ * @param sink Sink used in the benchmark.
+ */
+template<typename SinkType>
+auto report_writes(Result& result, SinkType& sink) -> void
+{
+    if constexpr (requires { sink.stats(); }) {
+        sink.flush();
+        const auto stats = sink.stats();
+        if constexpr (requires { stats.syscalls; }) {
+            result.syscalls = stats.syscalls;
+            result.bytes = stats.bytes;
+        }
+        if constexpr (requires { stats.ratio(); }) {
+            result.ratio = stats.ratio();
+            result.compress_rate = stats.throughput() / 1e6;
+        }
+    }
+}
+
+/**
+ * @brief Logs from one thread to a single sink of each type.
+ *
+ * @param options Benchmark options.
+ * @param results Results to append to.
+ */
+template<typename Char>
+auto bench_sinks(const Options& options, std::vector<Result>& results) -> void
+{
+    const auto pattern = widen<Char>(SinkPattern);
+    const auto run = [&](std::string_view name, auto&& add_sink) {
+        auto log = Logger<Char, SingleThreadedPolicy>::create(widen<Char>("bench"));
+        const auto sink = add_sink(*log);
+        auto result = run_logger(*log, 1, options.iterations);
+        result.scenario = "sinks";
+        result.name = name;
+        report_writes(result, *sink);
+        results.push_back(std::move(result));
+    };
+
+    run("null", [](auto& log) {
+        auto sink = std::make_shared<NullSink<Char>>();
+        log.add_sink(sink);
+        return sink;
+    });
+
+    NullStreamBuf<Char> null_buf;
+    std::basic_ostream<Char> null_stream(&null_buf);
+    run("ostream", [&](auto& log) {
+        return log.template add_sink<OStreamSink>(null_stream, pattern);
+    });
+
+    const auto filename = options.directory
+        / ("slimlog_bench." + std::string(char_name<Char>()) + ".log");
+    std::filesystem::remove(filename);
+    run("file", [&](auto& log) {
+        return log.template add_sink<FileSink>(filename.string(), pattern);
+    });
+    std::filesystem::remove(filename);
+    run("file-buffered", [&](auto& log) {
+        auto sink = std::make_shared<BufferedFileSink<Char, SingleThreadedPolicy>>(
+            filename.string(), BufferedFileOptions{}, pattern);
+        log.add_sink(sink);
+        return sink;
+    });
+    std::filesystem::remove(filename);
+    run("file-buffered-idx", [&](auto& log) {
+        auto sink = std::make_shared<BufferedFileSink<Char, SingleThreadedPolicy>>(
+            filename.string(), BufferedFileOptions{}, pattern);
+        sink->enable_index();
+        log.add_sink(sink);
+        return sink;
+    });
+    std::filesystem::remove(SeekIndex::path(filename));
+    std::filesystem::remove(filename);
+    run("file-uring", [&](auto& log) {
+        auto sink = std::make_shared<IoUringFileSink<Char, SingleThreadedPolicy>>(
+            filename.string(), IoUringFileOptions{}, pattern);
+        log.add_sink(sink);
+        return sink;
+    });
+    std::filesystem::remove(filename);
+    run("file-direct", [&](auto& log) {
+        auto sink = std::make_shared<DirectFileSink<Char, SingleThreadedPolicy>>(
+            filename.string(), DirectFileOptions{}, pattern);
+        log.add_sink(sink);
+        return sink;
+    });
+    std::filesystem::remove(filename);
+    run("file-mmap", [&](auto& log) {
+        auto sink = std::make_shared<MappedFileSink<Char, SingleThreadedPolicy>>(
+            filename.string(), MappedFileOptions{}, pattern);
+        log.add_sink(sink);
+        return sink;
+    });
+    std::filesystem::remove(filename);
+    // Records of the logger category go to a file named after it
+    std::string category_filename;
+    run("file-category", [&](auto& log) {
+        auto sink = std::make_shared<CategoryFileSink<Char, SingleThreadedPolicy>>(
+            filename.string(), CategoryFileOptions{}, pattern);
+        category_filename = sink->filename(log.category());
+        log.add_sink(sink);
+        return sink;
+    });
+    std::filesystem::remove(category_filename);
+    run("file-lz4", [&](auto& log) {
+        auto sink = std::make_shared<CompressedFileSink<Char, SingleThreadedPolicy>>(
+            filename.string(), CompressedFileOptions{}, pattern);
+        log.add_sink(sink);
+        return sink;
+    });
+    std::filesystem::remove(filename);
+    // Arguments are stored by type, the message is never formatted
+    run("file-binary", [&](auto& log) {
+        log.set_deferred_format(true);
+        auto sink = std::make_shared<BinaryFileSink<Char, SingleThreadedPolicy>>(filename.string());
+        log.add_sink(sink);
+        return sink;
+    });
+    std::filesystem::remove(filename);
+}
+
+/**
+ * @brief Logs from 1 to N threads to a child logger with a propagated NullSink.
+ *
+ * Measures the cost of the logger dispatch path (level check and sink iteration),
+ * which is what contends between threads when the sinks themselves are cheap.
+ * Then repeats the runs with a multi-threaded file sink of each type.
+ *
+ * @param options Benchmark options.
+ * @param results Results to append to.
+ */
+auto bench_scaling(const Options& options, std::vector<Result>& results) -> void
+{
+    auto root = Logger<char, MultiThreadedPolicy>::create("root");
+    root->add_sink(std::make_shared<NullSink<char>>());
+    auto log = Logger<char, MultiThreadedPolicy>::create(root, "bench");
+    log->add_sink(std::make_shared<NullSink<char>>());
+
+    // Powers of two up to the maximum, and the maximum itself
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t threads = 1; threads < options.max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(options.max_threads);
+
+    for (const auto threads : thread_counts) {
+        auto result = run_logger(*log, threads, options.iterations);
+        result.scenario = "scaling";
+        result.name = "null";
+        results.push_back(std::move(result));
+    }
+
+    // Contention in the file sinks: stdio lock, buffer and mapping reservation, io_uring queue,
+    // hand-off of the compressed blocks
+    const auto filename = options.directory / "slimlog_bench.scaling.log";
+    const auto run_file = [&](std::string_view name, auto make_sink) {
+        for (const auto threads : thread_counts) {
+            std::filesystem::remove(filename);
+            auto file_log = Logger<char, MultiThreadedPolicy>::create("bench");
+            const auto sink = make_sink();
+            file_log->add_sink(sink);
+            auto result = run_logger(*file_log, threads, options.iterations);
+            result.scenario = "scaling";
+            result.name = name;
+            report_writes(result, *sink);
+            results.push_back(std::move(result));
+        }
+        std::filesystem::remove(filename);
+    };
+    run_file("file", [&]() {
+        return std::make_shared<FileSink<char, MultiThreadedPolicy>>(
+            filename.string(), SinkPattern);
+    });
+    run_file("file-buffered", [&]() {
+        return std::make_shared<BufferedFileSink<char, MultiThreadedPolicy>>(
+            filename.string(), BufferedFileOptions{}, SinkPattern);
+    });
+    run_file("file-uring", [&]() {
+        return std::make_shared<IoUringFileSink<char, MultiThreadedPolicy>>(
+            filename.string(), IoUringFileOptions{}, SinkPattern);
+    });
+    run_file("file-direct", [&]() {
+        return std::make_shared<DirectFileSink<char, MultiThreadedPolicy>>(
+            filename.string(), DirectFileOptions{}, SinkPattern);
+    });
+    run_file("file-mmap", [&]() {
+        return std::make_shared<MappedFileSink<char, MultiThreadedPolicy>>(
+            filename.string(), MappedFileOptions{}, SinkPattern);
+    });
+    run_file("file-lz4", [&]() {
+        return std::make_shared<CompressedFileSink<char, MultiThreadedPolicy>>(
+            filename.string(), CompressedFileOptions{}, SinkPattern);
+    });
+}
+
+/**
+ * @brief Logs to the leaf of a logger chain, each logger having several stream sinks.
+ *
+ * @param options Benchmark options.
+ * @param results Results to append to.
+ */
+auto bench_hierarchy(const Options& options, std::vector<Result>& results) -> void
+{
+    static constexpr std::array Depths{1U, 4U, 16U};
+    static constexpr std::size_t SinksPerLogger = 4;
+
+    NullStreamBuf<char> null_buf;
+    std::ostream null_stream(&null_buf);
+    for (const auto depth : Depths) {
+        std::vector<std::shared_ptr<Logger<char, SingleThreadedPolicy>>> loggers;
+        for (std::size_t i = 0; i < depth; ++i) {
+            loggers.push_back(
+                loggers.empty()
+                    ? Logger<char, SingleThreadedPolicy>::create("level0")
+                    : Logger<char, SingleThreadedPolicy>::create(
+                          loggers.back(), "level" + std::to_string(i)));
+            for (std::size_t j = 0; j < SinksPerLogger; ++j) {
+                loggers.back()->add_sink<OStreamSink>(null_stream, SinkPattern);
+            }
+        }
+
+        auto result = run_logger(*loggers.back(), 1, options.iterations);
+        result.scenario = "hierarchy";
+        result.name = "depth " + std::to_string(depth) + ", "
+            + std::to_string(depth * SinksPerLogger) + " sinks";
+        results.push_back(std::move(result));
+    }
+}
+
+/**
+ * @brief Logs to a growing number of stream sinks with the same pattern.
+ *
+ * @param options Benchmark options.
+ * @param results Results to append to.
+ */
+auto bench_fanout(const Options& options, std::vector<Result>& results) -> void
+{
+    static constexpr std::array SinkCounts{1U, 4U, 16U};
+
+    NullStreamBuf<char> null_buf;
+    std::ostream null_stream(&null_buf);
+    for (const auto sinks : SinkCounts) {
+        auto log = Logger<char, SingleThreadedPolicy>::create("bench");
+        for (std::size_t i = 0; i < sinks; ++i) {
+            log->add_sink<OStreamSink>(null_stream, SinkPattern);
+        }
+
+        auto result = run_logger(*log, 1, options.iterations);
+        result.scenario = "fanout";
+        result.name = std::to_string(sinks) + " sinks";
+        results.push_back(std::move(result));
+    }
+}
+
+/**
+ * @brief Formats the same record with each pattern.
+ *
+ * @param options Benchmark options.
+ * @param results Results to append to.
+ */
+auto bench_pattern(const Options& options, std::vector<Result>& results) -> void
+{
+    static constexpr std::array Patterns{
+        std::string_view{"{message}"},
+        std::string_view{"[{level}] {category}: {message}"},
+        std::string_view{"{file}|{line} ({thread}) {function}: {message}"},
+        std::string_view{"[{level:^7}] {category:>10}: {message:<30}|"},
+        SinkPattern,
+    };
+
+    const std::string_view message = "Benchmark message";
+    const std::string_view category = "bench";
+    const Record<char> record{
+        CachedStringView<char>{message.data(), message.size()},
+        CachedStringView<char>{category.data(), category.size()},
+        CachedStringView<char>{__FILE__},
+        CachedStringView<char>{"bench_pattern"},
+        __LINE__,
+        Level::Info,
+        util::os::local_time(),
+        util::os::thread_id()};
+
+    for (const auto pattern_string : Patterns) {
+        const Pattern<char> pattern(pattern_string);
+        FormatBuffer<char, DefaultSinkBufferSize> buffer;
+        auto result = measure(1, options.iterations, [&](std::size_t /*number*/) {
+            buffer.clear();
+            pattern.format(buffer, record);
+        });
+        result.scenario = "pattern";
+        result.name = pattern_string;
+        result.char_type = char_name<char>();
+        results.push_back(std::move(result));
+    }
+}
+
+/**
+ * @brief Gets the formatting backend the library is built with.
+ *
+ * @return Backend name.
+ */
+constexpr auto backend() -> std::string_view
+{
+#ifdef SLIMLOG_FMTLIB
+    return "fmt";
+#else
+    return "std";
+#endif
+}
+
+auto print_table(const std::vector<Result>& results) -> void
+{
+    std::cout << "Backend: " << backend() << '\n';
+    const auto name_width = static_cast<int>(
+        std::ranges::max(results, {}, [](const auto& result) { return result.name.size(); })
+            .name.size()
+        + 2);
+    std::string_view scenario;
+    for (const auto& result : results) {
+        if (result.scenario != scenario) {
+            scenario = result.scenario;
+            std::cout << '\n'
+                      << scenario << '\n'
+                      << std::left << std::setw(name_width) << "name" << std::right << std::setw(8)
+                      << "char" << std::setw(8) << "threads" << std::setw(14) << "msgs/sec"
+                      << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns" << std::setw(10)
+                      << "p99.9 ns" << std::setw(10) << "syscalls" << std::setw(12) << "bytes/call"
+                      << std::setw(8) << "ratio" << std::setw(10) << "comp MB/s" << '\n';
+        }
+        std::cout << std::left << std::setw(name_width) << result.name << std::right << std::setw(8)
+                  << result.char_type << std::setw(8) << result.threads << std::setw(14)
+                  << std::fixed << std::setprecision(0)
+                  << static_cast<double>(result.messages) / result.seconds << std::setw(10)
+                  << result.latency.p50 << std::setw(10) << result.latency.p99 << std::setw(10)
+                  << result.latency.p999;
+        if (result.syscalls > 0) {
+            std::cout << std::setw(10) << result.syscalls << std::setw(12)
+                      << static_cast<double>(result.bytes) / static_cast<double>(result.syscalls);
+        } else {
+            std::cout << std::setw(10) << '-' << std::setw(12) << '-';
+        }
+        if (result.ratio > 0) {
+            std::cout << std::setw(8) << std::setprecision(2) << result.ratio << std::setw(10)
+                      << std::setprecision(0) << result.compress_rate;
+        } else {
+            std::cout << std::setw(8) << '-' << std::setw(10) << '-';
+        }
+        std::cout << '\n';
+    }
+}
+
+auto print_json(std::ostream& out, const Options& options, const std::vector<Result>& results)
+    -> void
+{
+    const auto quoted = [](std::string_view str) {
+        std::string result = "\"";
+        for (const auto chr : str) {
+            if (chr == '"' || chr == '\\') {
+                result += '\\';
+            }
+            result += chr;
+        }
+        return result + '"';
+    };
+
+    out << "{\n  \"backend\": " << quoted(backend()) << ",\n  \"iterations\": "
+        << options.iterations << ",\n  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"scenario\": " << quoted(result.scenario)
+            << ", \"name\": " << quoted(result.name) << ", \"char\": " << quoted(result.char_type)
+            << ", \"threads\": " << result.threads << ", \"messages\": " << result.messages
+            << std::fixed << std::setprecision(6) << ", \"seconds\": " << result.seconds
+            << std::setprecision(0) << ", \"msgs_per_sec\": "
+            << static_cast<double>(result.messages) / result.seconds
+            << ", \"p50_ns\": " << result.latency.p50 << ", \"p99_ns\": " << result.latency.p99
+            << ", \"p999_ns\": " << result.latency.p999;
+        if (result.syscalls > 0) {
+            out << ", \"syscalls\": " << result.syscalls << ", \"bytes\": " << result.bytes;
+        }
+        if (result.ratio > 0) {
+            out << std::setprecision(3) << ", \"ratio\": " << result.ratio
+                << std::setprecision(0) << ", \"compress_mb_per_sec\": " << result.compress_rate;
+        }
+        out << '}';
+    }
+    out << "\n  ]\n}\n";
+}
+
+auto print_usage(std::string_view program) -> void
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --scenario NAME    all, sinks, scaling, hierarchy, fanout or pattern\n"
+              << "  --iterations N     Messages per thread and run\n"
+              << "  --threads N        Maximum number of threads for the scaling scenario\n"
+              << "  --dir PATH         Directory for log files (tmpfs is preferred)\n"
+              << "  --json FILE        Write results as JSON, '-' for standard output\n";
+}
+
+auto parse_options(int argc, char* argv[]) -> Options // NOLINT(*-avoid-c-arrays)
+{
+    Options options;
+    const std::vector<std::string_view> args(argv + 1, argv + argc);
+    for (std::size_t i = 0; i < args.size(); i += 2) {
+        if (args[i] == "--help" || i + 1 == args.size()) {
+            print_usage(argv[0]);
+            std::exit(args[i] == "--help" ? EXIT_SUCCESS : EXIT_FAILURE); // NOLINT(concurrency-*)
+        }
+        if (args[i] == "--threads") {
+            options.max_threads = std::stoul(std::string(args[i + 1]));
+        } else if (args[i] == "--iterations") {
+            options.iterations = std::stoul(std::string(args[i + 1]));
+        } else if (args[i] == "--scenario") {
+            options.scenario = args[i + 1];
+        } else if (args[i] == "--dir") {
+            options.directory = args[i + 1];
+        } else if (args[i] == "--json") {
+            options.json = args[i + 1];
+        } else {
+            throw std::invalid_argument("Unknown option: " + std::string(args[i]));
+        }
+    }
+    return options;
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int // NOLINT(*-avoid-c-arrays)
+{
+    try {
+        const auto options = parse_options(argc, argv);
+        const auto enabled = [&options](std::string_view name) {
+            return options.scenario == "all" || options.scenario == name;
+        };
+
+        std::vector<Result> results;
+        if (enabled("sinks")) {
+            bench_sinks<char>(options, results);
+            bench_sinks<wchar_t>(options, results);
+        }
+        if (enabled("scaling")) {
+            bench_scaling(options, results);
+        }
+        if (enabled("hierarchy")) {
+            bench_hierarchy(options, results);
+        }
+        if (enabled("fanout")) {
+            bench_fanout(options, results);
+        }
+        if (enabled("pattern")) {
+            bench_pattern(options, results);
+        }
+        if (results.empty()) {
+            throw std::invalid_argument("Unknown scenario: " + std::string(options.scenario));
+        }
+
+        if (options.json == "-") {
+            print_json(std::cout, options, results);
+        } else {
+            print_table(results);
+            if (!options.json.empty()) {
+                std::ofstream out{std::string(options.json)};
+                print_json(out, options, results);
+            }
+        }
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
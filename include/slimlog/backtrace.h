@@ -0,0 +1,210 @@
+/**
+ * @file backtrace.h
+ * @brief Contains the declaration of the Backtrace class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/record.h"
+#include "slimlog/threading.h"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace slimlog {
+
+/**
+ * @brief Ring of recent log records suppressed by the logger level.
+ *
+ * Keeps copies of the last records that were not emitted because of the logger level,
+ * so that they can be passed to sinks later, e.g. when an error is logged.
+ * Records are stored as is (see RecordStorage): messages with deferred formatting
+ * keep their serialized arguments, so the text is formatted only if the ring is dumped.
+ *
+ * Once the ring is full, the oldest record is overwritten. A spare ring is allocated
+ * along with the ring, so dump() takes the records out by swapping the rings
+ * and does not allocate under the lock.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for the ring access.
+ * @tparam BufferSize Size of the pre-allocated buffer of each stored record.
+ * @tparam Allocator Allocator type for the record buffers.
+ */
+template<
+    typename Char,
+    typename ThreadingPolicy = DefaultThreadingPolicy,
+    std::size_t BufferSize = DefaultBufferSize,
+    typename Allocator = std::allocator<Char>>
+class Backtrace final {
+public:
+    /** @brief Log record type. */
+    using RecordType = Record<Char>;
+
+    Backtrace() = default;
+    ~Backtrace() = default;
+
+    Backtrace(const Backtrace&) = delete;
+    Backtrace(Backtrace&&) = delete;
+    auto operator=(const Backtrace&) -> Backtrace& = delete;
+    auto operator=(Backtrace&&) -> Backtrace& = delete;
+
+    /**
+     * @brief Enables the ring, discarding previously stored records.
+     *
+     * @param capacity Maximum number of stored records, zero disables the ring.
+     * @param level Least severe level of the stored records.
+     * @param trigger Least severe level of the records that trigger a dump.
+     */
+    auto enable(std::size_t capacity, Level level, Level trigger) -> void
+    {
+        const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+        m_enabled = false;
+        m_slots = capacity > 0 ? std::make_unique<SlotType[]>(capacity) // NOLINT(*-c-arrays)
+                               : nullptr;
+        m_spare = capacity > 0 ? std::make_unique<SlotType[]>(capacity) // NOLINT(*-c-arrays)
+                               : nullptr;
+        m_capacity = capacity;
+        m_head = 0;
+        m_size = 0;
+        m_level = level;
+        m_trigger = trigger;
+        m_enabled = capacity > 0;
+    }
+
+    /**
+     * @brief Disables the ring and releases stored records.
+     */
+    auto disable() -> void
+    {
+        enable(0, Level::Fatal, Level::Fatal);
+    }
+
+    /**
+     * @brief Checks if a suppressed record of the level should be stored.
+     *
+     * @param level Log level.
+     * @return \b true if the record should be passed to push().
+     */
+    [[nodiscard]] auto accepts(Level level) const noexcept -> bool
+    {
+        return static_cast<bool>(m_enabled) && static_cast<Level>(m_level) >= level;
+    }
+
+    /**
+     * @brief Checks if an emitted record of the level should trigger a dump.
+     *
+     * @param level Log level.
+     * @return \b true if stored records should be dumped before the record.
+     */
+    [[nodiscard]] auto triggers(Level level) const noexcept -> bool
+    {
+        return static_cast<bool>(m_enabled) && static_cast<Level>(m_trigger) >= level;
+    }
+
+    /**
+     * @brief Stores a copy of the record, overwriting the oldest one if the ring is full.
+     *
+     * @param record Log record.
+     */
+    auto push(const RecordType& record) -> void
+    {
+        const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+        if (m_capacity == 0) [[unlikely]] {
+            return;
+        }
+
+        auto& slot = m_slots[(m_head + m_size) % m_capacity];
+        if (m_size == m_capacity) {
+            m_head = (m_head + 1) % m_capacity;
+            --m_size;
+        }
+        // Slot stays empty if copying throws, so it is skipped by dump()
+        slot.reset();
+        ++m_size;
+        slot.assign(record);
+    }
+
+    /**
+     * @brief Passes stored records to the callback, oldest first, and clears the ring.
+     *
+     * Records are taken out of the ring under the lock by swapping it with the spare one
+     * and passed to the callback after releasing it, so that the callback may log through
+     * the same logger and concurrent push() calls are not blocked by sink I/O.
+     * The dumped ring becomes the spare one, keeping the allocated record buffers.
+     *
+     * @tparam Func Callback type, invocable with `const RecordType&`.
+     * @param consume Callback to pass the records to.
+     */
+    template<typename Func>
+    auto dump(Func&& consume) -> void
+    {
+        std::unique_ptr<SlotType[]> slots; // NOLINT(*-c-arrays)
+        std::unique_ptr<SlotType[]> spare; // NOLINT(*-c-arrays)
+        std::size_t capacity = 0;
+        std::size_t head = 0;
+        std::size_t size = 0;
+        for (;;) {
+            {
+                const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(
+                    m_mutex);
+                if (m_size == 0) {
+                    return;
+                }
+                if (m_spare || (spare && capacity == m_capacity)) {
+                    slots = std::exchange(m_slots, m_spare ? std::move(m_spare) : std::move(spare));
+                    capacity = m_capacity;
+                    head = m_head;
+                    size = m_size;
+                    m_head = 0;
+                    m_size = 0;
+                    break;
+                }
+                // Spare ring is taken by a concurrent dump
+                capacity = m_capacity;
+            }
+            spare = std::make_unique<SlotType[]>(capacity); // NOLINT(*-c-arrays)
+        }
+
+        for (; size > 0; --size) {
+            const auto& slot = slots[head];
+            head = (head + 1) % capacity;
+            if (!slot.empty()) {
+                consume(slot.record());
+            }
+        }
+
+        // Slots are reset by push() before reuse
+        const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+        if (!m_spare && capacity == m_capacity) {
+            m_spare = std::move(slots);
+        }
+    }
+
+    /**
+     * @brief Gets the number of stored records.
+     *
+     * @return Number of records.
+     */
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+        return m_size;
+    }
+
+private:
+    using SlotType = RecordStorage<Char, BufferSize, Allocator>;
+
+    std::unique_ptr<SlotType[]> m_slots; // NOLINT(*-avoid-c-arrays)
+    std::unique_ptr<SlotType[]> m_spare; // NOLINT(*-avoid-c-arrays)
+    std::size_t m_capacity = 0;
+    std::size_t m_head = 0;
+    std::size_t m_size = 0;
+    AtomicWrapper<bool, ThreadingPolicy> m_enabled{false};
+    AtomicWrapper<Level, ThreadingPolicy> m_level{Level::Fatal};
+    AtomicWrapper<Level, ThreadingPolicy> m_trigger{Level::Fatal};
+    mutable typename ThreadingPolicy::Mutex m_mutex;
+};
+
+} // namespace slimlog
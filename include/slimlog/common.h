@@ -8,8 +8,10 @@
 #include "slimlog/threading.h"
 #include "slimlog/util/string.h"
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 
 #ifndef SLIMLOG_HEADER_ONLY
 #include "slimlog_export.h" // IWYU pragma: export
@@ -18,6 +20,30 @@
 #define SLIMLOG_NO_EXPORT
 #endif
 
+/** @brief Numeric value of Level::Fatal for preprocessor checks. */
+#define SLIMLOG_LEVEL_FATAL 0
+/** @brief Numeric value of Level::Error for preprocessor checks. */
+#define SLIMLOG_LEVEL_ERROR 1
+/** @brief Numeric value of Level::Warning for preprocessor checks. */
+#define SLIMLOG_LEVEL_WARNING 2
+/** @brief Numeric value of Level::Info for preprocessor checks. */
+#define SLIMLOG_LEVEL_INFO 3
+/** @brief Numeric value of Level::Debug for preprocessor checks. */
+#define SLIMLOG_LEVEL_DEBUG 4
+/** @brief Numeric value of Level::Trace for preprocessor checks. */
+#define SLIMLOG_LEVEL_TRACE 5
+
+/**
+ * @brief Compile-time logging level ceiling.
+ *
+ * Messages of less severe levels are removed at compile time regardless
+ * of the runtime logger level. Can be set via `SLIMLOG_ACTIVE_LEVEL` CMake option
+ * or defined before including any SlimLog header, e.g. to `SLIMLOG_LEVEL_INFO`.
+ */
+#ifndef SLIMLOG_ACTIVE_LEVEL
+#define SLIMLOG_ACTIVE_LEVEL SLIMLOG_LEVEL_TRACE
+#endif
+
 namespace slimlog {
 
 /**
@@ -48,6 +74,30 @@ enum class Level : std::uint8_t {
     Trace ///< Trace messages for method entry and exit.
 };
 
+static_assert(
+    SLIMLOG_ACTIVE_LEVEL >= SLIMLOG_LEVEL_FATAL && SLIMLOG_ACTIVE_LEVEL <= SLIMLOG_LEVEL_TRACE,
+    "SLIMLOG_ACTIVE_LEVEL must be one of SLIMLOG_LEVEL_* values");
+
+/** @brief Least severe level compiled in, see SLIMLOG_ACTIVE_LEVEL. */
+inline constexpr Level ActiveLevel = static_cast<Level>(SLIMLOG_ACTIVE_LEVEL);
+
+/**
+ * @brief Checks if the level is not removed at compile time.
+ *
+ * @param level Logging level.
+ * @return \b true if messages of this level are compiled in.
+ */
+[[nodiscard]] constexpr auto is_active_level(Level level) noexcept -> bool
+{
+    return level <= ActiveLevel;
+}
+
+template<typename Char>
+class DeferredMessage;
+
+template<typename Char>
+class FormatCache;
+
 /**
  * @brief Represents a log record containing message details.
  *
@@ -61,6 +111,12 @@ struct Record {
     CachedStringView<char> function; ///< Function name.
     std::size_t line = {}; ///< Line number.
     Level level = {}; ///< Log level.
+    std::pair<std::chrono::sys_seconds, std::size_t> time = {}; ///< Timestamp and nanoseconds.
+    std::size_t thread_id = {}; ///< Thread ID.
+    /** @brief Message with postponed formatting, \a message is empty if set. */
+    const DeferredMessage<Char>* deferred = nullptr;
+    /** @brief Messages formatted by sinks within the current dispatch, may be null. */
+    FormatCache<Char>* format_cache = nullptr;
 };
 
 } // namespace slimlog
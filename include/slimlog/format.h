@@ -31,10 +31,15 @@
 #include <iterator>
 #endif
 
+#include <array>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <memory>
+#include <span>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -283,6 +288,304 @@ public:
     }
 };
 
+/**
+ * @brief Type of a format argument serialized in DeferredMessage.
+ *
+ * Allows reading the serialized arguments without knowing their C++ types,
+ * e.g. to store them in a binary log file.
+ */
+struct DeferredArgType {
+    /** @brief Kind of the argument value. */
+    enum class Kind : std::uint8_t { Bool, Char, Int, UInt, Float, Pointer, Null, String };
+
+    Kind kind; ///< Kind of the value.
+    std::uint8_t size; ///< Size of the value in bytes, or size of the length for strings.
+};
+
+/** @cond */
+namespace detail {
+
+/**
+ * @brief Serialization traits for deferred format arguments.
+ *
+ * Primary template: the type is not supported and is formatted eagerly.
+ */
+template<typename Char, typename T>
+struct DeferredArg {
+    static constexpr bool Supported = false;
+};
+
+/**
+ * @brief Serialization traits for trivially copyable arguments (numbers and void pointers).
+ *
+ * The value is stored bytewise in a number of `Char` slots.
+ */
+template<typename Char, typename T>
+    requires(std::is_arithmetic_v<T> || std::is_same_v<T, const void*> || std::is_same_v<T, void*>
+             || std::is_null_pointer_v<T>)
+struct DeferredArg<Char, T> {
+    static constexpr bool Supported = true;
+    static constexpr std::size_t Slots = (sizeof(T) + sizeof(Char) - 1) / sizeof(Char);
+    using DecodedType = T;
+
+    static constexpr DeferredArgType Type = []() {
+        using Kind = DeferredArgType::Kind;
+        constexpr auto Size = static_cast<std::uint8_t>(sizeof(T));
+        if constexpr (std::is_same_v<T, bool>) {
+            return DeferredArgType{Kind::Bool, Size};
+        } else if constexpr (
+            std::is_same_v<T, char> || std::is_same_v<T, wchar_t> || std::is_same_v<T, char8_t>
+            || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>) {
+            return DeferredArgType{Kind::Char, Size};
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return DeferredArgType{Kind::Float, Size};
+        } else if constexpr (std::is_null_pointer_v<T>) {
+            return DeferredArgType{Kind::Null, Size};
+        } else if constexpr (std::is_pointer_v<T>) {
+            return DeferredArgType{Kind::Pointer, Size};
+        } else if constexpr (std::is_signed_v<T>) {
+            return DeferredArgType{Kind::Int, Size};
+        } else {
+            return DeferredArgType{Kind::UInt, Size};
+        }
+    }();
+
+    template<typename Out>
+    static auto encode(Out& out, T value) -> void
+    {
+        std::array<Char, Slots> slots{};
+        std::memcpy(slots.data(), &value, sizeof(T));
+        out.append(slots);
+    }
+
+    static auto decode(const Char*& data) -> DecodedType
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        data += Slots;
+        return value;
+    }
+};
+
+/**
+ * @brief Serialization traits for string arguments.
+ *
+ * The string is stored as a length followed by the characters.
+ */
+template<typename Char, typename T>
+    requires(std::is_convertible_v<const T&, std::basic_string_view<Char>>
+             && !std::is_null_pointer_v<T>)
+struct DeferredArg<Char, T> {
+    static constexpr bool Supported = true;
+    using DecodedType = std::basic_string_view<Char>;
+    using SizeArg = DeferredArg<Char, std::size_t>;
+
+    static constexpr DeferredArgType Type{
+        DeferredArgType::Kind::String, static_cast<std::uint8_t>(sizeof(std::size_t))};
+
+    template<typename Out>
+    static auto encode(Out& out, const T& value) -> void
+    {
+        const std::basic_string_view<Char> str{value};
+        SizeArg::encode(out, str.size());
+        out.append(str);
+    }
+
+    static auto decode(const Char*& data) -> DecodedType
+    {
+        const auto size = SizeArg::decode(data);
+        const DecodedType value{data, size};
+        data += size;
+        return value;
+    }
+};
+
+} // namespace detail
+/** @endcond */
+
+/**
+ * @brief Log message with postponed formatting.
+ *
+ * Holds the format string, the arguments serialized into a compact binary form
+ * and a pointer to the function able to decode them. Allows the logger to skip
+ * parsing of the format string and conversion of the arguments on the caller's thread:
+ * the message is formatted only when a sink actually needs the text
+ * (e.g. on the AsyncSink backend thread).
+ *
+ * Only numbers, `void` pointers and strings are supported.
+ * The format string must outlive the message (normally it is a string literal).
+ *
+ * @tparam Char Character type of the format string.
+ */
+template<typename Char>
+class DeferredMessage final {
+public:
+    /** @brief Buffer type used to format the message. */
+    using BufferType = FormatBuffer<Char, DefaultBufferSize>;
+    /** @brief Function decoding the arguments and formatting the message. */
+    using FormatFunction = void (*)(BufferType&, std::basic_string_view<Char>, const Char*);
+
+    /**
+     * @brief Checks if all argument types can be serialized.
+     *
+     * @tparam Args Format argument types.
+     */
+    template<typename... Args>
+    static constexpr bool Supported
+        = (detail::DeferredArg<Char, std::remove_cvref_t<Args>>::Supported && ...);
+
+    /**
+     * @brief Types of the serialized arguments.
+     *
+     * @tparam Args Format argument types.
+     */
+    template<typename... Args>
+    static constexpr std::array<DeferredArgType, sizeof...(Args)> ArgTypes{
+        detail::DeferredArg<Char, std::remove_cvref_t<Args>>::Type...};
+
+    DeferredMessage() = default;
+
+    /**
+     * @brief Serializes format arguments to the buffer.
+     *
+     * @tparam Out Output buffer type (see MemoryBuffer).
+     * @tparam Args Format argument types.
+     * @param out Output buffer.
+     * @param args Format arguments.
+     */
+    template<typename Out, typename... Args>
+        requires Supported<Args...>
+    static auto encode(Out& out, const Args&... args) -> void
+    {
+        (detail::DeferredArg<Char, std::remove_cvref_t<Args>>::encode(out, args), ...);
+    }
+
+    /**
+     * @brief Creates a deferred message from the format string and serialized arguments.
+     *
+     * @tparam Args Format argument types.
+     * @param fmt Format string.
+     * @param args Arguments serialized with encode().
+     * @return Deferred message.
+     */
+    template<typename... Args>
+        requires Supported<Args...>
+    static auto create(const FormatString<Char, Args...>& fmt, std::basic_string_view<Char> args)
+        -> DeferredMessage
+    {
+#ifdef SLIMLOG_FMTLIB
+        const auto str = static_cast<fmt::basic_string_view<Char>>(fmt);
+#else
+        const auto str = fmt.get();
+#endif
+        return DeferredMessage(
+            {str.data(), str.size()},
+            &format_args<std::remove_cvref_t<Args>...>,
+            args,
+            ArgTypes<Args...>);
+    }
+
+    /**
+     * @brief Creates a copy of the message referencing another argument storage.
+     *
+     * @param args Copy of the serialized arguments.
+     * @return Deferred message.
+     */
+    [[nodiscard]] auto rebind(std::basic_string_view<Char> args) const -> DeferredMessage
+    {
+        return DeferredMessage(m_fmt, m_func, args, m_types);
+    }
+
+    /**
+     * @brief Gets the format string.
+     *
+     * @return Format string.
+     */
+    [[nodiscard]] auto fmt() const noexcept -> std::basic_string_view<Char>
+    {
+        return m_fmt;
+    }
+
+    /**
+     * @brief Gets the serialized arguments.
+     *
+     * @return Serialized arguments.
+     */
+    [[nodiscard]] auto args() const noexcept -> std::basic_string_view<Char>
+    {
+        return m_args;
+    }
+
+    /**
+     * @brief Gets the types of the serialized arguments.
+     *
+     * Numbers are stored bytewise in `(size + sizeof(Char) - 1) / sizeof(Char)` characters,
+     * strings as a `std::size_t` length followed by the characters.
+     *
+     * @return Argument types in order.
+     */
+    [[nodiscard]] auto types() const noexcept -> std::span<const DeferredArgType>
+    {
+        return m_types;
+    }
+
+    /**
+     * @brief Formats the message.
+     *
+     * @param out Output buffer.
+     */
+    auto format(BufferType& out) const -> void
+    {
+        m_func(out, m_fmt, m_args.data());
+    }
+
+    /**
+     * @brief Formats the message and returns the resolved copy of the record.
+     *
+     * @param record Log record containing this message.
+     * @param out Buffer to store the formatted message.
+     * @return Copy of the record with the formatted message.
+     */
+    [[nodiscard]] auto resolve(const Record<Char>& record, BufferType& out) const -> Record<Char>
+    {
+        format(out);
+        Record<Char> result = record;
+        result.message = std::basic_string_view<Char>{out.data(), out.size()};
+        result.deferred = nullptr;
+        return result;
+    }
+
+private:
+    DeferredMessage(
+        std::basic_string_view<Char> fmt,
+        FormatFunction func,
+        std::basic_string_view<Char> args,
+        std::span<const DeferredArgType> types) noexcept
+        : m_fmt(fmt)
+        , m_func(func)
+        , m_args(args)
+        , m_types(types)
+    {
+    }
+
+    template<typename... Args>
+    static auto format_args(BufferType& out, std::basic_string_view<Char> fmt, const Char* data)
+        -> void
+    {
+        // Elements of a braced initializer list are evaluated in order
+        std::tuple<typename detail::DeferredArg<Char, Args>::DecodedType...> values{
+            detail::DeferredArg<Char, Args>::decode(data)...};
+        std::apply(
+            [&out, fmt](auto&... args) { out.vformat(fmt, BufferType::make_format_args(args...)); },
+            values);
+    }
+
+    std::basic_string_view<Char> m_fmt;
+    FormatFunction m_func = nullptr;
+    std::basic_string_view<Char> m_args;
+    std::span<const DeferredArgType> m_types;
+};
+
 #ifndef SLIMLOG_FMTLIB
 template<typename T, Formattable<T> Char>
 class CachedFormatter;
@@ -11,7 +11,10 @@
 #include "slimlog/logger.h" // IWYU pragma: associated
 
 #include <algorithm>
+#include <memory>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace slimlog {
 
@@ -22,6 +25,8 @@ Logger<Char, ThreadingPolicy, BufferSize, Allocator>::Logger(
     , m_parent(nullptr)
     , m_level(level)
     , m_propagate(true)
+    , m_deferred_format(false)
+    , m_time_func(util::os::local_time)
 {
 }
 
@@ -182,6 +187,46 @@ auto Logger<Char, ThreadingPolicy, BufferSize, Allocator>::set_level(Level level
     m_level = level;
 }
 
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto Logger<Char, ThreadingPolicy, BufferSize, Allocator>::set_time_func(
+    TimeFunctionType time_func) -> void
+{
+    m_time_func = time_func;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto Logger<Char, ThreadingPolicy, BufferSize, Allocator>::set_deferred_format(bool enabled)
+    -> void
+{
+    m_deferred_format = enabled;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto Logger<Char, ThreadingPolicy, BufferSize, Allocator>::deferred_format() const -> bool
+{
+    return static_cast<bool>(m_deferred_format);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto Logger<Char, ThreadingPolicy, BufferSize, Allocator>::enable_backtrace(
+    std::size_t capacity, Level level, Level trigger) -> void
+{
+    m_backtrace.enable(capacity, level, trigger);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto Logger<Char, ThreadingPolicy, BufferSize, Allocator>::disable_backtrace() -> void
+{
+    m_backtrace.disable();
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto Logger<Char, ThreadingPolicy, BufferSize, Allocator>::dump_backtrace() const -> void
+{
+    const typename SinkSnapshot::ReadGuard sinks(m_propagated_sinks);
+    m_backtrace.dump([&sinks](const Record<Char>& stored) { dispatch(*sinks, stored); });
+}
+
 /**
  * @brief Gets the logging level.
  *
@@ -282,30 +327,33 @@ auto Logger<Char, ThreadingPolicy, BufferSize, Allocator>::update_propagated_sin
     }
 
     // Snapshot propagated sinks
-    std::vector<SinkType*> propagated_sinks;
+    std::vector<std::shared_ptr<SinkType>> propagated_sinks;
     if (parent && m_propagate) {
         const typename ThreadingPolicy::template SharedLock<decltype(m_mutex)> lock(
             parent->m_mutex);
-        propagated_sinks = parent->m_propagated_sinks;
+        propagated_sinks = *parent->m_propagated_sinks.get();
     }
 
-    // Update the current node's propagated sinks, snapshot children
+    // Update the current node's propagated sinks, snapshot children.
+    // Old list is reclaimed after releasing the lock, since it may wait for readers.
+    typename SinkSnapshot::Retired retired;
     std::vector<std::shared_ptr<Logger>> children;
     {
         const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
-        m_propagated_sinks = propagated_sinks;
         for (const auto& [sink, enabled] : m_sinks) {
-            const auto it
-                = std::find(m_propagated_sinks.begin(), m_propagated_sinks.end(), sink.get());
-            const auto found = it != m_propagated_sinks.end();
+            const auto it = std::find(propagated_sinks.begin(), propagated_sinks.end(), sink);
+            const auto found = it != propagated_sinks.end();
             if (!found && enabled) {
                 // Add sink if not already present
-                m_propagated_sinks.push_back(sink.get());
+                propagated_sinks.push_back(sink);
             } else if (found && !enabled) {
                 // Remove sink if present
-                m_propagated_sinks.erase(it);
+                propagated_sinks.erase(it);
             }
         }
+        retired = m_propagated_sinks.publish(
+            std::make_unique<const std::vector<std::shared_ptr<SinkType>>>(
+                std::move(propagated_sinks)));
 
         // Clean up expired children and snapshot valid ones
         children.reserve(m_children.size());
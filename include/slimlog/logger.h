@@ -5,15 +5,19 @@
 
 #pragma once
 
+#include "slimlog/backtrace.h"
 #include "slimlog/common.h" // IWYU pragma: export
 #include "slimlog/format.h"
 #include "slimlog/location.h" // IWYU pragma: export
 #include "slimlog/sink.h" // IWYU pragma: export
 #include "slimlog/threading.h" // IWYU pragma: export
+#include "slimlog/util/epoch.h"
+#include "slimlog/util/os.h"
 #include "slimlog/util/string.h"
 #include "slimlog/util/types.h"
 
 #include <array>
+#include <chrono>
 #include <concepts>
 #include <cstddef>
 #include <memory>
@@ -25,7 +29,6 @@
 #include <vector>
 
 // IWYU pragma: no_include <string>
-// IWYU pragma: no_include <chrono>
 
 namespace slimlog {
 
@@ -95,6 +98,8 @@ public:
     using StringViewType = std::basic_string_view<Char>;
     /** @brief Base sink type for the logger. */
     using SinkType = Sink<Char>;
+    /** @brief Time function type for getting the current time. */
+    using TimeFunctionType = std::pair<std::chrono::sys_seconds, std::size_t> (*)();
 
     Logger(const Logger&) = delete;
     Logger(Logger&&) = delete;
@@ -330,6 +335,70 @@ public:
      */
     [[nodiscard]] SLIMLOG_EXPORT auto level() const -> Level;
 
+    /**
+     * @brief Sets the time function used for log timestamps.
+     *
+     * The timestamp is taken once per record, so all sinks receive the same time.
+     * Defaults to util::os::local_time().
+     *
+     * @param time_func Time function to be set for this logger.
+     */
+    SLIMLOG_EXPORT auto set_time_func(TimeFunctionType time_func) -> void;
+
+    /**
+     * @brief Enables or disables deferred formatting of log messages.
+     *
+     * If enabled, formatted messages with arguments of basic types (numbers, `void` pointers
+     * and strings) are not formatted on the caller's thread. Instead, the arguments are
+     * serialized into a compact binary form and passed to sinks as Record::deferred,
+     * so that formatting happens only when a sink needs the message text.
+     * This is mostly useful with AsyncSink, which moves formatting to its backend thread.
+     *
+     * Custom sinks deriving directly from Sink should use DeferredMessage::resolve()
+     * to get the message text if Record::deferred is set.
+     *
+     * @param enabled Enabled flag.
+     */
+    SLIMLOG_EXPORT auto set_deferred_format(bool enabled) -> void;
+
+    /**
+     * @brief Checks if deferred formatting is enabled.
+     *
+     * @return \b true if deferred formatting is enabled.
+     */
+    [[nodiscard]] SLIMLOG_EXPORT auto deferred_format() const -> bool;
+
+    /**
+     * @brief Enables the backtrace of records suppressed by the logging level.
+     *
+     * Records of levels disabled for the logger, but not less severe than \p level,
+     * are kept in a ring of the last \p capacity records instead of being discarded.
+     * When a record of \p trigger level or more severe is emitted, the stored records
+     * are passed to the sinks first, oldest first. This gives detailed context
+     * for errors without formatting and writing debug messages in the steady state.
+     *
+     * Messages with arguments of basic types are stored unformatted
+     * (see set_deferred_format()), so they are formatted only if the backtrace is dumped.
+     *
+     * Calling this method again discards the stored records.
+     *
+     * @param capacity Maximum number of stored records, zero disables the backtrace.
+     * @param level Least severe level of the stored records.
+     * @param trigger Least severe level of the records that trigger a dump.
+     */
+    SLIMLOG_EXPORT auto enable_backtrace(
+        std::size_t capacity, Level level = Level::Trace, Level trigger = Level::Error) -> void;
+
+    /**
+     * @brief Disables the backtrace and discards the stored records.
+     */
+    SLIMLOG_EXPORT auto disable_backtrace() -> void;
+
+    /**
+     * @brief Passes the records stored in the backtrace to the sinks and clears it.
+     */
+    SLIMLOG_EXPORT auto dump_backtrace() const -> void;
+
     /**
      * @brief Checks if a particular logging level is enabled for the logger.
      *
@@ -361,13 +430,17 @@ public:
         Args&&... args) const -> void
     {
         // Early exit if the level is not enabled
-        if (static_cast<Level>(m_level) < level) [[unlikely]] {
+        if (!is_active_level(level)) [[unlikely]] {
+            return;
+        }
+        const bool suppressed = static_cast<Level>(m_level) < level;
+        if (suppressed && !m_backtrace.accepts(level)) [[unlikely]] {
             return;
         }
 
-        const typename ThreadingPolicy::template SharedLock<decltype(m_mutex)> lock(m_mutex);
+        const typename SinkSnapshot::ReadGuard sinks(m_propagated_sinks);
         // Early exit if there are no sinks to propagate to
-        if (m_propagated_sinks.empty()) [[unlikely]] {
+        if (sinks->empty()) [[unlikely]] {
             return;
         }
 
@@ -415,12 +488,17 @@ public:
             location.file_name(),
             location.function_name(),
             static_cast<std::size_t>(location.line()),
-            level};
+            level,
+            static_cast<TimeFunctionType>(m_time_func)(),
+            util::os::thread_id()};
 
-        // Propagate the message to all sinks
-        for (const auto sink : m_propagated_sinks) {
-            sink->message(record);
+        if (suppressed) {
+            m_backtrace.push(record);
+            return;
         }
+
+        // Propagate the message to all sinks
+        emit(*sinks, record);
     }
 
     /**
@@ -436,6 +514,18 @@ public:
     template<typename... Args>
     void message(Level level, Format<Char, std::type_identity_t<Args>...> fmt, Args&&... args) const
     {
+        if (!is_active_level(level)) [[unlikely]] {
+            return;
+        }
+
+        if constexpr (DeferredMessage<Char>::template Supported<Args...>) {
+            // Records stored in the backtrace are formatted only if dumped
+            if (static_cast<bool>(m_deferred_format) || static_cast<Level>(m_level) < level) {
+                this->template deferred_message<Args...>(level, fmt, args...);
+                return;
+            }
+        }
+
         using FormatBufferType = FormatBuffer<Char, BufferSize, Allocator>;
         auto callback = [&fmt = fmt.fmt()](FormatBufferType& buffer, Args&&... args) {
             buffer.format(fmt, std::forward<Args>(args)...);
@@ -454,7 +544,9 @@ public:
     template<typename... Args>
     auto trace(const Format<Char, std::type_identity_t<Args>...>& fmt, Args&&... args) const -> void
     {
-        this->message(Level::Trace, fmt, std::forward<Args>(args)...);
+        if constexpr (is_active_level(Level::Trace)) {
+            this->message(Level::Trace, fmt, std::forward<Args>(args)...);
+        }
     }
 
     /**
@@ -468,7 +560,9 @@ public:
     template<typename T>
     auto trace(T&& message, const Location& location = Location::current()) const -> void
     {
-        this->message(Level::Trace, std::forward<T>(message), location);
+        if constexpr (is_active_level(Level::Trace)) {
+            this->message(Level::Trace, std::forward<T>(message), location);
+        }
     }
 
     /**
@@ -481,7 +575,9 @@ public:
     template<typename... Args>
     auto debug(const Format<Char, std::type_identity_t<Args>...>& fmt, Args&&... args) const -> void
     {
-        this->message(Level::Debug, fmt, std::forward<Args>(args)...);
+        if constexpr (is_active_level(Level::Debug)) {
+            this->message(Level::Debug, fmt, std::forward<Args>(args)...);
+        }
     }
 
     /**
@@ -495,7 +591,9 @@ public:
     template<typename T>
     auto debug(T&& message, const Location& location = Location::current()) const -> void
     {
-        this->message(Level::Debug, std::forward<T>(message), location);
+        if constexpr (is_active_level(Level::Debug)) {
+            this->message(Level::Debug, std::forward<T>(message), location);
+        }
     }
 
     /**
@@ -508,7 +606,9 @@ public:
     template<typename... Args>
     auto info(const Format<Char, std::type_identity_t<Args>...>& fmt, Args&&... args) const -> void
     {
-        this->message(Level::Info, fmt, std::forward<Args>(args)...);
+        if constexpr (is_active_level(Level::Info)) {
+            this->message(Level::Info, fmt, std::forward<Args>(args)...);
+        }
     }
 
     /**
@@ -525,7 +625,9 @@ public:
     template<typename T>
     auto info(T&& message, const Location& location = Location::current()) const -> void
     {
-        this->message(Level::Info, std::forward<T>(message), location);
+        if constexpr (is_active_level(Level::Info)) {
+            this->message(Level::Info, std::forward<T>(message), location);
+        }
     }
 
     /**
@@ -539,7 +641,9 @@ public:
     auto warning(const Format<Char, std::type_identity_t<Args>...>& fmt, Args&&... args) const
         -> void
     {
-        this->message(Level::Warning, fmt, std::forward<Args>(args)...);
+        if constexpr (is_active_level(Level::Warning)) {
+            this->message(Level::Warning, fmt, std::forward<Args>(args)...);
+        }
     }
 
     /**
@@ -553,7 +657,9 @@ public:
     template<typename T>
     auto warning(T&& message, const Location& location = Location::current()) const -> void
     {
-        this->message(Level::Warning, std::forward<T>(message), location);
+        if constexpr (is_active_level(Level::Warning)) {
+            this->message(Level::Warning, std::forward<T>(message), location);
+        }
     }
 
     /**
@@ -566,7 +672,9 @@ public:
     template<typename... Args>
     auto error(const Format<Char, std::type_identity_t<Args>...>& fmt, Args&&... args) const -> void
     {
-        this->message(Level::Error, fmt, std::forward<Args>(args)...);
+        if constexpr (is_active_level(Level::Error)) {
+            this->message(Level::Error, fmt, std::forward<Args>(args)...);
+        }
     }
 
     /**
@@ -580,7 +688,9 @@ public:
     template<typename T>
     auto error(T&& message, const Location& location = Location::current()) const -> void
     {
-        this->message(Level::Error, std::forward<T>(message), location);
+        if constexpr (is_active_level(Level::Error)) {
+            this->message(Level::Error, std::forward<T>(message), location);
+        }
     }
 
     /**
@@ -593,7 +703,9 @@ public:
     template<typename... Args>
     auto fatal(const Format<Char, std::type_identity_t<Args>...>& fmt, Args&&... args) const -> void
     {
-        this->message(Level::Fatal, fmt, std::forward<Args>(args)...);
+        if constexpr (is_active_level(Level::Fatal)) {
+            this->message(Level::Fatal, fmt, std::forward<Args>(args)...);
+        }
     }
 
     /**
@@ -607,7 +719,9 @@ public:
     template<typename T>
     auto fatal(T&& message, const Location& location = Location::current()) const -> void
     {
-        this->message(Level::Fatal, std::forward<T>(message), location);
+        if constexpr (is_active_level(Level::Fatal)) {
+            this->message(Level::Fatal, std::forward<T>(message), location);
+        }
     }
 
     /**
@@ -640,6 +754,99 @@ protected:
     SLIMLOG_EXPORT auto remove_child(const std::shared_ptr<Logger>& child) -> void;
 
 private:
+    /** @brief Immutable list of sinks, replaced as a whole on changes. */
+    using SinkSnapshot
+        = util::SnapshotPtr<std::vector<std::shared_ptr<SinkType>>, ThreadingPolicy>;
+
+    /**
+     * @brief Emits a log message with postponed formatting.
+     *
+     * @tparam Args Format argument types.
+     * @param level Logging level.
+     * @param fmt Format string.
+     * @param args Format arguments.
+     */
+    template<typename... Args>
+    auto deferred_message(
+        Level level, const Format<Char, std::type_identity_t<Args>...>& fmt, const Args&... args)
+        const -> void
+    {
+        const bool suppressed = static_cast<Level>(m_level) < level;
+        if (suppressed && !m_backtrace.accepts(level)) [[unlikely]] {
+            return;
+        }
+
+        const typename SinkSnapshot::ReadGuard sinks(m_propagated_sinks);
+        if (sinks->empty()) [[unlikely]] {
+            return;
+        }
+
+        // Arguments are copied as is, without parsing the format string
+        util::MemoryBuffer<Char, BufferSize, Allocator> buffer; // NOLINT(misc-const-correctness)
+        DeferredMessage<Char>::encode(buffer, args...);
+        const auto deferred = DeferredMessage<Char>::template create<Args...>(
+            fmt.fmt(), StringViewType{buffer.data(), buffer.size()});
+
+        const auto& location = fmt.loc();
+        const Record<Char> record{
+            CachedStringView<Char>{},
+            CachedStringView<Char>(m_category),
+            location.file_name(),
+            location.function_name(),
+            static_cast<std::size_t>(location.line()),
+            level,
+            static_cast<TimeFunctionType>(m_time_func)(),
+            util::os::thread_id(),
+            &deferred};
+
+        if (suppressed) {
+            m_backtrace.push(record);
+            return;
+        }
+
+        emit(*sinks, record);
+    }
+
+    /**
+     * @brief Passes the log record to the sinks, preceded by the backtrace if triggered.
+     *
+     * @param sinks Sinks to pass the record to.
+     * @param record Log record.
+     */
+    auto emit(const std::vector<std::shared_ptr<SinkType>>& sinks, const Record<Char>& record) const
+        -> void
+    {
+        if (m_backtrace.triggers(record.level)) [[unlikely]] {
+            m_backtrace.dump([&sinks](const Record<Char>& stored) { dispatch(sinks, stored); });
+        }
+        dispatch(sinks, record);
+    }
+
+    /**
+     * @brief Passes the log record to the sinks.
+     *
+     * With several sinks, the record carries a FormatCache, so that the message is
+     * formatted once per distinct pattern rather than once per sink.
+     *
+     * @param sinks Sinks to pass the record to.
+     * @param record Log record.
+     */
+    static auto dispatch(
+        const std::vector<std::shared_ptr<SinkType>>& sinks, const Record<Char>& record) -> void
+    {
+        if (sinks.size() == 1) [[likely]] {
+            sinks.front()->message(record);
+            return;
+        }
+
+        FormatCache<Char> cache;
+        Record<Char> cached_record = record;
+        cached_record.format_cache = &cache;
+        for (const auto& sink : sinks) {
+            sink->message(cached_record);
+        }
+    }
+
     /** @brief Recursively updates the propagated sinks for
      *        the current logger and its children.
      * @param visited Set of visited loggers to avoid cycles.
@@ -649,11 +856,14 @@ private:
     std::unordered_map<std::shared_ptr<SinkType>, bool> m_sinks;
     CachedString<Char> m_category;
     std::vector<std::weak_ptr<Logger>> m_children;
-    std::vector<SinkType*> m_propagated_sinks;
+    SinkSnapshot m_propagated_sinks;
     std::shared_ptr<Logger> m_parent;
     mutable typename ThreadingPolicy::SharedMutex m_mutex;
     AtomicWrapper<Level, ThreadingPolicy> m_level;
     AtomicWrapper<bool, ThreadingPolicy> m_propagate;
+    AtomicWrapper<bool, ThreadingPolicy> m_deferred_format;
+    AtomicWrapper<TimeFunctionType, ThreadingPolicy> m_time_func;
+    mutable Backtrace<Char, ThreadingPolicy, BufferSize, Allocator> m_backtrace;
     static constexpr std::array<Char, 7> DefaultCategory{'d', 'e', 'f', 'a', 'u', 'l', 't'};
 };
 
@@ -877,6 +1087,57 @@ Logger(
 
 } // namespace slimlog
 
+/**
+ * @brief Emits a log message unless the level is removed at compile time.
+ *
+ * Unlike Logger::message(), argument expressions are not evaluated
+ * if the level is above SLIMLOG_ACTIVE_LEVEL.
+ *
+ * @param logger Pointer to the logger.
+ * @param level Logging level, must be a constant expression.
+ * @param ... Message, callback or format string with arguments.
+ */
+#define SLIMLOG_MESSAGE(logger, level, ...)                                                        \
+    do {                                                                                           \
+        if constexpr (::slimlog::is_active_level(level)) {                                         \
+            (logger)->message(level, __VA_ARGS__);                                                 \
+        }                                                                                          \
+    } while (false)
+
+// Per-level shortcuts expand to nothing if the level is removed at compile time,
+// so the arguments are not compiled at all.
+#if SLIMLOG_ACTIVE_LEVEL >= SLIMLOG_LEVEL_TRACE
+#define SLIMLOG_TRACE(logger, ...) (logger)->trace(__VA_ARGS__)
+#else
+#define SLIMLOG_TRACE(logger, ...) static_cast<void>(0)
+#endif
+
+#if SLIMLOG_ACTIVE_LEVEL >= SLIMLOG_LEVEL_DEBUG
+#define SLIMLOG_DEBUG(logger, ...) (logger)->debug(__VA_ARGS__)
+#else
+#define SLIMLOG_DEBUG(logger, ...) static_cast<void>(0)
+#endif
+
+#if SLIMLOG_ACTIVE_LEVEL >= SLIMLOG_LEVEL_INFO
+#define SLIMLOG_INFO(logger, ...) (logger)->info(__VA_ARGS__)
+#else
+#define SLIMLOG_INFO(logger, ...) static_cast<void>(0)
+#endif
+
+#if SLIMLOG_ACTIVE_LEVEL >= SLIMLOG_LEVEL_WARNING
+#define SLIMLOG_WARNING(logger, ...) (logger)->warning(__VA_ARGS__)
+#else
+#define SLIMLOG_WARNING(logger, ...) static_cast<void>(0)
+#endif
+
+#if SLIMLOG_ACTIVE_LEVEL >= SLIMLOG_LEVEL_ERROR
+#define SLIMLOG_ERROR(logger, ...) (logger)->error(__VA_ARGS__)
+#else
+#define SLIMLOG_ERROR(logger, ...) static_cast<void>(0)
+#endif
+
+#define SLIMLOG_FATAL(logger, ...) (logger)->fatal(__VA_ARGS__)
+
 #ifdef SLIMLOG_HEADER_ONLY
 #include "slimlog/logger-inl.h" // IWYU pragma: keep
 #endif
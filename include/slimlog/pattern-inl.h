@@ -13,57 +13,76 @@
 #include "slimlog/util/unicode.h"
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
+#include <cstddef>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace slimlog {
 
 template<typename Char>
-auto Pattern<Char>::Levels::get(Level level) const -> CachedStringView<Char>
+Pattern<Char>::Levels::Levels()
 {
-    switch (level) {
-    case Level::Fatal:
-        return CachedStringView<Char>(m_fatal);
-    case Level::Error:
-        return CachedStringView<Char>(m_error);
-    case Level::Warning:
-        return CachedStringView<Char>(m_warning);
-    case Level::Info:
-        return CachedStringView<Char>(m_info);
-    case Level::Debug:
-        return CachedStringView<Char>(m_debug);
-    case Level::Trace:
-        [[fallthrough]];
-    default:
-        return CachedStringView<Char>(m_trace);
+    for (const auto& name : m_names) {
+        name.codepoints();
     }
 }
 
+template<typename Char>
+auto Pattern<Char>::Levels::get(Level level) const -> CachedStringView<Char>
+{
+    // Unknown levels are reported as trace
+    const auto index = std::min(static_cast<std::size_t>(level), m_names.size() - 1);
+    return CachedStringView<Char>(m_names[index]);
+}
+
 template<typename Char>
 auto Pattern<Char>::Levels::set(Level level, StringViewType name) -> void
 {
-    switch (level) {
-    case Level::Fatal:
-        m_fatal = CachedString<Char>(name);
-        break;
-    case Level::Error:
-        m_error = CachedString<Char>(name);
-        break;
-    case Level::Warning:
-        m_warning = CachedString<Char>(name);
-        break;
-    case Level::Info:
-        m_info = CachedString<Char>(name);
-        break;
-    case Level::Debug:
-        m_debug = CachedString<Char>(name);
-        break;
-    case Level::Trace:
-        [[fallthrough]];
-    default:
-        m_trace = CachedString<Char>(name);
-        break;
+    const auto index = std::min(static_cast<std::size_t>(level), m_names.size() - 1);
+    m_names[index] = CachedString<Char>(name);
+    m_names[index].codepoints();
+}
+
+template<typename Char>
+auto Pattern<Char>::Levels::operator==(const Levels& other) const -> bool
+{
+    return std::ranges::equal(m_names, other.m_names, [](const auto& lhs, const auto& rhs) {
+        return StringViewType{CachedStringView<Char>(lhs)}
+            == StringViewType{CachedStringView<Char>(rhs)};
+    });
+}
+
+template<typename Char>
+auto Pattern<Char>::operator==(const Pattern& other) const -> bool
+{
+    // Formatters are built from the specs stored in the compiled pattern string
+    return m_id == other.m_id
+        || (m_pattern == other.m_pattern && m_program == other.m_program
+            && m_levels == other.m_levels && m_time_func == other.m_time_func);
+}
+
+template<typename Char>
+auto Pattern<Char>::intern(Pattern pattern) -> std::shared_ptr<const Pattern>
+{
+    static std::mutex mutex;
+    static std::vector<std::weak_ptr<const Pattern>> patterns;
+
+    const std::lock_guard lock(mutex);
+    std::erase_if(patterns, [](const auto& item) { return item.expired(); });
+    for (const auto& item : patterns) {
+        if (auto interned = item.lock(); interned && *interned == pattern) {
+            return interned;
+        }
     }
+
+    auto interned = std::make_shared<const Pattern>(std::move(pattern));
+    patterns.push_back(interned);
+    return interned;
 }
 
 template<typename Char>
@@ -74,46 +93,97 @@ template<typename Char>
 
 template<typename Char>
 template<typename ThreadingPolicy, typename BufferType>
-auto Pattern<Char>::format(BufferType& out, const Record<Char>& record) -> void
+auto Pattern<Char>::format(BufferType& out, const Record<Char>& record) const -> void
 {
-    std::pair<std::chrono::sys_seconds, std::size_t> time_point;
-    if (m_has_time) {
+    auto time_point = record.time;
+    if (m_time_func && m_has_time) [[unlikely]] {
         time_point = m_time_func();
     }
 
-    for (const auto& item : m_placeholders) {
-        std::visit(
-            util::types::Overloaded{
-                [&out](const StringViewType& text) { out.append(text); },
-                [&out, &record, this](const LevelFormatter& formatter) {
-                    formatter.template format<ThreadingPolicy>(out, m_levels.get(record.level));
-                },
-                [&out, &time_point](const TimeFormatter& formatter) {
-                    formatter.format(out, time_point.first);
-                },
-                [&out, &time_point](const MsecFormatter& formatter) {
-                    constexpr std::size_t MsecInNsec = 1'000'000;
-                    formatter.format(out, time_point.second / MsecInNsec);
-                },
-                [&out, &time_point](const UsecFormatter& formatter) {
-                    constexpr std::size_t UsecInNsec = 1'000;
-                    formatter.format(out, time_point.second / UsecInNsec);
-                },
-                [&out, &time_point](const NsecFormatter& formatter) {
-                    formatter.format(out, time_point.second);
-                },
-                [&out](const ThreadFormatter& formatter) {
-                    formatter.format(out, util::os::thread_id());
-                },
-                [&out, &record](const auto& formatter) {
-                    using FormatterType = std::decay_t<decltype(formatter)>;
-                    if constexpr (std::is_base_of_v<StringFormatter, FormatterType>) {
-                        formatter.template format<ThreadingPolicy>(out, record);
-                    } else {
-                        formatter.format(out, record);
-                    }
-                }},
-            item);
+    constexpr std::size_t MsecInNsec = 1'000'000;
+    constexpr std::size_t UsecInNsec = 1'000;
+    const auto write = [&out](const auto& value) {
+        StringFormatter::template write_string<ThreadingPolicy>(out, value);
+    };
+    const auto write_formatted = [&out, this](std::size_t index, const auto& value) {
+        m_string_formatters[index].template format<ThreadingPolicy>(out, value);
+    };
+
+    for (const auto& instruction : m_program) {
+        const auto index = instruction.offset;
+        // Literal text is the most frequent instruction, handle it without the jump table
+        if (instruction.opcode == Opcode::Text) {
+            out.append(StringViewType{m_pattern.data() + index, instruction.size});
+            continue;
+        }
+
+        switch (instruction.opcode) {
+        case Opcode::Text:
+            break;
+        case Opcode::Category:
+            write(record.category);
+            break;
+        case Opcode::Level:
+            write(m_levels.get(record.level));
+            break;
+        case Opcode::File:
+            write(record.filename);
+            break;
+        case Opcode::Function:
+            write(record.function);
+            break;
+        case Opcode::Message:
+            write(record.message);
+            break;
+        case Opcode::Line:
+            write_decimal(out, record.line, instruction.size);
+            break;
+        case Opcode::Thread:
+            write_decimal(out, record.thread_id, instruction.size);
+            break;
+        case Opcode::Msec:
+            write_decimal(out, time_point.second / MsecInNsec, instruction.size);
+            break;
+        case Opcode::Usec:
+            write_decimal(out, time_point.second / UsecInNsec, instruction.size);
+            break;
+        case Opcode::Nsec:
+            write_decimal(out, time_point.second, instruction.size);
+            break;
+        case Opcode::FormattedCategory:
+            write_formatted(index, record.category);
+            break;
+        case Opcode::FormattedLevel:
+            write_formatted(index, m_levels.get(record.level));
+            break;
+        case Opcode::FormattedFile:
+            write_formatted(index, record.filename);
+            break;
+        case Opcode::FormattedFunction:
+            write_formatted(index, record.function);
+            break;
+        case Opcode::FormattedMessage:
+            write_formatted(index, record.message);
+            break;
+        case Opcode::FormattedLine:
+            m_number_formatters[index].format(out, record.line);
+            break;
+        case Opcode::FormattedThread:
+            m_number_formatters[index].format(out, record.thread_id);
+            break;
+        case Opcode::FormattedMsec:
+            m_number_formatters[index].format(out, time_point.second / MsecInNsec);
+            break;
+        case Opcode::FormattedUsec:
+            m_number_formatters[index].format(out, time_point.second / UsecInNsec);
+            break;
+        case Opcode::FormattedNsec:
+            m_number_formatters[index].format(out, time_point.second);
+            break;
+        case Opcode::FormattedTime:
+            write_time(out, index, time_point.first);
+            break;
+        }
     }
 }
 
@@ -121,6 +191,7 @@ template<typename Char>
 auto Pattern<Char>::set_time_func(TimeFunctionType time_func) -> void
 {
     m_time_func = time_func;
+    m_id = next_id();
 }
 
 template<typename Char>
@@ -132,7 +203,12 @@ auto Pattern<Char>::set_pattern(StringViewType pattern) -> void
 template<typename Char>
 void Pattern<Char>::compile(StringViewType pattern)
 {
-    m_placeholders.clear();
+    m_program.clear();
+    m_string_formatters.clear();
+    m_number_formatters.clear();
+    m_time_formatters.clear();
+    m_id = next_id();
+    m_has_time = false;
     m_pattern.clear();
     m_pattern.reserve(pattern.size());
 
@@ -202,27 +278,24 @@ void Pattern<Char>::compile(StringViewType pattern)
     }
 
     // If no placeholders found, just add message as a default
-    if (m_placeholders.empty()) {
-        m_placeholders.emplace_back(MessageFormatter{});
+    if (m_program.empty()) {
+        m_program.push_back({Opcode::Message});
     }
 }
 
 template<typename Char>
 void Pattern<Char>::append_text(std::size_t count, std::size_t shift)
 {
-    auto data = StringViewType{m_pattern}.substr(m_pattern.size() - count - shift, count);
+    const auto offset = m_pattern.size() - count - shift;
 
-    // Try to merge with previous text placeholder
-    if (!m_placeholders.empty()) {
-        if (auto* text = std::get_if<StringViewType>(&m_placeholders.back())) {
-            // Merge by extending the string view
-            *text = StringViewType({text->data(), text->size() + data.size()});
-            return;
-        }
+    // Try to merge with previous text instruction
+    if (!m_program.empty() && m_program.back().opcode == Opcode::Text) {
+        m_program.back().size += count;
+        return;
     }
 
-    // Otherwise add new text placeholder
-    m_placeholders.emplace_back(data);
+    // Otherwise add new text instruction
+    m_program.push_back({Opcode::Text, offset, count});
 }
 
 template<typename Char>
@@ -230,7 +303,24 @@ template<typename PlaceholderType>
 void Pattern<Char>::append_placeholder(std::size_t count)
 {
     auto data = StringViewType{m_pattern}.substr(m_pattern.size() - count, count);
-    m_placeholders.emplace_back(PlaceholderType{data});
+    if constexpr (std::is_same_v<PlaceholderType, TimeFormatter>) {
+        m_program.push_back({PlaceholderType::Code, m_time_formatters.size()});
+        m_time_formatters.emplace_back(data);
+    } else if (data.empty()) {
+        // No format specs: the field is written as is
+        m_program.push_back({PlaceholderType::Code});
+    } else if (const auto width = zero_pad_width(data);
+               !std::is_base_of_v<StringFormatter, PlaceholderType> && width > 0) {
+        // Zero-padded number (e.g. "{msec:03}") is written by the digit writer
+        m_program.push_back({PlaceholderType::Code, 0, width});
+    } else if constexpr (std::is_base_of_v<StringFormatter, PlaceholderType>) {
+        m_program.push_back({PlaceholderType::FormattedCode, m_string_formatters.size()});
+        m_string_formatters.emplace_back(data);
+    } else {
+        m_program.push_back({PlaceholderType::FormattedCode, m_number_formatters.size()});
+        m_number_formatters.emplace_back(data);
+    }
+
     if constexpr (
         std::is_same_v<PlaceholderType, TimeFormatter>
         || std::is_same_v<PlaceholderType, MsecFormatter>
@@ -240,6 +330,90 @@ void Pattern<Char>::append_placeholder(std::size_t count)
     }
 }
 
+template<typename Char>
+template<typename BufferType>
+constexpr void Pattern<Char>::write_decimal(
+    BufferType& out, std::size_t value, std::size_t width)
+{
+    constexpr std::size_t Base = 10;
+    constexpr std::size_t MaxDigits = std::numeric_limits<std::size_t>::digits10 + 1;
+    std::array<Char, MaxDigits> digits; // NOLINT(cppcoreguidelines-pro-type-member-init)
+    auto* const end = digits.data() + digits.size();
+    auto* begin = end;
+    do {
+        *--begin = static_cast<Char>('0' + (value % Base));
+        value /= Base;
+    } while (value != 0);
+
+    // Width is limited by zero_pad_width() to fit the digits array
+    for (auto* const first = end - width; begin > first;) {
+        *--begin = Char{'0'};
+    }
+    out.append(StringViewType{begin, static_cast<std::size_t>(end - begin)});
+}
+
+template<typename Char>
+template<typename BufferType>
+void Pattern<Char>::write_time(
+    BufferType& out, std::size_t index, std::chrono::sys_seconds seconds) const
+{
+    // Pattern may be shared between threads, so each thread keeps its own copy
+    // of the text. Entries are looked up by pattern identifier, not by address,
+    // so that a destroyed pattern cannot be confused with a new one.
+    constexpr std::size_t MaxEntries = 16;
+    thread_local std::array<TimeCache, MaxEntries> entries;
+    thread_local std::size_t next_entry = 0;
+
+    auto cache = std::ranges::find_if(entries, [this, index](const TimeCache& entry) {
+        return entry.pattern == m_id && entry.index == index;
+    });
+    if (cache == entries.end()) [[unlikely]] {
+        cache = std::next(entries.begin(), static_cast<std::ptrdiff_t>(next_entry++ % MaxEntries));
+        cache->pattern = m_id;
+        cache->index = index;
+        cache->seconds = std::chrono::sys_seconds::min();
+    }
+
+    if (cache->seconds != seconds) [[unlikely]] {
+        const auto start = out.size();
+        m_time_formatters[index].format(out, seconds);
+        cache->text.assign(out.data() + start, out.size() - start);
+        cache->seconds = seconds;
+        return;
+    }
+    out.append(StringViewType{cache->text});
+}
+
+template<typename Char>
+auto Pattern<Char>::next_id() -> std::size_t
+{
+    // Zero is never used, so that empty cache entries do not match any pattern
+    static std::atomic<std::size_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+template<typename Char>
+constexpr auto Pattern<Char>::zero_pad_width(StringViewType specs) noexcept -> std::size_t
+{
+    // Accept only "0<width>}", everything else is left to the generic formatter
+    constexpr std::size_t MaxWidth = std::numeric_limits<std::size_t>::digits10 + 1;
+    if (specs.size() < 3 || specs.front() != Char{'0'} || specs.back() != Char{'}'}) {
+        return 0;
+    }
+
+    std::size_t width = 0;
+    for (const auto chr : specs.substr(1, specs.size() - 2)) {
+        if (chr < Char{'0'} || chr > Char{'9'}) {
+            return 0;
+        }
+        width = (width * 10) + static_cast<std::size_t>(chr - Char{'0'}); // NOLINT(*-magic-numbers)
+        if (width > MaxWidth) {
+            return 0;
+        }
+    }
+    return width;
+}
+
 template<typename Char>
 Pattern<Char>::StringFormatter::StringFormatter(StringViewType value)
 {
@@ -348,7 +522,7 @@ constexpr auto Pattern<Char>::StringFormatter::parse_align(
 template<typename Char>
 template<typename ThreadingPolicy, typename BufferType, typename T>
 constexpr void Pattern<Char>::StringFormatter::write_string(
-    BufferType& dst, const CachedStringView<T>& src) const
+    BufferType& dst, const CachedStringView<T>& src)
 {
     if constexpr (std::is_same_v<T, char> && !std::is_same_v<Char, char>) {
         // Calculate destination buffer size based on target character encoding:
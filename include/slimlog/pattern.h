@@ -8,13 +8,13 @@
 #include "slimlog/common.h"
 #include "slimlog/format.h"
 #include "slimlog/threading.h"
-#include "slimlog/util/os.h"
 #include "slimlog/util/string.h"
 
 #include <array>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -94,6 +94,41 @@ public:
     /** @brief Default move assignment operator. */
     auto operator=(Pattern&&) -> Pattern& = default;
 
+    /**
+     * @brief Checks if two patterns produce the same output.
+     *
+     * Compares the compiled pattern, level names and the time function.
+     *
+     * @param other Pattern to compare with.
+     * @return \b true if both patterns format any record identically.
+     */
+    [[nodiscard]] SLIMLOG_EXPORT auto operator==(const Pattern& other) const -> bool;
+
+    /**
+     * @brief Returns a shared immutable pattern equal to the given one.
+     *
+     * Equal patterns interned while the previous result is alive share a single object,
+     * so that sinks configured identically also share the same id().
+     *
+     * @param pattern Pattern to intern.
+     * @return Pointer to the interned pattern.
+     */
+    [[nodiscard]] SLIMLOG_EXPORT static auto intern(Pattern pattern)
+        -> std::shared_ptr<const Pattern>;
+
+    /**
+     * @brief Gets the pattern identifier.
+     *
+     * The identifier is changed by every modification and kept by copies,
+     * so patterns with equal identifiers produce the same output.
+     *
+     * @return Pattern identifier.
+     */
+    [[nodiscard]] auto id() const noexcept -> std::size_t
+    {
+        return m_id;
+    }
+
     /**
      * @brief Checks if the pattern is empty.
      *
@@ -113,12 +148,16 @@ public:
      * @param record Log record.
      */
     template<typename ThreadingPolicy = SingleThreadedPolicy, typename BufferType>
-    SLIMLOG_EXPORT auto format(BufferType& out, const Record<Char>& record) -> void;
+    SLIMLOG_EXPORT auto format(BufferType& out, const Record<Char>& record) const -> void;
 
     /**
-     * @brief Sets the time function used for log timestamps.
+     * @brief Overrides the time function used for log timestamps.
+     *
+     * By default, the timestamp captured by the logger is taken from the record
+     * (see Logger::set_time_func()). If set, the time function is called
+     * on each format() call instead.
      *
-     * @param time_func Time function to be set for this pattern.
+     * @param time_func Time function to be set for this pattern, or `nullptr` to reset.
      */
     SLIMLOG_EXPORT auto set_time_func(TimeFunctionType time_func) -> void;
 
@@ -156,6 +195,7 @@ public:
         for (const auto& pair : std::forward<Container>(container)) {
             m_levels.set(pair.first, StringViewType{pair.second});
         }
+        m_id = next_id();
     }
 
     /**
@@ -183,17 +223,21 @@ public:
                 m_levels.set(pair.first, StringViewType{pair.second});
             }(),
             ...);
+        m_id = next_id();
     }
 
 protected:
     /**
      * @brief Structure for managing log level names.
+     *
+     * Codepoints of the names are calculated when they are set,
+     * so that formatting never writes to the names of a shared pattern.
      */
     struct Levels {
         /** @brief Default destructor. */
         ~Levels() = default;
-        /** @brief Default constructor. */
-        Levels() = default;
+        /** @brief Constructs default level names with precalculated codepoints. */
+        SLIMLOG_EXPORT Levels();
         /** @brief Default copy constructor. */
         Levels(const Levels&) = default;
         /** @brief Default move constructor. */
@@ -219,13 +263,75 @@ protected:
          */
         SLIMLOG_EXPORT auto set(Level level, StringViewType name) -> void;
 
+        /**
+         * @brief Checks if all level names are equal.
+         *
+         * @param other Level names to compare with.
+         * @return \b true if the names are equal.
+         */
+        SLIMLOG_EXPORT auto operator==(const Levels& other) const -> bool;
+
     private:
-        CachedString<Char> m_trace = {'T', 'R', 'A', 'C', 'E'}; ///< Trace level
-        CachedString<Char> m_debug = {'D', 'E', 'B', 'U', 'G'}; ///< Debug level
-        CachedString<Char> m_info = {'I', 'N', 'F', 'O'}; ///< Info level
-        CachedString<Char> m_warning = {'W', 'A', 'R', 'N'}; ///< Warning level
-        CachedString<Char> m_error = {'E', 'R', 'R', 'O', 'R'}; ///< Error level
-        CachedString<Char> m_fatal = {'F', 'A', 'T', 'A', 'L'}; ///< Fatal level
+        /** @brief Level names indexed by Level value. */
+        std::array<CachedString<Char>, static_cast<std::size_t>(Level::Trace) + 1> m_names{
+            CachedString<Char>{'F', 'A', 'T', 'A', 'L'},
+            CachedString<Char>{'E', 'R', 'R', 'O', 'R'},
+            CachedString<Char>{'W', 'A', 'R', 'N'},
+            CachedString<Char>{'I', 'N', 'F', 'O'},
+            CachedString<Char>{'D', 'E', 'B', 'U', 'G'},
+            CachedString<Char>{'T', 'R', 'A', 'C', 'E'}};
+    };
+
+    /**
+     * @brief Operation codes of the compiled pattern.
+     *
+     * Fields without format specs are written directly, without formatter objects.
+     */
+    enum class Opcode : std::uint8_t {
+        Text, ///< Literal text from the pattern string.
+        Category, ///< Category name.
+        Level, ///< Level name.
+        File, ///< Source file name.
+        Function, ///< Function name.
+        Message, ///< Log message.
+        Line, ///< Source line number.
+        Thread, ///< Thread ID.
+        Msec, ///< Milliseconds of the timestamp.
+        Usec, ///< Microseconds of the timestamp.
+        Nsec, ///< Nanoseconds of the timestamp.
+        FormattedCategory, ///< Category name with format specs.
+        FormattedLevel, ///< Level name with format specs.
+        FormattedFile, ///< Source file name with format specs.
+        FormattedFunction, ///< Function name with format specs.
+        FormattedMessage, ///< Log message with format specs.
+        FormattedLine, ///< Source line number with format specs.
+        FormattedThread, ///< Thread ID with format specs.
+        FormattedMsec, ///< Milliseconds of the timestamp with format specs.
+        FormattedUsec, ///< Microseconds of the timestamp with format specs.
+        FormattedNsec, ///< Nanoseconds of the timestamp with format specs.
+        FormattedTime ///< Timestamp.
+    };
+
+    /**
+     * @brief Single instruction of the compiled pattern.
+     */
+    struct Instruction {
+        Opcode opcode = Opcode::Text; ///< Operation code.
+        std::size_t offset = 0; ///< Text offset in the pattern string, or formatter index.
+        std::size_t size = 0; ///< Text length, or width of a zero-padded number.
+
+        /** @brief Equality operator. */
+        auto operator==(const Instruction&) const -> bool = default;
+    };
+
+    /**
+     * @brief Timestamp text rendered by a time formatter.
+     */
+    struct TimeCache {
+        std::size_t pattern = 0; ///< Pattern identifier.
+        std::size_t index = 0; ///< Time formatter index.
+        std::chrono::sys_seconds seconds = std::chrono::sys_seconds::min(); ///< Timestamp.
+        std::basic_string<Char> text{}; ///< Rendered text.
     };
 
     /**
@@ -274,6 +380,18 @@ protected:
             }
         }
 
+        /**
+         * @brief Writes the source string to the destination buffer.
+         *
+         * @tparam ThreadingPolicy Threading policy for codepoint caching.
+         * @tparam BufferType Type of the destination buffer.
+         * @tparam T Character type of the source string view.
+         * @param dst Destination buffer where the string will be written.
+         * @param src Source string view to be written.
+         */
+        template<typename ThreadingPolicy, typename BufferType, typename T>
+        static constexpr void write_string(BufferType& dst, const CachedStringView<T>& src);
+
     protected:
         /**
          * @brief Converts a string to a non-negative integer.
@@ -302,18 +420,6 @@ protected:
         static constexpr auto parse_align(const Char* begin, const Char* end, StringSpecs& specs)
             -> const Char*;
 
-        /**
-         * @brief Writes the source string to the destination buffer.
-         *
-         * @tparam ThreadingPolicy Threading policy for codepoint caching.
-         * @tparam BufferType Type of the destination buffer.
-         * @tparam T Character type of the source string view.
-         * @param dst Destination buffer where the string will be written.
-         * @param src Source string view to be written.
-         */
-        template<typename ThreadingPolicy, typename BufferType, typename T>
-        constexpr void write_string(BufferType& dst, const CachedStringView<T>& src) const;
-
         /**
          * @brief Writes the source string to the destination buffer with specific alignment.
          *
@@ -338,28 +444,24 @@ protected:
     struct CategoryFormatter : public StringFormatter {
         using StringFormatter::StringFormatter;
 
+        /** @brief Opcode for the field without format specs. */
+        static constexpr Opcode Code = Opcode::Category;
+        /** @brief Opcode for the field with format specs. */
+        static constexpr Opcode FormattedCode = Opcode::FormattedCategory;
+
         /** @brief Placeholder name for the category formatter. */
         static constexpr std::array<Char, 8> Name{'c', 'a', 't', 'e', 'g', 'o', 'r', 'y'};
-
-        /**
-         * @brief Formats the category field into the output buffer.
-         *
-         * @tparam ThreadingPolicy Threading policy for codepoint caching.
-         * @tparam BufferType Type of the output buffer.
-         * @param out Output buffer where the category will be written.
-         * @param record Log record containing the category.
-         */
-        template<typename ThreadingPolicy, typename BufferType>
-        auto format(BufferType& out, const Record<Char>& record) const -> void
-        {
-            StringFormatter::template format<ThreadingPolicy>(out, record.category);
-        }
     };
 
     /** @brief %Formatter for the log level field. */
     struct LevelFormatter : public StringFormatter {
         using StringFormatter::StringFormatter;
 
+        /** @brief Opcode for the field without format specs. */
+        static constexpr Opcode Code = Opcode::Level;
+        /** @brief Opcode for the field with format specs. */
+        static constexpr Opcode FormattedCode = Opcode::FormattedLevel;
+
         /** @brief Placeholder name for the log level formatter. */
         static constexpr std::array<Char, 5> Name{'l', 'e', 'v', 'e', 'l'};
     };
@@ -368,87 +470,52 @@ protected:
     struct FileFormatter : public StringFormatter {
         using StringFormatter::StringFormatter;
 
+        /** @brief Opcode for the field without format specs. */
+        static constexpr Opcode Code = Opcode::File;
+        /** @brief Opcode for the field with format specs. */
+        static constexpr Opcode FormattedCode = Opcode::FormattedFile;
+
         /** @brief Placeholder name for the file name formatter. */
         static constexpr std::array<Char, 4> Name{'f', 'i', 'l', 'e'};
-
-        /**
-         * @brief Formats the filename field into the output buffer.
-         *
-         * @tparam ThreadingPolicy Threading policy for codepoint caching.
-         * @tparam BufferType Type of the output buffer.
-         * @param out Output buffer where the filename will be written.
-         * @param record Log record containing the filename.
-         */
-        template<typename ThreadingPolicy, typename BufferType>
-        auto format(BufferType& out, const Record<Char>& record) const -> void
-        {
-            StringFormatter::template format<ThreadingPolicy>(out, record.filename);
-        }
     };
 
     /** @brief %Formatter for the function name field. */
     struct FunctionFormatter : public StringFormatter {
         using StringFormatter::StringFormatter;
 
+        /** @brief Opcode for the field without format specs. */
+        static constexpr Opcode Code = Opcode::Function;
+        /** @brief Opcode for the field with format specs. */
+        static constexpr Opcode FormattedCode = Opcode::FormattedFunction;
+
         /** @brief Placeholder name for the function name formatter. */
         static constexpr std::array<Char, 8> Name{'f', 'u', 'n', 'c', 't', 'i', 'o', 'n'};
-
-        /**
-         * @brief Formats the function name field into the output buffer.
-         *
-         * @tparam ThreadingPolicy Threading policy for codepoint caching.
-         * @tparam BufferType Type of the output buffer.
-         * @param out Output buffer where the function name will be written.
-         * @param record Log record containing the function name.
-         */
-        template<typename ThreadingPolicy, typename BufferType>
-        auto format(BufferType& out, const Record<Char>& record) const -> void
-        {
-            StringFormatter::template format<ThreadingPolicy>(out, record.function);
-        }
     };
 
     /** @brief %Formatter for the log message field. */
     struct MessageFormatter : public StringFormatter {
         using StringFormatter::StringFormatter;
 
+        /** @brief Opcode for the field without format specs. */
+        static constexpr Opcode Code = Opcode::Message;
+        /** @brief Opcode for the field with format specs. */
+        static constexpr Opcode FormattedCode = Opcode::FormattedMessage;
+
         /** @brief Placeholder name for the message formatter. */
         static constexpr std::array<Char, 7> Name{'m', 'e', 's', 's', 'a', 'g', 'e'};
-
-        /**
-         * @brief Formats the message field into the output buffer.
-         *
-         * @tparam ThreadingPolicy Threading policy for codepoint caching.
-         * @tparam BufferType Type of the output buffer.
-         * @param out Output buffer where the message will be written.
-         * @param record Log record containing the message.
-         */
-        template<typename ThreadingPolicy, typename BufferType>
-        auto format(BufferType& out, const Record<Char>& record) const -> void
-        {
-            StringFormatter::template format<ThreadingPolicy>(out, record.message);
-        }
     };
 
     /** @brief %Formatter for the source line number field. */
     struct LineFormatter : public CachedFormatter<std::size_t, Char> {
         using CachedFormatter<std::size_t, Char>::CachedFormatter;
 
+        /** @brief Opcode for the field without format specs. */
+        static constexpr Opcode Code = Opcode::Line;
+        /** @brief Opcode for the field with format specs. */
+        static constexpr Opcode FormattedCode = Opcode::FormattedLine;
+
         /** @brief Placeholder name for the line number formatter. */
         static constexpr std::array<Char, 4> Name{'l', 'i', 'n', 'e'};
-
-        /**
-         * @brief Formats the line number field into the output buffer.
-         *
-         * @tparam BufferType Type of the output buffer.
-         * @param out Output buffer where the line number will be written.
-         * @param record Log record containing the line number.
-         */
-        template<typename BufferType>
-        auto format(BufferType& out, const Record<Char>& record) const -> void
-        {
-            return CachedFormatter<std::size_t, Char>::format(out, record.line);
-        }
     };
 
     /**
@@ -459,6 +526,11 @@ protected:
     struct ThreadFormatter : public CachedFormatter<std::size_t, Char> {
         using CachedFormatter<std::size_t, Char>::CachedFormatter;
 
+        /** @brief Opcode for the field without format specs. */
+        static constexpr Opcode Code = Opcode::Thread;
+        /** @brief Opcode for the field with format specs. */
+        static constexpr Opcode FormattedCode = Opcode::FormattedThread;
+
         /** @brief Placeholder name for the thread ID formatter. */
         static constexpr std::array<Char, 6> Name{'t', 'h', 'r', 'e', 'a', 'd'};
     };
@@ -471,6 +543,11 @@ protected:
     struct TimeFormatter : public CachedFormatter<std::chrono::sys_seconds, Char> {
         using CachedFormatter<std::chrono::sys_seconds, Char>::CachedFormatter;
 
+        /** @brief Opcode for the field (time is always formatted). */
+        static constexpr Opcode Code = Opcode::FormattedTime;
+        /** @brief Opcode for the field with format specs. */
+        static constexpr Opcode FormattedCode = Opcode::FormattedTime;
+
         /** @brief Placeholder name for the time formatter. */
         static constexpr std::array<Char, 4> Name{'t', 'i', 'm', 'e'};
     };
@@ -483,6 +560,11 @@ protected:
     struct MsecFormatter : public CachedFormatter<std::size_t, Char> {
         using CachedFormatter<std::size_t, Char>::CachedFormatter;
 
+        /** @brief Opcode for the field without format specs. */
+        static constexpr Opcode Code = Opcode::Msec;
+        /** @brief Opcode for the field with format specs. */
+        static constexpr Opcode FormattedCode = Opcode::FormattedMsec;
+
         /** @brief Placeholder name for the millisecond formatter. */
         static constexpr std::array<Char, 4> Name{'m', 's', 'e', 'c'};
     };
@@ -495,6 +577,11 @@ protected:
     struct UsecFormatter : public CachedFormatter<std::size_t, Char> {
         using CachedFormatter<std::size_t, Char>::CachedFormatter;
 
+        /** @brief Opcode for the field without format specs. */
+        static constexpr Opcode Code = Opcode::Usec;
+        /** @brief Opcode for the field with format specs. */
+        static constexpr Opcode FormattedCode = Opcode::FormattedUsec;
+
         /** @brief Placeholder name for the microsecond formatter. */
         static constexpr std::array<Char, 4> Name{'u', 's', 'e', 'c'};
     };
@@ -507,11 +594,16 @@ protected:
     struct NsecFormatter : public CachedFormatter<std::size_t, Char> {
         using CachedFormatter<std::size_t, Char>::CachedFormatter;
 
+        /** @brief Opcode for the field without format specs. */
+        static constexpr Opcode Code = Opcode::Nsec;
+        /** @brief Opcode for the field with format specs. */
+        static constexpr Opcode FormattedCode = Opcode::FormattedNsec;
+
         /** @brief Placeholder name for the nanosecond formatter. */
         static constexpr std::array<Char, 4> Name{'n', 's', 'e', 'c'};
     };
 
-    /** @brief Variant type holding all possible formatter types */
+    /** @brief Variant type listing all placeholder formatters, used for lookup by name. */
     using FormatterVariant = std::variant<
         StringViewType,
         CategoryFormatter,
@@ -529,8 +621,9 @@ protected:
     /**
      * @brief Compiles the pattern string into a fast-lookup representation.
      *
-     * This function processes the provided pattern string and converts it into
-     * an internal representation that allows for efficient formatting of log messages.
+     * This function processes the provided pattern string and lowers it into
+     * a flat array of instructions, so that formatting a record is a single loop
+     * over the array with no per-placeholder type dispatch.
      *
      * @param pattern The pattern string to be compiled.
      */
@@ -540,7 +633,8 @@ private:
     /**
      * @brief Append a pattern placeholder to the list of placeholders.
      *
-     * This function creates the appropriate wrapper formatter and appends it to the list.
+     * This function emits the instruction for the placeholder and creates
+     * the formatter if the placeholder has format specs.
      *
      * @tparam PlaceholderType Type of the placeholder formatter.
      * @param count Placeholder length.
@@ -548,6 +642,46 @@ private:
     template<typename PlaceholderType>
     void append_placeholder(std::size_t count);
 
+    /**
+     * @brief Writes an unsigned integer in decimal notation.
+     *
+     * @tparam BufferType Type of the output buffer.
+     * @param out Output buffer.
+     * @param value Value to be written.
+     * @param width Minimum number of digits, padded with zeros.
+     */
+    template<typename BufferType>
+    static constexpr void write_decimal(BufferType& out, std::size_t value, std::size_t width = 0);
+
+    /**
+     * @brief Writes the timestamp, reusing the text rendered earlier within the same second.
+     *
+     * The rendered text is cached per thread, since an interned pattern
+     * can be used by sinks of any threading policy at once.
+     *
+     * @tparam BufferType Type of the output buffer.
+     * @param out Output buffer.
+     * @param index Time formatter index.
+     * @param seconds Timestamp.
+     */
+    template<typename BufferType>
+    void write_time(BufferType& out, std::size_t index, std::chrono::sys_seconds seconds) const;
+
+    /**
+     * @brief Parses format specs of a zero-padded number, like `03` in `{msec:03}`.
+     *
+     * @param specs Format specs including the closing brace.
+     * @return Field width, or zero if the specs require the generic formatter.
+     */
+    static constexpr auto zero_pad_width(StringViewType specs) noexcept -> std::size_t;
+
+    /**
+     * @brief Generates a unique pattern identifier.
+     *
+     * @return New identifier.
+     */
+    SLIMLOG_EXPORT static auto next_id() -> std::size_t;
+
     /**
      * @brief Append raw text placeholder.
      *
@@ -557,9 +691,13 @@ private:
     void append_text(std::size_t count, std::size_t shift = 0);
 
     std::basic_string<Char> m_pattern;
-    std::vector<FormatterVariant> m_placeholders;
+    std::vector<Instruction> m_program;
+    std::vector<StringFormatter> m_string_formatters;
+    std::vector<CachedFormatter<std::size_t, Char>> m_number_formatters;
+    std::vector<CachedFormatter<std::chrono::sys_seconds, Char>> m_time_formatters;
+    std::size_t m_id = 0;
     Levels m_levels;
-    TimeFunctionType m_time_func = util::os::local_time;
+    TimeFunctionType m_time_func = nullptr;
     bool m_has_time = false;
 };
 
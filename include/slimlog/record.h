@@ -0,0 +1,123 @@
+/**
+ * @file record.h
+ * @brief Contains the declaration of the RecordStorage class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/format.h"
+#include "slimlog/util/buffer.h"
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace slimlog {
+
+/**
+ * @brief Owning copy of a log record.
+ *
+ * Log records passed to sinks only reference data owned by the caller.
+ * This class copies the message, category and deferred format arguments into its own buffer
+ * so that the record can outlive the Logger::message() call.
+ *
+ * File and function names are not copied: they are expected to have static
+ * storage duration, which is the case for records created by the Logger
+ * (see Location).
+ *
+ * @tparam Char Character type for the string.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename Char,
+    std::size_t BufferSize = DefaultBufferSize,
+    typename Allocator = std::allocator<Char>>
+class RecordStorage final {
+public:
+    /** @brief Log record type. */
+    using RecordType = Record<Char>;
+
+    RecordStorage() = default;
+    ~RecordStorage() = default;
+
+    // Copied record references the internal buffer
+    RecordStorage(const RecordStorage&) = delete;
+    RecordStorage(RecordStorage&&) = delete;
+    auto operator=(const RecordStorage&) -> RecordStorage& = delete;
+    auto operator=(RecordStorage&&) -> RecordStorage& = delete;
+
+    /**
+     * @brief Copies a log record into the storage.
+     *
+     * Storage stays empty if copying throws.
+     *
+     * @param record Log record to copy.
+     */
+    auto assign(const RecordType& record) -> void
+    {
+        m_empty = true;
+        m_buffer.clear();
+        m_buffer.append(record.category);
+        m_buffer.append(record.message);
+        if (record.deferred) {
+            m_buffer.append(record.deferred->args());
+        }
+
+        const std::basic_string_view<Char> data{m_buffer.data(), m_buffer.size()};
+        const auto category_size = record.category.size();
+        const auto message_size = record.message.size();
+        m_record = {
+            CachedStringView<Char>{data.substr(category_size, message_size)},
+            CachedStringView<Char>{data.substr(0, category_size)},
+            record.filename,
+            record.function,
+            record.line,
+            record.level,
+            record.time,
+            record.thread_id};
+        if (record.deferred) {
+            // Serialized arguments are copied, the format string is static
+            m_deferred = record.deferred->rebind(data.substr(category_size + message_size));
+            m_record.deferred = &m_deferred;
+        }
+        m_empty = false;
+    }
+
+    /**
+     * @brief Resets the storage to the empty state.
+     */
+    auto reset() noexcept -> void
+    {
+        m_empty = true;
+    }
+
+    /**
+     * @brief Checks if the storage contains a record.
+     *
+     * @return \b true if the storage is empty.
+     */
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return m_empty;
+    }
+
+    /**
+     * @brief Gets the stored record.
+     *
+     * @return Log record referencing the internal buffer.
+     */
+    [[nodiscard]] auto record() const noexcept -> const RecordType&
+    {
+        return m_record;
+    }
+
+private:
+    util::MemoryBuffer<Char, BufferSize, Allocator> m_buffer;
+    RecordType m_record;
+    DeferredMessage<Char> m_deferred;
+    bool m_empty = true;
+};
+
+} // namespace slimlog
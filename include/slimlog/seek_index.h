@@ -0,0 +1,375 @@
+/**
+ * @file seek_index.h
+ * @brief Contains declaration of SeekIndexWriter and SeekIndex classes.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/threading.h"
+#include "slimlog/util/os.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace slimlog {
+
+namespace detail {
+
+/** @brief Layout of the seek index file. */
+namespace seek_index {
+
+/** @brief File signature. */
+inline constexpr std::array<char, 8> Magic = {'S', 'L', 'I', 'M', 'S', 'I', 'D', 'X'};
+/** @brief Format version. */
+inline constexpr std::uint32_t Version = 1;
+
+/** @brief File header, followed by the entries. */
+struct FileHeader {
+    std::array<char, 8> magic; ///< File signature.
+    std::uint32_t version; ///< Format version.
+    std::uint16_t char_size; ///< Size of the character type of the log file.
+    std::uint8_t little_endian; ///< Byte order of the numbers, 1 for little-endian.
+    std::uint8_t reserved; ///< Padding to 16 bytes.
+};
+static_assert(sizeof(FileHeader) == 16);
+
+} // namespace seek_index
+} // namespace detail
+
+/**
+ * @brief Block of a log file described by a seek index entry.
+ *
+ * A block starts at a record boundary and contains whole records.
+ */
+struct SeekIndexEntry {
+    std::uint64_t offset; ///< Offset of the block in the log file.
+    std::uint32_t size; ///< Size of the block in bytes.
+    std::uint32_t levels; ///< Levels of the records, bit N is set for `Level(N)`.
+    std::int64_t min_time; ///< Earliest record time in nanoseconds since the epoch.
+    std::int64_t max_time; ///< Latest record time in nanoseconds since the epoch.
+};
+static_assert(sizeof(SeekIndexEntry) == 32);
+
+/**
+ * @brief Writer of a sidecar seek index of a log file.
+ *
+ * Collects the time range and the levels of the records of the current block,
+ * and appends an entry to the index file once the sink has written the block.
+ * Adding a record costs a few loads and, mostly for the latest time, a store.
+ *
+ * The sink calls add() for each record before it can be written, and commit()
+ * after each write. Calls to commit() must not overlap, and must not race with
+ * add() for the records of the written data.
+ *
+ * @tparam ThreadingPolicy Threading policy of the record accounting.
+ */
+template<typename ThreadingPolicy>
+class SeekIndexWriter final {
+public:
+    /**
+     * @brief Opens the index file for append.
+     *
+     * @param path Path to the index file, see SeekIndex::path().
+     * @param char_size Size of the character type of the log file.
+     * @param offset Current size of the log file.
+     * @param block_size Minimum size of an indexed block in bytes.
+     */
+    SeekIndexWriter(
+        const std::filesystem::path& path,
+        std::size_t char_size,
+        std::uint64_t offset,
+        std::size_t block_size)
+        : m_fp(util::os::fopen_shared(path.string().c_str(), "ab"))
+        , m_block_size(std::clamp<std::size_t>(block_size, 1, MaxBlockSize))
+        , m_offset(offset)
+    {
+        if (!m_fp) [[unlikely]] {
+            throw std::system_error({errno, std::system_category()}, "Error opening index file");
+        }
+        std::setvbuf(m_fp.get(), nullptr, _IONBF, 0);
+        if (std::fseek(m_fp.get(), 0, SEEK_END) != 0 || std::ftell(m_fp.get()) > 0) {
+            return;
+        }
+        const detail::seek_index::FileHeader header{
+            .magic = detail::seek_index::Magic,
+            .version = detail::seek_index::Version,
+            .char_size = static_cast<std::uint16_t>(char_size),
+            .little_endian = std::endian::native == std::endian::little,
+            .reserved = 0};
+        if (std::fwrite(&header, sizeof(header), 1, m_fp.get()) != 1) [[unlikely]] {
+            throw std::system_error({errno, std::system_category()}, "Failed writing index file");
+        }
+    }
+
+    /**
+     * @brief Accounts a record to the current block.
+     *
+     * @param time Record time in nanoseconds since the epoch.
+     * @param level Record level.
+     */
+    auto add(std::int64_t time, Level level) noexcept -> void
+    {
+        const auto bit = 1U << static_cast<unsigned>(level);
+        if constexpr (std::is_same_v<ThreadingPolicy, SingleThreadedPolicy>) {
+            const auto levels = m_levels.load(std::memory_order_relaxed);
+            m_levels.store(levels | bit, std::memory_order_relaxed);
+            if (time < m_min_time.load(std::memory_order_relaxed)) {
+                m_min_time.store(time, std::memory_order_relaxed);
+            }
+            if (time > m_max_time.load(std::memory_order_relaxed)) {
+                m_max_time.store(time, std::memory_order_relaxed);
+            }
+        } else {
+            if ((m_levels.load(std::memory_order_relaxed) & bit) == 0) {
+                m_levels.fetch_or(bit, std::memory_order_relaxed);
+            }
+            auto min_time = m_min_time.load(std::memory_order_relaxed);
+            while (time < min_time
+                   && !m_min_time.compare_exchange_weak(
+                       min_time, time, std::memory_order_relaxed, std::memory_order_relaxed)) {
+            }
+            auto max_time = m_max_time.load(std::memory_order_relaxed);
+            while (time > max_time
+                   && !m_max_time.compare_exchange_weak(
+                       max_time, time, std::memory_order_relaxed, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    /**
+     * @brief Accounts written data, appending an entry once the block is large enough.
+     *
+     * @param size Number of bytes written to the log file.
+     */
+    auto commit(std::uint64_t size) -> void
+    {
+        m_size += size;
+        if (m_size >= m_block_size) {
+            finish();
+        }
+    }
+
+    /**
+     * @brief Appends an entry for the written data of the current block, if any.
+     */
+    auto finish() -> void
+    {
+        if (m_size == 0) {
+            return;
+        }
+        const SeekIndexEntry entry{
+            .offset = m_offset,
+            .size = static_cast<std::uint32_t>(m_size),
+            .levels = m_levels.exchange(0, std::memory_order_relaxed),
+            .min_time = m_min_time.exchange(
+                std::numeric_limits<std::int64_t>::max(), std::memory_order_relaxed),
+            .max_time = m_max_time.exchange(
+                std::numeric_limits<std::int64_t>::min(), std::memory_order_relaxed)};
+        m_offset += m_size;
+        m_size = 0;
+        if (std::fwrite(&entry, sizeof(entry), 1, m_fp.get()) != 1) [[unlikely]] {
+            throw std::system_error({errno, std::system_category()}, "Failed writing index file");
+        }
+    }
+
+private:
+    // Blocks larger than this would not fit into an entry
+    static constexpr std::size_t MaxBlockSize = std::size_t{1} << 30U;
+
+    std::unique_ptr<FILE, int (*)(FILE*)> m_fp;
+    std::size_t m_block_size;
+    std::uint64_t m_offset;
+    std::uint64_t m_size = 0;
+    std::atomic<std::uint32_t> m_levels{0};
+    std::atomic<std::int64_t> m_min_time{std::numeric_limits<std::int64_t>::max()};
+    std::atomic<std::int64_t> m_max_time{std::numeric_limits<std::int64_t>::min()};
+};
+
+/**
+ * @brief Reader of the sidecar seek index of a log file.
+ *
+ * Finds the byte ranges of the log file which may contain records
+ * of a time window and of a minimum severity, so that only those
+ * have to be read. Parts of the log file not covered by the index,
+ * e.g. written after the last complete block, are always included.
+ *
+ * Usage example:
+ * ```cpp
+ * const Log::SeekIndex index("app.log");
+ * for (const auto& range : index.find(from, to, Log::Level::Error)) {
+ *     // Read range.size bytes of app.log at range.offset
+ * }
+ * ```
+ */
+class SeekIndex final {
+public:
+    /** @brief Time of the records. */
+    using Time = std::chrono::sys_time<std::chrono::nanoseconds>;
+
+    /** @brief Default minimum size of an indexed block. */
+    static constexpr std::size_t DefaultBlockSize = std::size_t{1024} * 1024;
+
+    /**
+     * @brief Range of the log file.
+     */
+    struct Range {
+        std::uint64_t offset; ///< Offset in bytes.
+        std::uint64_t size; ///< Size in bytes.
+
+        auto operator==(const Range&) const -> bool = default;
+    };
+
+    /**
+     * @brief Gets the path of the index of a log file.
+     *
+     * @param log_path Path to the log file.
+     * @return Path to the index file.
+     */
+    [[nodiscard]] static auto path(const std::filesystem::path& log_path) -> std::filesystem::path
+    {
+        auto result = log_path;
+        result += ".idx";
+        return result;
+    }
+
+    /**
+     * @brief Loads the index of a log file.
+     *
+     * @param log_path Path to the log file, the index is read from path().
+     * @throws std::runtime_error if the index cannot be read or is not an index file.
+     */
+    explicit SeekIndex(const std::filesystem::path& log_path)
+        : m_log_size(std::filesystem::file_size(log_path))
+    {
+        const auto index_path = path(log_path);
+        std::ifstream file(index_path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Error opening index file " + index_path.string());
+        }
+        std::vector<char> data{std::istreambuf_iterator<char>(file), {}};
+        if (data.size() < sizeof(detail::seek_index::FileHeader)) {
+            throw std::runtime_error("Not an index file: " + index_path.string());
+        }
+        std::memcpy(&m_header, data.data(), sizeof(m_header));
+        if (m_header.magic != detail::seek_index::Magic
+            || m_header.version != detail::seek_index::Version
+            || m_header.little_endian != (std::endian::native == std::endian::little)) {
+            throw std::runtime_error("Not an index file: " + index_path.string());
+        }
+
+        // A partially written entry is ignored, as are entries beyond a truncated log
+        const auto count = (data.size() - sizeof(m_header)) / sizeof(SeekIndexEntry);
+        m_entries.resize(count);
+        std::memcpy(
+            m_entries.data(), data.data() + sizeof(m_header), count * sizeof(SeekIndexEntry));
+        std::erase_if(m_entries, [this](const SeekIndexEntry& entry) {
+            return entry.offset + entry.size > m_log_size;
+        });
+        std::ranges::sort(m_entries, {}, &SeekIndexEntry::offset);
+    }
+
+    /**
+     * @brief Gets the size of the character type the log file was written with.
+     *
+     * @return Character size in bytes.
+     */
+    [[nodiscard]] auto char_size() const noexcept -> std::size_t
+    {
+        return m_header.char_size;
+    }
+
+    /**
+     * @brief Gets the size of the log file when the index was loaded.
+     *
+     * @return Size in bytes.
+     */
+    [[nodiscard]] auto log_size() const noexcept -> std::uint64_t
+    {
+        return m_log_size;
+    }
+
+    /**
+     * @brief Gets the indexed blocks in the order of their offsets.
+     *
+     * @return Index entries.
+     */
+    [[nodiscard]] auto entries() const noexcept -> std::span<const SeekIndexEntry>
+    {
+        return m_entries;
+    }
+
+    /**
+     * @brief Finds the ranges of the log file which may contain matching records.
+     *
+     * Adjacent ranges are merged. The byte order mark at the beginning
+     * of the log file is never included.
+     *
+     * @param from Earliest record time.
+     * @param to Latest record time.
+     * @param level Least severe level of the records.
+     * @return Ranges ordered by offset.
+     */
+    [[nodiscard]] auto find(Time from, Time to, Level level = Level::Trace) const
+        -> std::vector<Range>
+    {
+        const auto min_time = from.time_since_epoch().count();
+        const auto max_time = to.time_since_epoch().count();
+        const auto levels = (2U << static_cast<unsigned>(level)) - 1;
+
+        std::vector<Range> ranges;
+        const auto add = [&ranges](std::uint64_t offset, std::uint64_t size) {
+            if (size == 0) {
+                return;
+            }
+            if (!ranges.empty() && ranges.back().offset + ranges.back().size == offset) {
+                ranges.back().size += size;
+            } else {
+                ranges.push_back({offset, size});
+            }
+        };
+
+        // Gaps between the blocks were written without the index
+        std::uint64_t covered = m_header.char_size > 1 ? m_header.char_size : 0;
+        for (const auto& entry : m_entries) {
+            if (entry.offset > covered) {
+                add(covered, entry.offset - covered);
+            }
+            if (entry.max_time >= min_time && entry.min_time <= max_time
+                && (entry.levels & levels) != 0) {
+                add(entry.offset, entry.size);
+            }
+            covered = std::max(covered, entry.offset + entry.size);
+        }
+        if (m_log_size > covered) {
+            add(covered, m_log_size - covered);
+        }
+        return ranges;
+    }
+
+private:
+    detail::seek_index::FileHeader m_header{};
+    std::uint64_t m_log_size;
+    std::vector<SeekIndexEntry> m_entries;
+};
+
+} // namespace slimlog
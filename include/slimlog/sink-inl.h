@@ -10,6 +10,8 @@
 // NOLINTNEXTLINE(misc-header-include-cycle)
 #include "slimlog/sink.h" // IWYU pragma: associated
 
+#include <utility>
+
 namespace slimlog {
 
 template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
@@ -17,7 +19,9 @@ auto FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::set_time_fun
     TimeFunctionType time_func) -> void
 {
     const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
-    m_pattern.set_time_func(time_func);
+    Pattern<Char> pattern(*m_pattern);
+    pattern.set_time_func(time_func);
+    m_pattern = Pattern<Char>::intern(std::move(pattern));
 }
 
 template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
@@ -25,7 +29,9 @@ auto FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::set_pattern(
     StringViewType pattern) -> void
 {
     const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
-    m_pattern.set_pattern(pattern);
+    Pattern<Char> compiled(*m_pattern);
+    compiled.set_pattern(pattern);
+    m_pattern = Pattern<Char>::intern(std::move(compiled));
 }
 
 template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
@@ -33,7 +39,27 @@ auto FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::format(
     FormatBufferType& result, const RecordType& record) -> void
 {
     const typename ThreadingPolicy::template SharedLock<decltype(m_mutex)> lock(m_mutex);
-    m_pattern.template format<ThreadingPolicy>(result, record);
+    auto* const cache = record.format_cache;
+    if (cache) {
+        if (const auto message = cache->find(m_pattern->id()); message) {
+            result.append(*message);
+            return;
+        }
+    }
+
+    const auto start = result.size();
+    if (record.deferred) [[unlikely]] {
+        typename DeferredMessage<Char>::BufferType message;
+        m_pattern->template format<ThreadingPolicy>(
+            result, record.deferred->resolve(record, message));
+    } else {
+        m_pattern->template format<ThreadingPolicy>(result, record);
+    }
+
+    if (cache) {
+        cache->insert(
+            m_pattern->id(), StringViewType{result.data() + start, result.size() - start});
+    }
 }
 
 } // namespace slimlog
@@ -9,10 +9,13 @@
 #include "slimlog/format.h"
 #include "slimlog/pattern.h"
 #include "slimlog/threading.h"
+#include "slimlog/util/buffer.h"
 
+#include <array>
 #include <concepts>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <string_view>
 #include <tuple>
 #include <utility>
@@ -68,6 +71,68 @@ public:
     virtual auto flush() -> void = 0;
 };
 
+/**
+ * @brief Messages formatted within one Logger::message() call.
+ *
+ * Sinks sharing an interned pattern (see Pattern::intern()) produce identical output
+ * for a record, so the first FormattableSink stores its result here and the others copy it
+ * instead of formatting the record again. Entries are keyed by Pattern::id().
+ *
+ * @tparam Char Character type for the string.
+ */
+template<typename Char>
+class FormatCache final {
+public:
+    /** @brief Raw string view type. */
+    using StringViewType = std::basic_string_view<Char>;
+
+    /** @brief Maximum number of distinct patterns stored, others are not cached. */
+    static constexpr std::size_t MaxEntries = 8;
+
+    /**
+     * @brief Finds the message formatted with the pattern.
+     *
+     * @param pattern Pattern identifier.
+     * @return Formatted message, or `std::nullopt` if not found.
+     */
+    [[nodiscard]] auto find(std::size_t pattern) const -> std::optional<StringViewType>
+    {
+        for (std::size_t i = 0; i < m_size; ++i) {
+            if (const auto& entry = m_entries[i]; entry.pattern == pattern) {
+                return StringViewType{m_buffer.data() + entry.offset, entry.size};
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Stores the message formatted with the pattern.
+     *
+     * @param pattern Pattern identifier.
+     * @param message Formatted message.
+     */
+    auto insert(std::size_t pattern, StringViewType message) -> void
+    {
+        if (m_size == m_entries.size()) [[unlikely]] {
+            return;
+        }
+        m_entries[m_size++] = {pattern, m_buffer.size(), message.size()};
+        m_buffer.append(message);
+    }
+
+private:
+    /** @brief Location of a formatted message in the buffer. */
+    struct Entry {
+        std::size_t pattern = 0;
+        std::size_t offset = 0;
+        std::size_t size = 0;
+    };
+
+    util::MemoryBuffer<Char, DefaultSinkBufferSize> m_buffer;
+    std::array<Entry, MaxEntries> m_entries{};
+    std::size_t m_size = 0;
+};
+
 /**
  * @brief Abstract formattable sink class.
  *
@@ -120,13 +185,16 @@ public:
     template<typename... Args>
     explicit FormattableSink(Args&&... args)
         // NOLINTNEXTLINE(*-array-to-pointer-decay,*-no-array-decay)
-        : m_pattern(std::forward<Args>(args)...)
+        : m_pattern(Pattern<Char>::intern(Pattern<Char>(std::forward<Args>(args)...)))
     {
     }
 
     /**
-     * @brief Sets the time function used for log timestamps.
-     * @param time_func Time function to be set for this logger.
+     * @brief Overrides the time function used for log timestamps.
+     *
+     * By default, the timestamp captured by the logger is used (see Logger::set_time_func()).
+     *
+     * @param time_func Time function to be set for this sink, or `nullptr` to reset.
      */
     SLIMLOG_EXPORT auto set_time_func(TimeFunctionType time_func) -> void;
 
@@ -166,20 +234,25 @@ public:
     auto set_levels(Pairs&&... pairs) -> void
     {
         const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
-        m_pattern.set_levels(std::forward<Pairs>(pairs)...);
+        Pattern<Char> pattern(*m_pattern);
+        pattern.set_levels(std::forward<Pairs>(pairs)...);
+        m_pattern = Pattern<Char>::intern(std::move(pattern));
     }
 
 protected:
     /**
      * @brief Formats a log record according to the pattern.
      *
+     * If the record carries a FormatCache, the message formatted by another sink
+     * with an equal pattern is reused.
+     *
      * @param result Buffer to store the formatted message.
      * @param record The log record to format.
      */
     auto format(FormatBufferType& result, const RecordType& record) -> void;
 
 private:
-    Pattern<Char> m_pattern;
+    std::shared_ptr<const Pattern<Char>> m_pattern;
     mutable typename ThreadingPolicy::SharedMutex m_mutex;
 };
 
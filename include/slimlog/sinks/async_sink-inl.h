@@ -0,0 +1,219 @@
+/**
+ * @file async_sink-inl.h
+ * @brief Contains definition of AsyncSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/async_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/async_sink.h" // IWYU pragma: associated
+
+#include <utility>
+
+namespace slimlog {
+
+template<typename Char, std::size_t BufferSize, typename Allocator>
+AsyncSink<Char, BufferSize, Allocator>::AsyncSink(
+    std::shared_ptr<Sink<Char>> sink, std::size_t capacity, OverflowPolicy policy)
+    : m_sink(std::move(sink))
+    , m_policy(policy)
+    , m_queue(capacity)
+    , m_thread([this]() { run(); })
+{
+}
+
+template<typename Char, std::size_t BufferSize, typename Allocator>
+AsyncSink<Char, BufferSize, Allocator>::~AsyncSink()
+{
+    m_stop.store(true, std::memory_order_release);
+    wake_backend();
+    m_thread.join();
+}
+
+template<typename Char, std::size_t BufferSize, typename Allocator>
+auto AsyncSink<Char, BufferSize, Allocator>::message(const RecordType& record) -> void
+{
+    bool enqueued = try_enqueue(record);
+    if (!enqueued) [[unlikely]] {
+        switch (m_policy) {
+        case OverflowPolicy::DropNewest:
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        case OverflowPolicy::DropOldest:
+            do {
+                if (m_queue.try_pop([](SlotType& /*slot*/) {})) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    m_processed.fetch_add(1);
+                    notify_progress();
+                } else {
+                    // Nothing to drop: the backend is copying out the slot we need
+                    std::this_thread::yield();
+                }
+            } while (!try_enqueue(record));
+            break;
+        case OverflowPolicy::Block:
+            wake_backend();
+            while (!enqueued) {
+                const auto processed = m_processed.load();
+                enqueued = try_enqueue(record);
+                if (!enqueued) {
+                    wait_for(m_processed, processed);
+                    enqueued = try_enqueue(record);
+                }
+            }
+            break;
+        }
+    }
+    wake_backend();
+}
+
+template<typename Char, std::size_t BufferSize, typename Allocator>
+auto AsyncSink<Char, BufferSize, Allocator>::flush() -> void
+{
+    // Wait until everything enqueued so far is processed or dropped
+    const auto target = static_cast<std::uint64_t>(m_queue.push_count());
+    wake_backend();
+    for (auto processed = m_processed.load(); processed < target;
+         processed = m_processed.load()) {
+        wait_for(m_processed, processed);
+    }
+
+    // Ask the backend thread to flush the wrapped sink
+    const auto request = m_flush_requested.fetch_add(1) + 1;
+    wake_backend();
+    for (auto done = m_flush_done.load(); done < request; done = m_flush_done.load()) {
+        wait_for(m_flush_done, done);
+    }
+
+    std::exception_ptr error;
+    {
+        const std::lock_guard lock(m_mutex);
+        error = std::exchange(m_error, nullptr);
+    }
+    if (error) [[unlikely]] {
+        std::rethrow_exception(error);
+    }
+}
+
+template<typename Char, std::size_t BufferSize, typename Allocator>
+auto AsyncSink<Char, BufferSize, Allocator>::dropped() const noexcept -> std::uint64_t
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+template<typename Char, std::size_t BufferSize, typename Allocator>
+auto AsyncSink<Char, BufferSize, Allocator>::sink() const noexcept
+    -> const std::shared_ptr<Sink<Char>>&
+{
+    return m_sink;
+}
+
+template<typename Char, std::size_t BufferSize, typename Allocator>
+auto AsyncSink<Char, BufferSize, Allocator>::try_enqueue(const RecordType& record) -> bool
+{
+    return m_queue.try_push([&record](SlotType& slot) { slot.assign(record); });
+}
+
+template<typename Char, std::size_t BufferSize, typename Allocator>
+auto AsyncSink<Char, BufferSize, Allocator>::wake_backend() -> void
+{
+    // Pairs with the fence in run(): either the backend sees the new state
+    // before going to sleep, or we see it sleeping and wake it up.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed)) {
+        {
+            const std::lock_guard lock(m_mutex);
+            m_sleeping.store(false, std::memory_order_relaxed);
+        }
+        m_wakeup.notify_one();
+    }
+}
+
+template<typename Char, std::size_t BufferSize, typename Allocator>
+auto AsyncSink<Char, BufferSize, Allocator>::notify_progress() -> void
+{
+    // Waiters counter allows to skip locking when nobody waits
+    if (m_waiters.load() > 0) {
+        { const std::lock_guard lock(m_mutex); }
+        m_progress.notify_all();
+    }
+}
+
+template<typename Char, std::size_t BufferSize, typename Allocator>
+auto AsyncSink<Char, BufferSize, Allocator>::wait_for(
+    const std::atomic<std::uint64_t>& counter, std::uint64_t old) -> void
+{
+    std::unique_lock lock(m_mutex);
+    m_waiters.fetch_add(1);
+    m_progress.wait(lock, [&counter, old]() { return counter.load() != old; });
+    m_waiters.fetch_sub(1);
+}
+
+template<typename Char, std::size_t BufferSize, typename Allocator>
+auto AsyncSink<Char, BufferSize, Allocator>::run() -> void
+{
+    const auto guarded = [this](const auto& func) {
+        try {
+            func();
+        } catch (...) {
+            const std::lock_guard lock(m_mutex);
+            if (!m_error) {
+                m_error = std::current_exception();
+            }
+        }
+    };
+
+    for (;;) {
+        bool processed = false;
+        // Copy the record out to release the slot before calling the sink,
+        // otherwise producers would wait for the sink to reuse the slot.
+        while (m_queue.try_pop([this, &guarded](SlotType& slot) {
+            m_current.reset();
+            if (!slot.empty()) {
+                guarded([this, &slot]() { m_current.assign(slot.record()); });
+            }
+        })) {
+            if (!m_current.empty()) {
+                guarded([this]() { m_sink->message(m_current.record()); });
+            }
+            processed = true;
+            m_processed.fetch_add(1);
+            notify_progress();
+        }
+
+        if (const auto request = m_flush_requested.load(std::memory_order_acquire);
+            request != m_flush_done.load(std::memory_order_relaxed)) {
+            guarded([this]() { m_sink->flush(); });
+            m_flush_done.store(request);
+            notify_progress();
+        }
+
+        if (m_stop.load(std::memory_order_acquire)) {
+            if (m_queue.empty()) {
+                break;
+            }
+            continue;
+        }
+
+        if (processed) {
+            continue;
+        }
+
+        // Nothing to do: go to sleep unless something arrived in the meantime
+        std::unique_lock lock(m_mutex);
+        m_sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_queue.empty() && !m_stop.load(std::memory_order_relaxed)
+            && m_flush_requested.load(std::memory_order_relaxed)
+                == m_flush_done.load(std::memory_order_relaxed)) {
+            m_wakeup.wait(lock, [this]() { return !m_sleeping.load(std::memory_order_relaxed); });
+        }
+        m_sleeping.store(false, std::memory_order_relaxed);
+    }
+
+    guarded([this]() { m_sink->flush(); });
+}
+
+} // namespace slimlog
@@ -0,0 +1,154 @@
+/**
+ * @file async_sink.h
+ * @brief Contains declaration of AsyncSink class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/record.h"
+#include "slimlog/sink.h"
+#include "slimlog/util/queue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace slimlog {
+
+/**
+ * @brief Behavior of AsyncSink when the queue is full.
+ */
+enum class OverflowPolicy : std::uint8_t {
+    Block, ///< Wait until the backend thread frees a slot.
+    DropNewest, ///< Discard the incoming record.
+    DropOldest ///< Discard the oldest queued record to make room for the incoming one.
+};
+
+/**
+ * @brief Asynchronous sink wrapper.
+ *
+ * Copies log records into a preallocated lock-free queue and returns immediately.
+ * A dedicated backend thread drains the queue and passes records to the wrapped sink,
+ * so that slow sinks (e.g. file or network) do not block the logging threads.
+ *
+ * The wrapped sink is only ever called from the backend thread, so it can use
+ * SingleThreadedPolicy even if records are emitted from multiple threads.
+ * Combined with Logger::set_deferred_format(), message formatting is moved
+ * to the backend thread as well.
+ *
+ * Usage example:
+ * ```cpp
+ * auto log = Log::Logger<char, Log::MultiThreadedPolicy>::create();
+ * auto file = std::make_shared<Log::FileSink<char>>("app.log");
+ * log->add_sink(std::make_shared<Log::AsyncSink<char>>(file, 8192, Log::OverflowPolicy::Block));
+ * ```
+ *
+ * @tparam Char Character type for the string.
+ * @tparam BufferSize Size of the pre-allocated buffer of each queue slot.
+ * @tparam Allocator Allocator type for the slot buffers.
+ */
+template<
+    typename Char,
+    std::size_t BufferSize = DefaultBufferSize,
+    typename Allocator = std::allocator<Char>>
+class AsyncSink : public Sink<Char> {
+public:
+    using typename Sink<Char>::RecordType;
+
+    /** @brief Default number of queue slots. */
+    static constexpr std::size_t DefaultCapacity = 8192;
+
+    /**
+     * @brief Constructs a new AsyncSink object and starts the backend thread.
+     *
+     * @param sink Sink to forward the records to.
+     * @param capacity Number of queue slots (rounded up to a power of two).
+     * @param policy Behavior when the queue is full.
+     */
+    SLIMLOG_EXPORT explicit AsyncSink(
+        std::shared_ptr<Sink<Char>> sink,
+        std::size_t capacity = DefaultCapacity,
+        OverflowPolicy policy = OverflowPolicy::Block);
+
+    AsyncSink(const AsyncSink&) = delete;
+    AsyncSink(AsyncSink&&) = delete;
+    auto operator=(const AsyncSink&) -> AsyncSink& = delete;
+    auto operator=(AsyncSink&&) -> AsyncSink& = delete;
+
+    /**
+     * @brief Drains the queue, flushes the wrapped sink and stops the backend thread.
+     */
+    SLIMLOG_EXPORT ~AsyncSink() override;
+
+    /**
+     * @brief Enqueues a copy of the log record.
+     *
+     * @param record The log record to process.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Waits until all previously enqueued records are processed
+     *        and flushes the wrapped sink.
+     *
+     * Rethrows the first exception thrown by the wrapped sink on the backend thread, if any.
+     */
+    SLIMLOG_EXPORT auto flush() -> void override;
+
+    /**
+     * @brief Gets the number of records dropped due to queue overflow.
+     *
+     * @return Number of dropped records.
+     */
+    [[nodiscard]] SLIMLOG_EXPORT auto dropped() const noexcept -> std::uint64_t;
+
+    /**
+     * @brief Gets the wrapped sink.
+     *
+     * @return Shared pointer to the wrapped sink.
+     */
+    [[nodiscard]] SLIMLOG_EXPORT auto sink() const noexcept -> const std::shared_ptr<Sink<Char>>&;
+
+private:
+    using SlotType = RecordStorage<Char, BufferSize, Allocator>;
+
+    /** @brief Tries to enqueue the record, returns \b false if the queue is full. */
+    auto try_enqueue(const RecordType& record) -> bool;
+    /** @brief Wakes up the backend thread if it is sleeping. */
+    auto wake_backend() -> void;
+    /** @brief Wakes up threads waiting for the backend progress. */
+    auto notify_progress() -> void;
+    /** @brief Blocks until the counter differs from the expected value. */
+    auto wait_for(const std::atomic<std::uint64_t>& counter, std::uint64_t old) -> void;
+    /** @brief Backend thread loop. */
+    auto run() -> void;
+
+    std::shared_ptr<Sink<Char>> m_sink;
+    OverflowPolicy m_policy;
+    util::BoundedQueue<SlotType> m_queue;
+    SlotType m_current;
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<std::uint64_t> m_processed{0};
+    std::atomic<std::uint64_t> m_flush_requested{0};
+    std::atomic<std::uint64_t> m_flush_done{0};
+    std::atomic<std::uint32_t> m_waiters{0};
+    std::atomic<bool> m_sleeping{false};
+    std::atomic<bool> m_stop{false};
+    std::exception_ptr m_error;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_progress;
+    std::thread m_thread;
+};
+
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/async_sink-inl.h" // IWYU pragma: keep
+#endif
@@ -0,0 +1,271 @@
+/**
+ * @file binary_file_sink-inl.h
+ * @brief Contains definition of BinaryFileSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/binary_file_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/binary_file_sink.h" // IWYU pragma: associated
+#include "slimlog/util/os.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <system_error>
+
+namespace slimlog {
+
+template<typename Char, typename ThreadingPolicy>
+BinaryFileSink<Char, ThreadingPolicy>::~BinaryFileSink()
+{
+    try {
+        flush();
+    } catch (...) { // NOLINT(bugprone-empty-catch)
+        // Destructor must not throw, buffered records are lost
+    }
+}
+
+template<typename Char, typename ThreadingPolicy>
+auto BinaryFileSink<Char, ThreadingPolicy>::open(
+    std::string_view filename, std::size_t buffer_size) -> void
+{
+    const std::string name(filename);
+    m_fp = util::os::fopen_shared(name.c_str(), "ab");
+    if (!m_fp) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Error opening log file");
+    }
+
+    // Whole buffers are written at once, stdio buffering would only add a copy
+    std::setvbuf(m_fp.get(), nullptr, _IONBF, 0);
+    m_buffer_size = buffer_size;
+    m_buffer.reserve(buffer_size + DefaultBufferSize);
+    const auto* magic = reinterpret_cast<const std::byte*>(detail::binary::Magic.data()); // NOLINT
+    m_buffer.insert(m_buffer.end(), magic, magic + detail::binary::Magic.size()); // NOLINT
+    m_buffer.push_back(static_cast<std::byte>(detail::binary::Version));
+    m_buffer.push_back(static_cast<std::byte>(sizeof(Char)));
+    m_buffer.push_back(static_cast<std::byte>(std::endian::native == std::endian::little));
+    m_buffer.push_back(std::byte{0});
+    write();
+}
+
+template<typename Char, typename ThreadingPolicy>
+auto BinaryFileSink<Char, ThreadingPolicy>::message(const RecordType& record) -> void
+{
+    using detail::binary::put_varint;
+    const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+
+    // The last category is compared without hashing, most records share it
+    const std::basic_string_view<Char> category = record.category;
+    if (m_last_category_id == 0 || category != m_last_category) {
+        m_last_category_id = string_id(m_strings, category, detail::binary::Tag::String);
+        m_last_category = category;
+    }
+    const auto site = site_id(record);
+
+    const auto time = static_cast<std::int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(record.time.first.time_since_epoch())
+            .count()
+        + static_cast<std::int64_t>(record.time.second));
+    m_buffer.push_back(static_cast<std::byte>(detail::binary::Tag::Record));
+    put_varint(m_buffer, detail::binary::zigzag(time - m_last_time));
+    m_buffer.push_back(static_cast<std::byte>(record.level));
+    put_varint(m_buffer, m_last_category_id);
+    put_varint(m_buffer, site);
+    put_varint(m_buffer, record.thread_id);
+    m_last_time = time;
+
+    if (record.deferred) {
+        put_args(*record.deferred);
+    } else {
+        const std::basic_string_view<Char> message = record.message;
+        const auto* data = reinterpret_cast<const std::byte*>(message.data()); // NOLINT(*-cast)
+        put_varint(m_buffer, message.size());
+        m_buffer.insert(m_buffer.end(), data, data + (message.size() * sizeof(Char))); // NOLINT
+    }
+
+    if (m_buffer.size() >= m_buffer_size) {
+        write();
+    }
+}
+
+template<typename Char, typename ThreadingPolicy>
+auto BinaryFileSink<Char, ThreadingPolicy>::flush() -> void
+{
+    const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+    write();
+    if (std::fflush(m_fp.get()) != 0) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed flush to log file");
+    }
+}
+
+template<typename Char, typename ThreadingPolicy>
+template<typename T>
+auto BinaryFileSink<Char, ThreadingPolicy>::string_id(
+    detail::binary::StringMap<T>& map, std::basic_string_view<T> str, detail::binary::Tag tag)
+    -> std::uint64_t
+{
+    if (const auto it = map.find(str); it != map.end()) {
+        return it->second;
+    }
+
+    const auto id = m_next_id++;
+    map.emplace(str, id);
+    const auto* data = reinterpret_cast<const std::byte*>(str.data()); // NOLINT(*-cast)
+    m_buffer.push_back(static_cast<std::byte>(tag));
+    detail::binary::put_varint(m_buffer, id);
+    detail::binary::put_varint(m_buffer, str.size());
+    m_buffer.insert(m_buffer.end(), data, data + (str.size() * sizeof(T))); // NOLINT
+    return id;
+}
+
+template<typename Char, typename ThreadingPolicy>
+auto BinaryFileSink<Char, ThreadingPolicy>::site_id(const RecordType& record) -> std::uint64_t
+{
+    const std::string_view filename = record.filename;
+    const std::string_view function = record.function;
+    std::basic_string_view<Char> format;
+    std::span<const DeferredArgType> types;
+    if (record.deferred) {
+        format = record.deferred->fmt();
+        types = record.deferred->types();
+    }
+
+    // Strings are identified by address, the copies detect an address reused for another string
+    const SiteKey key{filename.data(), function.data(), record.line, format.data(), types.data()};
+    auto& site = m_sites[key];
+    if (site.id != 0 && site.filename == filename && site.function == function
+        && site.format == format) [[likely]] {
+        return site.id;
+    }
+
+    using detail::binary::Tag;
+    const auto filename_id = string_id(m_narrow_strings, filename, Tag::NarrowString);
+    const auto function_id = string_id(m_narrow_strings, function, Tag::NarrowString);
+    const auto format_id = record.deferred ? string_id(m_strings, format, Tag::String) : 0;
+    site = {m_next_id++,
+            std::string(filename),
+            std::string(function),
+            std::basic_string<Char>(format.data(), format.size())};
+
+    m_buffer.push_back(static_cast<std::byte>(Tag::Site));
+    detail::binary::put_varint(m_buffer, site.id);
+    detail::binary::put_varint(m_buffer, filename_id);
+    detail::binary::put_varint(m_buffer, function_id);
+    detail::binary::put_varint(m_buffer, record.line);
+    detail::binary::put_varint(m_buffer, format_id);
+    detail::binary::put_varint(m_buffer, types.size());
+    for (const auto type : types) {
+        m_buffer.push_back(static_cast<std::byte>(type.kind));
+        m_buffer.push_back(static_cast<std::byte>(type.size));
+    }
+    return site.id;
+}
+
+template<typename Char, typename ThreadingPolicy>
+auto BinaryFileSink<Char, ThreadingPolicy>::put_args(const DeferredMessage<Char>& message) -> void
+{
+    using Kind = DeferredArgType::Kind;
+    const auto* data = message.args().data();
+    for (const auto type : message.types()) {
+        // NOLINTBEGIN(*-pointer-arithmetic)
+        const auto slots = (type.size + sizeof(Char) - 1) / sizeof(Char);
+        // Numbers are stored bytewise in the characters
+        const auto unsigned_value = [&]() -> std::uint64_t {
+            switch (type.size) {
+            case 1: {
+                std::uint8_t value = 0;
+                std::memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            case 2: {
+                std::uint16_t value = 0;
+                std::memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            case 4: {
+                std::uint32_t value = 0;
+                std::memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            default: {
+                std::uint64_t value = 0;
+                std::memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            }
+        };
+        switch (type.kind) {
+        case Kind::Bool:
+            m_buffer.push_back(static_cast<std::byte>(unsigned_value() != 0));
+            break;
+        case Kind::Char:
+        case Kind::UInt:
+        case Kind::Pointer:
+            detail::binary::put_varint(m_buffer, unsigned_value());
+            break;
+        case Kind::Int: {
+            // Sign extension from the stored width
+            const auto shift = 64 - (type.size * 8U);
+            const auto value = static_cast<std::int64_t>(unsigned_value() << shift) >> shift;
+            detail::binary::put_varint(m_buffer, detail::binary::zigzag(value));
+            break;
+        }
+        case Kind::Float: {
+            std::array<std::byte, sizeof(double)> bytes{};
+            if (type.size == sizeof(float)) {
+                std::memcpy(bytes.data(), data, sizeof(float));
+                m_buffer.insert(m_buffer.end(), bytes.begin(), bytes.begin() + sizeof(float));
+                break;
+            }
+            if (type.size == sizeof(double)) {
+                std::memcpy(bytes.data(), data, sizeof(double));
+            } else {
+                long double value = 0;
+                std::memcpy(&value, data, sizeof(value));
+                const auto narrowed = static_cast<double>(value);
+                std::memcpy(bytes.data(), &narrowed, sizeof(narrowed));
+            }
+            m_buffer.insert(m_buffer.end(), bytes.begin(), bytes.end());
+            break;
+        }
+        case Kind::Null:
+            break;
+        case Kind::String: {
+            std::size_t size = 0;
+            std::memcpy(&size, data, sizeof(size));
+            data += slots;
+            const auto* str = reinterpret_cast<const std::byte*>(data); // NOLINT(*-cast)
+            detail::binary::put_varint(m_buffer, size);
+            m_buffer.insert(m_buffer.end(), str, str + (size * sizeof(Char)));
+            data += size;
+            continue;
+        }
+        }
+        data += slots;
+        // NOLINTEND(*-pointer-arithmetic)
+    }
+}
+
+template<typename Char, typename ThreadingPolicy>
+auto BinaryFileSink<Char, ThreadingPolicy>::write() -> void
+{
+    if (m_buffer.empty()) {
+        return;
+    }
+    if (std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_fp.get()) != m_buffer.size())
+        [[unlikely]] {
+        m_buffer.clear();
+        throw std::system_error({errno, std::system_category()}, "Failed writing to log file");
+    }
+    m_syscalls.fetch_add(1, std::memory_order_relaxed);
+    m_bytes.fetch_add(m_buffer.size(), std::memory_order_relaxed);
+    m_buffer.clear();
+}
+
+} // namespace slimlog
@@ -0,0 +1,741 @@
+/**
+ * @file binary_file_sink.h
+ * @brief Contains declaration of BinaryFileSink and BinaryLogReader classes.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/format.h"
+#include "slimlog/sink.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace slimlog {
+
+namespace detail {
+
+/** @brief Layout of the binary log file. */
+namespace binary {
+
+/** @brief Signature at the start of each segment. */
+inline constexpr std::array<char, 8> Magic = {'S', 'L', 'I', 'M', 'B', 'L', 'O', 'G'};
+/** @brief Format version. */
+inline constexpr std::uint8_t Version = 1;
+/** @brief Segment header size: signature, version, character size, byte order, reserved. */
+inline constexpr std::size_t HeaderSize = Magic.size() + 4;
+
+/**
+ * @brief Entry type, the first byte of each entry.
+ *
+ * Dictionary entries (strings and call sites) precede the first record using them.
+ * Identifiers are numbered from one within a segment.
+ */
+enum class Tag : std::uint8_t {
+    Record = 1, ///< Time delta, level, category ID, call site ID, thread ID, then the payload.
+    String = 2, ///< ID, length and code units of a category or a format string.
+    NarrowString = 3, ///< ID, length and bytes of a file or function name.
+    Site = 4, ///< ID, file, function, line, format string ID and argument types.
+};
+
+/**
+ * @brief Appends an unsigned LEB128 variable-length integer.
+ *
+ * @param out Output buffer.
+ * @param value Value to append.
+ */
+inline auto put_varint(std::vector<std::byte>& out, std::uint64_t value) -> void
+{
+    std::array<std::byte, 10> bytes{}; // NOLINT(*-magic-numbers)
+    std::size_t size = 0;
+    while (value >= 0x80) { // NOLINT(*-magic-numbers)
+        bytes[size++] = static_cast<std::byte>((value & 0x7FU) | 0x80U); // NOLINT(*-magic-numbers)
+        value >>= 7U;
+    }
+    bytes[size++] = static_cast<std::byte>(value);
+    out.insert(out.end(), bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(size));
+}
+
+/**
+ * @brief Maps signed integers to unsigned ones, so that small magnitudes stay short.
+ *
+ * @param value Signed value.
+ * @return Zigzag-encoded value.
+ */
+constexpr auto zigzag(std::int64_t value) noexcept -> std::uint64_t
+{
+    return (static_cast<std::uint64_t>(value) << 1U) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+/**
+ * @brief Reverses zigzag().
+ *
+ * @param value Zigzag-encoded value.
+ * @return Signed value.
+ */
+constexpr auto unzigzag(std::uint64_t value) noexcept -> std::int64_t
+{
+    return static_cast<std::int64_t>(value >> 1U) ^ -static_cast<std::int64_t>(value & 1U);
+}
+
+/** @brief Hash for heterogeneous lookup of strings by views. */
+template<typename Char>
+struct StringHash {
+    using is_transparent = void; ///< Enables lookup by string views.
+
+    auto operator()(std::basic_string_view<Char> str) const noexcept -> std::size_t
+    {
+        return std::hash<std::basic_string_view<Char>>{}(str);
+    }
+};
+
+/** @brief Map of strings to their dictionary IDs. */
+template<typename Char>
+using StringMap
+    = std::unordered_map<std::basic_string<Char>, std::uint64_t, StringHash<Char>, std::equal_to<>>;
+
+} // namespace binary
+} // namespace detail
+
+/**
+ * @brief Sink writing records in a compact binary format.
+ *
+ * Instead of text, each record stores the time as a variable-length delta
+ * from the previous record, the level, the category and call site IDs,
+ * the thread ID, and either the message or the typed format arguments.
+ * Category names, file and function names and format strings are written
+ * once per file into dictionary entries placed before their first use, so the
+ * file can be read even if the process did not finish it.
+ *
+ * Format arguments are stored only if the logger uses deferred formatting
+ * (see Logger::set_deferred_format()), in which case messages are never formatted
+ * by the application. Other messages are stored as text.
+ *
+ * Records are collected in a buffer and written when it is full or on flush().
+ * Each opening of the file appends a new segment with its own dictionary.
+ * Read the file with BinaryLogReader or the `slimlog_decode` tool.
+ *
+ * The sink is not derived from FileSink and has no DurabilityPolicy,
+ * written data reaches the disk when the system writes it back.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for sink operations.
+ */
+template<typename Char, typename ThreadingPolicy = DefaultThreadingPolicy>
+class BinaryFileSink : public Sink<Char> {
+public:
+    using typename Sink<Char>::RecordType;
+
+    /** @brief Default size of the buffer in bytes. */
+    static constexpr std::size_t DefaultBufferSize = std::size_t{64} * 1024;
+
+    /**
+     * @brief Write statistics.
+     */
+    struct Stats {
+        std::uint64_t syscalls = 0; ///< Number of write calls.
+        std::uint64_t bytes = 0; ///< Number of bytes written.
+    };
+
+    /**
+     * @brief Constructs a new BinaryFileSink object.
+     *
+     * @param filename Path to the log file.
+     * @param buffer_size Number of bytes collected before writing them.
+     */
+    explicit BinaryFileSink(std::string_view filename, std::size_t buffer_size = DefaultBufferSize)
+    {
+        open(filename, buffer_size);
+    }
+
+    /**
+     * @brief Writes the buffered records.
+     */
+    SLIMLOG_EXPORT ~BinaryFileSink() override;
+
+    BinaryFileSink(const BinaryFileSink&) = delete;
+    BinaryFileSink(BinaryFileSink&&) = delete;
+    auto operator=(const BinaryFileSink&) -> BinaryFileSink& = delete;
+    auto operator=(BinaryFileSink&&) -> BinaryFileSink& = delete;
+
+    /**
+     * @brief Encodes the log record into the buffer.
+     *
+     * @param record The log record to process.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Writes the buffered records to the file.
+     */
+    SLIMLOG_EXPORT auto flush() -> void override;
+
+    /**
+     * @brief Gets the write statistics.
+     *
+     * @return Number of write calls and bytes written.
+     */
+    [[nodiscard]] auto stats() const noexcept -> Stats
+    {
+        return {
+            m_syscalls.load(std::memory_order_relaxed), m_bytes.load(std::memory_order_relaxed)};
+    }
+
+private:
+    /** @brief Call site identity: pointers to static strings and the line. */
+    struct SiteKey {
+        const char* filename;
+        const char* function;
+        std::size_t line;
+        const Char* format;
+        const DeferredArgType* types;
+
+        auto operator==(const SiteKey&) const -> bool = default;
+    };
+
+    /** @brief Hash of the call site identity. */
+    struct SiteHash {
+        auto operator()(const SiteKey& key) const noexcept -> std::size_t
+        {
+            auto hash = std::hash<const void*>{}(key.filename);
+            for (const auto value :
+                 {std::hash<const void*>{}(key.function),
+                  std::hash<std::size_t>{}(key.line),
+                  std::hash<const void*>{}(key.format),
+                  std::hash<const void*>{}(key.types)}) {
+                hash ^= value + 0x9E3779B9 + (hash << 6U) + (hash >> 2U); // NOLINT(*-magic-numbers)
+            }
+            return hash;
+        }
+    };
+
+    /** @brief Call site with copies of its strings, to detect reused addresses. */
+    struct Site {
+        std::uint64_t id = 0;
+        std::string filename;
+        std::string function;
+        std::basic_string<Char> format;
+    };
+
+    /** @brief Opens the file and writes the segment header. */
+    SLIMLOG_EXPORT auto open(std::string_view filename, std::size_t buffer_size) -> void;
+    /** @brief Gets the ID of a string, adding a dictionary entry if needed. */
+    template<typename T>
+    auto string_id(
+        detail::binary::StringMap<T>& map, std::basic_string_view<T> str, detail::binary::Tag tag)
+        -> std::uint64_t;
+    /** @brief Gets the ID of the record call site, adding a dictionary entry if needed. */
+    auto site_id(const RecordType& record) -> std::uint64_t;
+    /** @brief Re-encodes the serialized format arguments. */
+    auto put_args(const DeferredMessage<Char>& message) -> void;
+    /** @brief Writes the buffer to the file. */
+    auto write() -> void;
+
+    std::unique_ptr<FILE, int (*)(FILE*)> m_fp = {nullptr, nullptr};
+    std::vector<std::byte> m_buffer;
+    std::size_t m_buffer_size = 0;
+    std::uint64_t m_next_id = 1;
+    detail::binary::StringMap<Char> m_strings;
+    detail::binary::StringMap<char> m_narrow_strings;
+    std::unordered_map<SiteKey, Site, SiteHash> m_sites;
+    std::basic_string<Char> m_last_category;
+    std::uint64_t m_last_category_id = 0;
+    std::int64_t m_last_time = 0;
+    typename ThreadingPolicy::Mutex m_mutex;
+    std::atomic<std::uint64_t> m_syscalls{0};
+    std::atomic<std::uint64_t> m_bytes{0};
+};
+
+/**
+ * @brief Reader of BinaryFileSink files.
+ *
+ * Formats the messages from the stored format strings and arguments,
+ * honoring the format specifications, and passes complete records to a callback,
+ * e.g. to format them with a Pattern.
+ *
+ * Usage example:
+ * ```cpp
+ * Log::BinaryLogReader reader("app.blog");
+ * Log::Pattern<char> pattern("{time} [{level}] {category}: {message}");
+ * reader.read<char>([&](const Log::Record<char>& record) {
+ *     Log::FormatBuffer<char, 1024> buffer;
+ *     pattern.format(buffer, record);
+ *     std::cout << std::string_view(buffer.data(), buffer.size()) << '\n';
+ * });
+ * ```
+ */
+class BinaryLogReader final {
+public:
+    /**
+     * @brief Loads the log file.
+     *
+     * @param path Path to the log file.
+     * @throws std::runtime_error if the file cannot be read or is not a binary log file.
+     */
+    explicit BinaryLogReader(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Error opening log file " + path.string());
+        }
+        file.seekg(0, std::ios::end);
+        m_data.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(
+            reinterpret_cast<char*>(m_data.data()), // NOLINT(*-reinterpret-cast)
+            static_cast<std::streamsize>(m_data.size()));
+        if (!file) {
+            throw std::runtime_error("Error reading log file " + path.string());
+        }
+        Cursor cursor{m_data};
+        const auto char_size = read_header(cursor);
+        if (!char_size) {
+            throw std::runtime_error("Not a binary log file: " + path.string());
+        }
+        m_char_size = *char_size;
+    }
+
+    /**
+     * @brief Gets the size of the character type the file was written with.
+     *
+     * @return Character size in bytes.
+     */
+    [[nodiscard]] auto char_size() const noexcept -> std::size_t
+    {
+        return m_char_size;
+    }
+
+    /**
+     * @brief Reads the records in the order they were written.
+     *
+     * Reading stops at the first incomplete entry, e.g. if the writer crashed.
+     *
+     * @tparam Char Character type of the file.
+     * @tparam Func Callback type, invocable with `const Record<Char>&`.
+     * @param callback Callback invoked for each record.
+     * @return Number of records read.
+     * @throws std::invalid_argument if the file was written with another character size.
+     */
+    template<typename Char, typename Func>
+    auto read(Func&& callback) const -> std::size_t
+    {
+        using Kind = DeferredArgType::Kind;
+        if (sizeof(Char) != m_char_size) {
+            throw std::invalid_argument("Log was written with another character type");
+        }
+
+        Cursor cursor{m_data};
+        Dictionary<Char> dictionary;
+        std::vector<Arg<Char>> args;
+        std::basic_string<Char> text;
+        std::int64_t time = 0;
+        std::size_t count = 0;
+        while (!cursor.data.empty()) {
+            if (cursor.data.front() == static_cast<std::byte>(detail::binary::Magic[0])) {
+                // Next segment starts over with its own dictionary and time base
+                if (read_header(cursor) != m_char_size) {
+                    break;
+                }
+                dictionary = {};
+                time = 0;
+                continue;
+            }
+
+            const auto tag = static_cast<detail::binary::Tag>(cursor.byte().value_or(0));
+            if (tag == detail::binary::Tag::String) {
+                const auto id = cursor.varint();
+                auto str = cursor.template string<Char>();
+                if (!id || !str) {
+                    break;
+                }
+                dictionary.strings[*id] = std::move(*str);
+            } else if (tag == detail::binary::Tag::NarrowString) {
+                const auto id = cursor.varint();
+                auto str = cursor.template string<char>();
+                if (!id || !str) {
+                    break;
+                }
+                dictionary.narrow_strings[*id] = std::move(*str);
+            } else if (tag == detail::binary::Tag::Site) {
+                const auto id = cursor.varint();
+                const auto filename = cursor.varint();
+                const auto function = cursor.varint();
+                const auto line = cursor.varint();
+                const auto format = cursor.varint();
+                const auto num_args = cursor.varint();
+                if (!id || !filename || !function || !line || !format || !num_args) {
+                    break;
+                }
+                SiteEntry site{*filename, *function, *line, *format, {}};
+                for (std::uint64_t i = 0; i < *num_args && !cursor.data.empty(); ++i) {
+                    const auto kind = cursor.byte();
+                    const auto size = cursor.byte();
+                    if (!kind || !size) {
+                        break;
+                    }
+                    site.types.push_back({static_cast<Kind>(*kind), *size});
+                }
+                if (site.types.size() != *num_args) {
+                    break;
+                }
+                dictionary.sites[*id] = std::move(site);
+            } else if (tag == detail::binary::Tag::Record) {
+                const auto delta = cursor.varint();
+                const auto level = cursor.byte();
+                const auto category = cursor.varint();
+                const auto site_id = cursor.varint();
+                const auto thread_id = cursor.varint();
+                if (!delta || !level || !category || !site_id || !thread_id) {
+                    break;
+                }
+                const auto site = dictionary.sites.find(*site_id);
+                if (site == dictionary.sites.end()) {
+                    break;
+                }
+                if (site->second.format == 0) {
+                    auto message = cursor.template string<Char>();
+                    if (!message) {
+                        break;
+                    }
+                    text = std::move(*message);
+                } else if (!read_args(cursor, site->second.types, args)) {
+                    break;
+                } else {
+                    text = render<Char>(dictionary.strings[site->second.format], args);
+                }
+
+                time += detail::binary::unzigzag(*delta);
+                const auto nsec = std::chrono::nanoseconds{time};
+                const auto seconds = std::chrono::floor<std::chrono::seconds>(nsec);
+                const std::basic_string_view<Char> category_name = dictionary.strings[*category];
+                const std::string_view filename = dictionary.narrow_strings[site->second.filename];
+                const std::string_view function = dictionary.narrow_strings[site->second.function];
+                const Record<Char> record{
+                    CachedStringView<Char>{std::basic_string_view<Char>{text}},
+                    CachedStringView<Char>{category_name},
+                    CachedStringView<char>{filename},
+                    CachedStringView<char>{function},
+                    static_cast<std::size_t>(site->second.line),
+                    static_cast<Level>(*level),
+                    {std::chrono::sys_seconds{seconds},
+                     static_cast<std::size_t>((nsec - seconds).count())},
+                    static_cast<std::size_t>(*thread_id)};
+                callback(record);
+                ++count;
+            } else {
+                break;
+            }
+        }
+        return count;
+    }
+
+private:
+    /** @brief Reader of the file contents, empty optionals mean the data ended. */
+    struct Cursor {
+        std::span<const std::byte> data;
+
+        auto byte() -> std::optional<std::uint8_t>
+        {
+            if (data.empty()) {
+                return std::nullopt;
+            }
+            const auto value = static_cast<std::uint8_t>(data.front());
+            data = data.subspan(1);
+            return value;
+        }
+
+        auto varint() -> std::optional<std::uint64_t>
+        {
+            std::uint64_t value = 0;
+            // NOLINTBEGIN(*-magic-numbers)
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                const auto next = byte();
+                if (!next) {
+                    return std::nullopt;
+                }
+                value |= static_cast<std::uint64_t>(*next & 0x7FU) << shift;
+                if ((*next & 0x80U) == 0) {
+                    return value;
+                }
+            }
+            // NOLINTEND(*-magic-numbers)
+            return std::nullopt;
+        }
+
+        auto bytes(std::size_t size) -> std::optional<std::span<const std::byte>>
+        {
+            if (size > data.size()) {
+                return std::nullopt;
+            }
+            const auto value = data.first(size);
+            data = data.subspan(size);
+            return value;
+        }
+
+        template<typename T>
+        auto string() -> std::optional<std::basic_string<T>>
+        {
+            const auto size = varint();
+            if (!size || *size > data.size() / sizeof(T)) {
+                return std::nullopt;
+            }
+            std::basic_string<T> value(static_cast<std::size_t>(*size), T{});
+            std::memcpy(value.data(), data.data(), value.size() * sizeof(T));
+            data = data.subspan(value.size() * sizeof(T));
+            return value;
+        }
+    };
+
+    /** @brief Call site dictionary entry. */
+    struct SiteEntry {
+        std::uint64_t filename;
+        std::uint64_t function;
+        std::uint64_t line;
+        std::uint64_t format;
+        std::vector<DeferredArgType> types;
+    };
+
+    /** @brief Dictionary of a segment. */
+    template<typename Char>
+    struct Dictionary {
+        std::unordered_map<std::uint64_t, std::basic_string<Char>> strings;
+        std::unordered_map<std::uint64_t, std::string> narrow_strings;
+        std::unordered_map<std::uint64_t, SiteEntry> sites;
+    };
+
+    /** @brief Decoded format argument. */
+    template<typename Char>
+    struct Arg {
+        DeferredArgType type;
+        std::uint64_t value = 0; ///< Bits of integers, characters, pointers and floats.
+        std::basic_string<Char> str;
+    };
+
+    /** @brief Reads and checks the segment header, returns the character size. */
+    static auto read_header(Cursor& cursor) -> std::optional<std::size_t>
+    {
+        const auto header = cursor.bytes(detail::binary::HeaderSize);
+        const auto magic = std::as_bytes(std::span{detail::binary::Magic});
+        if (!header || !std::equal(magic.begin(), magic.end(), header->begin())
+            || static_cast<std::uint8_t>((*header)[8]) != detail::binary::Version
+            || static_cast<bool>((*header)[10]) != (std::endian::native == std::endian::little)) {
+            return std::nullopt;
+        }
+        return static_cast<std::size_t>((*header)[9]);
+    }
+
+    /** @brief Reads the arguments of a record. */
+    template<typename Char>
+    static auto read_args(
+        Cursor& cursor, const std::vector<DeferredArgType>& types, std::vector<Arg<Char>>& args)
+        -> bool
+    {
+        using Kind = DeferredArgType::Kind;
+        args.resize(types.size());
+        for (std::size_t i = 0; i < types.size(); ++i) {
+            auto& arg = args[i];
+            arg.type = types[i];
+            if (arg.type.kind == Kind::String) {
+                auto str = cursor.template string<Char>();
+                if (!str) {
+                    return false;
+                }
+                arg.str = std::move(*str);
+            } else if (arg.type.kind == Kind::Bool) {
+                const auto value = cursor.byte();
+                if (!value) {
+                    return false;
+                }
+                arg.value = *value;
+            } else if (arg.type.kind == Kind::Float) {
+                const auto bytes = cursor.bytes(arg.type.size == sizeof(float) ? 4 : 8);
+                if (!bytes) {
+                    return false;
+                }
+                if (bytes->size() == sizeof(float)) {
+                    std::uint32_t value = 0;
+                    std::memcpy(&value, bytes->data(), sizeof(value));
+                    arg.value = value;
+                } else {
+                    std::memcpy(&arg.value, bytes->data(), sizeof(arg.value));
+                }
+            } else if (arg.type.kind != Kind::Null) {
+                const auto value = cursor.varint();
+                if (!value) {
+                    return false;
+                }
+                arg.value = *value;
+            }
+        }
+        return true;
+    }
+
+    /** @brief Formats a single argument with the replacement field. */
+    template<typename Char, typename Buffer>
+    static auto
+    format_arg(Buffer& out, std::basic_string_view<Char> field, const Arg<Char>& arg) -> void
+    {
+        using Kind = DeferredArgType::Kind;
+        const auto format = [&out, field](auto value) {
+            out.vformat(field, Buffer::make_format_args(value));
+        };
+        switch (arg.type.kind) {
+        case Kind::Bool:
+            format(arg.value != 0);
+            break;
+        case Kind::Char:
+            format(static_cast<Char>(arg.value));
+            break;
+        case Kind::Int:
+            format(detail::binary::unzigzag(arg.value));
+            break;
+        case Kind::UInt:
+            format(arg.value);
+            break;
+        case Kind::Float:
+            if (arg.type.size == 4) {
+                format(std::bit_cast<float>(static_cast<std::uint32_t>(arg.value)));
+            } else {
+                format(std::bit_cast<double>(arg.value));
+            }
+            break;
+        case Kind::Pointer:
+            format(reinterpret_cast<const void*>(arg.value)); // NOLINT(*-reinterpret-cast)
+            break;
+        case Kind::Null:
+            format(nullptr);
+            break;
+        case Kind::String:
+            format(std::basic_string_view<Char>{arg.str});
+            break;
+        }
+    }
+
+    /**
+     * @brief Formats the message from the format string and arguments.
+     *
+     * Each replacement field is formatted separately with its own argument,
+     * so that any format specification applies. Nested fields (dynamic width
+     * or precision) are replaced with the values of their arguments.
+     */
+    template<typename Char>
+    static auto render(std::basic_string_view<Char> fmt, const std::vector<Arg<Char>>& args)
+        -> std::basic_string<Char>
+    {
+        using String = std::basic_string<Char>;
+        FormatBuffer<Char, DefaultBufferSize> out;
+        std::size_t next_arg = 0;
+        // Gets the argument for an explicit or automatic index
+        const auto get_arg
+            = [&args, &next_arg](std::basic_string_view<Char> id) -> const Arg<Char>* {
+            std::size_t index = 0;
+            if (id.empty()) {
+                index = next_arg++;
+            } else {
+                for (const auto chr : id) {
+                    if (chr < Char{'0'} || chr > Char{'9'}) {
+                        return nullptr;
+                    }
+                    index = (index * 10) + static_cast<std::size_t>(chr - Char{'0'}); // NOLINT
+                }
+            }
+            return index < args.size() ? &args[index] : nullptr;
+        };
+
+        for (std::size_t pos = 0; pos < fmt.size(); ++pos) {
+            const auto chr = fmt[pos];
+            if (chr == Char{'}'}) {
+                pos += pos + 1 < fmt.size() && fmt[pos + 1] == Char{'}'} ? 1 : 0;
+                out.push_back(chr);
+                continue;
+            }
+            if (chr != Char{'{'}) {
+                out.push_back(chr);
+                continue;
+            }
+            if (pos + 1 < fmt.size() && fmt[pos + 1] == Char{'{'}) {
+                out.push_back(chr);
+                ++pos;
+                continue;
+            }
+
+            // Find the end of the field, skipping nested fields
+            auto end = pos + 1;
+            for (int depth = 1; end < fmt.size(); ++end) {
+                depth += fmt[end] == Char{'{'} ? 1 : fmt[end] == Char{'}'} ? -1 : 0;
+                if (depth == 0) {
+                    break;
+                }
+            }
+            const auto field = fmt.substr(pos + 1, end - pos - 1);
+            const auto raw = fmt.substr(pos, end - pos + 1);
+            pos = end;
+
+            const auto colon = field.find(Char{':'});
+            const auto* arg = get_arg(field.substr(0, colon));
+            String spec{Char{'{'}};
+            for (std::size_t i = colon; i < field.size(); ++i) {
+                if (field[i] != Char{'{'}) {
+                    spec.push_back(field[i]);
+                    continue;
+                }
+                const auto close = field.find(Char{'}'}, i);
+                const auto* nested = get_arg(field.substr(i + 1, close - i - 1));
+                if (nested == nullptr || close == std::basic_string_view<Char>::npos) {
+                    arg = nullptr;
+                    break;
+                }
+                const auto value = nested->type.kind == DeferredArgType::Kind::Int
+                    ? std::to_string(detail::binary::unzigzag(nested->value))
+                    : std::to_string(nested->value);
+                for (const auto digit : value) {
+                    spec.push_back(static_cast<Char>(digit));
+                }
+                i = close;
+            }
+            spec.push_back(Char{'}'});
+
+            const auto size = out.size();
+            try {
+                if (arg == nullptr) {
+                    throw std::out_of_range("No argument");
+                }
+                format_arg<Char>(out, spec, *arg);
+            } catch (const std::exception&) {
+                // Invalid fields are kept as is
+                out.resize(size);
+                out.append(raw);
+            }
+        }
+        return {out.data(), out.size()};
+    }
+
+    std::vector<std::byte> m_data;
+    std::size_t m_char_size = 0;
+};
+
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/binary_file_sink-inl.h" // IWYU pragma: keep
+#endif
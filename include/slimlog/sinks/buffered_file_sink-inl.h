@@ -0,0 +1,231 @@
+/**
+ * @file buffered_file_sink-inl.h
+ * @brief Contains definition of BufferedFileSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/buffered_file_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/buffered_file_sink.h" // IWYU pragma: associated
+#include "slimlog/threading.h"
+#include "slimlog/util/os.h"
+
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+namespace slimlog {
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+BufferedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::~BufferedFileSink()
+{
+    try {
+        flush();
+        if (m_index) {
+            m_index->finish();
+        }
+    } catch (...) { // NOLINT(bugprone-empty-catch)
+        // Destructor must not throw, buffered lines are lost
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto BufferedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::init() -> void
+{
+    // BOM is written by FileSink to the stdio buffer, it must precede our writes
+    if (std::fflush(this->file()) != 0) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed flush to log file");
+    }
+    m_fd = util::os::file_descriptor(this->file());
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto BufferedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::message(
+    const RecordType& record) -> void
+{
+    FormatBufferType buffer;
+    this->format(buffer, record);
+    buffer.push_back(static_cast<Char>('\n'));
+
+    const std::int64_t now = std::chrono::nanoseconds(record.time.first.time_since_epoch()).count()
+        + static_cast<std::int64_t>(record.time.second);
+    const bool started = append(buffer.data(), buffer.size() * sizeof(Char), now, record.level);
+    this->apply_durability(record);
+    if (m_interval <= 0) {
+        return;
+    }
+
+    if (started) {
+        // First line in the buffer starts the interval
+        m_deadline.store(now + m_interval, std::memory_order_relaxed);
+    } else if (auto deadline = m_deadline.load(std::memory_order_relaxed);
+               deadline != 0 && now >= deadline
+               && m_deadline.compare_exchange_strong(
+                   deadline, 0, std::memory_order_relaxed, std::memory_order_relaxed)) {
+        flush();
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto BufferedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::flush() -> void
+{
+    if constexpr (std::is_same_v<ThreadingPolicy, SingleThreadedPolicy>) {
+        drain(m_reserved.load(std::memory_order_relaxed), nullptr, 0);
+    } else {
+        // Reserve more than the capacity to become the drainer. If another writer
+        // is already draining the buffer, wait for it and try again: the generation
+        // read before the reservation may already be stale, so waking up does not
+        // prove that the buffer with our reservation has been written.
+        for (;;) {
+            const auto generation = m_generation.load(std::memory_order_acquire);
+            const auto offset = m_reserved.fetch_add(m_capacity + 1, std::memory_order_acq_rel);
+            if (offset <= m_capacity) {
+                drain(offset, nullptr, 0);
+                return;
+            }
+            m_generation.wait(generation, std::memory_order_acquire);
+        }
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto BufferedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::enable_index(
+    std::size_t block_size) -> void
+{
+    // Writers read the index pointer without synchronization,
+    // and offsets in the index start at the current end of the file
+    if (m_reserved.load(std::memory_order_acquire) != 0
+        || m_bytes.load(std::memory_order_relaxed) != 0) [[unlikely]] {
+        throw std::logic_error("Seek index must be enabled before logging");
+    }
+    m_index = std::make_unique<SeekIndexWriter<ThreadingPolicy>>(
+        SeekIndex::path(m_filename),
+        sizeof(Char),
+        std::filesystem::file_size(m_filename),
+        block_size);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto BufferedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::append(
+    const void* data, std::size_t size, std::int64_t time, Level level) -> bool
+{
+    // The record is accounted to the index before the buffer with it can be drained
+    if constexpr (std::is_same_v<ThreadingPolicy, SingleThreadedPolicy>) {
+        const auto offset = m_reserved.load(std::memory_order_relaxed);
+        if (m_index) {
+            m_index->add(time, level);
+        }
+        if (offset + size <= m_capacity) {
+            std::memcpy(m_buffer.data() + offset, data, size);
+            m_reserved.store(offset + size, std::memory_order_relaxed);
+            return offset == 0;
+        }
+        drain(offset, data, size);
+        return false;
+    } else {
+        for (;;) {
+            const auto generation = m_generation.load(std::memory_order_acquire);
+            const auto offset = m_reserved.fetch_add(size, std::memory_order_acq_rel);
+            if (offset + size <= m_capacity) {
+                std::memcpy(m_buffer.data() + offset, data, size);
+                if (m_index) {
+                    m_index->add(time, level);
+                }
+                m_committed.fetch_add(size, std::memory_order_release);
+                return offset == 0;
+            }
+            if (offset <= m_capacity) {
+                // The first writer which does not fit writes the buffer
+                if (m_index) {
+                    m_index->add(time, level);
+                }
+                drain(offset, data, size);
+                return false;
+            }
+            // Another writer is draining the buffer
+            m_generation.wait(generation, std::memory_order_acquire);
+        }
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto BufferedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::drain(
+    std::size_t size, const void* data, std::size_t data_size) -> void
+{
+    if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+        // All reservations before ours fit into the buffer, wait for their copies
+        while (m_committed.load(std::memory_order_acquire) != size) {
+            std::this_thread::yield();
+        }
+    }
+
+    try {
+        write(m_buffer.data(), size, data, data_size);
+        if (m_index) {
+            m_index->commit(size + data_size);
+        }
+    } catch (...) {
+        // Discard the buffer, otherwise other writers would wait forever
+        release();
+        throw;
+    }
+    release();
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto BufferedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::write(
+    const void* head, std::size_t head_size, const void* tail, std::size_t tail_size) -> void
+{
+    std::array<util::os::WriteBuffer, 2> buffers{{{head, head_size}, {tail, tail_size}}};
+    std::span<util::os::WriteBuffer> pending(buffers);
+
+    const auto advance = [&pending](std::size_t written) {
+        while (!pending.empty() && written >= pending.front().size) {
+            written -= pending.front().size;
+            pending = pending.subspan(1);
+        }
+        if (!pending.empty()) {
+            pending.front().data = static_cast<const std::byte*>(pending.front().data) + written;
+            pending.front().size -= written;
+        }
+    };
+
+    advance(0);
+    while (!pending.empty()) {
+        const auto written = util::os::write_vector(m_fd, pending);
+        if (written < 0) [[unlikely]] {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error({errno, std::system_category()}, "Failed writing to log file");
+        }
+        m_syscalls.fetch_add(1, std::memory_order_relaxed);
+        m_bytes.fetch_add(static_cast<std::uint64_t>(written), std::memory_order_relaxed);
+        advance(static_cast<std::size_t>(written));
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto BufferedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::release() noexcept -> void
+{
+    if constexpr (std::is_same_v<ThreadingPolicy, SingleThreadedPolicy>) {
+        m_reserved.store(0, std::memory_order_relaxed);
+    } else {
+        // New writers can only commit after they see the reset reservation
+        m_committed.store(0, std::memory_order_relaxed);
+        m_reserved.store(0, std::memory_order_release);
+        m_generation.fetch_add(1, std::memory_order_release);
+        m_generation.notify_all();
+    }
+}
+
+} // namespace slimlog
@@ -0,0 +1,217 @@
+/**
+ * @file buffered_file_sink.h
+ * @brief Contains declaration of BufferedFileSink class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/seek_index.h"
+#include "slimlog/sinks/file_sink.h"
+#include "slimlog/util/buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace slimlog {
+
+/**
+ * @brief Parameters of the output buffer in BufferedFileSink.
+ */
+struct BufferedFileOptions {
+    std::size_t capacity = std::size_t{256} * 1024; ///< Buffer size, rounded up to 4 KiB.
+    std::chrono::milliseconds flush_interval{1000}; ///< Maximum age of lines, zero disables.
+};
+
+/**
+ * @brief File sink with its own large output buffer.
+ *
+ * Unlike FileSink, which passes every line to `fwrite()`, this sink appends
+ * formatted lines to an aligned in-memory buffer and writes it to the file
+ * with a single `writev()` call once the buffer is full, the flush interval
+ * has expired or flush() is called.
+ *
+ * With MultiThreadedPolicy, space in the buffer is reserved with a single atomic
+ * addition, so concurrent writers copy their lines without taking a lock.
+ * The writer whose line does not fit anymore waits for the preceding copies
+ * to complete, writes the buffer together with its own line and resets the buffer,
+ * while the writers behind it wait for the reset.
+ *
+ * The flush interval is checked on every message against the record time,
+ * there is no background thread: the buffer of an idle sink is written on flush()
+ * or on destruction.
+ *
+ * With enable_index(), the sink also writes a sidecar seek index (see SeekIndex)
+ * with the time range and levels of each written block, so that readers can skip
+ * the parts of a large file which cannot contain the records they look for.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for sink operations.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename Char,
+    typename ThreadingPolicy = DefaultThreadingPolicy,
+    std::size_t BufferSize = DefaultSinkBufferSize,
+    typename Allocator = std::allocator<Char>>
+class BufferedFileSink : public FileSink<Char, ThreadingPolicy, BufferSize, Allocator> {
+public:
+    using typename FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::RecordType;
+    using typename FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::FormatBufferType;
+
+    /** @brief Alignment of the output buffer. */
+    static constexpr std::size_t Alignment = 4096;
+
+    /**
+     * @brief Write statistics.
+     */
+    struct Stats {
+        std::uint64_t syscalls = 0; ///< Number of write system calls issued.
+        std::uint64_t bytes = 0; ///< Number of bytes written.
+
+        /**
+         * @brief Gets the average number of bytes per write system call.
+         *
+         * @return Bytes per system call, zero if nothing was written.
+         */
+        [[nodiscard]] auto bytes_per_syscall() const noexcept -> double
+        {
+            return syscalls > 0 ? static_cast<double>(bytes) / static_cast<double>(syscalls)
+                                : 0.0;
+        }
+    };
+
+    /**
+     * @brief Constructs a new BufferedFileSink object.
+     *
+     * @tparam Args Argument types for the pattern and log levels.
+     * @param filename Path to the log file.
+     * @param options Parameters of the output buffer.
+     * @param args Optional pattern and list of log levels.
+     */
+    template<typename... Args>
+    BufferedFileSink(std::string_view filename, BufferedFileOptions options, Args&&... args)
+        : FileSink<Char, ThreadingPolicy, BufferSize, Allocator>(
+              filename, std::forward<Args>(args)...)
+        , m_filename(filename)
+        , m_capacity(
+              ((std::max(options.capacity, std::size_t{1}) + Alignment - 1) / Alignment)
+              * Alignment)
+        , m_buffer(m_capacity)
+        , m_interval(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(options.flush_interval).count())
+    {
+        init();
+    }
+
+    /**
+     * @brief Constructs a new BufferedFileSink object with default buffer parameters.
+     *
+     * @param filename Path to the log file.
+     */
+    explicit BufferedFileSink(std::string_view filename)
+        : BufferedFileSink(filename, BufferedFileOptions{})
+    {
+    }
+
+    /**
+     * @brief Writes the buffered lines and destroys the sink.
+     */
+    SLIMLOG_EXPORT ~BufferedFileSink() override;
+
+    BufferedFileSink(const BufferedFileSink&) = delete;
+    BufferedFileSink(BufferedFileSink&&) = delete;
+    auto operator=(const BufferedFileSink&) -> BufferedFileSink& = delete;
+    auto operator=(BufferedFileSink&&) -> BufferedFileSink& = delete;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Formats the log record and appends it to the output buffer.
+     *
+     * @param record The log record to process.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Writes the buffered lines to the file.
+     */
+    SLIMLOG_EXPORT auto flush() -> void override;
+
+    /**
+     * @brief Starts writing a seek index of the file.
+     *
+     * The index is appended to the file SeekIndex::path() next to the log file.
+     * An entry is written once the written data reaches the block size, and on
+     * destruction.
+     *
+     * Must be called before logging to the sink, and before the sink is shared
+     * with other threads: writers access the index without synchronization.
+     *
+     * @param block_size Minimum size of an indexed block in bytes.
+     * @throws std::logic_error if records were already logged to the sink.
+     */
+    SLIMLOG_EXPORT auto enable_index(std::size_t block_size = SeekIndex::DefaultBlockSize)
+        -> void;
+
+    /**
+     * @brief Gets the write statistics.
+     *
+     * @return Number of issued write system calls and written bytes.
+     */
+    [[nodiscard]] auto stats() const noexcept -> Stats
+    {
+        return {
+            m_syscalls.load(std::memory_order_relaxed), m_bytes.load(std::memory_order_relaxed)};
+    }
+
+    /**
+     * @brief Gets the output buffer capacity.
+     *
+     * @return Capacity in bytes.
+     */
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t
+    {
+        return m_capacity;
+    }
+
+private:
+    /** @brief Writes pending BOM and gets the file descriptor. */
+    auto init() -> void;
+    /** @brief Appends data to the buffer, returns \b true if the buffer was empty. */
+    auto append(const void* data, std::size_t size, std::int64_t time, Level level) -> bool;
+    /** @brief Writes the first bytes of the buffer followed by the data, then resets it. */
+    auto drain(std::size_t size, const void* data, std::size_t data_size) -> void;
+    /** @brief Writes two memory regions, repeating the system call on partial writes. */
+    auto write(const void* head, std::size_t head_size, const void* tail, std::size_t tail_size)
+        -> void;
+    /** @brief Resets the buffer and wakes up writers waiting for it. */
+    auto release() noexcept -> void;
+
+    std::string m_filename;
+    std::size_t m_capacity;
+    std::vector<std::byte, util::AlignedAllocator<std::byte, Alignment>> m_buffer;
+    std::unique_ptr<SeekIndexWriter<ThreadingPolicy>> m_index;
+    std::int64_t m_interval;
+    int m_fd = -1;
+    std::atomic<std::size_t> m_reserved{0};
+    std::atomic<std::size_t> m_committed{0};
+    std::atomic<std::uint32_t> m_generation{0};
+    std::atomic<std::int64_t> m_deadline{0};
+    std::atomic<std::uint64_t> m_syscalls{0};
+    std::atomic<std::uint64_t> m_bytes{0};
+};
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/buffered_file_sink-inl.h" // IWYU pragma: keep
+#endif
@@ -16,6 +16,12 @@ template<typename Char, typename ThreadingPolicy>
 auto CallbackSink<Char, ThreadingPolicy>::message(const RecordType& record) -> void
 {
     if (m_callback) {
+        if (record.deferred) [[unlikely]] {
+            typename DeferredMessage<Char>::BufferType buffer;
+            message(record.deferred->resolve(record, buffer));
+            return;
+        }
+
         const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
         // We can safely convert record.filename and record.function to const char*
         // because they're guaranteed to contain null-terminated strings initially.
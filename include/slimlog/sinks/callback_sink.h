@@ -6,6 +6,7 @@
 #pragma once
 
 #include "slimlog/common.h"
+#include "slimlog/format.h"
 #include "slimlog/location.h"
 #include "slimlog/sink.h"
 
@@ -0,0 +1,233 @@
+/**
+ * @file category_file_sink-inl.h
+ * @brief Contains definition of CategoryFileSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/category_file_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/category_file_sink.h" // IWYU pragma: associated
+#include "slimlog/util/os.h"
+#include "slimlog/util/unicode.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace slimlog {
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+CategoryFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::~CategoryFileSink()
+{
+    while (m_head != nullptr) {
+        try {
+            close(*m_head);
+        } catch (...) { // NOLINT(bugprone-empty-catch)
+            // Destructor must not throw, buffered lines of the file are lost
+        }
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CategoryFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::message(
+    const RecordType& record) -> void
+{
+    FormatBufferType buffer;
+    this->format(buffer, record);
+    buffer.push_back(static_cast<Char>('\n'));
+    const std::int64_t now = std::chrono::nanoseconds(record.time.first.time_since_epoch()).count()
+        + static_cast<std::int64_t>(record.time.second);
+    const auto capacity = std::max<std::size_t>(m_options.buffer_size / sizeof(Char), 1);
+
+    const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+    auto& partition = find(record.category);
+    if (!partition.fp) {
+        open(partition);
+    }
+    touch(partition);
+    partition.last_used = now;
+
+    if (!partition.buffer.empty() && partition.buffer.size() + buffer.size() > capacity) {
+        write(partition);
+    }
+    partition.buffer.insert(partition.buffer.end(), buffer.begin(), buffer.end());
+    if (partition.buffer.size() >= capacity) {
+        write(partition);
+    }
+
+    // Only the least recently used file can be idle for longer than the others
+    const auto timeout = std::chrono::nanoseconds(m_options.idle_timeout).count();
+    if (timeout > 0 && m_tail != &partition && now - m_tail->last_used >= timeout) {
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+        close(*m_tail);
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CategoryFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::flush() -> void
+{
+    const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+    for (auto* partition = m_head; partition != nullptr; partition = partition->next) {
+        write(*partition);
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CategoryFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::filename(
+    std::basic_string_view<Char> category) const -> std::string
+{
+    std::string name;
+    util::unicode::append_utf8(name, category.data(), category.size());
+    std::ranges::replace(name, '/', '_');
+    std::ranges::replace(name, '\\', '_');
+
+    auto result = m_path;
+    if (const auto pos = result.find(Placeholder); pos != std::string::npos) {
+        result.replace(pos, Placeholder.size(), name);
+    } else {
+        result += '.' + name;
+    }
+    return result;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CategoryFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::open_files() -> std::size_t
+{
+    const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+    return m_open;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CategoryFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::find(
+    std::basic_string_view<Char> category) -> Partition&
+{
+    // The address is compared first, the text only confirms an address reused for another string
+    const ViewKey key{category.data(), category.size()};
+    if (const auto it = m_views.find(key);
+        it != m_views.end() && it->second->category == category) [[likely]] {
+        return *it->second;
+    }
+
+    auto it = m_partitions.find(category);
+    if (it == m_partitions.end()) {
+        auto partition = std::make_unique<Partition>();
+        partition->category = category;
+        partition->filename = filename(category);
+        std::basic_string<Char> text(category);
+        it = m_partitions.emplace(std::move(text), std::move(partition)).first;
+    }
+
+    // Copied records bring a new address each, do not let them grow the map
+    if (m_views.size() >= (m_partitions.size() * 4) + 64) {
+        m_views.clear();
+    }
+    m_views.insert_or_assign(key, it->second.get());
+    return *it->second;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CategoryFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::open(Partition& partition)
+    -> void
+{
+    if (m_open >= m_options.max_open_files) {
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+        close(*m_tail);
+    }
+
+    auto fp = util::os::fopen_shared(partition.filename.c_str(), "ab");
+    if (!fp) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Error opening log file");
+    }
+    // Whole buffers are written at once, stdio buffering would only add a copy
+    std::setvbuf(fp.get(), nullptr, _IONBF, 0);
+    partition.buffer.reserve(std::max<std::size_t>(m_options.buffer_size / sizeof(Char), 1));
+    if constexpr (sizeof(Char) > 1) {
+        if (std::fseek(fp.get(), 0, SEEK_END) == 0 && std::ftell(fp.get()) == 0) {
+            // Code unit U+FEFF in native byte order is the UTF-16 or UTF-32 BOM
+            partition.buffer.push_back(static_cast<Char>(0xFEFF));
+        }
+    }
+
+    partition.fp = std::move(fp);
+    partition.next = m_head;
+    if (m_head != nullptr) {
+        m_head->prev = &partition;
+    }
+    m_head = &partition;
+    if (m_tail == nullptr) {
+        m_tail = &partition;
+    }
+    ++m_open;
+    m_opens.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CategoryFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::close(Partition& partition)
+    -> void
+{
+    std::exception_ptr error;
+    try {
+        write(partition);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // Buffers are kept only for the open files
+    unlink(partition);
+    --m_open;
+    partition.fp.reset();
+    partition.buffer = {};
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CategoryFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::write(Partition& partition)
+    -> void
+{
+    if (partition.buffer.empty()) {
+        return;
+    }
+    const auto size = partition.buffer.size() * sizeof(Char);
+    const auto written = std::fwrite(partition.buffer.data(), 1, size, partition.fp.get());
+    partition.buffer.clear();
+    if (written != size) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed writing to log file");
+    }
+    m_syscalls.fetch_add(1, std::memory_order_relaxed);
+    m_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CategoryFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::touch(
+    Partition& partition) noexcept -> void
+{
+    if (m_head == &partition) {
+        return;
+    }
+    unlink(partition);
+    partition.next = m_head;
+    m_head->prev = &partition;
+    m_head = &partition;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CategoryFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::unlink(
+    Partition& partition) noexcept -> void
+{
+    (partition.prev != nullptr ? partition.prev->next : m_head) = partition.next;
+    (partition.next != nullptr ? partition.next->prev : m_tail) = partition.prev;
+    partition.prev = nullptr;
+    partition.next = nullptr;
+}
+
+} // namespace slimlog
@@ -0,0 +1,240 @@
+/**
+ * @file category_file_sink.h
+ * @brief Contains declaration of CategoryFileSink class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/sink.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace slimlog {
+
+/**
+ * @brief Parameters of the open files of CategoryFileSink.
+ */
+struct CategoryFileOptions {
+    std::size_t max_open_files = 64; ///< Maximum number of files open at once.
+    std::size_t buffer_size = std::size_t{32} * 1024; ///< Size of the buffer of each file.
+    std::chrono::milliseconds idle_timeout{60000}; ///< Age of unused open files, zero disables.
+};
+
+/**
+ * @brief File sink writing the records of each category to a separate file.
+ *
+ * The file name is made from a path with a `{category}` placeholder,
+ * e.g. `logs/app.{category}.log`, by replacing it with the category
+ * in UTF-8, with path separators replaced by `_`. Without the placeholder,
+ * the category is appended to the path after a dot.
+ *
+ * Each file collects formatted lines in its own buffer, written with a single
+ * call once full, on flush() or when the file is closed. At most
+ * CategoryFileOptions::max_open_files files are open: opening one more
+ * closes the least recently used file, and files unused for the idle timeout
+ * (compared with the record time) are closed as well. A closed file is
+ * opened again for append on its next record.
+ *
+ * The category of a record points into its logger, so files are looked up
+ * by the address and size of the category, without hashing or copying its text.
+ * Copied records, e.g. from AsyncSink, fall back to a lookup by text.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for sink operations.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename Char,
+    typename ThreadingPolicy = DefaultThreadingPolicy,
+    std::size_t BufferSize = DefaultSinkBufferSize,
+    typename Allocator = std::allocator<Char>>
+class CategoryFileSink : public FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator> {
+public:
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::RecordType;
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::FormatBufferType;
+
+    /** @brief Placeholder replaced by the category in the path. */
+    static constexpr std::string_view Placeholder = "{category}";
+
+    /**
+     * @brief File statistics.
+     */
+    struct Stats {
+        std::uint64_t syscalls = 0; ///< Number of write calls.
+        std::uint64_t bytes = 0; ///< Number of bytes written.
+        std::uint64_t opens = 0; ///< Number of opened files.
+        std::uint64_t evictions = 0; ///< Number of files closed to open others or when idle.
+    };
+
+    /**
+     * @brief Constructs a new CategoryFileSink object.
+     *
+     * No file is opened until a record of its category arrives.
+     *
+     * @tparam Args Argument types for the pattern and log levels.
+     * @param path Path to the log files, with the `{category}` placeholder.
+     * @param options Parameters of the open files.
+     * @param args Optional pattern and list of log levels.
+     */
+    template<typename... Args>
+    CategoryFileSink(std::string_view path, CategoryFileOptions options, Args&&... args)
+        : FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>(
+              std::forward<Args>(args)...)
+        , m_path(path)
+        , m_options(options)
+    {
+        m_options.max_open_files = std::max<std::size_t>(m_options.max_open_files, 1);
+    }
+
+    /**
+     * @brief Constructs a new CategoryFileSink object with default file parameters.
+     *
+     * @param path Path to the log files, with the `{category}` placeholder.
+     */
+    explicit CategoryFileSink(std::string_view path)
+        : CategoryFileSink(path, CategoryFileOptions{})
+    {
+    }
+
+    /**
+     * @brief Writes the buffered lines and closes the files.
+     */
+    SLIMLOG_EXPORT ~CategoryFileSink() override;
+
+    CategoryFileSink(const CategoryFileSink&) = delete;
+    CategoryFileSink(CategoryFileSink&&) = delete;
+    auto operator=(const CategoryFileSink&) -> CategoryFileSink& = delete;
+    auto operator=(CategoryFileSink&&) -> CategoryFileSink& = delete;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Formats the log record and appends it to the buffer of its category file.
+     *
+     * @param record The log record to process.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Writes the buffered lines of all open files.
+     */
+    SLIMLOG_EXPORT auto flush() -> void override;
+
+    /**
+     * @brief Gets the name of the file of a category.
+     *
+     * @param category Category name.
+     * @return Path with the placeholder replaced.
+     */
+    [[nodiscard]] SLIMLOG_EXPORT auto filename(std::basic_string_view<Char> category) const
+        -> std::string;
+
+    /**
+     * @brief Gets the number of open files.
+     *
+     * @return Number of open files.
+     */
+    [[nodiscard]] SLIMLOG_EXPORT auto open_files() -> std::size_t;
+
+    /**
+     * @brief Gets the file statistics.
+     *
+     * @return Number of write calls, bytes written, opened and evicted files.
+     */
+    [[nodiscard]] auto stats() const noexcept -> Stats
+    {
+        return {
+            m_syscalls.load(std::memory_order_relaxed),
+            m_bytes.load(std::memory_order_relaxed),
+            m_opens.load(std::memory_order_relaxed),
+            m_evictions.load(std::memory_order_relaxed)};
+    }
+
+private:
+    /** @brief File of a category, linked into the list of open files while open. */
+    struct Partition {
+        std::basic_string<Char> category;
+        std::string filename;
+        std::unique_ptr<FILE, int (*)(FILE*)> fp = {nullptr, nullptr};
+        std::vector<Char> buffer;
+        std::int64_t last_used = 0;
+        Partition* prev = nullptr; ///< More recently used open file.
+        Partition* next = nullptr; ///< Less recently used open file.
+    };
+
+    /** @brief Address and size of a category string. */
+    struct ViewKey {
+        const Char* data;
+        std::size_t size;
+
+        auto operator==(const ViewKey&) const -> bool = default;
+    };
+
+    /** @brief Hash of the category address. */
+    struct ViewHash {
+        auto operator()(const ViewKey& key) const noexcept -> std::size_t
+        {
+            return std::hash<const void*>{}(key.data) ^ key.size;
+        }
+    };
+
+    /** @brief Hash of the category text, accepting string views. */
+    struct TextHash {
+        using is_transparent = void; ///< Enables lookup by string views.
+
+        auto operator()(std::basic_string_view<Char> str) const noexcept -> std::size_t
+        {
+            return std::hash<std::basic_string_view<Char>>{}(str);
+        }
+    };
+
+    /** @brief Gets the file of a category, creating it if needed. */
+    auto find(std::basic_string_view<Char> category) -> Partition&;
+    /** @brief Opens the file, closing the least recently used one if too many are open. */
+    auto open(Partition& partition) -> void;
+    /** @brief Writes the buffered lines and closes the file. */
+    auto close(Partition& partition) -> void;
+    /** @brief Writes the buffered lines of the file. */
+    auto write(Partition& partition) -> void;
+    /** @brief Moves the open file to the front of the list. */
+    auto touch(Partition& partition) noexcept -> void;
+    /** @brief Removes the open file from the list. */
+    auto unlink(Partition& partition) noexcept -> void;
+
+    std::string m_path;
+    CategoryFileOptions m_options;
+    std::unordered_map<
+        std::basic_string<Char>,
+        std::unique_ptr<Partition>,
+        TextHash,
+        std::equal_to<>>
+        m_partitions;
+    std::unordered_map<ViewKey, Partition*, ViewHash> m_views;
+    Partition* m_head = nullptr; ///< Most recently used open file.
+    Partition* m_tail = nullptr; ///< Least recently used open file.
+    std::size_t m_open = 0;
+    typename ThreadingPolicy::Mutex m_mutex;
+    std::atomic<std::uint64_t> m_syscalls{0};
+    std::atomic<std::uint64_t> m_bytes{0};
+    std::atomic<std::uint64_t> m_opens{0};
+    std::atomic<std::uint64_t> m_evictions{0};
+};
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/category_file_sink-inl.h" // IWYU pragma: keep
+#endif
@@ -0,0 +1,293 @@
+/**
+ * @file compressed_file_sink-inl.h
+ * @brief Contains definition of CompressedFileSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/compressed_file_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/compressed_file_sink.h" // IWYU pragma: associated
+#include "slimlog/util/lz4.h"
+#include "slimlog/util/os.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <tuple>
+
+namespace slimlog {
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+CompressedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::~CompressedFileSink()
+{
+    try {
+        flush();
+    } catch (...) { // NOLINT(bugprone-empty-catch)
+        // Destructor must not throw, failed blocks are lost
+    }
+    {
+        const std::lock_guard lock(m_queue_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_one();
+    m_thread.join();
+
+    // End mark completes the frame, the next opening of the file appends a new one
+    const std::array<std::byte, 4> end_mark{};
+    std::ignore = std::fwrite(end_mark.data(), 1, end_mark.size(), m_fp.get());
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::open(
+    std::string_view filename, CompressedFileOptions options) -> void
+{
+    const std::string name(filename);
+    m_fp = util::os::fopen_shared(name.c_str(), "ab");
+    if (!m_fp) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Error opening log file");
+    }
+    std::error_code error;
+    const auto size = std::filesystem::file_size(name, error);
+    if (error) [[unlikely]] {
+        throw std::system_error(error, "Error getting log file size");
+    }
+    const auto end = size > 0 ? end_frame(name, size) : size;
+
+    m_block_size = util::lz4::frame_block_size(options.block_size);
+    const auto header = util::lz4::frame_header(m_block_size);
+    if (std::fwrite(header.data(), 1, header.size(), m_fp.get()) != header.size()
+        || std::fflush(m_fp.get()) != 0) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed writing to log file");
+    }
+
+    m_blocks.resize(std::max(options.blocks, 2U));
+    for (auto& block : m_blocks) {
+        // NOLINTNEXTLINE(*-avoid-c-arrays)
+        block.data = std::make_unique_for_overwrite<std::byte[]>(m_block_size);
+    }
+
+    if constexpr (sizeof(Char) > 1) {
+        if (end == 0) {
+            // Code unit U+FEFF in native byte order is the UTF-16 or UTF-32 BOM
+            const auto bom = static_cast<Char>(0xFEFF);
+            append(reinterpret_cast<const std::byte*>(&bom), sizeof(bom)); // NOLINT(*-cast)
+        }
+    }
+
+    m_thread = std::thread(&CompressedFileSink::run, this);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::end_frame(
+    const std::string& filename, std::uint64_t size) -> std::uint64_t
+{
+    using util::lz4::detail::read_le32;
+
+    std::ifstream file(filename, std::ios::binary);
+    std::array<std::byte, 4> word{};
+    const auto read = [&file, &word, size](std::uint64_t offset, std::size_t count) {
+        if (offset + count > size) {
+            return false;
+        }
+        file.seekg(static_cast<std::streamoff>(offset));
+        // NOLINTNEXTLINE(*-reinterpret-cast)
+        if (!file.read(reinterpret_cast<char*>(word.data()), static_cast<std::streamsize>(count)))
+            [[unlikely]] {
+            throw std::system_error({errno, std::system_category()}, "Error reading log file");
+        }
+        return true;
+    };
+
+    // Walk the block headers up to the last complete block,
+    // frames written by the sink have no checksums
+    std::uint64_t end = 0;
+    bool open = false;
+    while (read(end, word.size())) {
+        if (read_le32(word.data()) != util::lz4::FrameMagic) {
+            // Not written by the sink, keep as is
+            return size;
+        }
+        if (!read(end + 4, 2)) {
+            break;
+        }
+        const auto flags = static_cast<unsigned>(word[0]);
+        const auto code = (static_cast<unsigned>(word[1]) >> 4) & 7;
+        if ((flags >> 6) != 1 || (flags & 0x15) != 0 || code < 4) {
+            return size;
+        }
+        const std::uint64_t header = util::lz4::FrameHeaderSize + ((flags & 0x08) != 0 ? 8 : 0);
+        if (end + header > size) {
+            break;
+        }
+        const std::uint64_t block_max = std::uint64_t{1} << (8 + (2 * code));
+        auto pos = end + header;
+        end = pos;
+        open = true;
+        while (read(pos, word.size())) {
+            const auto block = read_le32(word.data());
+            const auto block_size = block & ~util::lz4::UncompressedFlag;
+            pos += word.size() + block_size;
+            if (block_size > block_max || pos > size) {
+                break;
+            }
+            end = pos;
+            if (block == 0) {
+                open = false;
+                break;
+            }
+        }
+        if (open) {
+            break;
+        }
+    }
+    file.close();
+
+    const auto fd = util::os::file_descriptor(m_fp.get());
+    if (end != size && !util::os::resize_file(fd, end)) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Error truncating log file");
+    }
+    if (open) {
+        const std::array<std::byte, 4> end_mark{};
+        if (std::fwrite(end_mark.data(), 1, end_mark.size(), m_fp.get()) != end_mark.size())
+            [[unlikely]] {
+            throw std::system_error({errno, std::system_category()}, "Failed writing to log file");
+        }
+        end += end_mark.size();
+    }
+    return end;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::message(
+    const RecordType& record) -> void
+{
+    FormatBufferType buffer;
+    this->format(buffer, record);
+    buffer.push_back(static_cast<Char>('\n'));
+
+    const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+    // NOLINTNEXTLINE(*-reinterpret-cast)
+    append(reinterpret_cast<const std::byte*>(buffer.data()), buffer.size() * sizeof(Char));
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::flush() -> void
+{
+    std::exception_ptr error;
+    {
+        const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+        if (m_blocks[m_current].size > 0) {
+            submit();
+        }
+        std::unique_lock queue_lock(m_queue_mutex);
+        m_done.wait(queue_lock, [this]() { return m_completed == m_submitted; });
+        error = std::exchange(m_error, nullptr);
+    }
+    if (error) [[unlikely]] {
+        std::rethrow_exception(error);
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::append(
+    const std::byte* data, std::size_t size) -> void
+{
+    while (size > 0) {
+        auto& block = m_blocks[m_current];
+        const auto count = std::min(size, m_block_size - block.size);
+        std::memcpy(block.data.get() + block.size, data, count); // NOLINT(*-pointer-arithmetic)
+        block.size += count;
+        data += count; // NOLINT(*-pointer-arithmetic)
+        size -= count;
+        if (block.size == m_block_size) {
+            submit();
+        }
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::submit() -> void
+{
+    std::unique_lock lock(m_queue_mutex);
+    m_blocks[m_current].pending = true;
+    ++m_submitted;
+    m_current = (m_current + 1) % m_blocks.size();
+    m_wakeup.notify_one();
+    // The worker is behind by all blocks, wait for it to free the next one
+    m_done.wait(lock, [this]() { return !m_blocks[m_current].pending; });
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::write(
+    const Block& block, std::vector<std::byte>& output) -> void
+{
+    constexpr std::size_t HeaderSize = 4;
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t size = util::lz4::compress(
+        block.data.get(), block.size, output.data() + HeaderSize, output.size() - HeaderSize);
+    auto header = static_cast<std::uint32_t>(size);
+    if (size == 0 || size >= block.size) {
+        // Incompressible data is stored as is
+        std::memcpy(output.data() + HeaderSize, block.data.get(), block.size);
+        size = block.size;
+        header = static_cast<std::uint32_t>(size) | util::lz4::UncompressedFlag;
+    }
+    m_time.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count(),
+        std::memory_order_relaxed);
+
+    for (std::size_t i = 0; i < HeaderSize; ++i) {
+        output[i] = static_cast<std::byte>((header >> (i * 8)) & 0xFF);
+    }
+    size += HeaderSize;
+    if (std::fwrite(output.data(), 1, size, m_fp.get()) != size || std::fflush(m_fp.get()) != 0)
+        [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed writing to log file");
+    }
+    m_blocks_written.fetch_add(1, std::memory_order_relaxed);
+    m_input_bytes.fetch_add(block.size, std::memory_order_relaxed);
+    m_output_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::run() -> void
+{
+    std::vector<std::byte> output(4 + util::lz4::compress_bound(m_block_size));
+    std::unique_lock lock(m_queue_mutex);
+    for (;;) {
+        m_wakeup.wait(lock, [this]() { return m_blocks[m_next].pending || m_stop; });
+        auto& block = m_blocks[m_next];
+        if (!block.pending) {
+            break;
+        }
+
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            write(block, output);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+
+        if (error && !m_error) {
+            m_error = error;
+        }
+        block.size = 0;
+        block.pending = false;
+        ++m_completed;
+        m_next = (m_next + 1) % m_blocks.size();
+        m_done.notify_all();
+    }
+}
+
+} // namespace slimlog
@@ -0,0 +1,223 @@
+/**
+ * @file compressed_file_sink.h
+ * @brief Contains declaration of CompressedFileSink class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/sink.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace slimlog {
+
+/**
+ * @brief Parameters of the compression in CompressedFileSink.
+ */
+struct CompressedFileOptions {
+    std::size_t block_size = std::size_t{64} * 1024; ///< Uncompressed size of each block.
+    unsigned blocks = 4; ///< Number of blocks being filled or compressed at once.
+};
+
+/**
+ * @brief File sink compressing the output with LZ4.
+ *
+ * The file is a sequence of standard LZ4 frames, one per opening of the sink,
+ * so it can be read with `lz4 -d`, `lz4cat` or util::lz4::decompress_frames().
+ * Lines are collected in blocks of a fixed size (64 KiB, 256 KiB, 1 MiB or 4 MiB),
+ * each compressed independently of the others, so a crash loses at most
+ * the blocks which were not written yet: the one being filled and up to `blocks`
+ * queued for compression. The rest of the file stays readable. When the file
+ * is reopened after a crash, a partially written block is cut off and the frame
+ * left open is completed with the end mark, so the new frame is readable too.
+ *
+ * Writers only copy formatted lines into the current block. Full blocks are
+ * compressed and written by a worker thread, while the writers fill the next
+ * block. A writer waits only if all blocks are still queued for compression.
+ *
+ * The sink is not derived from FileSink and has no DurabilityPolicy:
+ * a record reaches the file only with its block, so it cannot be synced on its own.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for sink operations.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename Char,
+    typename ThreadingPolicy = DefaultThreadingPolicy,
+    std::size_t BufferSize = DefaultSinkBufferSize,
+    typename Allocator = std::allocator<Char>>
+class CompressedFileSink : public FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator> {
+public:
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::RecordType;
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::FormatBufferType;
+
+    /**
+     * @brief Compression statistics.
+     */
+    struct Stats {
+        std::uint64_t blocks = 0; ///< Number of written blocks.
+        std::uint64_t input_bytes = 0; ///< Number of bytes before compression.
+        std::uint64_t output_bytes = 0; ///< Number of bytes written to the file.
+        std::chrono::nanoseconds time{0}; ///< Time spent by the worker compressing blocks.
+
+        /**
+         * @brief Gets the compression ratio.
+         *
+         * @return Input size divided by output size, zero if nothing was written.
+         */
+        [[nodiscard]] auto ratio() const noexcept -> double
+        {
+            return output_bytes > 0
+                ? static_cast<double>(input_bytes) / static_cast<double>(output_bytes)
+                : 0.0;
+        }
+
+        /**
+         * @brief Gets the compression throughput of the worker.
+         *
+         * @return Input bytes compressed per second, zero if nothing was compressed.
+         */
+        [[nodiscard]] auto throughput() const noexcept -> double
+        {
+            return time.count() > 0
+                ? static_cast<double>(input_bytes) * 1e9 / static_cast<double>(time.count())
+                : 0.0;
+        }
+    };
+
+    /**
+     * @brief Constructs a new CompressedFileSink object and starts the worker thread.
+     *
+     * @tparam Args Argument types for the pattern and log levels.
+     * @param filename Path to the log file.
+     * @param options Compression parameters.
+     * @param args Optional pattern and list of log levels.
+     */
+    template<typename... Args>
+    CompressedFileSink(std::string_view filename, CompressedFileOptions options, Args&&... args)
+        : FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>(
+              std::forward<Args>(args)...)
+    {
+        open(filename, options);
+    }
+
+    /**
+     * @brief Constructs a new CompressedFileSink object with default compression parameters.
+     *
+     * @param filename Path to the log file.
+     */
+    explicit CompressedFileSink(std::string_view filename)
+        : CompressedFileSink(filename, CompressedFileOptions{})
+    {
+    }
+
+    /**
+     * @brief Writes the buffered lines, ends the frame and stops the worker thread.
+     */
+    SLIMLOG_EXPORT ~CompressedFileSink() override;
+
+    CompressedFileSink(const CompressedFileSink&) = delete;
+    CompressedFileSink(CompressedFileSink&&) = delete;
+    auto operator=(const CompressedFileSink&) -> CompressedFileSink& = delete;
+    auto operator=(CompressedFileSink&&) -> CompressedFileSink& = delete;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Formats the log record and copies it to the current block.
+     *
+     * @param record The log record to process.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Queues the current block, even if not full, and waits until all blocks are written.
+     *
+     * Rethrows the first error of the worker thread, if any.
+     */
+    SLIMLOG_EXPORT auto flush() -> void override;
+
+    /**
+     * @brief Gets the compression statistics.
+     *
+     * @return Number of blocks, bytes before and after compression, compression time.
+     */
+    [[nodiscard]] auto stats() const noexcept -> Stats
+    {
+        return {
+            m_blocks_written.load(std::memory_order_relaxed),
+            m_input_bytes.load(std::memory_order_relaxed),
+            m_output_bytes.load(std::memory_order_relaxed),
+            std::chrono::nanoseconds(m_time.load(std::memory_order_relaxed))};
+    }
+
+    /**
+     * @brief Gets the uncompressed size of the blocks.
+     *
+     * @return Block size in bytes.
+     */
+    [[nodiscard]] auto block_size() const noexcept -> std::size_t
+    {
+        return m_block_size;
+    }
+
+private:
+    /** @brief Block of lines. */
+    struct Block {
+        std::unique_ptr<std::byte[]> data; // NOLINT(*-avoid-c-arrays)
+        std::size_t size = 0; ///< Number of bytes in the block.
+        bool pending = false; ///< Block is queued for the worker.
+    };
+
+    /** @brief Opens the file, writes the frame header and starts the worker thread. */
+    SLIMLOG_EXPORT auto open(std::string_view filename, CompressedFileOptions options) -> void;
+    /** @brief Completes the frame left open by an abnormal termination, returns the size. */
+    auto end_frame(const std::string& filename, std::uint64_t size) -> std::uint64_t;
+    /** @brief Copies data to the blocks, queuing the full ones. */
+    auto append(const std::byte* data, std::size_t size) -> void;
+    /** @brief Queues the current block and waits until the next one is free. */
+    auto submit() -> void;
+    /** @brief Compresses the block and writes it to the file. */
+    auto write(const Block& block, std::vector<std::byte>& output) -> void;
+    /** @brief Worker thread loop. */
+    auto run() -> void;
+
+    std::unique_ptr<FILE, int (*)(FILE*)> m_fp = {nullptr, nullptr};
+    std::size_t m_block_size = 0;
+    std::vector<Block> m_blocks;
+    std::size_t m_current = 0; // Block filled by writers
+    std::size_t m_next = 0; // Block compressed by the worker
+    std::uint64_t m_submitted = 0;
+    std::uint64_t m_completed = 0;
+    bool m_stop = false;
+    std::exception_ptr m_error;
+    typename ThreadingPolicy::Mutex m_mutex;
+    std::mutex m_queue_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_done;
+    std::atomic<std::uint64_t> m_blocks_written{0};
+    std::atomic<std::uint64_t> m_input_bytes{0};
+    std::atomic<std::uint64_t> m_output_bytes{0};
+    std::atomic<std::int64_t> m_time{0};
+    std::thread m_thread;
+};
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/compressed_file_sink-inl.h" // IWYU pragma: keep
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file direct_file_sink-inl.h
+ * @brief Contains definition of DirectFileSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/direct_file_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/direct_file_sink.h" // IWYU pragma: associated
+#include "slimlog/util/os.h"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+namespace slimlog {
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+DirectFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::~DirectFileSink()
+{
+    try {
+        flush();
+    } catch (...) { // NOLINT(bugprone-empty-catch)
+        // Destructor must not throw, buffered lines are lost
+    }
+    util::os::close_file(m_fd);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto DirectFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::open(std::string_view filename)
+    -> void
+{
+    const std::string name(filename);
+    m_fd = util::os::open_direct(name.c_str(), m_direct);
+    if (m_fd < 0) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Error opening log file");
+    }
+
+    try {
+        std::error_code error;
+        const auto size = std::filesystem::file_size(name, error);
+        if (error) [[unlikely]] {
+            throw std::system_error(error, "Error getting log file size");
+        }
+
+        // Continue from the incomplete last block, it is rewritten with the next lines
+        const auto tail = static_cast<std::size_t>(size % Alignment);
+        m_offset = size - tail;
+        while (m_used < tail) {
+            const auto result = util::os::read_at(m_fd, m_buffer.data(), Alignment, m_offset);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            if (result <= 0) [[unlikely]] {
+                throw std::system_error({errno, std::system_category()}, "Failed reading log file");
+            }
+            m_used = static_cast<std::size_t>(result);
+        }
+        m_used = m_written = tail;
+
+        if constexpr (sizeof(Char) > 1) {
+            if (size == 0) {
+                // Code unit U+FEFF in native byte order is the UTF-16 or UTF-32 BOM
+                const auto bom = static_cast<Char>(0xFEFF);
+                append(reinterpret_cast<const std::byte*>(&bom), sizeof(bom)); // NOLINT(*-cast)
+            }
+        }
+    } catch (...) {
+        util::os::close_file(m_fd);
+        throw;
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto DirectFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::message(
+    const RecordType& record) -> void
+{
+    FormatBufferType buffer;
+    this->format(buffer, record);
+    buffer.push_back(static_cast<Char>('\n'));
+
+    const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+    // NOLINTNEXTLINE(*-reinterpret-cast)
+    append(reinterpret_cast<const std::byte*>(buffer.data()), buffer.size() * sizeof(Char));
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto DirectFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::flush() -> void
+{
+    const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+    if (m_used == m_written) {
+        return;
+    }
+
+    write(m_used);
+    const auto tail = m_used % Alignment;
+    if (tail > 0 && !util::os::resize_file(m_fd, m_offset + m_used)) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed truncating log file");
+    }
+
+    // Keep only the incomplete last block
+    const auto full = m_used - tail;
+    std::memmove(m_buffer.data(), m_buffer.data() + full, tail);
+    m_offset += full;
+    m_used = m_written = tail;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto DirectFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::append(
+    const std::byte* data, std::size_t size) -> void
+{
+    while (size > 0) {
+        const auto count = std::min(size, m_buffer.size() - m_used);
+        std::memcpy(m_buffer.data() + m_used, data, count);
+        m_used += count;
+        data += count; // NOLINT(*-pointer-arithmetic)
+        size -= count;
+
+        if (m_used == m_buffer.size()) {
+            write(m_used);
+            m_offset += m_used;
+            m_used = m_written = 0;
+        }
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto DirectFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::write(std::size_t size) -> void
+{
+    // Unbuffered writes must cover whole blocks, pad the last one with zeros
+    const auto padded = ((size + Alignment - 1) / Alignment) * Alignment;
+    std::memset(m_buffer.data() + size, 0, padded - size);
+
+    std::size_t done = 0;
+    while (done < padded) {
+        const auto result
+            = util::os::write_at(m_fd, m_buffer.data() + done, padded - done, m_offset + done);
+        if (result < 0) [[unlikely]] {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error({errno, std::system_category()}, "Failed writing to log file");
+        }
+        done += static_cast<std::size_t>(result);
+    }
+}
+
+} // namespace slimlog
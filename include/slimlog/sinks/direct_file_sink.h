@@ -0,0 +1,159 @@
+/**
+ * @file direct_file_sink.h
+ * @brief Contains declaration of DirectFileSink class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/sink.h"
+#include "slimlog/util/buffer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace slimlog {
+
+/**
+ * @brief Parameters of the buffer in DirectFileSink.
+ */
+struct DirectFileOptions {
+    std::size_t capacity = std::size_t{1024} * 1024; ///< Buffer size, rounded up to 4 KiB.
+};
+
+/**
+ * @brief File sink writing aligned blocks past the page cache.
+ *
+ * Opt-in sink for high-volume logs, which would otherwise evict other data
+ * from the page cache. The file is opened with `O_DIRECT` (see util::os::open_direct())
+ * and lines are collected in a buffer aligned to Alignment, so only whole blocks
+ * are written at aligned offsets.
+ *
+ * On flush, the incomplete last block is written padded with zeros and the file
+ * is truncated to the real length. The block stays in the buffer and is written
+ * again once more lines are appended to it.
+ *
+ * If the file system does not support unbuffered writes, the file is opened normally
+ * and the sink still writes whole blocks.
+ *
+ * The sink is not derived from FileSink and has no DurabilityPolicy:
+ * written blocks bypass the page cache, but buffered lines are written only
+ * once a block is full or on flush(), and the file size is not synced.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for sink operations.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename Char,
+    typename ThreadingPolicy = DefaultThreadingPolicy,
+    std::size_t BufferSize = DefaultSinkBufferSize,
+    typename Allocator = std::allocator<Char>>
+class DirectFileSink : public FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator> {
+public:
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::RecordType;
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::FormatBufferType;
+
+    /** @brief Alignment of the buffer, file offsets and write sizes in bytes. */
+    static constexpr std::size_t Alignment = 4096;
+
+    /**
+     * @brief Constructs a new DirectFileSink object.
+     *
+     * @tparam Args Argument types for the pattern and log levels.
+     * @param filename Path to the log file.
+     * @param options Parameters of the buffer.
+     * @param args Optional pattern and list of log levels.
+     */
+    template<typename... Args>
+    DirectFileSink(std::string_view filename, DirectFileOptions options, Args&&... args)
+        : FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>(
+              std::forward<Args>(args)...)
+        , m_buffer(
+              ((std::max(options.capacity, std::size_t{1}) + Alignment - 1) / Alignment)
+              * Alignment)
+    {
+        open(filename);
+    }
+
+    /**
+     * @brief Constructs a new DirectFileSink object with default buffer parameters.
+     *
+     * @param filename Path to the log file.
+     */
+    explicit DirectFileSink(std::string_view filename)
+        : DirectFileSink(filename, DirectFileOptions{})
+    {
+    }
+
+    /**
+     * @brief Writes the buffered lines and closes the file.
+     */
+    SLIMLOG_EXPORT ~DirectFileSink() override;
+
+    DirectFileSink(const DirectFileSink&) = delete;
+    DirectFileSink(DirectFileSink&&) = delete;
+    auto operator=(const DirectFileSink&) -> DirectFileSink& = delete;
+    auto operator=(DirectFileSink&&) -> DirectFileSink& = delete;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Formats the log record and appends it to the buffer.
+     *
+     * @param record The log record to process.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Writes the buffered lines, including the incomplete last block.
+     */
+    SLIMLOG_EXPORT auto flush() -> void override;
+
+    /**
+     * @brief Checks if the page cache is bypassed.
+     *
+     * @return \b false if the file system does not support unbuffered writes.
+     */
+    [[nodiscard]] auto direct() const noexcept -> bool
+    {
+        return m_direct;
+    }
+
+    /**
+     * @brief Gets the buffer capacity.
+     *
+     * @return Capacity in bytes.
+     */
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t
+    {
+        return m_buffer.size();
+    }
+
+private:
+    /** @brief Opens the file and loads its incomplete last block. */
+    SLIMLOG_EXPORT auto open(std::string_view filename) -> void;
+    /** @brief Copies data to the buffer, writing it once full. */
+    auto append(const std::byte* data, std::size_t size) -> void;
+    /** @brief Writes the beginning of the buffer at the current block offset. */
+    auto write(std::size_t size) -> void;
+
+    std::vector<std::byte, util::AlignedAllocator<std::byte, Alignment>> m_buffer;
+    std::size_t m_used = 0; // Bytes in the buffer
+    std::size_t m_written = 0; // Bytes in the buffer already written by flush()
+    std::uint64_t m_offset = 0; // File offset of the buffer
+    int m_fd = -1;
+    bool m_direct = false;
+    typename ThreadingPolicy::Mutex m_mutex;
+};
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/direct_file_sink-inl.h" // IWYU pragma: keep
+#endif
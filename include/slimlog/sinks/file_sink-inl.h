@@ -16,6 +16,7 @@
 #include <bit>
 #include <cerrno>
 #include <cstdint>
+#include <exception>
 #include <string>
 #include <system_error>
 #include <type_traits>
@@ -24,26 +25,34 @@ namespace slimlog {
 
 template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
 auto FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::open(std::string_view filename) -> void
+{
+    m_fp = open_file(filename);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::open_file(std::string_view filename)
+    -> FilePtr
 {
     // Open file in append binary mode with shared read access
-    m_fp = util::os::fopen_shared(std::string(filename).c_str(), "ab");
-    if (!m_fp) [[unlikely]] {
+    auto fp = util::os::fopen_shared(std::string(filename).c_str(), "ab");
+    if (!fp) [[unlikely]] {
         throw std::system_error({errno, std::system_category()}, "Error opening log file");
     }
 
     // Seek to end of file
-    if (std::fseek(m_fp.get(), 0, SEEK_END) != 0) [[unlikely]] {
+    if (std::fseek(fp.get(), 0, SEEK_END) != 0) [[unlikely]] {
         throw std::system_error({errno, std::system_category()}, "Error seeking log file");
     }
 
     // Write BOM only if the file is empty
-    if (std::ftell(m_fp.get()) == 0 && !write_bom()) [[unlikely]] {
+    if (std::ftell(fp.get()) == 0 && !write_bom(fp.get())) [[unlikely]] {
         throw std::system_error({errno, std::system_category()}, "Error writing BOM to log file");
     }
+    return fp;
 }
 
 template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
-auto FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::write_bom() -> bool
+auto FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::write_bom(FILE* fp) -> bool
 {
     if constexpr (
         std::is_same_v<Char, char16_t> || (sizeof(Char) == 2 && std::is_same_v<Char, wchar_t>)) {
@@ -51,14 +60,14 @@ auto FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::write_bom() -> bool
         static constexpr std::array<std::uint8_t, 2> LeBom = {0xFF, 0xFE}; // UTF-16LE
         static constexpr std::array<std::uint8_t, 2> BeBom = {0xFE, 0xFF}; // UTF-16BE
         const auto& bom = (std::endian::native == std::endian::little) ? LeBom : BeBom;
-        return util::os::fwrite_nolock(bom.data(), bom.size(), 1, m_fp.get()) == 1;
+        return util::os::fwrite_nolock(bom.data(), bom.size(), 1, fp) == 1;
     } else if constexpr (
         std::is_same_v<Char, char32_t> || (sizeof(Char) == 4 && std::is_same_v<Char, wchar_t>)) {
         // UTF-32 BOM
         static constexpr std::array<std::uint8_t, 4> LeBom = {0xFF, 0xFE, 0x00, 0x00}; // UTF-32LE
         static constexpr std::array<std::uint8_t, 4> BeBom = {0x00, 0x00, 0xFE, 0xFF}; // UTF-32BE
         const auto& bom = (std::endian::native == std::endian::little) ? LeBom : BeBom;
-        return util::os::fwrite_nolock(bom.data(), bom.size(), 1, m_fp.get()) == 1;
+        return util::os::fwrite_nolock(bom.data(), bom.size(), 1, fp) == 1;
     } else {
         return true;
     }
@@ -71,13 +80,20 @@ auto FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::message(const Recor
     FormatBufferType buffer;
     this->format(buffer, record);
     buffer.push_back(static_cast<Char>('\n'));
+    write(m_fp.get(), buffer.data(), buffer.size());
+    apply_durability(record);
+}
 
-    const std::size_t expected = buffer.size() * sizeof(Char);
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::write(
+    FILE* fp, const Char* data, std::size_t size) -> void
+{
+    const std::size_t expected = size * sizeof(Char);
     std::size_t written = 0;
     if constexpr (std::is_same_v<ThreadingPolicy, SingleThreadedPolicy>) {
-        written = util::os::fwrite_nolock(buffer.data(), 1, expected, m_fp.get());
+        written = util::os::fwrite_nolock(data, 1, expected, fp);
     } else {
-        written = std::fwrite(buffer.data(), 1, expected, m_fp.get());
+        written = std::fwrite(data, 1, expected, fp);
     }
     if (written != expected) [[unlikely]] {
         throw std::system_error({errno, std::system_category()}, "Failed writing to log file");
@@ -92,4 +108,96 @@ auto FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::flush() -> void
     }
 }
 
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::sync() -> void
+{
+    if constexpr (std::is_same_v<ThreadingPolicy, SingleThreadedPolicy>) {
+        flush();
+        sync_file();
+        m_syncs.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        std::unique_lock lock(m_sync_mutex);
+        const auto ticket = ++m_sync_requested;
+        while (m_sync_completed < ticket) {
+            if (m_syncing) {
+                // Data written before our request may be missed by the running sync
+                m_sync_done.wait(lock);
+                continue;
+            }
+
+            // Sync on behalf of all requests made so far
+            m_syncing = true;
+            const auto target = m_sync_requested;
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                flush();
+                sync_file();
+                m_syncs.fetch_add(1, std::memory_order_relaxed);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            m_syncing = false;
+            if (!error) {
+                m_sync_completed = target;
+            }
+            m_sync_done.notify_all();
+            if (error) {
+                // Waiting threads retry the sync themselves
+                std::rethrow_exception(error);
+            }
+        }
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::set_durability(
+    const DurabilityPolicy& policy) -> void
+{
+    m_sync_level.store(
+        policy.level ? static_cast<int>(*policy.level) : -1, std::memory_order_relaxed);
+    m_sync_interval.store(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(policy.interval).count(),
+        std::memory_order_relaxed);
+    m_sync_deadline.store(0, std::memory_order_relaxed);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::apply_durability(
+    const RecordType& record) -> void
+{
+    if (static_cast<int>(record.level) <= m_sync_level.load(std::memory_order_relaxed)) {
+        m_sync_deadline.store(0, std::memory_order_relaxed);
+        sync();
+        return;
+    }
+
+    const auto interval = m_sync_interval.load(std::memory_order_relaxed);
+    if (interval <= 0) {
+        return;
+    }
+    const std::int64_t now = std::chrono::nanoseconds(record.time.first.time_since_epoch()).count()
+        + static_cast<std::int64_t>(record.time.second);
+    auto deadline = m_sync_deadline.load(std::memory_order_relaxed);
+    if (deadline == 0) {
+        // First unsynced record starts the interval
+        m_sync_deadline.compare_exchange_strong(
+            deadline, now + interval, std::memory_order_relaxed, std::memory_order_relaxed);
+    } else if (
+        now >= deadline
+        && m_sync_deadline.compare_exchange_strong(
+            deadline, 0, std::memory_order_relaxed, std::memory_order_relaxed)) {
+        sync();
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::sync_file() -> void
+{
+    if (!util::os::sync_file(util::os::file_descriptor(m_fp.get()))) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed syncing log file");
+    }
+}
+
 } // namespace slimlog
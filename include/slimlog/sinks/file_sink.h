@@ -8,18 +8,41 @@
 #include "slimlog/common.h"
 #include "slimlog/sink.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string_view>
 #include <utility>
 
 namespace slimlog {
 
+/**
+ * @brief Durability policy of file sinks.
+ *
+ * Defines which records are followed by FileSink::sync(), which waits until
+ * the written data reaches the storage device.
+ */
+struct DurabilityPolicy {
+    std::optional<Level> level{}; ///< Records of this or a more severe level are synced.
+    std::chrono::milliseconds interval{0}; ///< Maximum age of unsynced records, zero disables.
+};
+
 /**
  * @brief Output file-based sink.
  *
  * This sink writes formatted log messages directly to a file.
  *
+ * By default, written data stays in the page cache until the system writes it back.
+ * A DurabilityPolicy set with set_durability() makes the sink call sync() for severe
+ * records or periodically. Concurrent sync() calls are coalesced into group commits,
+ * so that many threads logging errors at the same time share a single `fdatasync()`.
+ *
  * @tparam Char Character type for the string.
  * @tparam ThreadingPolicy Threading policy for sink operations.
  * @tparam BufferSize Size of the internal pre-allocated buffer.
@@ -63,7 +86,38 @@ public:
      */
     SLIMLOG_EXPORT auto flush() -> void override;
 
+    /**
+     * @brief Flushes the sink and waits until the data reaches the storage device.
+     *
+     * If another thread is already syncing, waits for it and then joins the threads
+     * arrived meanwhile in a single following sync, instead of syncing once per caller.
+     */
+    SLIMLOG_EXPORT auto sync() -> void;
+
+    /**
+     * @brief Sets the durability policy.
+     *
+     * The interval is checked against the time of the next record,
+     * so the last records are synced only on the next message or sync().
+     *
+     * @param policy Durability policy.
+     */
+    SLIMLOG_EXPORT auto set_durability(const DurabilityPolicy& policy) -> void;
+
+    /**
+     * @brief Gets the number of completed data syncs.
+     *
+     * @return Number of `fdatasync()` calls.
+     */
+    [[nodiscard]] auto syncs() const noexcept -> std::uint64_t
+    {
+        return m_syncs.load(std::memory_order_relaxed);
+    }
+
 protected:
+    /** @brief Owning pointer to an open file stream. */
+    using FilePtr = std::unique_ptr<FILE, int (*)(FILE*)>;
+
     /**
      * @brief Opens a particular log file for append.
      *
@@ -71,15 +125,85 @@ protected:
      */
     SLIMLOG_EXPORT auto open(std::string_view filename) -> void;
 
+    /**
+     * @brief Opens a log file for append and writes a BOM if the file is empty.
+     *
+     * @param filename Log file name.
+     * @return Open file stream.
+     */
+    SLIMLOG_EXPORT static auto open_file(std::string_view filename) -> FilePtr;
+
     /**
      * @brief Writes a BOM (Byte Order Mark) to the log file.
      *
+     * @param fp Open file stream.
      * @return true if the BOM was written successfully, false otherwise.
      */
-    SLIMLOG_EXPORT auto write_bom() -> bool;
+    SLIMLOG_EXPORT static auto write_bom(FILE* fp) -> bool;
+
+    /**
+     * @brief Writes formatted data to the log file.
+     *
+     * @param fp Open file stream.
+     * @param data Pointer to the characters.
+     * @param size Number of characters.
+     */
+    SLIMLOG_EXPORT static auto write(FILE* fp, const Char* data, std::size_t size) -> void;
+
+    /**
+     * @brief Gets the underlying file stream.
+     *
+     * @return Open file stream.
+     */
+    [[nodiscard]] auto file() const noexcept -> FILE*
+    {
+        return m_fp.get();
+    }
+
+    /**
+     * @brief Replaces the underlying file stream.
+     *
+     * Not synchronized with message() and flush(), derived classes
+     * replacing the file are responsible for locking.
+     *
+     * @param fp New file stream.
+     * @return Previous file stream.
+     */
+    auto replace_file(FilePtr fp) noexcept -> FilePtr
+    {
+        std::swap(m_fp, fp);
+        return fp;
+    }
+
+    /**
+     * @brief Syncs the written record if required by the durability policy.
+     *
+     * Called by message() after writing the record.
+     *
+     * @param record The written log record.
+     */
+    SLIMLOG_EXPORT auto apply_durability(const RecordType& record) -> void;
+
+    /**
+     * @brief Waits until the flushed data of the current file reaches the storage device.
+     *
+     * Derived classes replacing the file override it to lock the file.
+     */
+    SLIMLOG_EXPORT virtual auto sync_file() -> void;
 
 private:
-    std::unique_ptr<FILE, int (*)(FILE*)> m_fp = {nullptr, nullptr};
+    FilePtr m_fp = {nullptr, nullptr};
+    // Durability policy, level is -1 if disabled
+    std::atomic<int> m_sync_level{-1};
+    std::atomic<std::int64_t> m_sync_interval{0};
+    std::atomic<std::int64_t> m_sync_deadline{0};
+    // Group commit state
+    std::mutex m_sync_mutex;
+    std::condition_variable m_sync_done;
+    std::uint64_t m_sync_requested = 0;
+    std::uint64_t m_sync_completed = 0;
+    bool m_syncing = false;
+    std::atomic<std::uint64_t> m_syncs{0};
 };
 } // namespace slimlog
 
@@ -0,0 +1,203 @@
+/**
+ * @file flight_recorder_sink-inl.h
+ * @brief Contains definition of FlightRecorderSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/flight_recorder_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/flight_recorder_sink.h" // IWYU pragma: associated
+#include "slimlog/format.h"
+#include "slimlog/threading.h"
+#include "slimlog/util/os.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace slimlog {
+
+template<typename Char, typename ThreadingPolicy>
+FlightRecorderSink<Char, ThreadingPolicy>::~FlightRecorderSink()
+{
+    if (m_data != nullptr) {
+        util::os::unmap_file(m_data, m_size);
+    }
+}
+
+template<typename Char, typename ThreadingPolicy>
+auto FlightRecorderSink<Char, ThreadingPolicy>::open(
+    std::string_view filename, std::size_t capacity) -> void
+{
+    using namespace detail::recorder;
+    m_capacity = (std::max(capacity, MinCapacity) + Alignment - 1) / Alignment * Alignment;
+    m_size = sizeof(FileHeader) + m_capacity;
+
+    const std::string name(filename);
+    // Create the file if it does not exist, then reopen it for reading as required by mapping
+    if (!util::os::fopen_shared(name.c_str(), "ab")) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Error opening log file");
+    }
+    m_fp = util::os::fopen_shared(name.c_str(), "r+b");
+    if (!m_fp) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Error opening log file");
+    }
+    m_fd = util::os::file_descriptor(m_fp.get());
+
+    // Continue the ring left by the previous run, so that its records are kept
+    FileHeader existing{};
+    std::error_code error;
+    const bool reuse = std::fread(&existing, sizeof(existing), 1, m_fp.get()) == 1
+        && existing.magic == Magic && existing.version == Version
+        && existing.char_size == sizeof(Char) && existing.capacity == m_capacity
+        && existing.write_index % Alignment == 0
+        && std::filesystem::file_size(name, error) == m_size;
+    if (!reuse && !util::os::resize_file(m_fd, 0)) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed truncating log file");
+    }
+    if (!util::os::resize_file(m_fd, m_size)) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed extending log file");
+    }
+    void* data = util::os::map_file(m_fd, 0, m_size);
+    if (data == nullptr) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed mapping log file");
+    }
+
+    m_data = static_cast<std::byte*>(data);
+    m_header = static_cast<FileHeader*>(data);
+    m_ring = m_data + sizeof(FileHeader); // NOLINT(*-pointer-arithmetic)
+    if (!reuse) {
+        m_header->magic = Magic;
+        m_header->version = Version;
+        m_header->char_size = sizeof(Char);
+        m_header->capacity = m_capacity;
+    }
+}
+
+template<typename Char, typename ThreadingPolicy>
+auto FlightRecorderSink<Char, ThreadingPolicy>::message(const RecordType& record) -> void
+{
+    using namespace detail::recorder;
+    std::basic_string_view<Char> message = record.message;
+    typename DeferredMessage<Char>::BufferType formatted;
+    if (record.deferred) [[unlikely]] {
+        record.deferred->format(formatted);
+        message = {formatted.data(), formatted.size()};
+    }
+
+    // Names take at most a quarter of the maximum record size, the message gets the rest
+    const auto max_size = m_capacity / 2;
+    const auto name_size = [limit = std::min<std::size_t>(max_size / 8, 0xFFFF)](
+                               std::size_t size, std::size_t unit) {
+        return std::min(size * unit, limit / unit * unit);
+    };
+    const auto category_size = name_size(record.category.size(), sizeof(Char));
+    const auto filename_size = name_size(record.filename.size(), 1);
+    const auto function_size = name_size(record.function.size(), 1);
+    const auto fixed = sizeof(RecordHeader) + category_size + filename_size + function_size;
+    const auto message_size = std::min(
+        message.size() * sizeof(Char), (max_size - fixed) / sizeof(Char) * sizeof(Char));
+    const auto size = fixed + message_size;
+    const auto padded = (size + Alignment - 1) / Alignment * Alignment;
+
+    RecordHeader header{};
+    header.position = reserve(padded);
+    header.seconds = record.time.first.time_since_epoch().count();
+    header.thread_id = record.thread_id;
+    header.nanoseconds = static_cast<std::uint32_t>(record.time.second);
+    header.line = static_cast<std::uint32_t>(record.line);
+    header.size = static_cast<std::uint32_t>(size);
+    header.message_size = static_cast<std::uint32_t>(message_size);
+    header.category_size = static_cast<std::uint16_t>(category_size);
+    header.filename_size = static_cast<std::uint16_t>(filename_size);
+    header.function_size = static_cast<std::uint16_t>(function_size);
+    header.level = static_cast<std::uint8_t>(record.level);
+
+    // NOLINTBEGIN(*-pointer-arithmetic)
+    // Invalidate the overwritten record before its space is reused
+    auto* word = m_ring + (header.position % m_capacity);
+    const std::atomic_ref<std::uint64_t> commit(
+        *reinterpret_cast<std::uint64_t*>(word)); // NOLINT(*-cast)
+    commit.store(0, std::memory_order_relaxed);
+
+    // Serialize the record directly into the ring
+    static constexpr std::array<std::byte, Alignment> Padding{};
+    auto position = header.position + sizeof(header.commit);
+    const auto append = [this, &position](const void* data, std::size_t count) {
+        copy(position, data, count);
+        position += count;
+    };
+    append(reinterpret_cast<const std::byte*>(&header) + sizeof(header.commit), // NOLINT(*-cast)
+           sizeof(header) - sizeof(header.commit));
+    append(record.category.data(), category_size);
+    append(message.data(), message_size);
+    append(record.filename.data(), filename_size);
+    append(record.function.data(), function_size);
+    append(Padding.data(), padded - size);
+    // NOLINTEND(*-pointer-arithmetic)
+
+    // Publish the record with its commit word once the rest is written
+    commit.store(
+        RecordMagic | (static_cast<std::uint64_t>(checksum(header.position, padded)) << 32),
+        std::memory_order_release);
+}
+
+template<typename Char, typename ThreadingPolicy>
+auto FlightRecorderSink<Char, ThreadingPolicy>::flush() -> void
+{
+    if (!util::os::sync_mapping(m_data, m_size)) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed flush to log file");
+    }
+}
+
+template<typename Char, typename ThreadingPolicy>
+auto FlightRecorderSink<Char, ThreadingPolicy>::reserve(std::size_t size) noexcept
+    -> std::uint64_t
+{
+    std::atomic_ref<std::uint64_t> index(m_header->write_index);
+    if constexpr (std::is_same_v<ThreadingPolicy, SingleThreadedPolicy>) {
+        const auto position = index.load(std::memory_order_relaxed);
+        index.store(position + size, std::memory_order_relaxed);
+        return position;
+    } else {
+        return index.fetch_add(size, std::memory_order_relaxed);
+    }
+}
+
+template<typename Char, typename ThreadingPolicy>
+auto FlightRecorderSink<Char, ThreadingPolicy>::copy(
+    std::uint64_t position, const void* data, std::size_t size) noexcept -> void
+{
+    const auto offset = static_cast<std::size_t>(position % m_capacity);
+    const auto first = std::min(size, m_capacity - offset);
+    // NOLINTBEGIN(*-pointer-arithmetic)
+    std::memcpy(m_ring + offset, data, first);
+    std::memcpy(m_ring, static_cast<const std::byte*>(data) + first, size - first);
+    // NOLINTEND(*-pointer-arithmetic)
+}
+
+template<typename Char, typename ThreadingPolicy>
+auto FlightRecorderSink<Char, ThreadingPolicy>::checksum(
+    std::uint64_t position, std::size_t size) const noexcept -> std::uint32_t
+{
+    // Records are aligned to whole words, so no word wraps around the ring
+    detail::recorder::Checksum hash(size);
+    hash.update(0);
+    for (std::size_t i = sizeof(std::uint64_t); i < size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word = 0;
+        // NOLINTNEXTLINE(*-pointer-arithmetic)
+        std::memcpy(&word, m_ring + ((position + i) % m_capacity), sizeof(word));
+        hash.update(word);
+    }
+    return hash.value();
+}
+
+} // namespace slimlog
@@ -0,0 +1,417 @@
+/**
+ * @file flight_recorder_sink.h
+ * @brief Contains declaration of FlightRecorderSink and FlightRecorderReader classes.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/sink.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace slimlog {
+
+namespace detail {
+
+/** @brief Layout of the flight recorder file. */
+namespace recorder {
+
+/** @brief File signature. */
+inline constexpr std::array<char, 8> Magic = {'S', 'L', 'I', 'M', 'R', 'I', 'N', 'G'};
+/** @brief Format version. */
+inline constexpr std::uint32_t Version = 1;
+/** @brief Marker of a committed record, the checksum is stored in the upper half. */
+inline constexpr std::uint32_t RecordMagic = 0x52434C53; // "SLCR"
+/** @brief Alignment of the records in the ring. */
+inline constexpr std::size_t Alignment = 8;
+
+/** @brief File header, followed by the ring. */
+struct FileHeader {
+    std::array<char, 8> magic; ///< File signature.
+    std::uint32_t version; ///< Format version.
+    std::uint32_t char_size; ///< Size of the character type of the strings.
+    std::uint64_t capacity; ///< Size of the ring in bytes.
+    std::uint64_t write_index; ///< Number of bytes reserved since creation.
+    std::array<std::uint64_t, 4> reserved; ///< Padding to 64 bytes.
+};
+static_assert(sizeof(FileHeader) == 64);
+
+/**
+ * @brief Record header, followed by category and message, then file and function names.
+ *
+ * The commit word is stored last, so a record being copied is never
+ * considered complete.
+ */
+struct RecordHeader {
+    std::uint64_t commit; ///< RecordMagic and the checksum of the record.
+    std::uint64_t position; ///< Position of the record in the stream of reserved bytes.
+    std::int64_t seconds; ///< Timestamp seconds.
+    std::uint64_t thread_id; ///< Thread ID.
+    std::uint32_t nanoseconds; ///< Timestamp nanoseconds.
+    std::uint32_t line; ///< Line number.
+    std::uint32_t size; ///< Size of the record with the strings, without padding.
+    std::uint32_t message_size; ///< Message size in bytes.
+    std::uint16_t category_size; ///< Category size in bytes.
+    std::uint16_t filename_size; ///< File name size in bytes.
+    std::uint16_t function_size; ///< Function name size in bytes.
+    std::uint8_t level; ///< Log level.
+    std::uint8_t reserved; ///< Padding.
+};
+static_assert(sizeof(RecordHeader) == 56);
+
+/**
+ * @brief Checksum of a record computed word by word.
+ */
+class Checksum {
+public:
+    /**
+     * @brief Starts the checksum of a record.
+     *
+     * @param size Padded size of the record.
+     */
+    explicit Checksum(std::size_t size) noexcept
+        : m_hash(0x9E3779B97F4A7C15ULL ^ size)
+    {
+    }
+
+    /**
+     * @brief Adds the next 64-bit word of the record.
+     *
+     * @param word Record word.
+     */
+    auto update(std::uint64_t word) noexcept -> void
+    {
+        m_hash = (m_hash ^ word) * 0xBF58476D1CE4E5B9ULL;
+        m_hash ^= m_hash >> 29;
+    }
+
+    /**
+     * @brief Gets the checksum of the added words.
+     *
+     * @return Checksum value.
+     */
+    [[nodiscard]] auto value() const noexcept -> std::uint32_t
+    {
+        return static_cast<std::uint32_t>(m_hash ^ (m_hash >> 32));
+    }
+
+private:
+    std::uint64_t m_hash;
+};
+
+/**
+ * @brief Computes the checksum of a record.
+ *
+ * Processes whole 64-bit words, the record is padded with zeros to the alignment.
+ *
+ * @param data Record with the zeroed commit word.
+ * @param size Padded size of the record.
+ * @return Checksum value.
+ */
+[[nodiscard]] inline auto checksum(const std::byte* data, std::size_t size) noexcept
+    -> std::uint32_t
+{
+    Checksum hash(size);
+    for (std::size_t i = 0; i < size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data + i, sizeof(word)); // NOLINT(*-pointer-arithmetic)
+        hash.update(word);
+    }
+    return hash.value();
+}
+
+} // namespace recorder
+} // namespace detail
+
+/**
+ * @brief Crash-surviving ring of log records in a memory-mapped file.
+ *
+ * Records are stored unformatted (level, time, thread, location, category
+ * and message) in a ring mapped with `MAP_SHARED` from a file. A writer reserves
+ * space with a single atomic addition to the write index in the file header,
+ * serializes the record directly into it and publishes it with a checksum. Nothing is buffered
+ * in the process: once copied, a record is in the page cache and survives
+ * a crash of the process, and the ring keeps the most recent records.
+ *
+ * The records are read back with FlightRecorderReader, or with the `slimlog_recover`
+ * tool, and formatted with any Pattern. Reopening an existing ring of the same
+ * size continues after its last record.
+ *
+ * Messages which do not fit into half of the ring are truncated.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for sink operations.
+ */
+template<typename Char, typename ThreadingPolicy = DefaultThreadingPolicy>
+class FlightRecorderSink : public Sink<Char> {
+public:
+    using typename Sink<Char>::RecordType;
+
+    /** @brief Default size of the ring in bytes. */
+    static constexpr std::size_t DefaultCapacity = std::size_t{4} * 1024 * 1024;
+    /** @brief Minimum size of the ring in bytes. */
+    static constexpr std::size_t MinCapacity = 4096;
+
+    /**
+     * @brief Constructs a new FlightRecorderSink object.
+     *
+     * @param filename Path to the ring file.
+     * @param capacity Size of the ring in bytes (rounded up to the record alignment).
+     */
+    explicit FlightRecorderSink(std::string_view filename, std::size_t capacity = DefaultCapacity)
+    {
+        open(filename, capacity);
+    }
+
+    /**
+     * @brief Unmaps the ring.
+     */
+    SLIMLOG_EXPORT ~FlightRecorderSink() override;
+
+    FlightRecorderSink(const FlightRecorderSink&) = delete;
+    FlightRecorderSink(FlightRecorderSink&&) = delete;
+    auto operator=(const FlightRecorderSink&) -> FlightRecorderSink& = delete;
+    auto operator=(FlightRecorderSink&&) -> FlightRecorderSink& = delete;
+
+    /**
+     * @brief Copies the log record into the ring.
+     *
+     * @param record The log record to process.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Schedules writing the ring to disk.
+     *
+     * Not needed to survive a crash of the process, only of the system.
+     */
+    SLIMLOG_EXPORT auto flush() -> void override;
+
+    /**
+     * @brief Gets the size of the ring.
+     *
+     * @return Capacity in bytes.
+     */
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t
+    {
+        return m_capacity;
+    }
+
+private:
+    using FileHeader = detail::recorder::FileHeader;
+    using RecordHeader = detail::recorder::RecordHeader;
+
+    /** @brief Opens and maps the file, reusing a compatible ring. */
+    SLIMLOG_EXPORT auto open(std::string_view filename, std::size_t capacity) -> void;
+    /** @brief Reserves space in the ring and returns its position. */
+    auto reserve(std::size_t size) noexcept -> std::uint64_t;
+    /** @brief Copies data to the ring at the position, wrapping around. */
+    auto copy(std::uint64_t position, const void* data, std::size_t size) noexcept -> void;
+    /** @brief Computes the checksum of the record at the position, with a zero commit word. */
+    [[nodiscard]] auto checksum(std::uint64_t position, std::size_t size) const noexcept
+        -> std::uint32_t;
+
+    std::unique_ptr<FILE, int (*)(FILE*)> m_fp = {nullptr, nullptr};
+    int m_fd = -1;
+    std::byte* m_data = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_capacity = 0;
+    FileHeader* m_header = nullptr;
+    std::byte* m_ring = nullptr;
+};
+
+/**
+ * @brief Reader of the records of a FlightRecorderSink file.
+ *
+ * Usage example:
+ * ```cpp
+ * Log::FlightRecorderReader reader("app.ring");
+ * Log::Pattern<char> pattern("{time} [{level}] {category}: {message}");
+ * reader.read<char>([&](const Log::Record<char>& record) {
+ *     Log::FormatBuffer<char, 1024> buffer;
+ *     pattern.format(buffer, record);
+ *     std::cout << std::string_view(buffer.data(), buffer.size()) << '\n';
+ * });
+ * ```
+ */
+class FlightRecorderReader final {
+public:
+    /**
+     * @brief Loads the ring from the file.
+     *
+     * The file may belong to a process which crashed or is still running.
+     *
+     * @param path Path to the ring file.
+     * @throws std::runtime_error if the file cannot be read or is not a ring file.
+     */
+    explicit FlightRecorderReader(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Error opening ring file " + path.string());
+        }
+        file.seekg(0, std::ios::end);
+        m_data.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(
+            reinterpret_cast<char*>(m_data.data()), // NOLINT(*-reinterpret-cast)
+            static_cast<std::streamsize>(m_data.size()));
+        if (!file) {
+            throw std::runtime_error("Error reading ring file " + path.string());
+        }
+        if (m_data.size() < sizeof(FileHeader)) {
+            throw std::runtime_error("Not a ring file: " + path.string());
+        }
+        std::memcpy(&m_header, m_data.data(), sizeof(m_header));
+        if (m_header.magic != detail::recorder::Magic
+            || m_header.version != detail::recorder::Version
+            || m_header.capacity % detail::recorder::Alignment != 0
+            || m_header.capacity > m_data.size() - sizeof(FileHeader)) {
+            throw std::runtime_error("Not a ring file: " + path.string());
+        }
+    }
+
+    /**
+     * @brief Gets the size of the character type the ring was written with.
+     *
+     * @return Character size in bytes.
+     */
+    [[nodiscard]] auto char_size() const noexcept -> std::size_t
+    {
+        return m_header.char_size;
+    }
+
+    /**
+     * @brief Reads the complete records in the order they were reserved.
+     *
+     * Overwritten, partially written and corrupted records are skipped.
+     *
+     * @tparam Char Character type of the ring.
+     * @tparam Func Callback type, invocable with `const Record<Char>&`.
+     * @param callback Callback invoked for each record.
+     * @return Number of records read.
+     * @throws std::invalid_argument if the ring was written with another character size.
+     */
+    template<typename Char, typename Func>
+    auto read(Func&& callback) const -> std::size_t
+    {
+        if (sizeof(Char) != m_header.char_size) {
+            throw std::invalid_argument("Ring was written with another character type");
+        }
+
+        const auto capacity = m_header.capacity;
+        const auto end = m_header.write_index;
+        std::uint64_t position = end > capacity ? end - capacity : 0;
+        position -= position % detail::recorder::Alignment;
+        std::size_t count = 0;
+        std::vector<std::byte> buffer;
+        while (position + sizeof(RecordHeader) <= end) {
+            const auto size = parse(position, end, buffer);
+            if (size == 0) {
+                position += detail::recorder::Alignment;
+                continue;
+            }
+
+            RecordHeader header{};
+            std::memcpy(&header, buffer.data(), sizeof(header));
+            const auto string = [&buffer](std::size_t offset, std::size_t size) {
+                std::basic_string<Char> result(size / sizeof(Char), Char{});
+                // NOLINTNEXTLINE(*-pointer-arithmetic)
+                std::memcpy(result.data(), buffer.data() + offset, result.size() * sizeof(Char));
+                return result;
+            };
+            auto offset = sizeof(header);
+            const auto category = string(offset, header.category_size);
+            offset += header.category_size;
+            const auto message = string(offset, header.message_size);
+            offset += header.message_size;
+            // NOLINTBEGIN(*-reinterpret-cast,*-pointer-arithmetic)
+            const std::string filename(
+                reinterpret_cast<const char*>(buffer.data() + offset), header.filename_size);
+            offset += header.filename_size;
+            const std::string function(
+                reinterpret_cast<const char*>(buffer.data() + offset), header.function_size);
+            // NOLINTEND(*-reinterpret-cast,*-pointer-arithmetic)
+
+            const Record<Char> record{
+                CachedStringView<Char>{std::basic_string_view<Char>{message}},
+                CachedStringView<Char>{std::basic_string_view<Char>{category}},
+                CachedStringView<char>{std::string_view{filename}},
+                CachedStringView<char>{std::string_view{function}},
+                header.line,
+                static_cast<Level>(header.level),
+                {std::chrono::sys_seconds{std::chrono::seconds{header.seconds}},
+                 header.nanoseconds},
+                static_cast<std::size_t>(header.thread_id)};
+            callback(record);
+            ++count;
+            position += size;
+        }
+        return count;
+    }
+
+private:
+    using FileHeader = detail::recorder::FileHeader;
+    using RecordHeader = detail::recorder::RecordHeader;
+
+    /** @brief Copies data from the ring at the position, wrapping around. */
+    auto copy(std::uint64_t position, std::byte* data, std::size_t size) const noexcept -> void
+    {
+        const auto* ring = m_data.data() + sizeof(FileHeader); // NOLINT(*-pointer-arithmetic)
+        const auto offset = static_cast<std::size_t>(position % m_header.capacity);
+        const auto first = std::min<std::size_t>(size, m_header.capacity - offset);
+        std::memcpy(data, ring + offset, first); // NOLINT(*-pointer-arithmetic)
+        std::memcpy(data + first, ring, size - first); // NOLINT(*-pointer-arithmetic)
+    }
+
+    /** @brief Copies a valid record at the position, returns its padded size or zero. */
+    auto parse(std::uint64_t position, std::uint64_t end, std::vector<std::byte>& buffer) const
+        -> std::size_t
+    {
+        using namespace detail::recorder;
+        RecordHeader header{};
+        copy(position, reinterpret_cast<std::byte*>(&header), sizeof(header)); // NOLINT(*-cast)
+        if (static_cast<std::uint32_t>(header.commit) != RecordMagic
+            || header.position != position || header.size < sizeof(header)
+            || sizeof(header) + header.category_size + header.message_size
+                    + header.filename_size + header.function_size
+                != header.size) {
+            return 0;
+        }
+        const auto size = (std::size_t{header.size} + Alignment - 1) / Alignment * Alignment;
+        if (size > end - position) {
+            return 0;
+        }
+
+        buffer.resize(size);
+        copy(position, buffer.data(), size);
+        std::memset(buffer.data(), 0, sizeof(header.commit));
+        if (checksum(buffer.data(), size) != static_cast<std::uint32_t>(header.commit >> 32)) {
+            return 0;
+        }
+        return size;
+    }
+
+    std::vector<std::byte> m_data;
+    FileHeader m_header{};
+};
+
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/flight_recorder_sink-inl.h" // IWYU pragma: keep
+#endif
@@ -0,0 +1,236 @@
+/**
+ * @file io_uring_file_sink-inl.h
+ * @brief Contains definition of IoUringFileSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/io_uring_file_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/io_uring_file_sink.h" // IWYU pragma: associated
+#include "slimlog/util/os.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+namespace slimlog {
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+IoUringFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::~IoUringFileSink()
+{
+    try {
+        flush();
+    } catch (...) { // NOLINT(bugprone-empty-catch)
+        // Destructor must not throw, failed lines are lost
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto IoUringFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::init(std::string_view filename)
+    -> void
+{
+    m_options.queue_depth = std::max(m_options.queue_depth, 1U);
+    m_options.buffer_size
+        = ((std::max(m_options.buffer_size, std::size_t{1}) + Alignment - 1) / Alignment)
+        * Alignment;
+    if (!m_ring.init(m_options.queue_depth)) {
+        // Fall back to FileSink
+        return;
+    }
+
+    // BOM is written by FileSink to the stdio buffer, it must precede our writes
+    if (std::fflush(this->file()) != 0) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed flush to log file");
+    }
+    // Requests complete out of order, so each one writes at its own offset.
+    // That does not work with the append mode of FileSink, reopen the file without it.
+    const std::string name(filename);
+    m_fp = util::os::fopen_shared(name.c_str(), "r+b");
+    if (!m_fp) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Error opening log file");
+    }
+    m_fd = util::os::file_descriptor(m_fp.get());
+    std::error_code error;
+    m_offset = std::filesystem::file_size(name, error);
+    if (error) [[unlikely]] {
+        throw std::system_error(error, "Error getting log file size");
+    }
+
+    m_buffers.resize(m_options.buffer_size * m_options.queue_depth);
+    m_slots.resize(m_options.queue_depth);
+
+    if (m_options.register_buffers) {
+        std::vector<util::IoUring::Buffer> buffers;
+        buffers.reserve(m_slots.size());
+        for (std::size_t i = 0; i < m_slots.size(); ++i) {
+            buffers.push_back({buffer(i), m_options.buffer_size});
+        }
+        m_fixed_buffers = m_ring.register_buffers(buffers);
+    }
+    if (m_options.register_file) {
+        m_fixed_file = m_ring.register_file(m_fd);
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto IoUringFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::message(
+    const RecordType& record) -> void
+{
+    if (!m_ring.valid()) {
+        FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::message(record);
+        return;
+    }
+
+    FormatBufferType buffer;
+    this->format(buffer, record);
+    buffer.push_back(static_cast<Char>('\n'));
+
+    {
+        const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+        // NOLINTNEXTLINE(*-reinterpret-cast)
+        append(reinterpret_cast<const std::byte*>(buffer.data()), buffer.size() * sizeof(Char));
+    }
+    this->apply_durability(record);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto IoUringFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::flush() -> void
+{
+    if (!m_ring.valid()) {
+        FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::flush();
+        return;
+    }
+
+    const typename ThreadingPolicy::template UniqueLock<decltype(m_mutex)> lock(m_mutex);
+    auto& slot = m_slots[m_current];
+    if (slot.size > 0 && !slot.busy) {
+        queue(m_current);
+        m_current = (m_current + 1) % m_slots.size();
+    }
+    while (m_inflight > 0) {
+        submit(1);
+        reap();
+    }
+    check();
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto IoUringFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::append(
+    const std::byte* data, std::size_t size) -> void
+{
+    while (size > 0) {
+        auto& slot = m_slots[m_current];
+        while (slot.busy) {
+            // All buffers are in flight, wait for the oldest one
+            reap();
+            if (slot.busy) {
+                submit(1);
+            }
+        }
+
+        if (slot.size == 0) {
+            slot.offset = m_offset;
+        }
+        const auto count = std::min(size, m_options.buffer_size - slot.size);
+        std::memcpy(buffer(m_current) + slot.size, data, count);
+        slot.size += count;
+        m_offset += count;
+        data += count; // NOLINT(*-pointer-arithmetic)
+        size -= count;
+
+        if (slot.size == m_options.buffer_size) {
+            queue(m_current);
+            submit(0);
+            m_current = (m_current + 1) % m_slots.size();
+        }
+    }
+    reap();
+    check();
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto IoUringFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::queue(std::size_t index)
+    -> void
+{
+    auto& slot = m_slots[index];
+    while (!m_ring.prepare_write(
+        m_fixed_file ? -1 : m_fd,
+        buffer(index) + slot.written,
+        slot.size - slot.written,
+        slot.offset + slot.written,
+        index,
+        m_fixed_buffers ? static_cast<int>(index) : -1)) {
+        // Submission queue is full with requeued writes
+        submit(0);
+    }
+    slot.busy = true;
+    ++m_inflight;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto IoUringFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::submit(unsigned wait) -> void
+{
+    int result = 0;
+    do {
+        result = m_ring.submit(wait);
+        m_syscalls.fetch_add(1, std::memory_order_relaxed);
+    } while (result == -EINTR);
+    if (result < 0) [[unlikely]] {
+        throw std::system_error({-result, std::system_category()}, "Failed submitting writes");
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto IoUringFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::reap() -> void
+{
+    m_ring.reap([this](std::uint64_t index, int result) {
+        auto& slot = m_slots[index];
+        slot.busy = false;
+        --m_inflight;
+        if (result == -EAGAIN || result == -EINTR) {
+            queue(index);
+            return;
+        }
+        if (result <= 0) [[unlikely]] {
+            // Zero-length write would never make progress
+            m_error = result < 0 ? -result : EIO;
+        } else {
+            m_bytes.fetch_add(static_cast<std::uint64_t>(result), std::memory_order_relaxed);
+            slot.written += static_cast<std::size_t>(result);
+            if (slot.written < slot.size) {
+                // Short write, queue the rest
+                queue(index);
+                return;
+            }
+        }
+        slot.size = 0;
+        slot.written = 0;
+    });
+    if (m_ring.queued() > 0) {
+        submit(0);
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto IoUringFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::check() -> void
+{
+    if (m_error != 0) [[unlikely]] {
+        const auto error = std::exchange(m_error, 0);
+        throw std::system_error({error, std::system_category()}, "Failed writing to log file");
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto IoUringFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::buffer(
+    std::size_t index) noexcept -> std::byte*
+{
+    return m_buffers.data() + (index * m_options.buffer_size); // NOLINT(*-pointer-arithmetic)
+}
+
+} // namespace slimlog
@@ -0,0 +1,204 @@
+/**
+ * @file io_uring_file_sink.h
+ * @brief Contains declaration of IoUringFileSink class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/sinks/file_sink.h"
+#include "slimlog/util/buffer.h"
+#include "slimlog/util/io_uring.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace slimlog {
+
+/**
+ * @brief Parameters of the io_uring submission in IoUringFileSink.
+ */
+struct IoUringFileOptions {
+    unsigned queue_depth = 32; ///< Number of buffers, the maximum of writes in flight.
+    std::size_t buffer_size = std::size_t{64} * 1024; ///< Size of each buffer in bytes.
+    bool register_buffers = true; ///< Register the buffers with the kernel once.
+    bool register_file = true; ///< Register the file descriptor with the kernel once.
+};
+
+/**
+ * @brief File sink submitting writes asynchronously through io_uring.
+ *
+ * Lines are collected in a ring of aligned buffers. A full buffer is queued
+ * as a write request at its own file offset and submitted without waiting,
+ * so the calling thread does not block in `write()` while the kernel copies
+ * the data, and the next buffer is filled meanwhile. Completions are consumed
+ * in batches from the completion ring without a system call. A writer waits
+ * only if all buffers are still in flight.
+ *
+ * Buffers and the file descriptor are registered with the kernel if possible,
+ * which avoids pinning the pages and looking up the file on every request.
+ *
+ * If io_uring is not available at runtime (non-Linux system, old kernel,
+ * or disabled by the administrator), the sink behaves like FileSink.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for sink operations.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename Char,
+    typename ThreadingPolicy = DefaultThreadingPolicy,
+    std::size_t BufferSize = DefaultSinkBufferSize,
+    typename Allocator = std::allocator<Char>>
+class IoUringFileSink : public FileSink<Char, ThreadingPolicy, BufferSize, Allocator> {
+public:
+    using typename FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::RecordType;
+    using typename FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::FormatBufferType;
+
+    /** @brief Alignment of the buffers in bytes. */
+    static constexpr std::size_t Alignment = 4096;
+
+    /**
+     * @brief Write statistics.
+     */
+    struct Stats {
+        std::uint64_t syscalls = 0; ///< Number of `io_uring_enter()` system calls issued.
+        std::uint64_t bytes = 0; ///< Number of bytes written.
+
+        /**
+         * @brief Gets the average number of bytes per system call.
+         *
+         * @return Bytes per system call, zero if nothing was written.
+         */
+        [[nodiscard]] auto bytes_per_syscall() const noexcept -> double
+        {
+            return syscalls > 0 ? static_cast<double>(bytes) / static_cast<double>(syscalls)
+                                : 0.0;
+        }
+    };
+
+    /**
+     * @brief Constructs a new IoUringFileSink object.
+     *
+     * @tparam Args Argument types for the pattern and log levels.
+     * @param filename Path to the log file.
+     * @param options Submission parameters.
+     * @param args Optional pattern and list of log levels.
+     */
+    template<typename... Args>
+    IoUringFileSink(std::string_view filename, IoUringFileOptions options, Args&&... args)
+        : FileSink<Char, ThreadingPolicy, BufferSize, Allocator>(
+              filename, std::forward<Args>(args)...)
+        , m_options(options)
+    {
+        init(filename);
+    }
+
+    /**
+     * @brief Constructs a new IoUringFileSink object with default submission parameters.
+     *
+     * @param filename Path to the log file.
+     */
+    explicit IoUringFileSink(std::string_view filename)
+        : IoUringFileSink(filename, IoUringFileOptions{})
+    {
+    }
+
+    /**
+     * @brief Waits for the writes in flight and destroys the sink.
+     */
+    SLIMLOG_EXPORT ~IoUringFileSink() override;
+
+    IoUringFileSink(const IoUringFileSink&) = delete;
+    IoUringFileSink(IoUringFileSink&&) = delete;
+    auto operator=(const IoUringFileSink&) -> IoUringFileSink& = delete;
+    auto operator=(IoUringFileSink&&) -> IoUringFileSink& = delete;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Formats the log record and appends it to the current buffer.
+     *
+     * @param record The log record to process.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Submits the current buffer and waits for all writes in flight.
+     */
+    SLIMLOG_EXPORT auto flush() -> void override;
+
+    /**
+     * @brief Checks if the writes go through io_uring.
+     *
+     * @return \b false if the sink fell back to FileSink.
+     */
+    [[nodiscard]] auto active() const noexcept -> bool
+    {
+        return m_ring.valid();
+    }
+
+    /**
+     * @brief Gets the write statistics.
+     *
+     * @return Number of issued system calls and written bytes.
+     */
+    [[nodiscard]] auto stats() const noexcept -> Stats
+    {
+        return {
+            m_syscalls.load(std::memory_order_relaxed), m_bytes.load(std::memory_order_relaxed)};
+    }
+
+private:
+    using typename FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::FilePtr;
+
+    /** @brief State of a buffer. */
+    struct Slot {
+        std::uint64_t offset = 0; ///< File offset of the buffer.
+        std::size_t size = 0; ///< Number of bytes to write.
+        std::size_t written = 0; ///< Number of bytes written so far.
+        bool busy = false; ///< Write is in flight.
+    };
+
+    /** @brief Creates the ring, opens the file for positioned writes and registers resources. */
+    SLIMLOG_EXPORT auto init(std::string_view filename) -> void;
+    /** @brief Copies data to the buffers, submitting the full ones. */
+    auto append(const std::byte* data, std::size_t size) -> void;
+    /** @brief Queues the write of the remaining part of the buffer. */
+    auto queue(std::size_t index) -> void;
+    /** @brief Submits queued writes and waits for the given number of completions. */
+    auto submit(unsigned wait) -> void;
+    /** @brief Processes available completions. */
+    auto reap() -> void;
+    /** @brief Throws the error of a failed write, if any. */
+    auto check() -> void;
+    /** @brief Gets the pointer to the buffer. */
+    auto buffer(std::size_t index) noexcept -> std::byte*;
+
+    IoUringFileOptions m_options;
+    FilePtr m_fp = {nullptr, nullptr};
+    int m_fd = -1;
+    std::vector<std::byte, util::AlignedAllocator<std::byte, Alignment>> m_buffers;
+    std::vector<Slot> m_slots;
+    std::size_t m_current = 0;
+    std::uint64_t m_offset = 0;
+    unsigned m_inflight = 0;
+    int m_error = 0;
+    bool m_fixed_buffers = false;
+    bool m_fixed_file = false;
+    typename ThreadingPolicy::Mutex m_mutex;
+    std::atomic<std::uint64_t> m_syscalls{0};
+    std::atomic<std::uint64_t> m_bytes{0};
+    util::IoUring m_ring;
+};
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/io_uring_file_sink-inl.h" // IWYU pragma: keep
+#endif
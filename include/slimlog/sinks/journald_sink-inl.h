@@ -0,0 +1,197 @@
+/**
+ * @file journald_sink-inl.h
+ * @brief Contains definition of JournaldSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/journald_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/journald_sink.h" // IWYU pragma: associated
+#include "slimlog/util/os.h"
+#include "slimlog/util/unicode.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace slimlog {
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto JournaldSink<Char, ThreadingPolicy, BufferSize, Allocator>::message(const RecordType& record)
+    -> void
+{
+    FormatBufferType buffer;
+    this->format(buffer, record);
+
+    std::string_view text;
+    std::string_view category;
+    if constexpr (sizeof(Char) == 1) {
+        const std::basic_string_view<Char> category_view = record.category;
+        // NOLINTBEGIN(*-reinterpret-cast)
+        text = {reinterpret_cast<const char*>(buffer.data()), buffer.size()};
+        category = {reinterpret_cast<const char*>(category_view.data()), category_view.size()};
+        // NOLINTEND(*-reinterpret-cast)
+    } else {
+        // Reused by the records of the thread, so the conversion does not allocate
+        thread_local std::string utf8_text;
+        thread_local std::string utf8_category;
+        utf8_text.clear();
+        utf8_category.clear();
+        util::unicode::append_utf8(utf8_text, buffer.data(), buffer.size());
+        util::unicode::append_utf8(utf8_category, record.category.data(), record.category.size());
+        text = utf8_text;
+        category = utf8_category;
+    }
+
+    // Writes the name of a field following the previous value, values spanning
+    // several lines are preceded by their size as 64-bit little endian instead of '='
+    const auto field_name = [](std::span<char> out, std::string_view name, std::string_view value) {
+        std::size_t pos = 0;
+        out[pos++] = '\n';
+        pos += name.copy(out.subspan(pos).data(), name.size());
+        if (value.find('\n') == std::string_view::npos) {
+            out[pos++] = '=';
+            return pos;
+        }
+        out[pos++] = '\n';
+        auto size = static_cast<std::uint64_t>(value.size());
+        for (int i = 0; i < 8; ++i, size >>= 8U) {
+            out[pos++] = static_cast<char>(size & 0xFFU);
+        }
+        return pos;
+    };
+    std::array<char, MaxFieldName + 10> category_name; // NOLINT(*-member-init)
+    std::array<char, 18> message_name; // NOLINT(*-member-init)
+    const auto category_size = field_name(category_name, m_category_field, category);
+    const auto message_size = field_name(message_name, "MESSAGE", text);
+
+    // Line and thread ID between the file and function values
+    static constexpr std::string_view LineField = "\nCODE_LINE=";
+    static constexpr std::string_view ThreadField = "\nTID=";
+    static constexpr std::string_view FunctionField = "\nCODE_FUNC=";
+    std::array<char, 80> numbers; // NOLINT(*-member-init)
+    auto* const end = numbers.data() + numbers.size(); // NOLINT(*-pointer-arithmetic)
+    auto* ptr = std::ranges::copy(LineField, numbers.data()).out;
+    ptr = std::to_chars(ptr, end, record.line).ptr;
+    ptr = std::ranges::copy(ThreadField, ptr).out;
+    ptr = std::to_chars(ptr, end, record.thread_id).ptr;
+    ptr = std::ranges::copy(FunctionField, ptr).out;
+
+    const auto& prefix = m_prefixes.at(static_cast<std::size_t>(record.level));
+    const std::string_view filename = record.filename;
+    const std::string_view function = record.function;
+    const std::array<util::os::WriteBuffer, 9> buffers{{
+        {prefix.data(), prefix.size()},
+        {filename.data(), filename.size()},
+        {numbers.data(), static_cast<std::size_t>(ptr - numbers.data())},
+        {function.data(), function.size()},
+        {category_name.data(), category_size},
+        {category.data(), category.size()},
+        {message_name.data(), message_size},
+        {text.data(), text.size()},
+        {"\n", 1},
+    }};
+    auto result = m_socket.send(buffers);
+    if (result < 0 && (errno == ECONNREFUSED || errno == ENOTCONN) && m_socket.reconnect())
+        [[unlikely]] {
+        result = m_socket.send(buffers);
+    }
+    if (result < 0 && (errno == EMSGSIZE || errno == ENOBUFS)) {
+        result = send_memory_file(buffers);
+    }
+
+    if (result < 0) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed sending to journald");
+    }
+    m_syscalls.fetch_add(1, std::memory_order_relaxed);
+    m_bytes.fetch_add(static_cast<std::uint64_t>(result), std::memory_order_relaxed);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto JournaldSink<Char, ThreadingPolicy, BufferSize, Allocator>::open(
+    const JournaldOptions& options) -> void
+{
+    // Field names are upper case letters, digits and underscores, not starting with a digit
+    // or an underscore, which are reserved for the fields added by journald
+    const auto& name = options.category_field;
+    if (name.empty() || name.size() > MaxFieldName || name.front() == '_'
+        || (name.front() >= '0' && name.front() <= '9')
+        || !std::ranges::all_of(name, [](char chr) {
+               return (chr >= 'A' && chr <= 'Z') || (chr >= '0' && chr <= '9') || chr == '_';
+           })) {
+        throw std::invalid_argument("Invalid journal field name: " + name);
+    }
+    m_category_field = name;
+
+    // Severities of the levels from Fatal to Trace
+    static constexpr std::array<char, 6> Severities{'2', '3', '4', '6', '7', '7'};
+    auto identifier = options.identifier.empty() ? util::os::program_name() : options.identifier;
+    std::ranges::replace(identifier, '\n', ' ');
+    for (std::size_t i = 0; i < m_prefixes.size(); ++i) {
+        m_prefixes.at(i) = std::string("PRIORITY=") + Severities.at(i) + "\nSYSLOG_IDENTIFIER="
+            + identifier + "\nCODE_FILE=";
+    }
+
+    if (!m_socket.connect(options.path, util::UnixSocket::Type::Datagram, false)) {
+        throw std::system_error({errno, std::system_category()}, "Error connecting to journald");
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto JournaldSink<Char, ThreadingPolicy, BufferSize, Allocator>::send_memory_file(
+    std::span<const util::os::WriteBuffer> buffers) -> std::ptrdiff_t
+{
+    const int fd = util::os::create_memory_file("slimlog-journal");
+    if (fd < 0) {
+        return -1;
+    }
+
+    std::array<util::os::WriteBuffer, util::UnixSocket::MaxBuffers> pending{};
+    const auto count = std::min(buffers.size(), pending.size());
+    std::ranges::copy(buffers.first(count), pending.begin());
+    std::ptrdiff_t total = 0;
+    bool written = true;
+    for (std::size_t first = 0; first < count;) {
+        const auto result
+            = util::os::write_vector(fd, std::span(pending).subspan(first, count - first));
+        if (result < 0) {
+            written = false;
+            break;
+        }
+        total += result;
+        // Skip the buffers written completely and the written part of the next one
+        auto remaining = static_cast<std::size_t>(result);
+        for (; first < count && remaining >= pending.at(first).size; ++first) {
+            remaining -= pending.at(first).size;
+        }
+        if (first < count) {
+            auto& next = pending.at(first);
+            next.data = static_cast<const char*>(next.data) + remaining; // NOLINT(*-arithmetic)
+            next.size -= remaining;
+        }
+    }
+
+    // Journald only accepts files which cannot change any more
+    const bool sent
+        = written && util::os::seal_memory_file(fd) && m_socket.send_descriptor(fd) >= 0;
+    const int error = errno;
+    util::os::close_file(fd);
+    if (!sent) {
+        errno = error;
+        return -1;
+    }
+    m_memory_files.fetch_add(1, std::memory_order_relaxed);
+    return total;
+}
+
+} // namespace slimlog
@@ -0,0 +1,158 @@
+/**
+ * @file journald_sink.h
+ * @brief Contains declaration of JournaldSink class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/sink.h"
+#include "slimlog/util/os.h"
+#include "slimlog/util/socket.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace slimlog {
+
+/**
+ * @brief Parameters of the journal entries of JournaldSink.
+ */
+struct JournaldOptions {
+    std::string path = "/run/systemd/journal/socket"; ///< Path of the journal socket.
+    std::string identifier; ///< `SYSLOG_IDENTIFIER` field, empty for the program name.
+    std::string category_field = "CATEGORY"; ///< Name of the field with the category.
+};
+
+/**
+ * @brief Sink sending records to the systemd journal with its native protocol.
+ *
+ * Each record is sent as a datagram of fields, so journald stores them
+ * without parsing text:
+ * - `MESSAGE`: record formatted with the pattern of the sink;
+ * - `PRIORITY`: syslog severity of the level;
+ * - `SYSLOG_IDENTIFIER`, `CODE_FILE`, `CODE_LINE`, `CODE_FUNC` and `TID`;
+ * - the category, in the field named by JournaldOptions::category_field.
+ *
+ * The fields which are the same for all records of a level are prepared once,
+ * so a record is a single `sendmsg()` of them and the record fields,
+ * without assembling a string. Text of wide character types is converted to UTF-8.
+ *
+ * Records too large for a datagram are written to a sealed memory file
+ * passed to journald instead (Linux only). If journald was restarted,
+ * the socket is connected again once before the record is reported as failed.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for sink operations.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename Char,
+    typename ThreadingPolicy = DefaultThreadingPolicy,
+    std::size_t BufferSize = DefaultSinkBufferSize,
+    typename Allocator = std::allocator<Char>>
+class JournaldSink : public FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator> {
+public:
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::RecordType;
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::FormatBufferType;
+
+    /**
+     * @brief Message statistics.
+     */
+    struct Stats {
+        std::uint64_t syscalls = 0; ///< Number of messages sent.
+        std::uint64_t bytes = 0; ///< Number of bytes sent, including memory files.
+        std::uint64_t memory_files = 0; ///< Number of records sent in memory files.
+    };
+
+    /**
+     * @brief Constructs a new JournaldSink object.
+     *
+     * @tparam Args Argument types for the pattern and log levels.
+     * @param options Socket path and field names.
+     * @param args Optional pattern and list of log levels.
+     * @throws std::invalid_argument if the category field name is not valid.
+     * @throws std::system_error if the socket cannot be connected.
+     */
+    template<typename... Args>
+    explicit JournaldSink(const JournaldOptions& options, Args&&... args)
+        : FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>(
+              std::forward<Args>(args)...)
+    {
+        open(options);
+    }
+
+    /**
+     * @brief Constructs a new JournaldSink object sending to the system journal.
+     */
+    JournaldSink()
+        : JournaldSink(JournaldOptions{})
+    {
+    }
+
+    ~JournaldSink() override = default;
+
+    JournaldSink(const JournaldSink&) = delete;
+    JournaldSink(JournaldSink&&) = delete;
+    auto operator=(const JournaldSink&) -> JournaldSink& = delete;
+    auto operator=(JournaldSink&&) -> JournaldSink& = delete;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Formats the log record and sends it with the other fields.
+     *
+     * @param record The log record to process.
+     * @throws std::system_error if the entry cannot be sent.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Does nothing, each record is sent immediately.
+     */
+    auto flush() -> void override
+    {
+    }
+
+    /**
+     * @brief Gets the message statistics.
+     *
+     * @return Number of messages and bytes sent, and of records sent in memory files.
+     */
+    [[nodiscard]] auto stats() const noexcept -> Stats
+    {
+        return {
+            m_syscalls.load(std::memory_order_relaxed),
+            m_bytes.load(std::memory_order_relaxed),
+            m_memory_files.load(std::memory_order_relaxed)};
+    }
+
+private:
+    /** @brief Maximum length of a field name accepted by journald. */
+    static constexpr std::size_t MaxFieldName = 64;
+
+    /** @brief Prepares the fields and connects the socket. */
+    SLIMLOG_EXPORT auto open(const JournaldOptions& options) -> void;
+    /** @brief Sends the entry in a sealed memory file, returns its size or -1. */
+    SLIMLOG_EXPORT auto send_memory_file(std::span<const util::os::WriteBuffer> buffers)
+        -> std::ptrdiff_t;
+
+    std::array<std::string, static_cast<std::size_t>(Level::Trace) + 1> m_prefixes;
+    std::string m_category_field;
+    util::UnixSocket m_socket;
+    std::atomic<std::uint64_t> m_syscalls{0};
+    std::atomic<std::uint64_t> m_bytes{0};
+    std::atomic<std::uint64_t> m_memory_files{0};
+};
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/journald_sink-inl.h" // IWYU pragma: keep
+#endif
@@ -0,0 +1,265 @@
+/**
+ * @file mapped_file_sink-inl.h
+ * @brief Contains definition of MappedFileSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/mapped_file_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/mapped_file_sink.h" // IWYU pragma: associated
+#include "slimlog/threading.h"
+#include "slimlog/util/os.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+namespace slimlog {
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+MappedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::~MappedFileSink()
+{
+    if (m_data == nullptr) {
+        return;
+    }
+    const auto end = m_base + m_reserved.load(std::memory_order_relaxed);
+    util::os::unmap_file(m_data, m_size);
+    // Remove the zero padding after the written data
+    std::ignore = util::os::resize_file(m_fd, end);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto MappedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::open(
+    std::string_view filename, std::size_t chunk_size) -> void
+{
+    const std::string name(filename);
+    // Create the file if it does not exist, then reopen it for reading as required by mapping
+    if (!util::os::fopen_shared(name.c_str(), "ab")) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Error opening log file");
+    }
+    m_fp = util::os::fopen_shared(name.c_str(), "r+b");
+    if (!m_fp) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Error opening log file");
+    }
+    m_fd = util::os::file_descriptor(m_fp.get());
+
+    std::error_code error;
+    const auto size = std::filesystem::file_size(name, error);
+    if (error) [[unlikely]] {
+        throw std::system_error(error, "Error getting log file size");
+    }
+    const auto end = trim_padding(name, size);
+
+    m_granularity = util::os::map_granularity();
+    m_chunk_size = std::max(
+        (chunk_size + m_granularity - 1) / m_granularity * m_granularity, m_granularity);
+    release(map(end, 0));
+
+    if constexpr (sizeof(Char) > 1) {
+        if (end == 0) {
+            // Code unit U+FEFF in native byte order is the UTF-16 or UTF-32 BOM
+            const auto bom = static_cast<Char>(0xFEFF);
+            append(&bom, sizeof(bom));
+        }
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto MappedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::trim_padding(
+    const std::string& filename, std::uint64_t size) -> std::uint64_t
+{
+    if (size % sizeof(Char) != 0) {
+        // Not written by the sink, keep as is
+        return size;
+    }
+
+    // Scan backwards for the last character which is not zero
+    constexpr std::uint64_t BlockSize = 4096;
+    std::array<char, BlockSize> block{};
+    std::ifstream file(filename, std::ios::binary);
+    auto end = size;
+    while (end > 0) {
+        const auto count = std::min(end, BlockSize);
+        file.seekg(static_cast<std::streamoff>(end - count));
+        if (!file.read(block.data(), static_cast<std::streamsize>(count))) [[unlikely]] {
+            throw std::system_error({errno, std::system_category()}, "Error reading log file");
+        }
+        auto pos = count;
+        while (pos > 0
+               && std::all_of(
+                   block.begin() + static_cast<std::ptrdiff_t>(pos - sizeof(Char)),
+                   block.begin() + static_cast<std::ptrdiff_t>(pos),
+                   [](char byte) { return byte == 0; })) {
+            pos -= sizeof(Char);
+        }
+        end -= count - pos;
+        if (pos > 0) {
+            break;
+        }
+    }
+
+    if (end != size && !util::os::resize_file(m_fd, end)) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Error truncating log file");
+    }
+    return end;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto MappedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::message(
+    const RecordType& record) -> void
+{
+    FormatBufferType buffer;
+    this->format(buffer, record);
+    buffer.push_back(static_cast<Char>('\n'));
+    append(buffer.data(), buffer.size() * sizeof(Char));
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto MappedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::flush() -> void
+{
+    std::size_t offset = 0;
+    if constexpr (std::is_same_v<ThreadingPolicy, SingleThreadedPolicy>) {
+        offset = m_reserved.load(std::memory_order_relaxed);
+    } else {
+        // Reserve more than the chunk to get exclusive access to the mapping,
+        // or wait for the writer that is already mapping the next chunk
+        const auto generation = m_generation.load(std::memory_order_acquire);
+        offset = m_reserved.fetch_add(m_chunk_size + 1, std::memory_order_acq_rel);
+        if (offset > m_chunk_size) {
+            m_generation.wait(generation, std::memory_order_acquire);
+            return;
+        }
+        while (m_committed.load(std::memory_order_acquire) != offset) {
+            std::this_thread::yield();
+        }
+    }
+
+    const bool synced = util::os::sync_mapping(m_data, offset);
+    release(offset);
+    if (!synced) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed flush to log file");
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto MappedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::append(
+    const void* data, std::size_t size) -> void
+{
+    if constexpr (std::is_same_v<ThreadingPolicy, SingleThreadedPolicy>) {
+        const auto offset = m_reserved.load(std::memory_order_relaxed);
+        if (offset + size <= m_chunk_size) {
+            std::memcpy(m_data + offset, data, size);
+            m_reserved.store(offset + size, std::memory_order_relaxed);
+            return;
+        }
+        remap(offset, data, size);
+    } else {
+        for (;;) {
+            const auto generation = m_generation.load(std::memory_order_acquire);
+            const auto offset = m_reserved.fetch_add(size, std::memory_order_acq_rel);
+            if (offset + size <= m_chunk_size) {
+                std::memcpy(m_data + offset, data, size);
+                m_committed.fetch_add(size, std::memory_order_release);
+                return;
+            }
+            if (offset <= m_chunk_size) {
+                // The first writer which does not fit maps the next chunk
+                remap(offset, data, size);
+                return;
+            }
+            // Another writer is mapping the next chunk
+            m_generation.wait(generation, std::memory_order_acquire);
+        }
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto MappedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::remap(
+    std::size_t offset, const void* data, std::size_t size) -> void
+{
+    if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+        // All reservations before ours fit into the chunk, wait for their copies
+        while (m_committed.load(std::memory_order_acquire) != offset) {
+            std::this_thread::yield();
+        }
+    }
+
+    std::size_t end = 0;
+    try {
+        end = map(m_base + offset, size);
+    } catch (...) {
+        // Keep the previous mapping, otherwise other writers would wait forever
+        release(offset);
+        throw;
+    }
+
+    std::memcpy(m_data + end, data, size);
+    if (end + size > m_chunk_size) {
+        // The line is larger than the rest of the chunk, start the next one after it
+        try {
+            release(map(m_base + end + size, 0));
+        } catch (...) {
+            // Drop the line, it is overwritten by the next writer
+            release(end);
+            throw;
+        }
+        return;
+    }
+    release(end + size);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto MappedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::map(
+    std::uint64_t begin, std::size_t size) -> std::size_t
+{
+    const auto base = begin - (begin % m_granularity);
+    const auto offset = static_cast<std::size_t>(begin - base);
+    const auto length = std::max(
+        m_chunk_size, (offset + size + m_granularity - 1) / m_granularity * m_granularity);
+
+    if (!util::os::resize_file(m_fd, base + length)) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed extending log file");
+    }
+    void* data = util::os::map_file(m_fd, base, length);
+    if (data == nullptr) [[unlikely]] {
+        throw std::system_error({errno, std::system_category()}, "Failed mapping log file");
+    }
+    if (m_data != nullptr) {
+        util::os::unmap_file(m_data, m_size);
+    }
+
+    m_data = static_cast<std::byte*>(data);
+    m_size = length;
+    m_base = base;
+    m_mappings.fetch_add(1, std::memory_order_relaxed);
+    return offset;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto MappedFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::release(
+    std::size_t offset) noexcept -> void
+{
+    if constexpr (std::is_same_v<ThreadingPolicy, SingleThreadedPolicy>) {
+        m_reserved.store(offset, std::memory_order_relaxed);
+    } else {
+        // New writers can only commit after they see the reset reservation
+        m_committed.store(offset, std::memory_order_relaxed);
+        m_reserved.store(offset, std::memory_order_release);
+        m_generation.fetch_add(1, std::memory_order_release);
+        m_generation.notify_all();
+    }
+}
+
+} // namespace slimlog
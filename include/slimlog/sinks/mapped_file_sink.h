@@ -0,0 +1,157 @@
+/**
+ * @file mapped_file_sink.h
+ * @brief Contains declaration of MappedFileSink class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/sink.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace slimlog {
+
+/**
+ * @brief Parameters of the mapping in MappedFileSink.
+ */
+struct MappedFileOptions {
+    std::size_t chunk_size = std::size_t{16} * 1024 * 1024; ///< Mapped size, rounded to pages.
+};
+
+/**
+ * @brief Append-only file sink writing through a memory mapping.
+ *
+ * The file is extended in large chunks with `ftruncate()` and the chunk is mapped
+ * into memory, so that formatted lines are copied directly into the page cache
+ * without a system call per line. The system writes the pages back to disk.
+ *
+ * With MultiThreadedPolicy, space in the mapping is reserved with a single atomic
+ * addition, so concurrent writers copy their lines without taking a lock.
+ * The writer whose line does not fit into the mapped chunk waits for the preceding
+ * copies to complete, extends the file and maps the next chunk, while the writers
+ * behind it wait for the new mapping.
+ *
+ * The file is truncated to the length of the written data on destruction.
+ * Until then, and if the process terminates abnormally, the file contains
+ * zero padding up to the end of the current chunk. Trailing zero characters
+ * are removed when the file is reopened, so the padding is not left
+ * in the middle of the log.
+ *
+ * The sink is not derived from FileSink and has no DurabilityPolicy:
+ * mapped pages reach the disk when the system writes them back.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for sink operations.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename Char,
+    typename ThreadingPolicy = DefaultThreadingPolicy,
+    std::size_t BufferSize = DefaultSinkBufferSize,
+    typename Allocator = std::allocator<Char>>
+class MappedFileSink : public FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator> {
+public:
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::RecordType;
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::FormatBufferType;
+
+    /**
+     * @brief Constructs a new MappedFileSink object.
+     *
+     * @tparam Args Argument types for the pattern and log levels.
+     * @param filename Path to the log file.
+     * @param options Parameters of the mapping.
+     * @param args Optional pattern and list of log levels.
+     */
+    template<typename... Args>
+    MappedFileSink(std::string_view filename, MappedFileOptions options, Args&&... args)
+        : FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>(
+              std::forward<Args>(args)...)
+    {
+        open(filename, options.chunk_size);
+    }
+
+    /**
+     * @brief Constructs a new MappedFileSink object with default mapping parameters.
+     *
+     * @param filename Path to the log file.
+     */
+    explicit MappedFileSink(std::string_view filename)
+        : MappedFileSink(filename, MappedFileOptions{})
+    {
+    }
+
+    /**
+     * @brief Unmaps the file and truncates it to the length of the written data.
+     */
+    SLIMLOG_EXPORT ~MappedFileSink() override;
+
+    MappedFileSink(const MappedFileSink&) = delete;
+    MappedFileSink(MappedFileSink&&) = delete;
+    auto operator=(const MappedFileSink&) -> MappedFileSink& = delete;
+    auto operator=(MappedFileSink&&) -> MappedFileSink& = delete;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Formats the log record and copies it into the mapped chunk.
+     *
+     * @param record The log record to process.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Schedules writeback of the mapped chunk without waiting for it.
+     */
+    SLIMLOG_EXPORT auto flush() -> void override;
+
+    /**
+     * @brief Gets the number of times the file was extended and mapped.
+     *
+     * @return Number of mapped chunks.
+     */
+    [[nodiscard]] auto mappings() const noexcept -> std::uint64_t
+    {
+        return m_mappings.load(std::memory_order_relaxed);
+    }
+
+private:
+    /** @brief Opens the file and maps the chunk at its end. */
+    SLIMLOG_EXPORT auto open(std::string_view filename, std::size_t chunk_size) -> void;
+    /** @brief Truncates the zero padding left by an abnormal termination, returns the size. */
+    auto trim_padding(const std::string& filename, std::uint64_t size) -> std::uint64_t;
+    /** @brief Copies data into the mapping. */
+    auto append(const void* data, std::size_t size) -> void;
+    /** @brief Maps the next chunk starting at the offset and appends the data to it. */
+    auto remap(std::size_t offset, const void* data, std::size_t size) -> void;
+    /** @brief Extends the file and maps the chunk starting at the range, returns its offset. */
+    auto map(std::uint64_t begin, std::size_t size) -> std::size_t;
+    /** @brief Resets the reservation and wakes up writers waiting for the mapping. */
+    auto release(std::size_t offset) noexcept -> void;
+
+    std::unique_ptr<FILE, int (*)(FILE*)> m_fp = {nullptr, nullptr};
+    int m_fd = -1;
+    std::size_t m_granularity = 0;
+    std::size_t m_chunk_size = 0;
+    // Mapping is replaced only by the writer holding the reservation past the chunk
+    std::byte* m_data = nullptr;
+    std::size_t m_size = 0;
+    std::uint64_t m_base = 0;
+    std::atomic<std::size_t> m_reserved{0};
+    std::atomic<std::size_t> m_committed{0};
+    std::atomic<std::uint32_t> m_generation{0};
+    std::atomic<std::uint64_t> m_mappings{0};
+};
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/mapped_file_sink-inl.h" // IWYU pragma: keep
+#endif
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "slimlog/common.h"
+#include "slimlog/format.h"
 #include "slimlog/sink.h"
 #include "slimlog/util/types.h"
 
@@ -52,6 +53,12 @@ public:
      */
     auto message(const RecordType& record) -> void override
     {
+        if (record.deferred) [[unlikely]] {
+            typename DeferredMessage<Char>::BufferType buffer;
+            message(record.deferred->resolve(record, buffer));
+            return;
+        }
+
         const auto msg_logger = QMessageLogger(
             record.filename.data(), record.line, record.function.data(), m_qt_log_category);
         switch (record.level) {
@@ -0,0 +1,267 @@
+/**
+ * @file rotating_file_sink-inl.h
+ * @brief Contains definition of RotatingFileSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/rotating_file_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/rotating_file_sink.h" // IWYU pragma: associated
+#include "slimlog/util/os.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace slimlog {
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+RotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::~RotatingFileSink()
+{
+    if (m_thread.joinable()) {
+        {
+            const std::lock_guard lock(m_next_mutex);
+            m_stop = true;
+        }
+        m_wakeup.notify_one();
+        m_thread.join();
+    }
+    try {
+        m_next.reset();
+        std::error_code error;
+        std::filesystem::remove(next_name(), error);
+    } catch (...) { // NOLINT(bugprone-empty-catch)
+        // Destructor must not throw, the prepared file is left on disk
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto RotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::init() -> void
+{
+    m_size.store(static_cast<std::size_t>(std::ftell(this->file())), std::memory_order_relaxed);
+    // Not supported by all file systems, appends work anyway
+    util::os::preallocate(util::os::file_descriptor(this->file()), m_max_size);
+
+#ifndef _WIN32
+    m_next = prepare();
+#endif
+    if (m_size.load(std::memory_order_relaxed) >= m_max_size) {
+        rotate();
+    }
+#ifndef _WIN32
+    m_thread = std::thread(&RotatingFileSink::run, this);
+#endif
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto RotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::message(
+    const RecordType& record) -> void
+{
+    FormatBufferType buffer;
+    this->format(buffer, record);
+    buffer.push_back(static_cast<Char>('\n'));
+    {
+        const typename ThreadingPolicy::template SharedLock<decltype(m_file_mutex)> lock(
+            m_file_mutex);
+        this->write(this->file(), buffer.data(), buffer.size());
+    }
+    this->apply_durability(record);
+
+    // Only one writer rotates the file, others keep appending to the current one.
+    // If the rotation fails, the size stays over the limit and the next write retries.
+    const auto size = buffer.size() * sizeof(Char);
+    const auto before = m_size.fetch_add(size, std::memory_order_relaxed);
+    if (before + size >= m_max_size && !m_rotating.exchange(true, std::memory_order_acquire)) {
+        try {
+            // Another writer might have rotated the file already
+            if (m_size.load(std::memory_order_relaxed) >= m_max_size) {
+                rotate();
+            }
+        } catch (...) {
+            m_rotating.store(false, std::memory_order_release);
+            throw;
+        }
+        m_rotating.store(false, std::memory_order_release);
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto RotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::flush() -> void
+{
+    const typename ThreadingPolicy::template SharedLock<decltype(m_file_mutex)> lock(m_file_mutex);
+    FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::flush();
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto RotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::sync_file() -> void
+{
+    const typename ThreadingPolicy::template SharedLock<decltype(m_file_mutex)> lock(m_file_mutex);
+    FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::sync_file();
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto RotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::rotate() -> void
+{
+    const typename ThreadingPolicy::template UniqueLock<decltype(m_rotation_mutex)> rotation(
+        m_rotation_mutex);
+#ifdef _WIN32
+    // Open files cannot be renamed, writers wait until the new file is opened
+    const typename ThreadingPolicy::template UniqueLock<decltype(m_file_mutex)> lock(m_file_mutex);
+    this->replace_file(FilePtr{nullptr, nullptr}).reset();
+    try {
+        shift({});
+    } catch (...) {
+        // The files were renamed back, keep writing to the current one
+        this->replace_file(this->open_file(m_filename));
+        throw;
+    }
+    this->replace_file(this->open_file(m_filename));
+    m_size.store(static_cast<std::size_t>(std::ftell(this->file())), std::memory_order_relaxed);
+#else
+    // Writers keep appending to the current file while it is renamed
+    auto next = take_next();
+    if (!next) {
+        // The preparing thread failed
+        next = prepare();
+    }
+    try {
+        shift(next_name());
+    } catch (...) {
+        // The prepared file might be gone, prepare a new one for the retry
+        next.reset();
+        request_next();
+        throw;
+    }
+
+    FilePtr previous{nullptr, nullptr};
+    {
+        const typename ThreadingPolicy::template UniqueLock<decltype(m_file_mutex)> lock(
+            m_file_mutex);
+        previous = this->replace_file(std::move(next));
+        m_size.store(
+            static_cast<std::size_t>(std::ftell(this->file())), std::memory_order_relaxed);
+    }
+    // Flush the rest of the previous file without blocking the writers
+    previous.reset();
+    request_next();
+#endif
+    m_rotations.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto RotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::prepare() -> FilePtr
+{
+    // Leftover of an interrupted rotation
+    const auto filename = next_name();
+    std::error_code error;
+    std::filesystem::remove(filename, error);
+
+    auto fp = this->open_file(filename);
+    util::os::preallocate(util::os::file_descriptor(fp.get()), m_max_size);
+    return fp;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto RotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::take_next() -> FilePtr
+{
+    std::unique_lock lock(m_next_mutex);
+    m_done.wait(lock, [this] { return !m_preparing; });
+    return std::move(m_next);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto RotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::request_next() -> void
+{
+    {
+        const std::lock_guard lock(m_next_mutex);
+        m_preparing = true;
+    }
+    m_wakeup.notify_one();
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto RotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::run() -> void
+{
+    std::unique_lock lock(m_next_mutex);
+    while (!m_stop) {
+        if (!m_preparing) {
+            m_wakeup.wait(lock);
+            continue;
+        }
+
+        lock.unlock();
+        FilePtr next{nullptr, nullptr};
+        try {
+            next = prepare();
+        } catch (...) { // NOLINT(bugprone-empty-catch)
+            // The next rotation prepares the file itself
+        }
+        lock.lock();
+        m_next = std::move(next);
+        m_preparing = false;
+        m_done.notify_all();
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto RotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::shift(const std::string& next)
+    -> void
+{
+    // The oldest file is moved aside and removed only after all renames succeeded
+    const auto discarded = m_filename + ".old";
+    std::error_code error;
+    std::filesystem::remove(discarded, error);
+
+    std::vector<std::pair<std::string, std::string>> moves;
+    // The current file might have been removed, then there is nothing to shift
+    const auto current = std::filesystem::exists(m_filename, error);
+    if (error) [[unlikely]] {
+        throw std::system_error(error, "Error rotating log file");
+    }
+    if (current) {
+        if (m_max_files == 0) {
+            moves.emplace_back(m_filename, discarded);
+        } else {
+            moves.emplace_back(backup_name(m_max_files), discarded);
+            for (auto index = m_max_files - 1; index > 0; --index) {
+                moves.emplace_back(backup_name(index), backup_name(index + 1));
+            }
+            moves.emplace_back(m_filename, backup_name(1));
+        }
+    }
+    if (!next.empty()) {
+        moves.emplace_back(next, m_filename);
+    }
+
+    std::vector<std::pair<std::string, std::string>> renamed;
+    for (const auto& [from, to] : moves) {
+        // Missing backups are skipped, the prepared file must be there
+        const auto required = !next.empty() && from == next;
+        if (!required && !std::filesystem::exists(from, error)) {
+            if (error) {
+                break;
+            }
+            continue;
+        }
+        std::filesystem::rename(from, to, error);
+        if (error) {
+            break;
+        }
+        renamed.emplace_back(from, to);
+    }
+    if (error) [[unlikely]] {
+        std::error_code ignored;
+        for (auto it = renamed.rbegin(); it != renamed.rend(); ++it) {
+            std::filesystem::rename(it->second, it->first, ignored);
+        }
+        throw std::system_error(error, "Error rotating log file");
+    }
+    std::filesystem::remove(discarded, error);
+}
+
+} // namespace slimlog
@@ -0,0 +1,192 @@
+/**
+ * @file rotating_file_sink.h
+ * @brief Contains declaration of RotatingFileSink class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/sinks/file_sink.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+namespace slimlog {
+
+/**
+ * @brief File sink rotating log files by size.
+ *
+ * Once the current file reaches the size limit, it is renamed to `<filename>.1`,
+ * existing backups are shifted (`<filename>.1` to `<filename>.2` and so on),
+ * the oldest backup beyond the limit is removed and a new file is started.
+ *
+ * The next file is prepared in advance as `<filename>.next`, with disk space
+ * reserved for the whole segment (see util::os::preallocate()), so that appends
+ * do not allocate extents. The first one is prepared by the constructor, the
+ * following ones by a background thread after each rotation, so the writer
+ * rotating the file only renames files. On POSIX systems the backups are renamed
+ * while the current file is still being written, and other writers are only blocked
+ * while the file stream is swapped. On Windows open files cannot be renamed,
+ * so writers wait for the whole rotation, and no file is prepared.
+ *
+ * Each write reaching the size limit triggers a rotation unless another writer
+ * is already rotating, so a rotation that failed (e.g. on a rename error) is
+ * retried by the next write, and a zero limit starts a new file for every record.
+ * A failed rotation renames the files back, so no backup is lost. If the current
+ * file was removed, the new file just takes its place.
+ *
+ * The size is tracked approximately with MultiThreadedPolicy: lines written
+ * concurrently with the rotation may end up in the new file while being counted
+ * in the old one.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for sink operations.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename Char,
+    typename ThreadingPolicy = DefaultThreadingPolicy,
+    std::size_t BufferSize = DefaultSinkBufferSize,
+    typename Allocator = std::allocator<Char>>
+class RotatingFileSink : public FileSink<Char, ThreadingPolicy, BufferSize, Allocator> {
+public:
+    using typename FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::RecordType;
+    using typename FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::FormatBufferType;
+
+    /**
+     * @brief Constructs a new RotatingFileSink object.
+     *
+     * Rotates the file immediately if it already exceeds the size limit.
+     *
+     * @tparam Args Argument types for the pattern and log levels.
+     * @param filename Path to the log file.
+     * @param max_size Size of a file in bytes after which it is rotated.
+     * @param max_files Number of kept backups, zero to discard rotated files.
+     * @param args Optional pattern and list of log levels.
+     */
+    template<typename... Args>
+    RotatingFileSink(
+        std::string_view filename, std::size_t max_size, std::size_t max_files, Args&&... args)
+        : FileSink<Char, ThreadingPolicy, BufferSize, Allocator>(
+              filename, std::forward<Args>(args)...)
+        , m_filename(filename)
+        , m_max_size(max_size)
+        , m_max_files(max_files)
+    {
+        init();
+    }
+
+    /**
+     * @brief Stops the preparing thread, removes the prepared file and destroys the sink.
+     */
+    SLIMLOG_EXPORT ~RotatingFileSink() override;
+
+    RotatingFileSink(const RotatingFileSink&) = delete;
+    RotatingFileSink(RotatingFileSink&&) = delete;
+    auto operator=(const RotatingFileSink&) -> RotatingFileSink& = delete;
+    auto operator=(RotatingFileSink&&) -> RotatingFileSink& = delete;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Formats the log record, writes it to the current file
+     * and rotates the file if it reached the size limit.
+     *
+     * @param record The log record to process.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Flushes the current file.
+     */
+    SLIMLOG_EXPORT auto flush() -> void override;
+
+    /**
+     * @brief Rotates the current file regardless of its size.
+     */
+    SLIMLOG_EXPORT auto rotate() -> void;
+
+    /**
+     * @brief Gets the number of rotations performed by the sink.
+     *
+     * @return Number of rotations.
+     */
+    [[nodiscard]] auto rotations() const noexcept -> std::uint64_t
+    {
+        return m_rotations.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the name of a backup file.
+     *
+     * @param index Backup index, starting from 1 for the most recent one.
+     * @return Path to the backup file.
+     */
+    [[nodiscard]] auto backup_name(std::size_t index) const -> std::string
+    {
+        return m_filename + '.' + std::to_string(index);
+    }
+
+protected:
+    /**
+     * @brief Syncs the current file, holding it from being rotated.
+     */
+    SLIMLOG_EXPORT auto sync_file() -> void override;
+
+private:
+    using typename FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::FilePtr;
+
+    /** @brief Reserves space for the current file and prepares the next one. */
+    auto init() -> void;
+    /** @brief Opens the next file and reserves space for it. */
+    auto prepare() -> FilePtr;
+    /** @brief Takes the prepared file, waiting for the preparing thread. */
+    auto take_next() -> FilePtr;
+    /** @brief Asks the preparing thread to prepare the next file. */
+    auto request_next() -> void;
+    /** @brief Preparing thread loop. */
+    auto run() -> void;
+    /**
+     * @brief Renames the backups and the current file, moving `next` (if any) in its place.
+     *
+     * The oldest backup is removed only once all renames succeeded,
+     * otherwise the files are renamed back.
+     */
+    auto shift(const std::string& next) -> void;
+    /** @brief Gets the name of the file prepared for the next rotation. */
+    [[nodiscard]] auto next_name() const -> std::string
+    {
+        return m_filename + ".next";
+    }
+
+    std::string m_filename;
+    std::size_t m_max_size;
+    std::size_t m_max_files;
+    std::atomic<std::size_t> m_size{0};
+    std::atomic<std::uint64_t> m_rotations{0};
+    std::atomic<bool> m_rotating{false};
+    mutable typename ThreadingPolicy::SharedMutex m_file_mutex;
+    typename ThreadingPolicy::Mutex m_rotation_mutex;
+    // Preparing thread state
+    std::mutex m_next_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_done;
+    FilePtr m_next = {nullptr, nullptr}; // Guarded by m_next_mutex
+    bool m_preparing = false;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/rotating_file_sink-inl.h" // IWYU pragma: keep
+#endif
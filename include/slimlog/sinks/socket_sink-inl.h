@@ -0,0 +1,258 @@
+/**
+ * @file socket_sink-inl.h
+ * @brief Contains definition of SocketSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/socket_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/socket_sink.h" // IWYU pragma: associated
+#include "slimlog/util/unicode.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace slimlog {
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+SocketSink<Char, ThreadingPolicy, BufferSize, Allocator>::~SocketSink()
+{
+    {
+        const std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_all();
+    m_thread.join();
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto SocketSink<Char, ThreadingPolicy, BufferSize, Allocator>::message(const RecordType& record)
+    -> void
+{
+    FormatBufferType buffer;
+    this->format(buffer, record);
+
+    std::string_view text;
+    if constexpr (sizeof(Char) == 1) {
+        // NOLINTNEXTLINE(*-reinterpret-cast)
+        text = {reinterpret_cast<const char*>(buffer.data()), buffer.size()};
+    } else {
+        // Reused by the records of the thread, so the conversion does not allocate
+        thread_local std::string utf8_text;
+        utf8_text.clear();
+        util::unicode::append_utf8(utf8_text, buffer.data(), buffer.size());
+        text = utf8_text;
+    }
+
+    const auto size = text.size() + (m_options.framing == SocketFraming::Newline ? 1 : 4);
+    bool wakeup = false;
+    {
+        const std::lock_guard lock(m_mutex);
+        const auto pending = m_pending.size();
+        if (pending + size > m_options.spill_size) [[unlikely]] {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (m_options.framing == SocketFraming::LengthPrefix) {
+            const auto length = static_cast<std::uint32_t>(text.size());
+            m_pending.insert(
+                m_pending.end(),
+                {static_cast<char>(length >> 24U),
+                 static_cast<char>(length >> 16U),
+                 static_cast<char>(length >> 8U),
+                 static_cast<char>(length)});
+            m_pending.insert(m_pending.end(), text.begin(), text.end());
+        } else {
+            m_pending.insert(m_pending.end(), text.begin(), text.end());
+            m_pending.push_back('\n');
+        }
+        m_appended += size;
+        wakeup = pending < m_options.batch_size && pending + size >= m_options.batch_size;
+    }
+    if (wakeup) {
+        m_wakeup.notify_one();
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto SocketSink<Char, ThreadingPolicy, BufferSize, Allocator>::flush() -> void
+{
+    std::unique_lock lock(m_mutex);
+    const auto appended = m_appended;
+    m_flush = true;
+    m_wakeup.notify_one();
+    m_done.wait(lock, [this, appended]() { return m_processed >= appended || m_failed; });
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto SocketSink<Char, ThreadingPolicy, BufferSize, Allocator>::open(
+    std::string_view address, SocketOptions options) -> void
+{
+    m_address = address;
+    options.min_backoff = std::max(options.min_backoff, std::chrono::milliseconds{1});
+    options.max_backoff = std::max(options.max_backoff, options.min_backoff);
+    m_options = options;
+    m_backoff = options.min_backoff;
+    m_pending.reserve(std::min(options.batch_size, options.spill_size));
+    m_thread = std::thread(&SocketSink::run, this);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto SocketSink<Char, ThreadingPolicy, BufferSize, Allocator>::run() -> void
+{
+    std::unique_lock lock(m_mutex);
+    for (;;) {
+        m_wakeup.wait_for(lock, m_options.flush_interval, [this]() {
+            return m_stop || m_flush || m_pending.size() >= m_options.batch_size;
+        });
+        m_flush = false;
+        if (m_pending.empty()) {
+            if (m_stop) {
+                break;
+            }
+            continue;
+        }
+
+        // Writers continue appending to the emptied buffer of the previous batch
+        std::swap(m_pending, m_sending);
+        lock.unlock();
+        send();
+        lock.lock();
+
+        m_processed += m_sending.size();
+        m_sending.clear();
+        m_done.notify_all();
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto SocketSink<Char, ThreadingPolicy, BufferSize, Allocator>::send() -> void
+{
+    bool stalled = false;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    std::size_t offset = 0;
+    while (offset < m_sending.size()) {
+        if (!m_socket.valid()) {
+            if (!connect(deadline)) {
+                break;
+            }
+            // The part of a frame sent before the connection broke is lost,
+            // the collector only gets whole frames after the new connection
+            std::size_t start = 0;
+            while (start < offset) {
+                start = record_end(start);
+            }
+            if (start > offset) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            offset = start;
+            continue;
+        }
+
+        const auto result = m_socket.send(
+            m_sending.data() + offset, m_sending.size() - offset, m_options.flush_interval);
+        if (result > 0) {
+            offset += static_cast<std::size_t>(result);
+            m_syscalls.fetch_add(1, std::memory_order_relaxed);
+            m_bytes.fetch_add(static_cast<std::uint64_t>(result), std::memory_order_relaxed);
+            if (stalled) {
+                const std::lock_guard lock(m_mutex);
+                m_failed = stalled = false;
+            }
+        } else if (result < 0 && errno == EAGAIN) {
+            // The collector does not read, new records wait in the spill buffer
+            // and waiting flushes return
+            const std::lock_guard lock(m_mutex);
+            m_failed = stalled = true;
+            m_done.notify_all();
+            if (!deadline && m_stop) {
+                deadline = std::chrono::steady_clock::now() + m_options.shutdown_timeout;
+            }
+            if (deadline && std::chrono::steady_clock::now() >= *deadline) {
+                break;
+            }
+        } else {
+            m_socket.close();
+        }
+    }
+
+    // Records not sent completely because the sink is stopped
+    if (offset < m_sending.size()) {
+        for (std::size_t start = 0; start < m_sending.size(); start = record_end(start)) {
+            if (record_end(start) > offset) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto SocketSink<Char, ThreadingPolicy, BufferSize, Allocator>::connect(
+    std::optional<std::chrono::steady_clock::time_point>& deadline) -> bool
+{
+    for (;;) {
+        auto timeout = m_options.connect_timeout;
+        {
+            const std::lock_guard lock(m_mutex);
+            if (m_stop) {
+                // The sink is destroyed, the rest is sent within the shutdown timeout
+                const auto now = std::chrono::steady_clock::now();
+                if (!deadline) {
+                    deadline = now + m_options.shutdown_timeout;
+                }
+                if (now >= *deadline) {
+                    return false;
+                }
+                timeout = std::min(
+                    timeout, std::chrono::ceil<std::chrono::milliseconds>(*deadline - now));
+            }
+        }
+
+        const bool connected = m_socket.connect(m_address, timeout);
+        std::unique_lock lock(m_mutex);
+        m_failed = !connected;
+        if (connected) {
+            m_backoff = m_options.min_backoff;
+            m_connects.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Waiting flushes return, the records stay in the buffers until the next attempt
+        m_done.notify_all();
+        if (m_stop || m_wakeup.wait_for(lock, m_backoff, [this]() { return m_stop; })) {
+            return false;
+        }
+        m_backoff = std::min(m_backoff * 2, m_options.max_backoff);
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto SocketSink<Char, ThreadingPolicy, BufferSize, Allocator>::record_end(std::size_t offset) const
+    -> std::size_t
+{
+    if (m_options.framing == SocketFraming::Newline) {
+        const auto* const begin = m_sending.data();
+        const auto* const end = begin + m_sending.size(); // NOLINT(*-pointer-arithmetic)
+        // NOLINTNEXTLINE(*-pointer-arithmetic)
+        const auto* const newline = std::find(begin + offset, end, '\n');
+        return newline == end ? m_sending.size() : static_cast<std::size_t>(newline - begin) + 1;
+    }
+
+    std::uint32_t length = 0;
+    for (std::size_t i = 0; i < 4; ++i) {
+        length = (length << 8U) | static_cast<unsigned char>(m_sending[offset + i]);
+    }
+    return std::min(offset + 4 + length, m_sending.size());
+}
+
+} // namespace slimlog
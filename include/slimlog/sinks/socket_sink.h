@@ -0,0 +1,207 @@
+/**
+ * @file socket_sink.h
+ * @brief Contains declaration of SocketSink class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/sink.h"
+#include "slimlog/util/socket.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace slimlog {
+
+/**
+ * @brief Delimiting of the records sent by SocketSink.
+ */
+enum class SocketFraming : std::uint8_t {
+    Newline, ///< Each record is followed by a newline, lines are the delimited frames.
+    LengthPrefix ///< Each record is preceded by its size as 32-bit big endian.
+};
+
+/**
+ * @brief Parameters of the connection of SocketSink.
+ */
+struct SocketOptions {
+    SocketFraming framing = SocketFraming::Newline; ///< Delimiting of the records.
+    std::size_t batch_size = std::size_t{64} * 1024; ///< Buffered size waking up the writer.
+    std::size_t spill_size = std::size_t{4} * 1024 * 1024; ///< Maximum size of waiting records.
+    std::chrono::milliseconds flush_interval{100}; ///< Maximum delay of waiting records.
+    std::chrono::milliseconds connect_timeout{1000}; ///< Maximum time to connect.
+    std::chrono::milliseconds min_backoff{100}; ///< Delay after a failed connection.
+    std::chrono::milliseconds max_backoff{10000}; ///< Maximum delay after repeated failures.
+    std::chrono::milliseconds shutdown_timeout{1000}; ///< Time to send the rest when destroyed.
+};
+
+/**
+ * @brief Sink sending records to a collector over a TCP or Unix domain stream socket.
+ *
+ * The address is `HOST:PORT`, e.g. `127.0.0.1:5170`, or `unix:PATH`. Records are
+ * converted to UTF-8 and framed with a newline or a length prefix (SocketOptions),
+ * the latter keeps records spanning several lines whole.
+ *
+ * Writers only append framed records to a buffer. A writer thread connects
+ * to the collector and sends the buffer with large writes once it holds
+ * SocketOptions::batch_size bytes, after SocketOptions::flush_interval or on flush().
+ * If the connection fails or the collector stops reading, the thread reconnects
+ * with an exponential backoff while records wait in the buffer; records which
+ * do not fit into SocketOptions::spill_size are dropped and counted in stats(),
+ * so logging never waits for the collector.
+ *
+ * After a reconnection, sending resumes at the first frame not sent completely:
+ * a record with SocketFraming::LengthPrefix, a line with SocketFraming::Newline.
+ * The collector never gets a truncated frame, but a record spanning several lines
+ * may lose its first lines, each of them counted as a dropped record in stats().
+ * Delivery is at most once: records accepted by the system before the connection
+ * broke may be lost. When the sink is destroyed, connecting and sending the rest
+ * wait at most for SocketOptions::shutdown_timeout.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for sink operations.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename Char,
+    typename ThreadingPolicy = DefaultThreadingPolicy,
+    std::size_t BufferSize = DefaultSinkBufferSize,
+    typename Allocator = std::allocator<Char>>
+class SocketSink : public FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator> {
+public:
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::RecordType;
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::FormatBufferType;
+
+    /**
+     * @brief Connection statistics.
+     */
+    struct Stats {
+        std::uint64_t syscalls = 0; ///< Number of writes to the socket.
+        std::uint64_t bytes = 0; ///< Number of bytes sent.
+        std::uint64_t dropped = 0; ///< Number of records dropped or not sent completely.
+        std::uint64_t connects = 0; ///< Number of successful connections.
+    };
+
+    /**
+     * @brief Constructs a new SocketSink object and starts the writer thread.
+     *
+     * The connection is made by the writer thread once there are records to send.
+     *
+     * @tparam Args Argument types for the pattern and log levels.
+     * @param address Address of the collector, `HOST:PORT` or `unix:PATH`.
+     * @param options Parameters of the connection.
+     * @param args Optional pattern and list of log levels.
+     */
+    template<typename... Args>
+    SocketSink(std::string_view address, SocketOptions options, Args&&... args)
+        : FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>(
+              std::forward<Args>(args)...)
+    {
+        open(address, options);
+    }
+
+    /**
+     * @brief Constructs a new SocketSink object with default connection parameters.
+     *
+     * @param address Address of the collector, `HOST:PORT` or `unix:PATH`.
+     */
+    explicit SocketSink(std::string_view address)
+        : SocketSink(address, SocketOptions{})
+    {
+    }
+
+    /**
+     * @brief Sends the waiting records within the shutdown timeout and stops the writer thread.
+     */
+    SLIMLOG_EXPORT ~SocketSink() override;
+
+    SocketSink(const SocketSink&) = delete;
+    SocketSink(SocketSink&&) = delete;
+    auto operator=(const SocketSink&) -> SocketSink& = delete;
+    auto operator=(SocketSink&&) -> SocketSink& = delete;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Formats the log record and appends it to the buffer, or drops it if the buffer is full.
+     *
+     * @param record The log record to process.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Wakes up the writer thread and waits until the waiting records are sent.
+     *
+     * Returns early if the collector cannot be connected or does not read,
+     * the records keep waiting.
+     */
+    SLIMLOG_EXPORT auto flush() -> void override;
+
+    /**
+     * @brief Gets the connection statistics.
+     *
+     * @return Number of writes, bytes sent, dropped records and connections.
+     */
+    [[nodiscard]] auto stats() const noexcept -> Stats
+    {
+        return {
+            m_syscalls.load(std::memory_order_relaxed),
+            m_bytes.load(std::memory_order_relaxed),
+            m_dropped.load(std::memory_order_relaxed),
+            m_connects.load(std::memory_order_relaxed)};
+    }
+
+private:
+    /** @brief Stores the parameters and starts the writer thread. */
+    SLIMLOG_EXPORT auto open(std::string_view address, SocketOptions options) -> void;
+    /** @brief Writer thread loop. */
+    auto run() -> void;
+    /** @brief Sends the records taken by the writer, counts the rest as dropped when stopping. */
+    auto send() -> void;
+    /**
+     * @brief Connects the socket, retrying after the backoff delay until stopped.
+     *
+     * Once stopped, the shutdown deadline is set on first use and limits connecting.
+     */
+    auto connect(std::optional<std::chrono::steady_clock::time_point>& deadline) -> bool;
+    /** @brief Gets the end of the taken record starting at the offset. */
+    [[nodiscard]] auto record_end(std::size_t offset) const -> std::size_t;
+
+    std::string m_address;
+    SocketOptions m_options;
+    util::StreamSocket m_socket; // Used by the writer thread only
+    std::vector<char> m_pending; // Records waiting for the writer
+    std::vector<char> m_sending; // Records taken by the writer
+    std::chrono::milliseconds m_backoff{0};
+    std::uint64_t m_appended = 0; // Bytes appended to the pending records
+    std::uint64_t m_processed = 0; // Bytes sent or dropped by the writer
+    bool m_failed = false; // Collector cannot be connected or does not read
+    bool m_flush = false;
+    bool m_stop = false;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_done;
+    std::atomic<std::uint64_t> m_syscalls{0};
+    std::atomic<std::uint64_t> m_bytes{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<std::uint64_t> m_connects{0};
+    std::thread m_thread;
+};
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/socket_sink-inl.h" // IWYU pragma: keep
+#endif
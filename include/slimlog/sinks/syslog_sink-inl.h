@@ -0,0 +1,134 @@
+/**
+ * @file syslog_sink-inl.h
+ * @brief Contains definition of SyslogSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/syslog_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/syslog_sink.h" // IWYU pragma: associated
+#include "slimlog/util/os.h"
+#include "slimlog/util/unicode.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace slimlog {
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto SyslogSink<Char, ThreadingPolicy, BufferSize, Allocator>::message(const RecordType& record)
+    -> void
+{
+    namespace chrono = std::chrono;
+    FormatBufferType buffer;
+    this->format(buffer, record);
+
+    std::string_view text;
+    if constexpr (sizeof(Char) == 1) {
+        // NOLINTNEXTLINE(*-reinterpret-cast)
+        text = {reinterpret_cast<const char*>(buffer.data()), buffer.size()};
+    } else {
+        // Reused by the records of the thread, so the conversion does not allocate
+        thread_local std::string utf8;
+        utf8.clear();
+        util::unicode::append_utf8(utf8, buffer.data(), buffer.size());
+        text = utf8;
+    }
+
+    // Date and time change once per second, only the fraction is written for each record
+    thread_local chrono::sys_seconds cached_seconds{chrono::sys_seconds::min()};
+    thread_local std::array<char, TimestampSize> timestamp{};
+    const auto put = [](char* ptr, unsigned value, int width) {
+        for (int i = width - 1; i >= 0; --i) {
+            ptr[i] = static_cast<char>('0' + (value % 10)); // NOLINT(*-pointer-arithmetic)
+            value /= 10;
+        }
+    };
+    if (record.time.first != cached_seconds) {
+        const auto days = chrono::floor<chrono::days>(record.time.first);
+        const chrono::year_month_day date{days};
+        const chrono::hh_mm_ss time{record.time.first - days};
+        put(&timestamp[0], static_cast<unsigned>(static_cast<int>(date.year())), 4);
+        timestamp[4] = '-';
+        put(&timestamp[5], static_cast<unsigned>(date.month()), 2);
+        timestamp[7] = '-';
+        put(&timestamp[8], static_cast<unsigned>(date.day()), 2);
+        timestamp[10] = 'T';
+        put(&timestamp[11], static_cast<unsigned>(time.hours().count()), 2);
+        timestamp[13] = ':';
+        put(&timestamp[14], static_cast<unsigned>(time.minutes().count()), 2);
+        timestamp[16] = ':';
+        put(&timestamp[17], static_cast<unsigned>(time.seconds().count()), 2);
+        timestamp[19] = '.';
+        // Record time is local, so the current offset of the time zone is appended
+        const auto offset = util::os::utc_offset();
+        const auto offset_minutes = chrono::duration_cast<chrono::minutes>(chrono::abs(offset))
+                                        .count();
+        timestamp[26] = offset < chrono::seconds::zero() ? '-' : '+';
+        put(&timestamp[27], static_cast<unsigned>(offset_minutes / 60), 2);
+        timestamp[29] = ':';
+        put(&timestamp[30], static_cast<unsigned>(offset_minutes % 60), 2);
+        cached_seconds = record.time.first;
+    }
+    put(&timestamp[20], static_cast<unsigned>(record.time.second / 1000), 6);
+
+    const auto& priority = m_priorities.at(static_cast<std::size_t>(record.level));
+    const std::array<util::os::WriteBuffer, 4> buffers{{
+        {priority.data(), priority.size()},
+        {timestamp.data(), timestamp.size()},
+        {m_header.data(), m_header.size()},
+        {text.data(), text.size()},
+    }};
+    auto result = m_socket.send(buffers);
+    if (result < 0 && (errno == ECONNREFUSED || errno == ENOTCONN) && m_socket.reconnect())
+        [[unlikely]] {
+        result = m_socket.send(buffers);
+    }
+
+    if (result >= 0) [[likely]] {
+        m_syscalls.fetch_add(1, std::memory_order_relaxed);
+        m_bytes.fetch_add(static_cast<std::uint64_t>(result), std::memory_order_relaxed);
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        throw std::system_error({errno, std::system_category()}, "Failed sending to syslog");
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto SyslogSink<Char, ThreadingPolicy, BufferSize, Allocator>::open(const SyslogOptions& options)
+    -> void
+{
+    // Severities of the levels from Fatal to Trace
+    static constexpr std::array<unsigned, 6> Severities{2, 3, 4, 6, 7, 7};
+    for (std::size_t i = 0; i < m_priorities.size(); ++i) {
+        const auto priority = (static_cast<unsigned>(options.facility) * 8) + Severities.at(i);
+        m_priorities.at(i) = '<' + std::to_string(priority) + ">1 ";
+    }
+
+    // Header fields are printable ASCII without spaces, the nil value "-" if empty
+    const auto field = [](std::string value, std::size_t max_size) {
+        value.resize(std::min(value.size(), max_size));
+        std::ranges::replace_if(value, [](char chr) { return chr <= ' ' || chr > '~'; }, '_');
+        return value.empty() ? std::string("-") : value;
+    };
+    m_header = ' '
+        + field(options.hostname.empty() ? util::os::host_name() : options.hostname, 255) + ' '
+        + field(options.app_name.empty() ? util::os::program_name() : options.app_name, 48)
+        + ' ' + std::to_string(util::os::process_id()) + " - - ";
+
+    if (!m_socket.connect(options.path, util::UnixSocket::Type::Datagram, options.nonblocking)) {
+        throw std::system_error({errno, std::system_category()}, "Error connecting to syslog");
+    }
+}
+
+} // namespace slimlog
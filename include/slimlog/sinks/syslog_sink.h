@@ -0,0 +1,157 @@
+/**
+ * @file syslog_sink.h
+ * @brief Contains declaration of SyslogSink class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/sink.h"
+#include "slimlog/util/socket.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace slimlog {
+
+/**
+ * @brief Parameters of the syslog messages of SyslogSink.
+ */
+struct SyslogOptions {
+    std::string path = "/dev/log"; ///< Path of the `AF_UNIX` datagram socket.
+    std::uint8_t facility = 1; ///< Facility code, 1 is user-level messages.
+    std::string app_name; ///< Application name, empty for the program name.
+    std::string hostname; ///< Host name, empty for the name of this host.
+    bool nonblocking = false; ///< Drop messages instead of waiting for a full socket buffer.
+};
+
+/**
+ * @brief Sink sending records to a local syslog daemon in the RFC 5424 format.
+ *
+ * Each record is sent as a datagram to a Unix domain socket, `/dev/log` by default:
+ * ```
+ * <14>1 2024-01-01T12:00:00.123456+01:00 host app 1234 - - Message
+ * ```
+ * The priority prefix of each level and the host name, application name and
+ * process ID are prepared once, so a record costs one `sendmsg()` of these parts,
+ * the timestamp and the formatted message, without assembling them into a string.
+ * Record times are local, so the timestamp carries the UTC offset of the local time zone.
+ * Messages of wide character types are converted to UTF-8.
+ *
+ * Levels map to the severities critical (Fatal), error, warning,
+ * informational (Info) and debug (Debug and Trace).
+ *
+ * In non-blocking mode, records that do not fit into the socket buffer are
+ * dropped and counted in stats(). If the daemon was restarted, the socket is
+ * connected again once before the record is reported as failed.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for sink operations.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename Char,
+    typename ThreadingPolicy = DefaultThreadingPolicy,
+    std::size_t BufferSize = DefaultSinkBufferSize,
+    typename Allocator = std::allocator<Char>>
+class SyslogSink : public FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator> {
+public:
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::RecordType;
+    using typename FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>::FormatBufferType;
+
+    /**
+     * @brief Message statistics.
+     */
+    struct Stats {
+        std::uint64_t syscalls = 0; ///< Number of messages sent.
+        std::uint64_t bytes = 0; ///< Number of bytes sent.
+        std::uint64_t dropped = 0; ///< Number of messages dropped in non-blocking mode.
+    };
+
+    /**
+     * @brief Constructs a new SyslogSink object.
+     *
+     * @tparam Args Argument types for the pattern and log levels.
+     * @param options Socket path and header fields.
+     * @param args Optional pattern and list of log levels.
+     * @throws std::system_error if the socket cannot be connected.
+     */
+    template<typename... Args>
+    explicit SyslogSink(const SyslogOptions& options, Args&&... args)
+        : FormattableSink<Char, ThreadingPolicy, BufferSize, Allocator>(
+              std::forward<Args>(args)...)
+    {
+        open(options);
+    }
+
+    /**
+     * @brief Constructs a new SyslogSink object sending to `/dev/log`.
+     */
+    SyslogSink()
+        : SyslogSink(SyslogOptions{})
+    {
+    }
+
+    ~SyslogSink() override = default;
+
+    SyslogSink(const SyslogSink&) = delete;
+    SyslogSink(SyslogSink&&) = delete;
+    auto operator=(const SyslogSink&) -> SyslogSink& = delete;
+    auto operator=(SyslogSink&&) -> SyslogSink& = delete;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Formats the log record and sends it with the syslog header.
+     *
+     * @param record The log record to process.
+     * @throws std::system_error if the message cannot be sent.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Does nothing, each record is sent immediately.
+     */
+    auto flush() -> void override
+    {
+    }
+
+    /**
+     * @brief Gets the message statistics.
+     *
+     * @return Number of messages and bytes sent, and of dropped messages.
+     */
+    [[nodiscard]] auto stats() const noexcept -> Stats
+    {
+        return {
+            m_syscalls.load(std::memory_order_relaxed),
+            m_bytes.load(std::memory_order_relaxed),
+            m_dropped.load(std::memory_order_relaxed)};
+    }
+
+private:
+    /** @brief Length of the `YYYY-MM-DDThh:mm:ss.ffffff+hh:mm` timestamp. */
+    static constexpr std::size_t TimestampSize = 32;
+
+    /** @brief Prepares the header and connects the socket. */
+    SLIMLOG_EXPORT auto open(const SyslogOptions& options) -> void;
+
+    std::array<std::string, static_cast<std::size_t>(Level::Trace) + 1> m_priorities;
+    std::string m_header;
+    util::UnixSocket m_socket;
+    std::atomic<std::uint64_t> m_syscalls{0};
+    std::atomic<std::uint64_t> m_bytes{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+};
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/syslog_sink-inl.h" // IWYU pragma: keep
+#endif
@@ -0,0 +1,362 @@
+/**
+ * @file time_rotating_file_sink-inl.h
+ * @brief Contains definition of TimeRotatingFileSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/time_rotating_file_sink.h"
+
+// NOLINTNEXTLINE(misc-header-include-cycle)
+#include "slimlog/sinks/time_rotating_file_sink.h" // IWYU pragma: associated
+#include "slimlog/format.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace slimlog {
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::~TimeRotatingFileSink()
+{
+    if (m_thread.joinable()) {
+        {
+            const std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_wakeup.notify_one();
+        m_thread.join();
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::period_start(
+    std::chrono::sys_seconds time, std::chrono::seconds period) -> std::chrono::sys_seconds
+{
+    // Local time is stored as sys_seconds, so days start at local midnight
+    return std::chrono::sys_seconds{(time.time_since_epoch() / period) * period};
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::make_filename(
+    const Pattern<char>& pattern, std::chrono::sys_seconds start) -> std::string
+{
+    Record<char> record;
+    record.time = {start, 0};
+    FormatBuffer<char, DefaultSinkBufferSize> buffer;
+    pattern.format(buffer, record);
+    return {buffer.data(), buffer.size()};
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::escape_regex(
+    std::string_view text) -> std::string
+{
+    std::string result;
+    for (const char chr : text) {
+        if (std::string_view(R"(\^$.|?*+()[]{}/)").find(chr) != std::string_view::npos) {
+            result.push_back('\\');
+        }
+        result.push_back(chr);
+    }
+    return result;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::filename_regex(
+    std::string_view filename) -> std::regex
+{
+    const auto name = std::filesystem::path(filename).filename().string();
+    std::string_view pattern = name;
+    std::string regex;
+    while (!pattern.empty()) {
+        const auto pos = pattern.find_first_of("{}");
+        if (pos == std::string_view::npos) {
+            regex += escape_regex(pattern);
+            break;
+        }
+        regex += escape_regex(pattern.substr(0, pos));
+        pattern = pattern.substr(pos);
+
+        // Escaped braces
+        if (pattern.size() > 1 && pattern[1] == pattern[0]) {
+            regex += escape_regex(pattern.substr(0, 1));
+            pattern = pattern.substr(2);
+            continue;
+        }
+
+        const auto end = pattern.find('}');
+        if (pattern[0] != '{' || end == std::string_view::npos) {
+            throw FormatError("format error: unmatched brace in file name pattern");
+        }
+        constexpr std::string_view Time = "time";
+        const auto placeholder = pattern.substr(1, end - 1);
+        if (placeholder.starts_with(Time)
+            && (placeholder.size() == Time.size() || placeholder[Time.size()] == ':')) {
+            regex += time_regex(placeholder.substr(std::min(placeholder.size(), Time.size() + 1)));
+        } else {
+            // Fields other than time do not depend on the period
+            regex += escape_regex(make_filename(
+                Pattern<char>(pattern.substr(0, end + 1)), std::chrono::sys_seconds{}));
+        }
+        pattern = pattern.substr(end + 1);
+    }
+    return std::regex(regex);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::time_regex(
+    std::string_view specs) -> std::string
+{
+    if (specs.empty()) {
+        // Default format of sys_seconds, e.g. "2024-01-31 12:00:00"
+        return R"(\d{4}-\d{2}-\d{2} \d{2}:\d{2}:\d{2})";
+    }
+
+    std::string regex;
+    for (std::size_t pos = 0; pos < specs.size(); ++pos) {
+        if (specs[pos] != '%' || pos + 1 == specs.size()) {
+            regex += escape_regex(specs.substr(pos, 1));
+            continue;
+        }
+
+        auto conversion = specs[++pos];
+        if ((conversion == 'E' || conversion == 'O') && pos + 1 < specs.size()) {
+            conversion = specs[++pos];
+        }
+        switch (conversion) {
+        case 'Y':
+        case 'G':
+            regex += R"(\d{4})";
+            break;
+        case 'C':
+        case 'y':
+        case 'g':
+        case 'm':
+        case 'd':
+        case 'H':
+        case 'I':
+        case 'M':
+        case 'S':
+        case 'U':
+        case 'W':
+        case 'V':
+            regex += R"(\d{2})";
+            break;
+        case 'e':
+            regex += R"([ \d]\d)";
+            break;
+        case 'j':
+            regex += R"(\d{3})";
+            break;
+        case 'u':
+        case 'w':
+            regex += R"(\d)";
+            break;
+        case 'F':
+            regex += R"(\d{4}-\d{2}-\d{2})";
+            break;
+        case 'D':
+        case 'x':
+            regex += R"(\d{2}/\d{2}/\d{2})";
+            break;
+        case 'T':
+        case 'X':
+            regex += R"(\d{2}:\d{2}:\d{2})";
+            break;
+        case 'R':
+            regex += R"(\d{2}:\d{2})";
+            break;
+        case 'z':
+            regex += R"([+-]\d{4})";
+            break;
+        case 'n':
+            regex += "\n";
+            break;
+        case 't':
+            regex += "\t";
+            break;
+        case '%':
+            regex += "%";
+            break;
+        default:
+            // Names (month, weekday, AM/PM, time zone) and other conversions
+            regex += R"([^/]+?)";
+            break;
+        }
+    }
+    return regex;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::init() -> void
+{
+    if (m_retention.max_age.count() > 0 || m_retention.max_size > 0) {
+        m_requested = 1;
+        m_thread = std::thread(&TimeRotatingFileSink::run, this);
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::message(
+    const RecordType& record) -> void
+{
+    if (record.time.first.time_since_epoch().count()
+        >= m_next_start.load(std::memory_order_relaxed)) [[unlikely]] {
+        split(record.time.first);
+    }
+
+    FormatBufferType buffer;
+    this->format(buffer, record);
+    buffer.push_back(static_cast<Char>('\n'));
+
+    {
+        const typename ThreadingPolicy::template SharedLock<decltype(m_file_mutex)> lock(
+            m_file_mutex);
+        this->write(this->file(), buffer.data(), buffer.size());
+    }
+    this->apply_durability(record);
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::flush() -> void
+{
+    const typename ThreadingPolicy::template SharedLock<decltype(m_file_mutex)> lock(m_file_mutex);
+    FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::flush();
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::sync_file() -> void
+{
+    const typename ThreadingPolicy::template SharedLock<decltype(m_file_mutex)> lock(m_file_mutex);
+    FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::sync_file();
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::filename() const
+    -> std::string
+{
+    const std::lock_guard lock(m_mutex);
+    return m_filename;
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::wait_retention() -> void
+{
+    std::unique_lock lock(m_mutex);
+    if (m_thread.joinable()) {
+        m_done.wait(lock, [this]() { return m_processed == m_requested; });
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::split(
+    std::chrono::sys_seconds time) -> void
+{
+    const typename ThreadingPolicy::template UniqueLock<decltype(m_split_mutex)> split_lock(
+        m_split_mutex);
+    if (time.time_since_epoch().count() < m_next_start.load(std::memory_order_relaxed)) {
+        // Another writer has already switched the file
+        return;
+    }
+
+    const auto start = period_start(time, m_period);
+    auto filename = make_filename(m_pattern, start);
+    auto next = this->open_file(filename);
+
+    FilePtr previous{nullptr, nullptr};
+    {
+        const typename ThreadingPolicy::template UniqueLock<decltype(m_file_mutex)> lock(
+            m_file_mutex);
+        previous = this->replace_file(std::move(next));
+    }
+    m_next_start.store((start + m_period).time_since_epoch().count(), std::memory_order_relaxed);
+    // Flush the rest of the previous file without blocking the writers
+    previous.reset();
+
+    {
+        const std::lock_guard lock(m_mutex);
+        m_filename = std::move(filename);
+        ++m_requested;
+    }
+    m_wakeup.notify_one();
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::run() -> void
+{
+    std::unique_lock lock(m_mutex);
+    while (!m_stop) {
+        if (m_processed == m_requested) {
+            m_wakeup.wait(lock);
+            continue;
+        }
+
+        const auto requested = m_requested;
+        lock.unlock();
+        try {
+            apply_retention();
+        } catch (...) { // NOLINT(bugprone-empty-catch)
+            // Failures are retried on the next split
+        }
+        lock.lock();
+        m_processed = requested;
+        m_done.notify_all();
+    }
+}
+
+template<typename Char, typename ThreadingPolicy, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<Char, ThreadingPolicy, BufferSize, Allocator>::apply_retention() -> void
+{
+    namespace fs = std::filesystem;
+
+    const fs::path current = filename();
+    auto directory = current.parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+
+    struct Segment {
+        fs::path path;
+        fs::file_time_type time;
+        std::uintmax_t size;
+    };
+    std::vector<Segment> segments;
+    std::uintmax_t total_size = 0;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        const auto name = entry.path().filename().string();
+        if (!entry.is_regular_file(error) || !std::regex_match(name, m_name_regex)) {
+            continue;
+        }
+        const auto size = entry.file_size(error);
+        if (error) {
+            continue;
+        }
+        total_size += size;
+        if (entry.path().filename() != current.filename()) {
+            segments.push_back({entry.path(), entry.last_write_time(error), size});
+        }
+    }
+
+    // Oldest files first
+    std::ranges::sort(segments, {}, &Segment::time);
+    const auto expired = fs::file_time_type::clock::now() - m_retention.max_age;
+    for (const auto& segment : segments) {
+        const bool too_old = m_retention.max_age.count() > 0 && segment.time < expired;
+        const bool too_large = m_retention.max_size > 0 && total_size > m_retention.max_size;
+        if (!too_old && !too_large) {
+            break;
+        }
+        if (fs::remove(segment.path, error)) {
+            total_size -= segment.size;
+        }
+    }
+}
+
+} // namespace slimlog
@@ -0,0 +1,205 @@
+/**
+ * @file time_rotating_file_sink.h
+ * @brief Contains declaration of TimeRotatingFileSink class.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/pattern.h"
+#include "slimlog/sinks/file_sink.h"
+#include "slimlog/util/os.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+namespace slimlog {
+
+/**
+ * @brief Retention limits for the files of TimeRotatingFileSink.
+ *
+ * Zero values disable the corresponding limit.
+ */
+struct FileRetention {
+    std::chrono::seconds max_age{0}; ///< Files modified earlier are removed.
+    std::uintmax_t max_size = 0; ///< Oldest files are removed while the total size exceeds it.
+};
+
+/**
+ * @brief File sink splitting log files on wall-clock boundaries.
+ *
+ * File names are produced from a pattern containing a `{time}` placeholder
+ * (see Pattern), formatted with the start of the period, e.g. `app.{time:%Y-%m-%d}.log`
+ * with a period of `std::chrono::days(1)` starts a new file every local midnight.
+ *
+ * The record timestamp is compared with the precomputed start of the next period,
+ * so that checking for a split does not convert the time on each message.
+ * Records with a timestamp earlier than the current period are written to the current file.
+ *
+ * If retention limits are set, a background thread removes the files matching
+ * the pattern after each split. A file matches if it is in the same directory
+ * and its whole name could have been produced by the pattern: other placeholders
+ * must render exactly, and each `{time}` conversion must match its field
+ * (e.g. `%Y` four digits). Fill and width in the time specs are not supported,
+ * so such files are kept. The current file is never removed.
+ *
+ * @tparam Char Character type for the string.
+ * @tparam ThreadingPolicy Threading policy for sink operations.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename Char,
+    typename ThreadingPolicy = DefaultThreadingPolicy,
+    std::size_t BufferSize = DefaultSinkBufferSize,
+    typename Allocator = std::allocator<Char>>
+class TimeRotatingFileSink : public FileSink<Char, ThreadingPolicy, BufferSize, Allocator> {
+public:
+    using typename FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::RecordType;
+    using typename FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::FormatBufferType;
+
+    /**
+     * @brief Constructs a new TimeRotatingFileSink object.
+     *
+     * The first file is named after the current local time.
+     *
+     * @tparam Args Argument types for the pattern and log levels.
+     * @param filename File name pattern.
+     * @param period Length of the period covered by a single file.
+     * @param retention Limits for removing old files.
+     * @param args Optional pattern and list of log levels.
+     */
+    template<typename... Args>
+    TimeRotatingFileSink(
+        std::string_view filename,
+        std::chrono::seconds period,
+        FileRetention retention,
+        Args&&... args)
+        : TimeRotatingFileSink(
+              filename,
+              period,
+              period_start(util::os::local_time().first, period),
+              retention,
+              std::forward<Args>(args)...)
+    {
+    }
+
+    /**
+     * @brief Stops the retention thread and destroys the sink.
+     */
+    SLIMLOG_EXPORT ~TimeRotatingFileSink() override;
+
+    TimeRotatingFileSink(const TimeRotatingFileSink&) = delete;
+    TimeRotatingFileSink(TimeRotatingFileSink&&) = delete;
+    auto operator=(const TimeRotatingFileSink&) -> TimeRotatingFileSink& = delete;
+    auto operator=(TimeRotatingFileSink&&) -> TimeRotatingFileSink& = delete;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Starts a new file if the record belongs to a later period,
+     * then formats the log record and writes it to the current file.
+     *
+     * @param record The log record to process.
+     */
+    SLIMLOG_EXPORT auto message(const RecordType& record) -> void override;
+
+    /**
+     * @brief Flushes the current file.
+     */
+    SLIMLOG_EXPORT auto flush() -> void override;
+
+    /**
+     * @brief Gets the name of the current file.
+     *
+     * @return Path to the file.
+     */
+    [[nodiscard]] SLIMLOG_EXPORT auto filename() const -> std::string;
+
+    /**
+     * @brief Blocks until the retention thread has processed all splits.
+     */
+    SLIMLOG_EXPORT auto wait_retention() -> void;
+
+protected:
+    /**
+     * @brief Syncs the current file, holding it from being split.
+     */
+    SLIMLOG_EXPORT auto sync_file() -> void override;
+
+private:
+    using typename FileSink<Char, ThreadingPolicy, BufferSize, Allocator>::FilePtr;
+
+    template<typename... Args>
+    TimeRotatingFileSink(
+        std::string_view filename,
+        std::chrono::seconds period,
+        std::chrono::sys_seconds start,
+        FileRetention retention,
+        Args&&... args)
+        : FileSink<Char, ThreadingPolicy, BufferSize, Allocator>(
+              make_filename(Pattern<char>(filename), start), std::forward<Args>(args)...)
+        , m_pattern(filename)
+        , m_name_regex(filename_regex(filename))
+        , m_period(period)
+        , m_retention(retention)
+        , m_filename(make_filename(m_pattern, start))
+        , m_next_start((start + period).time_since_epoch().count())
+    {
+        init();
+    }
+
+    /** @brief Gets the start of the period containing the time point. */
+    static auto period_start(std::chrono::sys_seconds time, std::chrono::seconds period)
+        -> std::chrono::sys_seconds;
+    /** @brief Formats the file name for the period. */
+    static auto make_filename(const Pattern<char>& pattern, std::chrono::sys_seconds start)
+        -> std::string;
+    /** @brief Builds a regular expression matching the file names produced by the pattern. */
+    static auto filename_regex(std::string_view filename) -> std::regex;
+    /** @brief Escapes special characters of a regular expression. */
+    static auto escape_regex(std::string_view text) -> std::string;
+    /** @brief Builds a regular expression matching the time formatted with chrono specs. */
+    static auto time_regex(std::string_view specs) -> std::string;
+
+    /** @brief Starts the retention thread if needed. */
+    auto init() -> void;
+    /** @brief Switches to the file of the period containing the time point. */
+    auto split(std::chrono::sys_seconds time) -> void;
+    /** @brief Removes files exceeding the retention limits. */
+    auto apply_retention() -> void;
+    /** @brief Retention thread loop. */
+    auto run() -> void;
+
+    Pattern<char> m_pattern;
+    std::regex m_name_regex;
+    std::chrono::seconds m_period;
+    FileRetention m_retention;
+    std::string m_filename; // Guarded by m_mutex
+    std::atomic<std::chrono::sys_seconds::rep> m_next_start;
+    mutable typename ThreadingPolicy::SharedMutex m_file_mutex;
+    typename ThreadingPolicy::Mutex m_split_mutex;
+    // Retention thread state
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_done;
+    std::uint64_t m_requested = 0;
+    std::uint64_t m_processed = 0;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+} // namespace slimlog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/time_rotating_file_sink-inl.h" // IWYU pragma: keep
+#endif
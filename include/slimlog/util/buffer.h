@@ -9,6 +9,7 @@
 #include <cassert>
 #include <cstddef>
 #include <memory>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -522,4 +523,76 @@ private:
     Allocator m_allocator;
 };
 
+/**
+ * @brief Allocator returning memory aligned to a fixed boundary.
+ *
+ * Used for buffers passed to unbuffered I/O, which requires the memory
+ * to be aligned to the logical block size of the device.
+ *
+ * @tparam T Element type.
+ * @tparam Alignment Alignment in bytes, a power of two not less than `alignof(T)`.
+ */
+template<typename T, std::size_t Alignment>
+class AlignedAllocator {
+    static_assert(
+        (Alignment & (Alignment - 1)) == 0 && Alignment >= alignof(T),
+        "Alignment must be a power of two not less than the alignment of T");
+
+public:
+    using value_type = T;
+
+    /**
+     * @brief Rebinds the allocator to another element type.
+     *
+     * @tparam U Element type.
+     */
+    template<typename U>
+    struct rebind { // NOLINT(readability-identifier-naming)
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    /**
+     * @brief Constructs the allocator from an allocator of another element type.
+     */
+    template<typename U>
+    // NOLINTNEXTLINE(*-explicit-constructor,*-explicit-conversions)
+    AlignedAllocator(const AlignedAllocator<U, Alignment>& /*unused*/) noexcept
+    {
+    }
+
+    /**
+     * @brief Allocates aligned memory for the elements.
+     *
+     * @param count Number of elements.
+     * @return Pointer to the allocated memory.
+     */
+    [[nodiscard]] auto allocate(std::size_t count) -> T*
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    /**
+     * @brief Deallocates memory returned by allocate().
+     *
+     * @param ptr Pointer to the memory.
+     */
+    auto deallocate(T* ptr, std::size_t /*unused*/) noexcept -> void
+    {
+        ::operator delete(ptr, std::align_val_t{Alignment});
+    }
+
+    /**
+     * @brief Compares allocators, any of them can free memory of the other.
+     *
+     * @return Always \b true.
+     */
+    template<typename U>
+    auto operator==(const AlignedAllocator<U, Alignment>& /*unused*/) const noexcept -> bool
+    {
+        return true;
+    }
+};
+
 } // namespace slimlog::util
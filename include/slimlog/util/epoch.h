@@ -0,0 +1,475 @@
+/**
+ * @file epoch.h
+ * @brief Contains epoch-based memory reclamation and snapshot pointer classes.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/threading.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace slimlog::util {
+
+/**
+ * @brief Epoch-based memory reclamation domain.
+ *
+ * Allows readers to access shared objects without locks and without writing
+ * to shared memory: each thread only publishes the epoch it observed on entering
+ * the read-side critical section into its own cache line.
+ *
+ * Writers replace the shared pointer and then retire the old object,
+ * which is deleted once all read-side sections started before are finished.
+ *
+ * Read-side sections can be nested. If an object is retired from within a read-side
+ * section (e.g. a sink modifies the logger while processing a message),
+ * its deletion is postponed until the next retirement from outside.
+ */
+class EpochDomain final {
+    /** @brief Per-thread state visible to writers. */
+    struct alignas(64) Participant { // NOLINT(*-magic-numbers)
+        std::atomic<std::uint64_t> epoch{0};
+        std::atomic<bool> in_use{false};
+        Participant* next = nullptr;
+    };
+
+    /** @brief Thread-local handle to the participant record. */
+    struct LocalState {
+        LocalState(const LocalState&) = delete;
+        LocalState(LocalState&&) = delete;
+        auto operator=(const LocalState&) -> LocalState& = delete;
+        auto operator=(LocalState&&) -> LocalState& = delete;
+
+        explicit LocalState(Participant* participant) noexcept
+            : participant(participant)
+        {
+        }
+
+        ~LocalState()
+        {
+            // Record is reused by other threads, never deallocated
+            participant->in_use.store(false, std::memory_order_release);
+        }
+
+        Participant* participant;
+        std::size_t depth = 0;
+    };
+
+    /** @brief Retired object waiting for deletion. */
+    struct Retired {
+        const void* pointer;
+        void (*deleter)(const void*);
+    };
+
+public:
+    /**
+     * @brief RAII guard for the read-side critical section.
+     *
+     * Objects loaded from shared pointers while the guard is alive are not deleted.
+     */
+    class Guard final {
+    public:
+        /**
+         * @brief Enters the read-side critical section.
+         */
+        Guard()
+            : m_state(EpochDomain::instance().local_state())
+        {
+            if (m_state.depth++ == 0) {
+                m_state.participant->epoch.store(
+                    EpochDomain::instance().m_epoch.load(std::memory_order_acquire),
+                    std::memory_order_relaxed);
+                // Pairs with the fence in synchronize(): either the writer sees
+                // this section, or this section sees the new shared pointer.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+
+        Guard(const Guard&) = delete;
+        Guard(Guard&&) = delete;
+        auto operator=(const Guard&) -> Guard& = delete;
+        auto operator=(Guard&&) -> Guard& = delete;
+
+        /**
+         * @brief Leaves the read-side critical section.
+         */
+        ~Guard()
+        {
+            if (--m_state.depth == 0) {
+                m_state.participant->epoch.store(0, std::memory_order_release);
+            }
+        }
+
+    private:
+        LocalState& m_state;
+    };
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain(EpochDomain&&) = delete;
+    auto operator=(const EpochDomain&) -> EpochDomain& = delete;
+    auto operator=(EpochDomain&&) -> EpochDomain& = delete;
+
+    /**
+     * @brief Destroys the domain and all postponed objects.
+     */
+    ~EpochDomain()
+    {
+        for (auto& retired : m_retired) {
+            retired.deleter(retired.pointer);
+        }
+        // Participants might still be referenced by thread-local states of
+        // running threads, so they are intentionally leaked.
+    }
+
+    /**
+     * @brief Gets the global reclamation domain.
+     *
+     * Defined out of line, so that the library and the executable
+     * share a single domain when built as a shared library.
+     *
+     * @return Reference to the global domain.
+     */
+    SLIMLOG_EXPORT static auto instance() -> EpochDomain&;
+
+    /**
+     * @brief Checks if the calling thread is inside a read-side critical section.
+     *
+     * @return \b true if the caller holds a Guard.
+     */
+    [[nodiscard]] auto in_critical_section() -> bool
+    {
+        return local_state().depth > 0;
+    }
+
+    /**
+     * @brief Waits until all read-side sections started before the call are finished.
+     *
+     * Must not be called from within a read-side critical section.
+     */
+    auto synchronize() -> void
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto target = m_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+        for (auto* participant = m_participants.load(std::memory_order_acquire);
+             participant != nullptr;
+             participant = participant->next) {
+            for (auto epoch = participant->epoch.load(std::memory_order_acquire);
+                 epoch != 0 && epoch < target;
+                 epoch = participant->epoch.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * @brief Deletes the object once it is not accessed by any reader.
+     *
+     * The object must be already unreachable for new readers.
+     * Blocks until the grace period is over, unless called from within
+     * a read-side section: then the deletion is postponed.
+     *
+     * @tparam T Object type.
+     * @param pointer Pointer to the object allocated with `new`.
+     */
+    template<typename T>
+    auto retire(const T* pointer) -> void
+    {
+        if (pointer == nullptr) {
+            return;
+        }
+
+        const Retired retired{pointer, [](const void* ptr) { delete static_cast<const T*>(ptr); }};
+        if (in_critical_section()) [[unlikely]] {
+            const std::lock_guard lock(m_mutex);
+            m_retired.push_back(retired);
+            return;
+        }
+
+        // Objects retired before the grace period are safe to delete after it
+        std::vector<Retired> postponed;
+        {
+            const std::lock_guard lock(m_mutex);
+            postponed.swap(m_retired);
+        }
+        synchronize();
+        retired.deleter(retired.pointer);
+        for (auto& item : postponed) {
+            item.deleter(item.pointer);
+        }
+    }
+
+private:
+    EpochDomain() = default;
+
+    /**
+     * @brief Gets the state of the calling thread, registering it on first use.
+     *
+     * @return Reference to the thread-local state.
+     */
+    SLIMLOG_EXPORT auto local_state() -> LocalState&;
+
+    /**
+     * @brief Finds a free participant record or allocates a new one.
+     *
+     * @return Pointer to the participant record.
+     */
+    auto acquire_participant() -> Participant*
+    {
+        for (auto* participant = m_participants.load(std::memory_order_acquire);
+             participant != nullptr;
+             participant = participant->next) {
+            bool expected = false;
+            if (!participant->in_use.load(std::memory_order_relaxed)
+                && participant->in_use.compare_exchange_strong(
+                    expected, true, std::memory_order_acquire)) {
+                return participant;
+            }
+        }
+
+        auto* participant = new Participant(); // NOLINT(cppcoreguidelines-owning-memory)
+        participant->in_use.store(true, std::memory_order_relaxed);
+        participant->next = m_participants.load(std::memory_order_relaxed);
+        while (!m_participants.compare_exchange_weak(
+            participant->next, participant, std::memory_order_release)) {
+        }
+        return participant;
+    }
+
+    std::atomic<std::uint64_t> m_epoch{1};
+    std::atomic<Participant*> m_participants{nullptr};
+    std::mutex m_mutex;
+    std::vector<Retired> m_retired;
+};
+
+/**
+ * @brief Pointer to an immutable object, replaced as a whole by writers.
+ *
+ * Generic template, specialized for each threading policy.
+ *
+ * @tparam T Object type.
+ * @tparam ThreadingPolicy Threading policy (SingleThreadedPolicy or MultiThreadedPolicy).
+ */
+template<typename T, typename ThreadingPolicy>
+class SnapshotPtr final {};
+
+/**
+ * @brief Single-threaded specialized implementation of SnapshotPtr.
+ *
+ * Old objects are deleted as soon as they are no longer referenced.
+ *
+ * @tparam T Object type.
+ */
+template<typename T>
+class SnapshotPtr<T, SingleThreadedPolicy> final {
+public:
+    /** @brief Handle to the replaced object, deletes it when destroyed. */
+    using Retired = std::unique_ptr<const T>;
+
+    /** @brief Read access to the current object. */
+    class ReadGuard final {
+    public:
+        /**
+         * @brief Loads the current object.
+         *
+         * @param ptr Snapshot pointer.
+         */
+        explicit ReadGuard(const SnapshotPtr& ptr) noexcept
+            : m_value(ptr.m_value.get())
+        {
+        }
+
+        /**
+         * @brief Accesses the object.
+         *
+         * @return Pointer to the object.
+         */
+        auto operator->() const noexcept -> const T*
+        {
+            return m_value;
+        }
+
+        /**
+         * @brief Accesses the object.
+         *
+         * @return Reference to the object.
+         */
+        auto operator*() const noexcept -> const T&
+        {
+            return *m_value;
+        }
+
+    private:
+        const T* m_value;
+    };
+
+    /**
+     * @brief Constructs a new SnapshotPtr object.
+     *
+     * @param value Initial object.
+     */
+    explicit SnapshotPtr(std::unique_ptr<const T> value = std::make_unique<const T>())
+        : m_value(std::move(value))
+    {
+    }
+
+    /**
+     * @brief Gets the current object. Must be used only by writers.
+     *
+     * @return Pointer to the current object.
+     */
+    [[nodiscard]] auto get() const noexcept -> const T*
+    {
+        return m_value.get();
+    }
+
+    /**
+     * @brief Replaces the current object.
+     *
+     * @param value New object.
+     * @return Handle to the replaced object.
+     */
+    [[nodiscard]] auto publish(std::unique_ptr<const T> value) -> Retired
+    {
+        return std::exchange(m_value, std::move(value));
+    }
+
+private:
+    std::unique_ptr<const T> m_value;
+};
+
+/**
+ * @brief Multi-threaded specialized implementation of SnapshotPtr.
+ *
+ * Readers do a single acquire load inside an epoch-based critical section,
+ * old objects are deleted after the grace period (see EpochDomain).
+ *
+ * @tparam T Object type.
+ */
+template<typename T>
+class SnapshotPtr<T, MultiThreadedPolicy> final {
+    /** @brief Deleter retiring the object in the reclamation domain. */
+    struct Reclaimer {
+        auto operator()(const T* pointer) const -> void
+        {
+            EpochDomain::instance().retire(pointer);
+        }
+    };
+
+public:
+    /** @brief Handle to the replaced object, retires it when destroyed. */
+    using Retired = std::unique_ptr<const T, Reclaimer>;
+
+    /** @brief Read access to the current object. */
+    class ReadGuard final {
+    public:
+        /**
+         * @brief Enters the read-side section and loads the current object.
+         *
+         * @param ptr Snapshot pointer.
+         */
+        explicit ReadGuard(const SnapshotPtr& ptr)
+            : m_value(ptr.m_value.load(std::memory_order_acquire))
+        {
+        }
+
+        /**
+         * @brief Accesses the object.
+         *
+         * @return Pointer to the object.
+         */
+        auto operator->() const noexcept -> const T*
+        {
+            return m_value;
+        }
+
+        /**
+         * @brief Accesses the object.
+         *
+         * @return Reference to the object.
+         */
+        auto operator*() const noexcept -> const T&
+        {
+            return *m_value;
+        }
+
+    private:
+        // Guard must be constructed before loading the pointer
+        EpochDomain::Guard m_guard;
+        const T* m_value;
+    };
+
+    /**
+     * @brief Constructs a new SnapshotPtr object.
+     *
+     * @param value Initial object.
+     */
+    explicit SnapshotPtr(std::unique_ptr<const T> value = std::make_unique<const T>())
+        : m_value(value.release())
+    {
+    }
+
+    SnapshotPtr(const SnapshotPtr&) = delete;
+    SnapshotPtr(SnapshotPtr&&) = delete;
+    auto operator=(const SnapshotPtr&) -> SnapshotPtr& = delete;
+    auto operator=(SnapshotPtr&&) -> SnapshotPtr& = delete;
+
+    /**
+     * @brief Deletes the current object. There must be no readers left.
+     */
+    ~SnapshotPtr()
+    {
+        delete m_value.load(std::memory_order_relaxed); // NOLINT(cppcoreguidelines-owning-memory)
+    }
+
+    /**
+     * @brief Gets the current object. Must be used only by writers.
+     *
+     * @return Pointer to the current object.
+     */
+    [[nodiscard]] auto get() const noexcept -> const T*
+    {
+        return m_value.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Replaces the current object.
+     *
+     * Old object is retired when the returned handle is destroyed,
+     * which may block until readers are finished, so avoid holding locks
+     * that readers might take at that point.
+     *
+     * @param value New object.
+     * @return Handle to the replaced object.
+     */
+    [[nodiscard]] auto publish(std::unique_ptr<const T> value) -> Retired
+    {
+        return Retired(m_value.exchange(value.release(), std::memory_order_acq_rel));
+    }
+
+private:
+    std::atomic<const T*> m_value;
+};
+
+#ifdef SLIMLOG_HEADER_ONLY
+inline auto EpochDomain::instance() -> EpochDomain&
+{
+    static EpochDomain domain;
+    return domain;
+}
+
+inline auto EpochDomain::local_state() -> LocalState&
+{
+    thread_local LocalState state(acquire_participant());
+    return state;
+}
+#endif
+
+} // namespace slimlog::util
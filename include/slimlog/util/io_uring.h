@@ -0,0 +1,321 @@
+/**
+ * @file io_uring.h
+ * @brief Contains a minimal io_uring submission ring for file writes.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define SLIMLOG_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h> // for mmap
+#include <sys/syscall.h> // for io_uring syscalls
+#include <sys/uio.h> // for iovec
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace slimlog::util {
+
+/**
+ * @brief Minimal io_uring instance issuing write requests.
+ *
+ * Talks to the kernel with the raw `io_uring_setup()`, `io_uring_enter()`
+ * and `io_uring_register()` system calls, so no liburing is needed.
+ * The ring is not thread-safe, callers must serialize access to it.
+ *
+ * On systems without io_uring, or if the kernel refuses to create the ring
+ * (old kernel, seccomp filter, `kernel.io_uring_disabled`), init() returns \b false.
+ */
+class IoUring final {
+public:
+    /**
+     * @brief Memory region registered with register_buffers().
+     */
+    struct Buffer {
+        void* data; ///< Pointer to the memory.
+        std::size_t size; ///< Size of the memory in bytes.
+    };
+
+    IoUring() = default;
+    IoUring(const IoUring&) = delete;
+    IoUring(IoUring&&) = delete;
+    auto operator=(const IoUring&) -> IoUring& = delete;
+    auto operator=(IoUring&&) -> IoUring& = delete;
+
+    /**
+     * @brief Unmaps the rings and closes the io_uring instance.
+     *
+     * Requests still in flight are completed by the kernel.
+     */
+    ~IoUring()
+    {
+#ifdef SLIMLOG_IO_URING
+        if (m_fd < 0) {
+            return;
+        }
+        ::munmap(m_sqes, m_sqes_size);
+        if (m_cq_ring != m_sq_ring) {
+            ::munmap(m_cq_ring, m_cq_size);
+        }
+        ::munmap(m_sq_ring, m_sq_size);
+        ::close(m_fd);
+#endif
+    }
+
+    /**
+     * @brief Creates the io_uring instance.
+     *
+     * @param entries Number of submission queue entries.
+     * @return \b true if io_uring is available, \b false otherwise.
+     */
+    [[nodiscard]] auto init([[maybe_unused]] unsigned entries) noexcept -> bool
+    {
+#ifdef SLIMLOG_IO_URING
+        io_uring_params params{};
+        const auto fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0) {
+            return false;
+        }
+        // IORING_OP_WRITE appeared together with IORING_FEAT_RW_CUR_POS in Linux 5.6
+        if ((params.features & IORING_FEAT_RW_CUR_POS) == 0) {
+            ::close(fd);
+            return false;
+        }
+
+        m_sq_size = params.sq_off.array + (params.sq_entries * sizeof(unsigned));
+        m_cq_size = params.cq_off.cqes + (params.cq_entries * sizeof(io_uring_cqe));
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            m_sq_size = m_cq_size = std::max(m_sq_size, m_cq_size);
+        }
+        m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+        const auto map = [fd](std::size_t size, off_t offset) -> void* {
+            void* ptr = ::mmap(
+                nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+            return ptr == MAP_FAILED ? nullptr : ptr;
+        };
+        m_sq_ring = map(m_sq_size, IORING_OFF_SQ_RING);
+        m_cq_ring = single_mmap || m_sq_ring == nullptr ? m_sq_ring
+                                                        : map(m_cq_size, IORING_OFF_CQ_RING);
+        m_sqes = m_cq_ring == nullptr ? nullptr : map(m_sqes_size, IORING_OFF_SQES);
+        if (m_sqes == nullptr) {
+            if (m_cq_ring != nullptr && m_cq_ring != m_sq_ring) {
+                ::munmap(m_cq_ring, m_cq_size);
+            }
+            if (m_sq_ring != nullptr) {
+                ::munmap(m_sq_ring, m_sq_size);
+            }
+            ::close(fd);
+            return false;
+        }
+
+        auto* sq = static_cast<std::byte*>(m_sq_ring);
+        auto* cq = static_cast<std::byte*>(m_cq_ring);
+        // NOLINTBEGIN(*-reinterpret-cast,*-pointer-arithmetic)
+        m_sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        m_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        // NOLINTEND(*-reinterpret-cast,*-pointer-arithmetic)
+        m_entries = params.sq_entries;
+        m_fd = fd;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Checks if the ring was created.
+     *
+     * @return \b true if init() succeeded.
+     */
+    [[nodiscard]] auto valid() const noexcept -> bool
+    {
+        return m_fd >= 0;
+    }
+
+    /**
+     * @brief Registers buffers for prepare_write() with a buffer index.
+     *
+     * Registered buffers are pinned once, instead of on every request.
+     *
+     * @param buffers Buffers to register.
+     * @return \b true on success, \b false if registration is not possible.
+     */
+    [[nodiscard]] auto register_buffers([[maybe_unused]] std::span<const Buffer> buffers) noexcept
+        -> bool
+    {
+#ifdef SLIMLOG_IO_URING
+        static_assert(sizeof(Buffer) == sizeof(iovec));
+        return ::syscall(
+                   __NR_io_uring_register,
+                   m_fd,
+                   IORING_REGISTER_BUFFERS,
+                   buffers.data(),
+                   static_cast<unsigned>(buffers.size()))
+            == 0;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Registers a file for prepare_write() with a fixed file.
+     *
+     * Fixed file requests skip looking up the file descriptor on every request.
+     *
+     * @param fd File descriptor, referred to by index 0.
+     * @return \b true on success, \b false if registration is not possible.
+     */
+    [[nodiscard]] auto register_file([[maybe_unused]] int fd) noexcept -> bool
+    {
+#ifdef SLIMLOG_IO_URING
+        return ::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_FILES, &fd, 1U) == 0;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Queues a write request without submitting it.
+     *
+     * @param fd File descriptor, or -1 to use the registered file.
+     * @param data Data to write.
+     * @param size Size of the data in bytes.
+     * @param offset Offset in the file.
+     * @param user_data Value passed to the completion callback of reap().
+     * @param buffer Index of the registered buffer containing the data, or -1.
+     * @return \b true if queued, \b false if the submission queue is full.
+     */
+    auto prepare_write(
+        [[maybe_unused]] int fd,
+        [[maybe_unused]] const void* data,
+        [[maybe_unused]] std::size_t size,
+        [[maybe_unused]] std::uint64_t offset,
+        [[maybe_unused]] std::uint64_t user_data,
+        [[maybe_unused]] int buffer) noexcept -> bool
+    {
+#ifdef SLIMLOG_IO_URING
+        const unsigned tail = *m_sq_tail;
+        if (tail - __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE) >= m_entries) {
+            return false;
+        }
+
+        const unsigned index = tail & m_sq_mask;
+        auto* sqe = static_cast<io_uring_sqe*>(m_sqes) + index; // NOLINT(*-pointer-arithmetic)
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = buffer >= 0 ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        sqe->fd = fd >= 0 ? fd : 0;
+        sqe->flags = fd >= 0 ? 0 : IOSQE_FIXED_FILE;
+        sqe->addr = reinterpret_cast<std::uintptr_t>(data); // NOLINT(*-reinterpret-cast)
+        sqe->len = static_cast<std::uint32_t>(size);
+        sqe->off = offset;
+        sqe->buf_index = buffer >= 0 ? static_cast<std::uint16_t>(buffer) : 0;
+        sqe->user_data = user_data;
+        m_sq_array[index] = index; // NOLINT(*-pointer-arithmetic)
+        __atomic_store_n(m_sq_tail, tail + 1, __ATOMIC_RELEASE);
+        ++m_queued;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Submits the queued requests and optionally waits for completions.
+     *
+     * @param wait Number of completions to wait for.
+     * @return Number of submitted requests, or negated `errno` on error.
+     */
+    auto submit([[maybe_unused]] unsigned wait) noexcept -> int
+    {
+#ifdef SLIMLOG_IO_URING
+        const auto result = static_cast<int>(::syscall(
+            __NR_io_uring_enter,
+            m_fd,
+            m_queued,
+            wait,
+            wait > 0 ? IORING_ENTER_GETEVENTS : 0U,
+            nullptr,
+            0));
+        if (result < 0) {
+            return -errno;
+        }
+        m_queued -= static_cast<unsigned>(result);
+        return result;
+#else
+        return -1;
+#endif
+    }
+
+    /**
+     * @brief Gets the number of requests queued but not yet submitted.
+     *
+     * @return Number of queued requests.
+     */
+    [[nodiscard]] auto queued() const noexcept -> unsigned
+    {
+        return m_queued;
+    }
+
+    /**
+     * @brief Consumes all available completions without a system call.
+     *
+     * @tparam Func Callback type, invocable with `(std::uint64_t user_data, int result)`.
+     * @param callback Callback invoked for each completion.
+     * @return Number of consumed completions.
+     */
+    template<typename Func>
+    auto reap([[maybe_unused]] Func&& callback) -> unsigned
+    {
+        unsigned count = 0;
+#ifdef SLIMLOG_IO_URING
+        unsigned head = *m_cq_head;
+        const unsigned tail = __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++count) {
+            const auto cqe = m_cqes[head & m_cq_mask]; // NOLINT(*-pointer-arithmetic)
+            // Release the entry first, so that it is not consumed again if the callback throws
+            __atomic_store_n(m_cq_head, ++head, __ATOMIC_RELEASE);
+            callback(cqe.user_data, cqe.res);
+        }
+#endif
+        return count;
+    }
+
+private:
+    int m_fd = -1;
+    unsigned m_entries = 0;
+    unsigned m_queued = 0;
+#ifdef SLIMLOG_IO_URING
+    void* m_sq_ring = nullptr;
+    void* m_cq_ring = nullptr;
+    void* m_sqes = nullptr;
+    std::size_t m_sq_size = 0;
+    std::size_t m_cq_size = 0;
+    std::size_t m_sqes_size = 0;
+    unsigned* m_sq_head = nullptr;
+    unsigned* m_sq_tail = nullptr;
+    unsigned* m_sq_array = nullptr;
+    unsigned m_sq_mask = 0;
+    unsigned* m_cq_head = nullptr;
+    unsigned* m_cq_tail = nullptr;
+    unsigned m_cq_mask = 0;
+    io_uring_cqe* m_cqes = nullptr;
+#endif
+};
+
+} // namespace slimlog::util
@@ -0,0 +1,466 @@
+/**
+ * @file lz4.h
+ * @brief Contains an LZ4 block compressor and a reader of the LZ4 frame format.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace slimlog::util::lz4 {
+
+/** @brief Magic number of the LZ4 frame. */
+inline constexpr std::uint32_t FrameMagic = 0x184D2204;
+/** @brief Size of the frame header written by frame_header(). */
+inline constexpr std::size_t FrameHeaderSize = 7;
+/** @brief Flag of the block size field marking an uncompressed block. */
+inline constexpr std::uint32_t UncompressedFlag = 0x80000000U;
+/** @brief Smallest maximum block size of the frame format. */
+inline constexpr std::size_t MinBlockSize = std::size_t{64} * 1024;
+/** @brief Largest maximum block size of the frame format. */
+inline constexpr std::size_t MaxBlockSize = std::size_t{4} * 1024 * 1024;
+
+namespace detail {
+
+inline constexpr std::size_t MinMatch = 4;
+// The last 5 bytes are always literals, the last match starts at least 12 bytes before the end
+inline constexpr std::size_t LastLiterals = 5;
+inline constexpr std::size_t MatchFindLimit = 12;
+inline constexpr std::size_t MaxOffset = 65535;
+inline constexpr unsigned HashLog = 12;
+
+[[nodiscard]] inline auto read32(const std::byte* ptr) noexcept -> std::uint32_t
+{
+    std::uint32_t value = 0;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+[[nodiscard]] inline auto read_le32(const std::byte* ptr) noexcept -> std::uint32_t
+{
+    // NOLINTBEGIN(*-pointer-arithmetic)
+    return static_cast<std::uint32_t>(ptr[0]) | (static_cast<std::uint32_t>(ptr[1]) << 8)
+        | (static_cast<std::uint32_t>(ptr[2]) << 16) | (static_cast<std::uint32_t>(ptr[3]) << 24);
+    // NOLINTEND(*-pointer-arithmetic)
+}
+
+[[nodiscard]] inline auto hash(std::uint32_t sequence) noexcept -> std::uint32_t
+{
+    return (sequence * 2654435761U) >> (32 - HashLog);
+}
+
+[[nodiscard]] constexpr auto rotl(std::uint32_t value, int shift) noexcept -> std::uint32_t
+{
+    return (value << shift) | (value >> (32 - shift));
+}
+
+/** @brief Writes the length remainder as a sequence of 255 bytes and the last byte. */
+inline auto write_length(std::byte*& out, std::size_t length) noexcept -> void
+{
+    for (; length >= 255; length -= 255) {
+        *out++ = std::byte{255}; // NOLINT(*-pointer-arithmetic)
+    }
+    *out++ = static_cast<std::byte>(length); // NOLINT(*-pointer-arithmetic)
+}
+
+/** @brief Reads the length remainder, returns \b false if the input ends. */
+[[nodiscard]] inline auto
+read_length(const std::byte*& in, const std::byte* end, std::size_t& length) noexcept -> bool
+{
+    std::byte value{255};
+    while (value == std::byte{255}) {
+        if (in == end) {
+            return false;
+        }
+        value = *in++; // NOLINT(*-pointer-arithmetic)
+        length += static_cast<std::size_t>(value);
+    }
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Gets the maximum compressed size of the data.
+ *
+ * @param size Size of the uncompressed data in bytes.
+ * @return Size of the output buffer sufficient for compress().
+ */
+[[nodiscard]] constexpr auto compress_bound(std::size_t size) noexcept -> std::size_t
+{
+    return size + (size / 255) + 16;
+}
+
+/**
+ * @brief Computes the 32-bit xxHash of the data.
+ *
+ * Used for the header checksum of the LZ4 frame format.
+ *
+ * @param data Data to hash.
+ * @param size Size of the data in bytes.
+ * @param seed Hash seed.
+ * @return Hash value.
+ */
+[[nodiscard]] inline auto
+xxh32(const std::byte* data, std::size_t size, std::uint32_t seed = 0) noexcept -> std::uint32_t
+{
+    constexpr std::uint32_t Prime1 = 2654435761U;
+    constexpr std::uint32_t Prime2 = 2246822519U;
+    constexpr std::uint32_t Prime3 = 3266489917U;
+    constexpr std::uint32_t Prime4 = 668265263U;
+    constexpr std::uint32_t Prime5 = 374761393U;
+    const auto round = [](std::uint32_t acc, std::uint32_t input) {
+        return detail::rotl(acc + (input * Prime2), 13) * Prime1;
+    };
+
+    // NOLINTBEGIN(*-pointer-arithmetic)
+    const auto* ptr = data;
+    const auto* end = data + size;
+    std::uint32_t hash = 0;
+    if (size >= 16) {
+        std::array<std::uint32_t, 4> acc
+            = {seed + Prime1 + Prime2, seed + Prime2, seed, seed - Prime1};
+        for (; end - ptr >= 16; ptr += 16) {
+            for (std::size_t i = 0; i < acc.size(); ++i) {
+                acc[i] = round(acc[i], detail::read_le32(ptr + (i * 4)));
+            }
+        }
+        hash = detail::rotl(acc[0], 1) + detail::rotl(acc[1], 7) + detail::rotl(acc[2], 12)
+            + detail::rotl(acc[3], 18);
+    } else {
+        hash = seed + Prime5;
+    }
+    hash += static_cast<std::uint32_t>(size);
+    for (; end - ptr >= 4; ptr += 4) {
+        hash = detail::rotl(hash + (detail::read_le32(ptr) * Prime3), 17) * Prime4;
+    }
+    for (; ptr != end; ++ptr) {
+        hash = detail::rotl(hash + (static_cast<std::uint32_t>(*ptr) * Prime5), 11) * Prime1;
+    }
+    // NOLINTEND(*-pointer-arithmetic)
+    hash ^= hash >> 15;
+    hash *= Prime2;
+    hash ^= hash >> 13;
+    hash *= Prime3;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/**
+ * @brief Compresses the data into a single LZ4 block.
+ *
+ * Greedy single-pass matcher with a 4096-entry hash table, the output
+ * is decodable by any LZ4 implementation. Lines of a log share long
+ * prefixes (time, level, category, source location), which this
+ * finds without the cost of a deeper search.
+ *
+ * @param src Data to compress.
+ * @param size Size of the data in bytes.
+ * @param dst Output buffer.
+ * @param capacity Size of the output buffer, at least compress_bound(size) to always succeed.
+ * @return Size of the compressed block, zero if it does not fit into the output buffer.
+ */
+[[nodiscard]] inline auto
+compress(const std::byte* src, std::size_t size, std::byte* dst, std::size_t capacity) noexcept
+    -> std::size_t
+{
+    using namespace detail;
+    // NOLINTBEGIN(*-pointer-arithmetic)
+    std::array<std::uint32_t, std::size_t{1} << HashLog> table{};
+    std::byte* out = dst;
+    const std::byte* const out_end = dst + capacity;
+    std::size_t anchor = 0;
+
+    // Emits the literals since the anchor, followed by a match unless it is the last sequence
+    const auto emit = [&](std::size_t literals, std::size_t offset, std::size_t match) {
+        if (static_cast<std::size_t>(out_end - out)
+            < 1 + literals + (literals / 255) + 1 + (match > 0 ? 3 + (match / 255) : 0)) {
+            return false;
+        }
+        std::byte* token = out++;
+        *token = static_cast<std::byte>(std::min<std::size_t>(literals, 15) << 4);
+        if (literals >= 15) {
+            write_length(out, literals - 15);
+        }
+        std::memcpy(out, src + anchor, literals);
+        out += literals;
+        if (match == 0) {
+            return true;
+        }
+        *out++ = static_cast<std::byte>(offset & 0xFF);
+        *out++ = static_cast<std::byte>(offset >> 8);
+        const auto length = match - MinMatch;
+        *token |= static_cast<std::byte>(std::min<std::size_t>(length, 15));
+        if (length >= 15) {
+            write_length(out, length - 15);
+        }
+        return true;
+    };
+
+    if (size > MatchFindLimit) {
+        const std::size_t limit = size - MatchFindLimit;
+        const std::size_t match_limit = size - LastLiterals;
+        std::size_t pos = 1;
+        table[hash(read32(src))] = 0;
+        // Skip faster through data without matches
+        unsigned attempts = 1U << 6;
+        while (pos <= limit) {
+            const auto sequence = read32(src + pos);
+            auto& slot = table[hash(sequence)];
+            std::size_t ref = slot;
+            slot = static_cast<std::uint32_t>(pos);
+            if (pos - ref > MaxOffset || read32(src + ref) != sequence) {
+                pos += attempts++ >> 6;
+                continue;
+            }
+            attempts = 1U << 6;
+
+            while (pos > anchor && ref > 0 && src[pos - 1] == src[ref - 1]) {
+                --pos;
+                --ref;
+            }
+            std::size_t length = MinMatch;
+            while (pos + length < match_limit && src[pos + length] == src[ref + length]) {
+                ++length;
+            }
+            if (!emit(pos - anchor, pos - ref, length)) {
+                return 0;
+            }
+            pos += length;
+            anchor = pos;
+            if (pos <= limit) {
+                table[hash(read32(src + pos - 2))] = static_cast<std::uint32_t>(pos - 2);
+            }
+        }
+    }
+
+    if (!emit(size - anchor, 0, 0)) {
+        return 0;
+    }
+    return static_cast<std::size_t>(out - dst);
+    // NOLINTEND(*-pointer-arithmetic)
+}
+
+/**
+ * @brief Decompresses a single LZ4 block.
+ *
+ * Matches may reference up to `history` bytes preceding the output buffer,
+ * which holds the previous block in frames with linked blocks.
+ *
+ * @param src Compressed block.
+ * @param size Size of the compressed block in bytes.
+ * @param dst Output buffer.
+ * @param capacity Size of the output buffer.
+ * @param history Number of decoded bytes available before the output buffer.
+ * @return Size of the decompressed data, or empty value if the block is malformed.
+ */
+[[nodiscard]] inline auto decompress(
+    const std::byte* src,
+    std::size_t size,
+    std::byte* dst,
+    std::size_t capacity,
+    std::size_t history = 0) noexcept -> std::optional<std::size_t>
+{
+    using namespace detail;
+    // NOLINTBEGIN(*-pointer-arithmetic)
+    const std::byte* in = src;
+    const std::byte* const in_end = src + size;
+    std::size_t pos = 0;
+    while (in != in_end) {
+        const auto token = static_cast<std::size_t>(*in++);
+        std::size_t literals = token >> 4;
+        if (literals == 15 && !read_length(in, in_end, literals)) {
+            return std::nullopt;
+        }
+        if (literals > static_cast<std::size_t>(in_end - in) || literals > capacity - pos) {
+            return std::nullopt;
+        }
+        std::memcpy(dst + pos, in, literals);
+        in += literals;
+        pos += literals;
+        if (in == in_end) {
+            // The last sequence has no match
+            break;
+        }
+
+        if (in_end - in < 2) {
+            return std::nullopt;
+        }
+        const auto offset
+            = static_cast<std::size_t>(in[0]) | (static_cast<std::size_t>(in[1]) << 8);
+        in += 2;
+        std::size_t length = token & 15;
+        if (length == 15 && !read_length(in, in_end, length)) {
+            return std::nullopt;
+        }
+        length += MinMatch;
+        if (offset == 0 || offset > pos + history || length > capacity - pos) {
+            return std::nullopt;
+        }
+        const std::byte* match = dst + pos - offset;
+        if (offset >= length) {
+            std::memcpy(dst + pos, match, length);
+        } else {
+            // Overlapping copy repeats the last bytes
+            for (std::size_t i = 0; i < length; ++i) {
+                dst[pos + i] = match[i];
+            }
+        }
+        pos += length;
+    }
+    return pos;
+    // NOLINTEND(*-pointer-arithmetic)
+}
+
+/**
+ * @brief Rounds the block size up to a maximum block size of the frame format.
+ *
+ * @param size Requested block size in bytes.
+ * @return 64 KiB, 256 KiB, 1 MiB or 4 MiB.
+ */
+[[nodiscard]] constexpr auto frame_block_size(std::size_t size) noexcept -> std::size_t
+{
+    std::size_t result = MinBlockSize;
+    while (result < size && result < MaxBlockSize) {
+        result *= 4;
+    }
+    return result;
+}
+
+/**
+ * @brief Creates the header of a frame with independent blocks.
+ *
+ * The frame has no checksums and no content size, so it can be written
+ * block by block without seeking back.
+ *
+ * @param block_size Maximum block size, one of the values of frame_block_size().
+ * @return Header bytes.
+ */
+[[nodiscard]] inline auto frame_header(std::size_t block_size) noexcept
+    -> std::array<std::byte, FrameHeaderSize>
+{
+    unsigned code = 4;
+    for (auto size = MinBlockSize; size < block_size && code < 7; size *= 4) {
+        ++code;
+    }
+    // Version 01, independent blocks
+    constexpr std::byte Flags{0x60};
+    const auto descriptor = static_cast<std::byte>(code << 4);
+    const std::array<std::byte, 2> checked = {Flags, descriptor};
+    return {
+        static_cast<std::byte>(FrameMagic & 0xFF),
+        static_cast<std::byte>((FrameMagic >> 8) & 0xFF),
+        static_cast<std::byte>((FrameMagic >> 16) & 0xFF),
+        static_cast<std::byte>(FrameMagic >> 24),
+        Flags,
+        descriptor,
+        static_cast<std::byte>((xxh32(checked.data(), checked.size()) >> 8) & 0xFF)};
+}
+
+/**
+ * @brief Decodes a sequence of LZ4 frames.
+ *
+ * Accepts any frames of the format (linked blocks, checksums, content size),
+ * skippable frames are ignored. Checksums are not verified. The input may end
+ * in the middle of a frame or a block, as left by a crashed writer: the complete
+ * blocks are decoded and the rest is ignored.
+ *
+ * @param data Frames to decode.
+ * @param out Vector to append the decoded data to.
+ * @return \b false if the data is not in the LZ4 frame format or is corrupted.
+ */
+[[nodiscard]] inline auto
+decompress_frames(std::span<const std::byte> data, std::vector<std::byte>& out) -> bool
+{
+    using detail::read_le32;
+    // NOLINTBEGIN(*-pointer-arithmetic)
+    const std::byte* in = data.data();
+    const std::byte* const end = in + data.size();
+    const auto available = [&in, end]() { return static_cast<std::size_t>(end - in); };
+    while (available() >= 4) {
+        const auto magic = read_le32(in);
+        in += 4;
+        if ((magic & 0xFFFFFFF0U) == 0x184D2A50U) {
+            // Skippable frame
+            if (available() < 4 || available() - 4 < read_le32(in)) {
+                return true;
+            }
+            in += 4 + static_cast<std::size_t>(read_le32(in));
+            continue;
+        }
+        if (magic != FrameMagic) {
+            return false;
+        }
+        if (available() < 2) {
+            return true;
+        }
+        const auto flags = static_cast<unsigned>(in[0]);
+        const auto code = (static_cast<unsigned>(in[1]) >> 4) & 7;
+        if ((flags >> 6) != 1 || code < 4) {
+            return false;
+        }
+        const bool block_checksum = (flags & 0x10) != 0;
+        const bool content_checksum = (flags & 0x04) != 0;
+        // Descriptor, optional content size and dictionary ID, header checksum
+        const std::size_t header
+            = 3U + ((flags & 0x08) != 0 ? 8U : 0U) + ((flags & 0x01) != 0 ? 4U : 0U);
+        if (available() < header) {
+            return true;
+        }
+        in += header;
+        const std::size_t block_max = std::size_t{1} << (8 + (2 * code));
+        const std::size_t frame_start = out.size();
+
+        for (;;) {
+            if (available() < 4) {
+                return true;
+            }
+            const auto block = read_le32(in);
+            in += 4;
+            if (block == 0) {
+                // End mark
+                if (content_checksum) {
+                    if (available() < 4) {
+                        return true;
+                    }
+                    in += 4;
+                }
+                break;
+            }
+            const std::size_t size = block & ~UncompressedFlag;
+            if (size > block_max) {
+                return false;
+            }
+            if (available() < size + (block_checksum ? 4 : 0)) {
+                return true;
+            }
+            const auto pos = out.size();
+            if ((block & UncompressedFlag) != 0) {
+                out.insert(out.end(), in, in + size);
+            } else {
+                out.resize(pos + block_max);
+                // Linked blocks reference up to 64 KiB of the previous data of the frame
+                const auto history = (flags & 0x20) != 0 ? 0 : pos - frame_start;
+                const auto decoded
+                    = lz4::decompress(in, size, out.data() + pos, block_max, history);
+                if (!decoded) {
+                    out.resize(pos);
+                    return false;
+                }
+                out.resize(pos + *decoded);
+            }
+            in += size + (block_checksum ? 4 : 0);
+        }
+    }
+    // NOLINTEND(*-pointer-arithmetic)
+    return true;
+}
+
+} // namespace slimlog::util::lz4
@@ -5,10 +5,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <ctime>
 #include <memory>
+#include <span>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -28,9 +35,15 @@
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
 #endif
+#include <fcntl.h> // for _O_BINARY
+#include <io.h> // for _write, _fileno
+#include <process.h> // for _getpid
 #include <share.h> // for _SH_DENYWR
 #include <windows.h> // for GetCurrentThreadId
 #else
+#include <fcntl.h> // for open, fallocate, F_ADD_SEALS
+#include <sys/mman.h> // for mmap, memfd_create
+#include <sys/uio.h> // for writev
 #include <unistd.h>
 #ifdef __linux__
 #include <sys/syscall.h> // use gettid() syscall under linux to get thread id
@@ -263,6 +276,28 @@ inline void atomic_store_relaxed(T* ptr, T value) noexcept
     return std::make_pair(cached_local, static_cast<std::size_t>(curtime.tv_nsec));
 }
 
+/**
+ * @brief Gets the current offset of the local time from UTC.
+ *
+ * @return Offset to add to UTC to get the local time.
+ */
+[[nodiscard]] inline auto utc_offset() -> std::chrono::seconds
+{
+    const auto now = std::time(nullptr);
+    ::tm local_tm{};
+#ifdef _WIN32
+#ifdef __STDC_WANT_SECURE_LIB__
+    std::ignore = ::localtime_s(&local_tm, &now);
+#else
+    local_tm = *::localtime(&now);
+#endif
+    return std::chrono::seconds(::_mkgmtime(&local_tm) - now);
+#else
+    std::ignore = ::localtime_r(&now, &local_tm);
+    return std::chrono::seconds(local_tm.tm_gmtoff);
+#endif
+}
+
 /**
  * @brief Wrapper for fopen with shared read access on Windows.
  *
@@ -306,4 +341,471 @@ inline void atomic_store_relaxed(T* ptr, T value) noexcept
 #endif
 }
 
+/**
+ * @brief Gets the file descriptor of a stream.
+ *
+ * @param stream Open file stream.
+ * @return File descriptor.
+ */
+[[nodiscard]] inline auto file_descriptor(FILE* stream) noexcept -> int
+{
+#ifdef _WIN32
+    return _fileno(stream);
+#else
+    return ::fileno(stream);
+#endif
+}
+
+/**
+ * @brief Reserves disk space for a file without changing its size.
+ *
+ * Subsequent appends within the reserved range do not allocate new extents.
+ * Only supported on Linux (`fallocate()` with `FALLOC_FL_KEEP_SIZE`),
+ * elsewhere the call does nothing.
+ *
+ * @param fd File descriptor.
+ * @param size Number of bytes to reserve from the beginning of the file.
+ * @return \b true if the space was reserved.
+ */
+inline auto preallocate([[maybe_unused]] int fd, [[maybe_unused]] std::size_t size) noexcept
+    -> bool
+{
+#ifdef __linux__
+    return ::fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size)) == 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Gets the alignment required for file mapping offsets.
+ *
+ * @return Page size on POSIX systems, allocation granularity on Windows.
+ */
+[[nodiscard]] inline auto map_granularity() noexcept -> std::size_t
+{
+#ifdef _WIN32
+    ::SYSTEM_INFO info{};
+    ::GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+#else
+    return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+}
+
+/**
+ * @brief Changes the size of a file, filling the extension with zeros.
+ *
+ * @param fd File descriptor.
+ * @param size New file size in bytes.
+ * @return \b true on success, \b false on error (see `errno`).
+ */
+[[nodiscard]] inline auto resize_file(int fd, std::uint64_t size) noexcept -> bool
+{
+#ifdef _WIN32
+    return _chsize_s(fd, static_cast<__int64>(size)) == 0;
+#else
+    return ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+#endif
+}
+
+/**
+ * @brief Maps a region of a file to memory for reading and writing.
+ *
+ * Changes of the mapped memory are written back to the file by the system.
+ *
+ * @param fd File descriptor open for reading and writing.
+ * @param offset Offset in the file, must be a multiple of map_granularity().
+ * @param size Size of the region in bytes.
+ * @return Address of the mapped region, or `nullptr` on error.
+ */
+[[nodiscard]] inline auto map_file(int fd, std::uint64_t offset, std::size_t size) noexcept
+    -> void*
+{
+#ifdef _WIN32
+    const auto end = offset + size;
+    ::HANDLE mapping = ::CreateFileMappingW(
+        reinterpret_cast<::HANDLE>(_get_osfhandle(fd)), // NOLINT(*-reinterpret-cast)
+        nullptr,
+        PAGE_READWRITE,
+        static_cast<::DWORD>(end >> 32U),
+        static_cast<::DWORD>(end & 0xFFFFFFFFU),
+        nullptr);
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+    // The view keeps the mapping object alive
+    void* ptr = ::MapViewOfFile(
+        mapping,
+        FILE_MAP_WRITE,
+        static_cast<::DWORD>(offset >> 32U),
+        static_cast<::DWORD>(offset & 0xFFFFFFFFU),
+        size);
+    ::CloseHandle(mapping);
+    return ptr;
+#else
+    void* ptr
+        = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, static_cast<off_t>(offset));
+    return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+}
+
+/**
+ * @brief Maps a region of a file to memory for reading.
+ *
+ * @param fd File descriptor open for reading.
+ * @param offset Offset in the file, must be a multiple of map_granularity().
+ * @param size Size of the region in bytes.
+ * @return Address of the mapped region, or `nullptr` on error.
+ */
+[[nodiscard]] inline auto map_file_readonly(int fd, std::uint64_t offset, std::size_t size) noexcept
+    -> const void*
+{
+#ifdef _WIN32
+    ::HANDLE mapping = ::CreateFileMappingW(
+        reinterpret_cast<::HANDLE>(_get_osfhandle(fd)), // NOLINT(*-reinterpret-cast)
+        nullptr,
+        PAGE_READONLY,
+        0,
+        0,
+        nullptr);
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+    const void* ptr = ::MapViewOfFile(
+        mapping,
+        FILE_MAP_READ,
+        static_cast<::DWORD>(offset >> 32U),
+        static_cast<::DWORD>(offset & 0xFFFFFFFFU),
+        size);
+    ::CloseHandle(mapping);
+    return ptr;
+#else
+    void* ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(offset));
+    return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+}
+
+/**
+ * @brief Unmaps a region mapped with map_file() or map_file_readonly().
+ *
+ * @param ptr Address of the mapped region.
+ * @param size Size of the region in bytes.
+ */
+inline auto unmap_file(const void* ptr, [[maybe_unused]] std::size_t size) noexcept -> void
+{
+#ifdef _WIN32
+    ::UnmapViewOfFile(ptr);
+#else
+    ::munmap(const_cast<void*>(ptr), size); // NOLINT(*-const-cast)
+#endif
+}
+
+/**
+ * @brief Schedules writeback of a mapped region without waiting for it.
+ *
+ * @param ptr Address within the mapped region, must be a multiple of map_granularity().
+ * @param size Size of the range in bytes.
+ * @return \b true on success, \b false on error.
+ */
+inline auto sync_mapping(void* ptr, std::size_t size) noexcept -> bool
+{
+#ifdef _WIN32
+    return ::FlushViewOfFile(ptr, size) != 0;
+#else
+    return ::msync(ptr, size, MS_ASYNC) == 0;
+#endif
+}
+
+/**
+ * @brief Memory region to be written by write_vector().
+ */
+struct WriteBuffer {
+    const void* data; ///< Pointer to the data.
+    std::size_t size; ///< Size of the data in bytes.
+};
+
+/**
+ * @brief Writes several buffers to a file descriptor with a single system call.
+ *
+ * Uses `writev()` on POSIX systems. On Windows, only the first non-empty buffer
+ * is written with `_write()`. In both cases the write can be partial,
+ * so the caller is expected to repeat the call for the remaining data.
+ *
+ * @param fd File descriptor.
+ * @param buffers Buffers to write, at most 16 of them are written at once.
+ * @return Number of bytes written, or -1 on error (see `errno`).
+ */
+[[nodiscard]] inline auto write_vector(int fd, std::span<const WriteBuffer> buffers)
+    -> std::ptrdiff_t
+{
+#ifdef _WIN32
+    const auto buffer
+        = std::ranges::find_if(buffers, [](const WriteBuffer& item) { return item.size > 0; });
+    if (buffer == buffers.end()) {
+        return 0;
+    }
+    // _write() takes the size as unsigned int
+    constexpr std::size_t MaxWrite = 1U << 30U;
+    return _write(fd, buffer->data, static_cast<unsigned>(std::min(buffer->size, MaxWrite)));
+#else
+    constexpr std::size_t MaxBuffers = 16;
+    std::array<::iovec, MaxBuffers> iov{};
+    const auto count = std::min(buffers.size(), MaxBuffers);
+    for (std::size_t i = 0; i < count; ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        iov[i] = {const_cast<void*>(buffers[i].data), buffers[i].size};
+    }
+    return ::writev(fd, iov.data(), static_cast<int>(count));
+#endif
+}
+
+/**
+ * @brief Opens a file for unbuffered writing, bypassing the page cache.
+ *
+ * Uses `O_DIRECT` where available, `F_NOCACHE` on macOS and `FILE_FLAG_NO_BUFFERING`
+ * on Windows. Reads and writes must then use buffers, sizes and offsets aligned
+ * to the logical block size of the device. If the file system does not support
+ * unbuffered access, the file is opened normally.
+ *
+ * @param filename Path to the file, created if it does not exist.
+ * @param direct Set to \b true if the page cache is bypassed.
+ * @return File descriptor open for reading and writing, or -1 on error (see `errno`).
+ */
+[[nodiscard]] inline auto open_direct(const char* filename, bool& direct) noexcept -> int
+{
+#ifdef _WIN32
+    for (const ::DWORD flags : {FILE_FLAG_NO_BUFFERING, 0UL}) {
+        ::HANDLE handle = ::CreateFileA(
+            filename,
+            GENERIC_READ | GENERIC_WRITE,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL | flags,
+            nullptr);
+        if (handle != INVALID_HANDLE_VALUE) {
+            direct = flags != 0;
+            // NOLINTNEXTLINE(*-reinterpret-cast)
+            return _open_osfhandle(reinterpret_cast<std::intptr_t>(handle), _O_BINARY);
+        }
+    }
+    return -1;
+#else
+    constexpr int Flags = O_RDWR | O_CREAT | O_CLOEXEC;
+    constexpr ::mode_t Mode = 0644;
+#ifdef O_DIRECT
+    // NOLINTNEXTLINE(*-vararg)
+    if (const int fd = ::open(filename, Flags | O_DIRECT, Mode); fd >= 0 || errno != EINVAL) {
+        direct = fd >= 0;
+        return fd;
+    }
+#endif
+    const int fd = ::open(filename, Flags, Mode); // NOLINT(*-vararg)
+#ifdef F_NOCACHE
+    direct = fd >= 0 && ::fcntl(fd, F_NOCACHE, 1) == 0; // NOLINT(*-vararg)
+#else
+    direct = false;
+#endif
+    return fd;
+#endif
+}
+
+/**
+ * @brief Closes a file descriptor.
+ *
+ * @param fd File descriptor.
+ */
+inline auto close_file(int fd) noexcept -> void
+{
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+/**
+ * @brief Writes data at an offset without changing the file position.
+ *
+ * @param fd File descriptor.
+ * @param data Data to write.
+ * @param size Size of the data in bytes.
+ * @param offset Offset in the file.
+ * @return Number of bytes written, or -1 on error (see `errno`).
+ */
+[[nodiscard]] inline auto
+write_at(int fd, const void* data, std::size_t size, std::uint64_t offset) noexcept
+    -> std::ptrdiff_t
+{
+#ifdef _WIN32
+    ::OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<::DWORD>(offset & 0xFFFFFFFFU);
+    overlapped.OffsetHigh = static_cast<::DWORD>(offset >> 32U);
+    ::DWORD written = 0;
+    if (::WriteFile(
+            reinterpret_cast<::HANDLE>(_get_osfhandle(fd)), // NOLINT(*-reinterpret-cast)
+            data,
+            static_cast<::DWORD>(std::min<std::size_t>(size, 1U << 30U)),
+            &written,
+            &overlapped)
+        == 0) {
+        return -1;
+    }
+    return written;
+#else
+    return ::pwrite(fd, data, size, static_cast<off_t>(offset));
+#endif
+}
+
+/**
+ * @brief Reads data at an offset without changing the file position.
+ *
+ * @param fd File descriptor.
+ * @param data Buffer for the data.
+ * @param size Size of the buffer in bytes.
+ * @param offset Offset in the file.
+ * @return Number of bytes read, or -1 on error (see `errno`).
+ */
+[[nodiscard]] inline auto
+read_at(int fd, void* data, std::size_t size, std::uint64_t offset) noexcept -> std::ptrdiff_t
+{
+#ifdef _WIN32
+    ::OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<::DWORD>(offset & 0xFFFFFFFFU);
+    overlapped.OffsetHigh = static_cast<::DWORD>(offset >> 32U);
+    ::DWORD read = 0;
+    if (::ReadFile(
+            reinterpret_cast<::HANDLE>(_get_osfhandle(fd)), // NOLINT(*-reinterpret-cast)
+            data,
+            static_cast<::DWORD>(std::min<std::size_t>(size, 1U << 30U)),
+            &read,
+            &overlapped)
+        == 0) {
+        return ::GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+    }
+    return read;
+#else
+    return ::pread(fd, data, size, static_cast<off_t>(offset));
+#endif
+}
+
+/**
+ * @brief Waits until the data of a file reaches the storage device.
+ *
+ * Uses `fdatasync()`, which skips metadata not needed to read the data back,
+ * `fsync()` on macOS and `_commit()` on Windows.
+ *
+ * @param fd File descriptor.
+ * @return \b true on success, \b false on error (see `errno`).
+ */
+[[nodiscard]] inline auto sync_file(int fd) noexcept -> bool
+{
+#ifdef _WIN32
+    return _commit(fd) == 0;
+#elif defined(__APPLE__)
+    return ::fsync(fd) == 0;
+#else
+    return ::fdatasync(fd) == 0;
+#endif
+}
+
+/**
+ * @brief Gets the identifier of the current process.
+ *
+ * @return Process ID.
+ */
+[[nodiscard]] inline auto process_id() noexcept -> std::uint64_t
+{
+#ifdef _WIN32
+    return static_cast<std::uint64_t>(_getpid());
+#else
+    return static_cast<std::uint64_t>(::getpid());
+#endif
+}
+
+/**
+ * @brief Gets the network name of the host.
+ *
+ * @return Host name, or an empty string if it is not available.
+ */
+[[nodiscard]] inline auto host_name() -> std::string
+{
+#ifdef _WIN32
+    std::array<char, MAX_COMPUTERNAME_LENGTH + 1> name{};
+    auto size = static_cast<::DWORD>(name.size());
+    return ::GetComputerNameA(name.data(), &size) != 0 ? std::string(name.data(), size) : "";
+#else
+    std::array<char, 256> name{};
+    if (::gethostname(name.data(), name.size() - 1) != 0) {
+        return {};
+    }
+    return name.data();
+#endif
+}
+
+/**
+ * @brief Gets the name of the program executable, without the directory.
+ *
+ * @return Program name, or an empty string if it is not available.
+ */
+[[nodiscard]] inline auto program_name() -> std::string
+{
+#ifdef _WIN32
+    std::array<char, MAX_PATH> path{};
+    const auto size = ::GetModuleFileNameA(nullptr, path.data(), static_cast<::DWORD>(path.size()));
+    std::string name(path.data(), size);
+    if (const auto pos = name.find_last_of("\\/"); pos != std::string::npos) {
+        name.erase(0, pos + 1);
+    }
+    if (name.ends_with(".exe")) {
+        name.resize(name.size() - 4);
+    }
+    return name;
+#elif defined(__GLIBC__)
+    return ::program_invocation_short_name;
+#elif defined(__APPLE__) || defined(__DragonFly__) || defined(__FreeBSD__) \
+    || defined(__NetBSD__) || defined(__OpenBSD__)
+    const char* name = ::getprogname();
+    return name != nullptr ? name : "";
+#else
+    return {};
+#endif
+}
+
+/**
+ * @brief Creates an anonymous file in memory which can be sealed.
+ *
+ * Uses `memfd_create()` on Linux, other systems fail with `ENOTSUP`.
+ *
+ * @param name Name of the file, only used for debugging.
+ * @return File descriptor open for reading and writing, or -1 on error (see `errno`).
+ */
+[[nodiscard]] inline auto create_memory_file([[maybe_unused]] const char* name) noexcept -> int
+{
+#if defined(__linux__) && defined(MFD_ALLOW_SEALING)
+    return ::memfd_create(name, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#else
+    errno = ENOTSUP;
+    return -1;
+#endif
+}
+
+/**
+ * @brief Seals a file created with create_memory_file() against any further change.
+ *
+ * @param fd File descriptor.
+ * @return \b true on success, \b false on error (see `errno`).
+ */
+[[nodiscard]] inline auto seal_memory_file([[maybe_unused]] int fd) noexcept -> bool
+{
+#if defined(__linux__) && defined(F_ADD_SEALS)
+    constexpr int Seals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL;
+    return ::fcntl(fd, F_ADD_SEALS, Seals) == 0; // NOLINT(*-vararg)
+#else
+    errno = ENOTSUP;
+    return false;
+#endif
+}
+
 } // namespace slimlog::util::os
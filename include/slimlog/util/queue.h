@@ -0,0 +1,198 @@
+/**
+ * @file queue.h
+ * @brief Contains the bounded lock-free queue used by asynchronous sinks.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace slimlog::util {
+
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer queue.
+ *
+ * Ring of preallocated cells, each guarded by its own sequence number
+ * (Dmitry Vyukov's bounded MPMC algorithm). Producers and consumers
+ * claim positions with a single CAS and then work on the cell in place,
+ * so elements are never moved or allocated after construction.
+ *
+ * Elements are accessed via callbacks: `try_push()` passes a reference
+ * to a free cell to be filled, `try_pop()` passes a reference to a ready cell
+ * to be consumed. The cell is published only after the callback returns.
+ *
+ * @tparam T Element type. Must be default constructible.
+ */
+template<typename T>
+class BoundedQueue final {
+public:
+    /**
+     * @brief Constructs a new BoundedQueue object.
+     *
+     * @param capacity Minimum number of elements. Rounded up to the nearest power of two.
+     */
+    explicit BoundedQueue(std::size_t capacity)
+        : m_capacity(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity))
+        , m_mask(m_capacity - 1)
+        , m_cells(std::make_unique<Cell[]>(m_capacity)) // NOLINT(*-avoid-c-arrays)
+    {
+        for (std::size_t i = 0; i < m_capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue(BoundedQueue&&) = delete;
+    auto operator=(const BoundedQueue&) -> BoundedQueue& = delete;
+    auto operator=(BoundedQueue&&) -> BoundedQueue& = delete;
+    ~BoundedQueue() = default;
+
+    /**
+     * @brief Tries to enqueue an element.
+     *
+     * If the callback throws, the cell is still published to keep the ring consistent,
+     * so the callback should leave the element in a state recognizable by consumers.
+     *
+     * @tparam Func Callback type, invocable with `T&`.
+     * @param fill Callback to fill the claimed element.
+     * @return \b true if the element was enqueued.
+     * @return \b false if the queue is full.
+     */
+    template<typename Func>
+    auto try_push(Func&& fill) -> bool
+    {
+        std::size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueue_pos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        const Publisher publisher{cell, pos + 1};
+        std::forward<Func>(fill)(cell->data);
+        return true;
+    }
+
+    /**
+     * @brief Tries to dequeue an element.
+     *
+     * @tparam Func Callback type, invocable with `T&`.
+     * @param consume Callback to process the dequeued element.
+     * @return \b true if an element was dequeued.
+     * @return \b false if the queue is empty.
+     */
+    template<typename Func>
+    auto try_pop(Func&& consume) -> bool
+    {
+        std::size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff
+                = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (m_dequeue_pos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        const Publisher publisher{cell, pos + m_capacity};
+        std::forward<Func>(consume)(cell->data);
+        return true;
+    }
+
+    /**
+     * @brief Checks if there is an element ready to be dequeued.
+     *
+     * @return \b true if the queue has no published elements.
+     */
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        const std::size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+        const std::size_t seq = m_cells[pos & m_mask].sequence.load(std::memory_order_acquire);
+        return static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1) < 0;
+    }
+
+    /**
+     * @brief Returns the total number of positions claimed by producers so far.
+     *
+     * @return Monotonic producer position.
+     */
+    [[nodiscard]] auto push_count() const noexcept -> std::size_t
+    {
+        return m_enqueue_pos.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Returns the queue capacity.
+     *
+     * @return Maximum number of elements.
+     */
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t
+    {
+        return m_capacity;
+    }
+
+private:
+    // Not using std::hardware_destructive_interference_size as it is not ABI-stable
+    static constexpr std::size_t CacheLineSize = 64;
+
+    struct alignas(CacheLineSize) Cell {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    /** @brief Publishes the cell sequence on scope exit, even if the callback throws. */
+    struct Publisher {
+        Publisher(const Publisher&) = delete;
+        Publisher(Publisher&&) = delete;
+        auto operator=(const Publisher&) -> Publisher& = delete;
+        auto operator=(Publisher&&) -> Publisher& = delete;
+
+        Publisher(Cell* cell, std::size_t sequence) noexcept
+            : m_cell(cell)
+            , m_sequence(sequence)
+        {
+        }
+
+        ~Publisher()
+        {
+            m_cell->sequence.store(m_sequence, std::memory_order_release);
+        }
+
+    private:
+        Cell* m_cell;
+        std::size_t m_sequence;
+    };
+
+    std::size_t m_capacity;
+    std::size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells; // NOLINT(*-avoid-c-arrays)
+    alignas(CacheLineSize) std::atomic<std::size_t> m_enqueue_pos{0};
+    alignas(CacheLineSize) std::atomic<std::size_t> m_dequeue_pos{0};
+};
+
+} // namespace slimlog::util
@@ -0,0 +1,452 @@
+/**
+ * @file socket.h
+ * @brief Contains minimal Unix domain and TCP socket clients.
+ */
+
+#pragma once
+
+#include "slimlog/util/os.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SLIMLOG_UNIX_SOCKET
+#include <fcntl.h> // for fcntl
+#include <netdb.h> // for getaddrinfo
+#include <netinet/in.h> // for IPPROTO_TCP
+#include <netinet/tcp.h> // for TCP_NODELAY
+#include <poll.h> // for poll
+#include <sys/socket.h> // for socket, sendmsg
+#include <sys/uio.h> // for iovec
+#include <sys/un.h> // for sockaddr_un
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#endif
+
+namespace slimlog::util {
+
+#ifdef SLIMLOG_UNIX_SOCKET
+namespace detail {
+#ifdef MSG_NOSIGNAL
+// A closed stream must not kill the process with SIGPIPE
+inline constexpr int SendFlags = MSG_NOSIGNAL;
+#else
+inline constexpr int SendFlags = 0;
+#endif
+} // namespace detail
+#endif
+
+/**
+ * @brief Unix domain socket connected to a local service.
+ *
+ * Connecting fixes the peer address, so each send() is a single `sendmsg()`
+ * of the given buffers. Datagram sockets deliver each send() as one message,
+ * and concurrent sends do not interleave.
+ *
+ * On systems without Unix domain sockets, connect() fails with `ENOTSUP`.
+ */
+class UnixSocket final {
+public:
+    /** @brief Socket type. */
+    enum class Type : std::uint8_t {
+        Datagram, ///< Message boundaries are preserved, e.g. `/dev/log`.
+        Stream ///< Byte stream.
+    };
+
+    UnixSocket() = default;
+    UnixSocket(const UnixSocket&) = delete;
+    UnixSocket(UnixSocket&&) = delete;
+    auto operator=(const UnixSocket&) -> UnixSocket& = delete;
+    auto operator=(UnixSocket&&) -> UnixSocket& = delete;
+
+    /**
+     * @brief Closes the socket.
+     */
+    ~UnixSocket()
+    {
+        close();
+    }
+
+    /**
+     * @brief Creates the socket and connects it to a path.
+     *
+     * @param path Path of the socket to connect to.
+     * @param type Socket type.
+     * @param nonblocking Set to \b true to fail with `EAGAIN` instead of waiting
+     *                    for space in the socket buffer.
+     * @return \b true on success, \b false on error (see `errno`).
+     */
+    [[nodiscard]] auto connect(
+        [[maybe_unused]] std::string_view path,
+        [[maybe_unused]] Type type,
+        [[maybe_unused]] bool nonblocking) noexcept -> bool
+    {
+#ifdef SLIMLOG_UNIX_SOCKET
+        close();
+        m_address = {};
+        m_address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(m_address.sun_path)) {
+            errno = ENAMETOOLONG;
+            return false;
+        }
+        std::ranges::copy(path, std::begin(m_address.sun_path));
+        m_type = type;
+        m_nonblocking = nonblocking;
+        m_fd = open();
+        return m_fd >= 0;
+#else
+        errno = ENOTSUP;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Connects a new socket to the same path, e.g. after the service restarted.
+     *
+     * The new socket takes over the descriptor of the old one, so concurrent
+     * send() calls use either socket but never a closed descriptor.
+     *
+     * @return \b true on success, \b false on error (see `errno`).
+     */
+    [[nodiscard]] auto reconnect() noexcept -> bool
+    {
+#ifdef SLIMLOG_UNIX_SOCKET
+        if (m_fd < 0) {
+            errno = ENOTCONN;
+            return false;
+        }
+        const int fd = open();
+        if (fd < 0) {
+            return false;
+        }
+        const bool replaced = ::dup2(fd, m_fd) >= 0;
+        ::close(fd);
+        return replaced;
+#else
+        errno = ENOTSUP;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Sends several buffers with a single system call.
+     *
+     * @param buffers Buffers to send, at most MaxBuffers are sent.
+     * @return Number of bytes sent, or -1 on error (see `errno`).
+     */
+    [[nodiscard]] auto
+    send([[maybe_unused]] std::span<const os::WriteBuffer> buffers) const noexcept
+        -> std::ptrdiff_t
+    {
+#ifdef SLIMLOG_UNIX_SOCKET
+        std::array<::iovec, MaxBuffers> iov{};
+        const auto count = std::min(buffers.size(), MaxBuffers);
+        for (std::size_t i = 0; i < count; ++i) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            iov[i] = {const_cast<void*>(buffers[i].data), buffers[i].size};
+        }
+        ::msghdr message{};
+        message.msg_iov = iov.data();
+        message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(count);
+        return ::sendmsg(m_fd, &message, detail::SendFlags);
+#else
+        errno = ENOTSUP;
+        return -1;
+#endif
+    }
+
+    /**
+     * @brief Sends an empty message passing a file descriptor to the peer.
+     *
+     * @param fd File descriptor to pass, it stays open in this process.
+     * @return Zero on success, or -1 on error (see `errno`).
+     */
+    [[nodiscard]] auto send_descriptor([[maybe_unused]] int fd) const noexcept -> std::ptrdiff_t
+    {
+#ifdef SLIMLOG_UNIX_SOCKET
+        // The union aligns the buffer for the control message header
+        union {
+            ::cmsghdr header;
+            std::array<char, CMSG_SPACE(sizeof(int))> data;
+        } control{};
+        ::msghdr message{};
+        message.msg_control = control.data.data();
+        message.msg_controllen = sizeof(control.data);
+        ::cmsghdr* header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(header), &fd, sizeof(fd));
+        return ::sendmsg(m_fd, &message, detail::SendFlags);
+#else
+        errno = ENOTSUP;
+        return -1;
+#endif
+    }
+
+    /**
+     * @brief Checks if the socket is connected.
+     *
+     * @return \b true if connect() succeeded.
+     */
+    [[nodiscard]] auto valid() const noexcept -> bool
+    {
+        return m_fd >= 0;
+    }
+
+    /**
+     * @brief Closes the socket.
+     */
+    auto close() noexcept -> void
+    {
+#ifdef SLIMLOG_UNIX_SOCKET
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+#endif
+    }
+
+    /** @brief Maximum number of buffers sent at once. */
+    static constexpr std::size_t MaxBuffers = 16;
+
+private:
+#ifdef SLIMLOG_UNIX_SOCKET
+    // Creates a socket connected to the address
+    [[nodiscard]] auto open() const noexcept -> int
+    {
+        const int fd = ::socket(AF_UNIX, m_type == Type::Datagram ? SOCK_DGRAM : SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC); // NOLINT(*-vararg)
+#ifdef SO_NOSIGPIPE
+        const int enable = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+        // NOLINTNEXTLINE(*-reinterpret-cast)
+        if (::connect(fd, reinterpret_cast<const ::sockaddr*>(&m_address), sizeof(m_address))
+            != 0) {
+            const int error = errno;
+            ::close(fd);
+            errno = error;
+            return -1;
+        }
+        // Set after connecting, so that connecting a stream socket does not return early
+        if (m_nonblocking) {
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK); // NOLINT(*-vararg)
+        }
+        return fd;
+    }
+
+    ::sockaddr_un m_address{};
+#endif
+    int m_fd = -1;
+    Type m_type = Type::Datagram;
+    bool m_nonblocking = false;
+};
+
+/**
+ * @brief Non-blocking stream socket connected to a TCP or Unix domain address.
+ *
+ * Connecting and sending wait at most for a given timeout,
+ * so the caller can give up on a peer which stopped reading.
+ *
+ * On systems without BSD sockets, connect() fails with `ENOTSUP`.
+ */
+class StreamSocket final {
+public:
+    StreamSocket() = default;
+    StreamSocket(const StreamSocket&) = delete;
+    StreamSocket(StreamSocket&&) = delete;
+    auto operator=(const StreamSocket&) -> StreamSocket& = delete;
+    auto operator=(StreamSocket&&) -> StreamSocket& = delete;
+
+    /**
+     * @brief Closes the socket.
+     */
+    ~StreamSocket()
+    {
+        close();
+    }
+
+    /**
+     * @brief Creates the socket and connects it to an address.
+     *
+     * @param address `HOST:PORT` for TCP, with an IPv6 host in brackets,
+     *                or `unix:PATH` for a Unix domain socket.
+     * @param timeout Maximum time to wait for the connection.
+     * @return \b true on success, \b false on error (see `errno`).
+     */
+    [[nodiscard]] auto connect(
+        [[maybe_unused]] std::string_view address,
+        [[maybe_unused]] std::chrono::milliseconds timeout) noexcept -> bool
+    {
+#ifdef SLIMLOG_UNIX_SOCKET
+        close();
+        if (address.starts_with("unix:")) {
+            const auto path = address.substr(5);
+            ::sockaddr_un unix_address{};
+            unix_address.sun_family = AF_UNIX;
+            if (path.empty() || path.size() >= sizeof(unix_address.sun_path)) {
+                errno = ENAMETOOLONG;
+                return false;
+            }
+            std::ranges::copy(path, std::begin(unix_address.sun_path));
+            // NOLINTNEXTLINE(*-reinterpret-cast)
+            const auto* addr = reinterpret_cast<const ::sockaddr*>(&unix_address);
+            m_fd = open(AF_UNIX, addr, sizeof(unix_address), timeout);
+            return m_fd >= 0;
+        }
+
+        // Host and port are copied to add the terminating zeros
+        std::array<char, 256> host{};
+        std::array<char, 16> port{};
+        const auto colon = address.rfind(':');
+        auto host_name = address.substr(0, std::min(colon, address.size()));
+        if (host_name.size() >= 2 && host_name.front() == '[' && host_name.back() == ']') {
+            host_name = host_name.substr(1, host_name.size() - 2);
+        }
+        if (colon == std::string_view::npos || host_name.size() >= host.size()
+            || address.size() - colon - 1 >= port.size()) {
+            errno = EINVAL;
+            return false;
+        }
+        host_name.copy(host.data(), host_name.size());
+        address.substr(colon + 1).copy(port.data(), port.size() - 1);
+
+        ::addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        ::addrinfo* list = nullptr;
+        // Without a host, the loopback address is used
+        const char* node = host_name.empty() ? nullptr : host.data();
+        if (::getaddrinfo(node, port.data(), &hints, &list) != 0) {
+            errno = EHOSTUNREACH;
+            return false;
+        }
+        for (const auto* info = list; info != nullptr && m_fd < 0; info = info->ai_next) {
+            m_fd = open(info->ai_family, info->ai_addr, info->ai_addrlen, timeout);
+        }
+        const int error = errno;
+        ::freeaddrinfo(list);
+        if (m_fd < 0) {
+            errno = error;
+            return false;
+        }
+        // Data is already sent in batches, do not delay the last one
+        const int enable = 1;
+        ::setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        return true;
+#else
+        errno = ENOTSUP;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Sends data, waiting for space in the socket buffer if needed.
+     *
+     * @param data Data to send.
+     * @param size Size of the data in bytes.
+     * @param timeout Maximum time to wait for the peer to read.
+     * @return Number of bytes sent, which can be less than \a size,
+     *         or -1 on error (see `errno`), `EAGAIN` if the timeout expired.
+     */
+    [[nodiscard]] auto send(
+        [[maybe_unused]] const void* data,
+        [[maybe_unused]] std::size_t size,
+        [[maybe_unused]] std::chrono::milliseconds timeout) const noexcept -> std::ptrdiff_t
+    {
+#ifdef SLIMLOG_UNIX_SOCKET
+        auto result = ::send(m_fd, data, size, detail::SendFlags);
+        if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            ::pollfd poll_fd{m_fd, POLLOUT, 0};
+            if (::poll(&poll_fd, 1, static_cast<int>(timeout.count())) <= 0) {
+                errno = EAGAIN;
+                return -1;
+            }
+            result = ::send(m_fd, data, size, detail::SendFlags);
+        }
+        return result;
+#else
+        errno = ENOTSUP;
+        return -1;
+#endif
+    }
+
+    /**
+     * @brief Checks if the socket is connected.
+     *
+     * @return \b true if connect() succeeded.
+     */
+    [[nodiscard]] auto valid() const noexcept -> bool
+    {
+        return m_fd >= 0;
+    }
+
+    /**
+     * @brief Closes the socket.
+     */
+    auto close() noexcept -> void
+    {
+#ifdef SLIMLOG_UNIX_SOCKET
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+#endif
+    }
+
+private:
+#ifdef SLIMLOG_UNIX_SOCKET
+    // Creates a non-blocking socket connected to the address
+    [[nodiscard]] static auto open(
+        int family,
+        const ::sockaddr* address,
+        ::socklen_t size,
+        std::chrono::milliseconds timeout) noexcept -> int
+    {
+        const int fd = ::socket(family, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC); // NOLINT(*-vararg)
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK); // NOLINT(*-vararg)
+#ifdef SO_NOSIGPIPE
+        const int enable = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+        int error = 0;
+        if (::connect(fd, address, size) != 0) {
+            error = errno;
+            ::pollfd poll_fd{fd, POLLOUT, 0};
+            if (error == EINPROGRESS) {
+                error = ETIMEDOUT;
+                ::socklen_t length = sizeof(error);
+                if (::poll(&poll_fd, 1, static_cast<int>(timeout.count())) > 0) {
+                    ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+                }
+            }
+        }
+        if (error != 0) {
+            ::close(fd);
+            errno = error;
+            return -1;
+        }
+        return fd;
+    }
+#endif
+
+    int m_fd = -1;
+};
+
+} // namespace slimlog::util
@@ -379,4 +379,51 @@ auto from_utf8(T&& str) -> std::basic_string<Char>
     }
 }
 
+/**
+ * @brief Appends the code units to the output as UTF-8.
+ *
+ * UTF-16 surrogate pairs are combined, unpaired surrogates are encoded as is.
+ *
+ * @tparam Char The source character type.
+ * @param output Output string.
+ * @param data Pointer to UTF-8, UTF-16 or UTF-32 code units.
+ * @param size Number of code units.
+ */
+template<typename Char>
+auto append_utf8(std::string& output, const Char* data, std::size_t size) -> void
+{
+    // NOLINTBEGIN(*-magic-numbers,*-pointer-arithmetic,*-signed-bitwise)
+    for (std::size_t i = 0; i < size; ++i) {
+        auto codepoint = static_cast<std::uint32_t>(data[i]);
+        if constexpr (sizeof(Char) == 1) {
+            output.push_back(static_cast<char>(codepoint));
+            continue;
+        } else if constexpr (sizeof(Char) == 2) {
+            if (codepoint >= 0xD800 && codepoint < 0xDC00 && i + 1 < size) {
+                const auto low = static_cast<std::uint32_t>(data[i + 1]);
+                if (low >= 0xDC00 && low < 0xE000) {
+                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10U) + (low - 0xDC00);
+                    ++i;
+                }
+            }
+        }
+        if (codepoint < 0x80) {
+            output.push_back(static_cast<char>(codepoint));
+        } else if (codepoint < 0x800) {
+            output.push_back(static_cast<char>(0xC0 | (codepoint >> 6U)));
+            output.push_back(static_cast<char>(0x80 | (codepoint & 0x3FU)));
+        } else if (codepoint < 0x10000) {
+            output.push_back(static_cast<char>(0xE0 | (codepoint >> 12U)));
+            output.push_back(static_cast<char>(0x80 | ((codepoint >> 6U) & 0x3FU)));
+            output.push_back(static_cast<char>(0x80 | (codepoint & 0x3FU)));
+        } else {
+            output.push_back(static_cast<char>(0xF0 | (codepoint >> 18U)));
+            output.push_back(static_cast<char>(0x80 | ((codepoint >> 12U) & 0x3FU)));
+            output.push_back(static_cast<char>(0x80 | ((codepoint >> 6U) & 0x3FU)));
+            output.push_back(static_cast<char>(0x80 | (codepoint & 0x3FU)));
+        }
+    }
+    // NOLINTEND(*-magic-numbers,*-pointer-arithmetic,*-signed-bitwise)
+}
+
 } // namespace slimlog::util::unicode
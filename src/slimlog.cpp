@@ -1,10 +1,25 @@
 #include "slimlog/format.h"
 #include "slimlog/logger.h"
 #include "slimlog/pattern.h"
+#include "slimlog/sinks/async_sink.h"
+#include "slimlog/sinks/binary_file_sink.h"
+#include "slimlog/sinks/buffered_file_sink.h"
 #include "slimlog/sinks/callback_sink.h"
+#include "slimlog/sinks/category_file_sink.h"
+#include "slimlog/sinks/compressed_file_sink.h"
+#include "slimlog/sinks/direct_file_sink.h"
 #include "slimlog/sinks/file_sink.h"
+#include "slimlog/sinks/flight_recorder_sink.h"
+#include "slimlog/sinks/io_uring_file_sink.h"
+#include "slimlog/sinks/journald_sink.h"
+#include "slimlog/sinks/mapped_file_sink.h"
 #include "slimlog/sinks/null_sink.h"
 #include "slimlog/sinks/ostream_sink.h"
+#include "slimlog/sinks/rotating_file_sink.h"
+#include "slimlog/sinks/socket_sink.h"
+#include "slimlog/sinks/syslog_sink.h"
+#include "slimlog/sinks/time_rotating_file_sink.h"
+#include "slimlog/util/epoch.h"
 
 #ifndef SLIMLOG_HEADER_ONLY
 // IWYU pragma: begin_keep
@@ -12,9 +27,23 @@
 #include "slimlog/logger-inl.h"
 #include "slimlog/pattern-inl.h"
 #include "slimlog/sink-inl.h"
+#include "slimlog/sinks/async_sink-inl.h"
+#include "slimlog/sinks/binary_file_sink-inl.h"
+#include "slimlog/sinks/buffered_file_sink-inl.h"
 #include "slimlog/sinks/callback_sink-inl.h"
+#include "slimlog/sinks/category_file_sink-inl.h"
+#include "slimlog/sinks/compressed_file_sink-inl.h"
+#include "slimlog/sinks/direct_file_sink-inl.h"
 #include "slimlog/sinks/file_sink-inl.h"
+#include "slimlog/sinks/flight_recorder_sink-inl.h"
+#include "slimlog/sinks/io_uring_file_sink-inl.h"
+#include "slimlog/sinks/journald_sink-inl.h"
+#include "slimlog/sinks/mapped_file_sink-inl.h"
 #include "slimlog/sinks/ostream_sink-inl.h"
+#include "slimlog/sinks/rotating_file_sink-inl.h"
+#include "slimlog/sinks/socket_sink-inl.h"
+#include "slimlog/sinks/syslog_sink-inl.h"
+#include "slimlog/sinks/time_rotating_file_sink-inl.h"
 // IWYU pragma: end_keep
 #endif
 
@@ -30,6 +59,22 @@
 #endif
 
 namespace slimlog {
+#ifndef SLIMLOG_HEADER_ONLY
+namespace util {
+auto EpochDomain::instance() -> EpochDomain&
+{
+    static EpochDomain domain;
+    return domain;
+}
+
+auto EpochDomain::local_state() -> LocalState&
+{
+    thread_local LocalState state(acquire_participant());
+    return state;
+}
+} // namespace util
+#endif
+
 // char
 template class SLIMLOG_EXPORT_CLASS Logger<char, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS Logger<char, MultiThreadedPolicy>;
@@ -37,16 +82,43 @@ template class SLIMLOG_EXPORT_CLASS FormattableSink<char, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS FormattableSink<char, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS FileSink<char, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS FileSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BufferedFileSink<char, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BufferedFileSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS MappedFileSink<char, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS MappedFileSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS IoUringFileSink<char, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS IoUringFileSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS DirectFileSink<char, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS DirectFileSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CompressedFileSink<char, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CompressedFileSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS FlightRecorderSink<char, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS FlightRecorderSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BinaryFileSink<char, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BinaryFileSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CategoryFileSink<char, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CategoryFileSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SyslogSink<char, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SyslogSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS JournaldSink<char, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS JournaldSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SocketSink<char, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SocketSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS RotatingFileSink<char, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS RotatingFileSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS TimeRotatingFileSink<char, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS TimeRotatingFileSink<char, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS OStreamSink<char, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS OStreamSink<char, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS CallbackSink<char, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS CallbackSink<char, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS AsyncSink<char>;
 template class NullSink<char>;
 template class Pattern<char>;
 template SLIMLOG_EXPORT void Pattern<char>::format<SingleThreadedPolicy>(
-    FormatBuffer<char, DefaultSinkBufferSize>&, const Record<char>&);
+    FormatBuffer<char, DefaultSinkBufferSize>&, const Record<char>&) const;
 template SLIMLOG_EXPORT void Pattern<char>::format<MultiThreadedPolicy>(
-    FormatBuffer<char, DefaultSinkBufferSize>&, const Record<char>&);
+    FormatBuffer<char, DefaultSinkBufferSize>&, const Record<char>&) const;
 template class CachedFormatter<std::size_t, char>;
 template class CachedFormatter<std::chrono::sys_seconds, char>;
 #ifndef SLIMLOG_FMTLIB
@@ -61,16 +133,43 @@ template class SLIMLOG_EXPORT_CLASS FormattableSink<wchar_t, SingleThreadedPolic
 template class SLIMLOG_EXPORT_CLASS FormattableSink<wchar_t, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS FileSink<wchar_t, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS FileSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BufferedFileSink<wchar_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BufferedFileSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS MappedFileSink<wchar_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS MappedFileSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS IoUringFileSink<wchar_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS IoUringFileSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS DirectFileSink<wchar_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS DirectFileSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CompressedFileSink<wchar_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CompressedFileSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS FlightRecorderSink<wchar_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS FlightRecorderSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BinaryFileSink<wchar_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BinaryFileSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CategoryFileSink<wchar_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CategoryFileSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SyslogSink<wchar_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SyslogSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS JournaldSink<wchar_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS JournaldSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SocketSink<wchar_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SocketSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS RotatingFileSink<wchar_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS RotatingFileSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS TimeRotatingFileSink<wchar_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS TimeRotatingFileSink<wchar_t, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS OStreamSink<wchar_t, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS OStreamSink<wchar_t, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS CallbackSink<wchar_t, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS CallbackSink<wchar_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS AsyncSink<wchar_t>;
 template class NullSink<wchar_t>;
 template class Pattern<wchar_t>;
 template SLIMLOG_EXPORT void Pattern<wchar_t>::format<SingleThreadedPolicy>(
-    FormatBuffer<wchar_t, DefaultSinkBufferSize>&, const Record<wchar_t>&);
+    FormatBuffer<wchar_t, DefaultSinkBufferSize>&, const Record<wchar_t>&) const;
 template SLIMLOG_EXPORT void Pattern<wchar_t>::format<MultiThreadedPolicy>(
-    FormatBuffer<wchar_t, DefaultSinkBufferSize>&, const Record<wchar_t>&);
+    FormatBuffer<wchar_t, DefaultSinkBufferSize>&, const Record<wchar_t>&) const;
 template class CachedFormatter<std::size_t, wchar_t>;
 template class CachedFormatter<std::chrono::sys_seconds, wchar_t>;
 #ifndef SLIMLOG_FMTLIB
@@ -86,16 +185,43 @@ template class SLIMLOG_EXPORT_CLASS FormattableSink<char8_t, SingleThreadedPolic
 template class SLIMLOG_EXPORT_CLASS FormattableSink<char8_t, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS FileSink<char8_t, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS FileSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BufferedFileSink<char8_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BufferedFileSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS MappedFileSink<char8_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS MappedFileSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS IoUringFileSink<char8_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS IoUringFileSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS DirectFileSink<char8_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS DirectFileSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CompressedFileSink<char8_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CompressedFileSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS FlightRecorderSink<char8_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS FlightRecorderSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BinaryFileSink<char8_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BinaryFileSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CategoryFileSink<char8_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CategoryFileSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SyslogSink<char8_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SyslogSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS JournaldSink<char8_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS JournaldSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SocketSink<char8_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SocketSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS RotatingFileSink<char8_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS RotatingFileSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS TimeRotatingFileSink<char8_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS TimeRotatingFileSink<char8_t, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS OStreamSink<char8_t, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS OStreamSink<char8_t, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS CallbackSink<char8_t, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS CallbackSink<char8_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS AsyncSink<char8_t>;
 template class NullSink<char8_t>;
 template class Pattern<char8_t>;
 template SLIMLOG_EXPORT void Pattern<char8_t>::format<SingleThreadedPolicy>(
-    FormatBuffer<char8_t, DefaultSinkBufferSize>&, const Record<char8_t>&);
+    FormatBuffer<char8_t, DefaultSinkBufferSize>&, const Record<char8_t>&) const;
 template SLIMLOG_EXPORT void Pattern<char8_t>::format<MultiThreadedPolicy>(
-    FormatBuffer<char8_t, DefaultSinkBufferSize>&, const Record<char8_t>&);
+    FormatBuffer<char8_t, DefaultSinkBufferSize>&, const Record<char8_t>&) const;
 template class CachedFormatter<std::size_t, char8_t>;
 template class CachedFormatter<std::chrono::sys_seconds, char8_t>;
 #endif
@@ -108,16 +234,43 @@ template class SLIMLOG_EXPORT_CLASS FormattableSink<char16_t, SingleThreadedPoli
 template class SLIMLOG_EXPORT_CLASS FormattableSink<char16_t, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS FileSink<char16_t, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS FileSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BufferedFileSink<char16_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BufferedFileSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS MappedFileSink<char16_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS MappedFileSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS IoUringFileSink<char16_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS IoUringFileSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS DirectFileSink<char16_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS DirectFileSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CompressedFileSink<char16_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CompressedFileSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS FlightRecorderSink<char16_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS FlightRecorderSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BinaryFileSink<char16_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BinaryFileSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CategoryFileSink<char16_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CategoryFileSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SyslogSink<char16_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SyslogSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS JournaldSink<char16_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS JournaldSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SocketSink<char16_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SocketSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS RotatingFileSink<char16_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS RotatingFileSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS TimeRotatingFileSink<char16_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS TimeRotatingFileSink<char16_t, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS OStreamSink<char16_t, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS OStreamSink<char16_t, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS CallbackSink<char16_t, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS CallbackSink<char16_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS AsyncSink<char16_t>;
 template class NullSink<char16_t>;
 template class Pattern<char16_t>;
 template SLIMLOG_EXPORT void Pattern<char16_t>::format<SingleThreadedPolicy>(
-    FormatBuffer<char16_t, DefaultSinkBufferSize>&, const Record<char16_t>&);
+    FormatBuffer<char16_t, DefaultSinkBufferSize>&, const Record<char16_t>&) const;
 template SLIMLOG_EXPORT void Pattern<char16_t>::format<MultiThreadedPolicy>(
-    FormatBuffer<char16_t, DefaultSinkBufferSize>&, const Record<char16_t>&);
+    FormatBuffer<char16_t, DefaultSinkBufferSize>&, const Record<char16_t>&) const;
 template class CachedFormatter<std::size_t, char16_t>;
 template class CachedFormatter<std::chrono::sys_seconds, char16_t>;
 #endif
@@ -130,16 +283,43 @@ template class SLIMLOG_EXPORT_CLASS FormattableSink<char32_t, SingleThreadedPoli
 template class SLIMLOG_EXPORT_CLASS FormattableSink<char32_t, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS FileSink<char32_t, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS FileSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BufferedFileSink<char32_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BufferedFileSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS MappedFileSink<char32_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS MappedFileSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS IoUringFileSink<char32_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS IoUringFileSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS DirectFileSink<char32_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS DirectFileSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CompressedFileSink<char32_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CompressedFileSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS FlightRecorderSink<char32_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS FlightRecorderSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BinaryFileSink<char32_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS BinaryFileSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CategoryFileSink<char32_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS CategoryFileSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SyslogSink<char32_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SyslogSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS JournaldSink<char32_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS JournaldSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SocketSink<char32_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS SocketSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS RotatingFileSink<char32_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS RotatingFileSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS TimeRotatingFileSink<char32_t, SingleThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS TimeRotatingFileSink<char32_t, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS OStreamSink<char32_t, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS OStreamSink<char32_t, MultiThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS CallbackSink<char32_t, SingleThreadedPolicy>;
 template class SLIMLOG_EXPORT_CLASS CallbackSink<char32_t, MultiThreadedPolicy>;
+template class SLIMLOG_EXPORT_CLASS AsyncSink<char32_t>;
 template class NullSink<char32_t>;
 template class Pattern<char32_t>;
 template SLIMLOG_EXPORT void Pattern<char32_t>::format<SingleThreadedPolicy>(
-    FormatBuffer<char32_t, DefaultSinkBufferSize>&, const Record<char32_t>&);
+    FormatBuffer<char32_t, DefaultSinkBufferSize>&, const Record<char32_t>&) const;
 template SLIMLOG_EXPORT void Pattern<char32_t>::format<MultiThreadedPolicy>(
-    FormatBuffer<char32_t, DefaultSinkBufferSize>&, const Record<char32_t>&);
+    FormatBuffer<char32_t, DefaultSinkBufferSize>&, const Record<char32_t>&) const;
 template class CachedFormatter<std::size_t, char32_t>;
 template class CachedFormatter<std::chrono::sys_seconds, char32_t>;
 #endif
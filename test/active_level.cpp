@@ -0,0 +1,110 @@
+// Remove all messages less severe than Info at compile time
+#undef SLIMLOG_ACTIVE_LEVEL
+#define SLIMLOG_ACTIVE_LEVEL SLIMLOG_LEVEL_INFO
+
+#include "slimlog/common.h"
+#include "slimlog/format.h"
+#include "slimlog/location.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/callback_sink.h"
+
+// Test helpers
+#include "helpers/common.h"
+
+#include <mettle.hpp>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// IWYU pragma: no_include <memory>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+const suite<SLIMLOG_CHAR_THREADING_TYPES> ActiveLevel("active_level", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using StringView = std::basic_string_view<Char>;
+
+    static_assert(is_active_level(Level::Info));
+    static_assert(!is_active_level(Level::Debug));
+
+    // Test that member functions of removed levels emit nothing
+    _.test("member_functions", []() {
+        std::vector<Level> levels;
+        auto log = LoggerType::create(Level::Trace);
+        log->template add_sink<CallbackSink>(
+            [&levels](Level level, const Location& /*location*/, StringView /*message*/) {
+                levels.push_back(level);
+            });
+
+        static constexpr std::array<Char, 3> FmtMessage{'{', '}', '\0'};
+        const auto message = from_utf8<Char>("Message");
+        log->trace(message);
+        log->debug(FmtMessage.data(), message);
+        log->info(message);
+        log->warning(FmtMessage.data(), message);
+
+        expect(levels, equal_to(std::vector{Level::Info, Level::Warning}));
+    });
+
+    // Test that callbacks are not invoked for removed levels despite the runtime level
+    _.test("callback", []() {
+        std::vector<Level> levels;
+        auto log = LoggerType::create(Level::Trace);
+        log->template add_sink<CallbackSink>(
+            [&levels](Level level, const Location& /*location*/, StringView /*message*/) {
+                levels.push_back(level);
+            });
+
+        int calls = 0;
+        const auto callback = [&calls]() {
+            ++calls;
+            return from_utf8<Char>("Message");
+        };
+        log->message(Level::Trace, callback);
+        log->message(Level::Debug, callback);
+        log->message(Level::Error, callback);
+
+        expect(calls, equal_to(1));
+        expect(levels, equal_to(std::vector{Level::Error}));
+    });
+
+    // Test that macros do not evaluate arguments of removed levels
+    _.test("macros", []() {
+        std::vector<Level> levels;
+        auto log = LoggerType::create(Level::Trace);
+        log->template add_sink<CallbackSink>(
+            [&levels](Level level, const Location& /*location*/, StringView /*message*/) {
+                levels.push_back(level);
+            });
+
+        int evaluated = 0;
+        const auto argument = [&evaluated]() {
+            ++evaluated;
+            return from_utf8<Char>("Message");
+        };
+        static constexpr std::array<Char, 3> FmtMessage{'{', '}', '\0'};
+        SLIMLOG_TRACE(log, FmtMessage.data(), argument());
+        SLIMLOG_DEBUG(log, argument());
+        SLIMLOG_MESSAGE(log, Level::Debug, FmtMessage.data(), argument());
+        SLIMLOG_INFO(log, argument());
+        SLIMLOG_WARNING(log, FmtMessage.data(), argument());
+        SLIMLOG_MESSAGE(log, Level::Error, argument());
+        SLIMLOG_FATAL(log, argument());
+
+        expect(evaluated, equal_to(4));
+        expect(
+            levels,
+            equal_to(std::vector{Level::Info, Level::Warning, Level::Error, Level::Fatal}));
+    });
+});
+
+} // namespace
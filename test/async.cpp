@@ -0,0 +1,314 @@
+#include "slimlog/common.h"
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/sink.h"
+#include "slimlog/sinks/async_sink.h"
+#include "slimlog/threading.h"
+
+// Test helpers
+#include "helpers/common.h"
+
+#include <mettle.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// IWYU pragma: no_include <utility>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+/**
+ * @brief Sink collecting messages, optionally blocking the caller until released.
+ */
+template<typename Char>
+class CollectingSink : public Sink<Char> {
+public:
+    using typename Sink<Char>::RecordType;
+
+    auto message(const RecordType& record) -> void override
+    {
+        if (record.deferred) {
+            m_deferred.fetch_add(1);
+            typename DeferredMessage<Char>::BufferType buffer;
+            message(record.deferred->resolve(record, buffer));
+            return;
+        }
+        while (m_blocked.load()) {
+            m_blocked.wait(true);
+        }
+        if (m_throw) {
+            throw std::runtime_error("Sink error");
+        }
+        const std::lock_guard lock(m_mutex);
+        m_messages.emplace_back(record.message);
+        m_categories.emplace_back(record.category);
+        m_thread_ids.push_back(std::this_thread::get_id());
+    }
+
+    auto flush() -> void override
+    {
+        m_flushes.fetch_add(1);
+    }
+
+    auto block() -> void
+    {
+        m_blocked.store(true);
+    }
+
+    auto release() -> void
+    {
+        m_blocked.store(false);
+        m_blocked.notify_all();
+    }
+
+    auto set_throw(bool enabled) -> void
+    {
+        m_throw = enabled;
+    }
+
+    auto messages() -> std::vector<std::basic_string<Char>>
+    {
+        const std::lock_guard lock(m_mutex);
+        return m_messages;
+    }
+
+    auto categories() -> std::vector<std::basic_string<Char>>
+    {
+        const std::lock_guard lock(m_mutex);
+        return m_categories;
+    }
+
+    auto thread_ids() -> std::vector<std::thread::id>
+    {
+        const std::lock_guard lock(m_mutex);
+        return m_thread_ids;
+    }
+
+    auto flushes() const -> int
+    {
+        return m_flushes.load();
+    }
+
+    auto deferred() const -> int
+    {
+        return m_deferred.load();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::basic_string<Char>> m_messages;
+    std::vector<std::basic_string<Char>> m_categories;
+    std::vector<std::thread::id> m_thread_ids;
+    std::atomic<bool> m_blocked{false};
+    std::atomic<int> m_flushes{0};
+    std::atomic<int> m_deferred{0};
+    std::atomic<bool> m_throw{false};
+};
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_TYPES> Async("async", type_only, [](auto& _) {
+    using Char = mettle::fixture_type_t<decltype(_)>;
+    using LoggerType = Logger<Char, MultiThreadedPolicy>;
+    using AsyncSinkType = AsyncSink<Char>;
+
+    // Test that the wrapped sink is accessible and receives records
+    _.test("wrapped_sink", []() {
+        auto collector = std::make_shared<CollectingSink<Char>>();
+        auto async_sink = std::make_shared<AsyncSinkType>(collector);
+        expect(async_sink->sink(), equal_to(collector));
+
+        auto log = LoggerType::create(from_utf8<Char>("async"));
+        log->add_sink(async_sink);
+        log->warning(numbered<Char>(1));
+        async_sink->flush();
+
+        expect(collector->messages(), equal_to(std::vector{numbered<Char>(1)}));
+        expect(collector->categories(), equal_to(std::vector{from_utf8<Char>("async")}));
+    });
+
+    // Test that flush() waits for all queued records and flushes the wrapped sink
+    _.test("flush", []() {
+        constexpr int NumMessages = 1000;
+
+        auto collector = std::make_shared<CollectingSink<Char>>();
+        auto async_sink = std::make_shared<AsyncSinkType>(collector, 16);
+        auto log = LoggerType::create(from_utf8<Char>("async"));
+        log->add_sink(async_sink);
+
+        for (int i = 0; i < NumMessages; ++i) {
+            log->info(numbered<Char>(i));
+        }
+        async_sink->flush();
+
+        const auto messages = collector->messages();
+        expect(messages.size(), equal_to(NumMessages));
+        for (int i = 0; i < NumMessages; ++i) {
+            expect(messages[i], equal_to(numbered<Char>(i)));
+        }
+        expect(collector->categories().back(), equal_to(from_utf8<Char>("async")));
+        expect(collector->thread_ids().back(), not_equal_to(std::this_thread::get_id()));
+        expect(collector->flushes(), greater_equal(1));
+        expect(async_sink->dropped(), equal_to(0U));
+    });
+
+    // Test that records are drained when the sink is destroyed
+    _.test("drain_on_destroy", []() {
+        constexpr int NumMessages = 500;
+
+        auto collector = std::make_shared<CollectingSink<Char>>();
+        {
+            auto async_sink = std::make_shared<AsyncSinkType>(collector, 1024);
+            auto log = LoggerType::create();
+            log->add_sink(async_sink);
+            for (int i = 0; i < NumMessages; ++i) {
+                log->info(numbered<Char>(i));
+            }
+        }
+        expect(collector->messages().size(), equal_to(NumMessages));
+    });
+
+    // Test drop-newest overflow policy
+    _.test("drop_newest", []() {
+        constexpr int NumMessages = 64;
+        constexpr std::size_t Capacity = 8;
+
+        auto collector = std::make_shared<CollectingSink<Char>>();
+        auto async_sink
+            = std::make_shared<AsyncSinkType>(collector, Capacity, OverflowPolicy::DropNewest);
+        auto log = LoggerType::create();
+        log->add_sink(async_sink);
+
+        collector->block();
+        for (int i = 0; i < NumMessages; ++i) {
+            log->info(numbered<Char>(i));
+        }
+        collector->release();
+        async_sink->flush();
+
+        const auto messages = collector->messages();
+        expect(async_sink->dropped(), greater(0U));
+        expect(messages.size() + async_sink->dropped(), equal_to(NumMessages));
+        // The oldest records must survive
+        expect(messages.front(), equal_to(numbered<Char>(0)));
+    });
+
+    // Test drop-oldest overflow policy
+    _.test("drop_oldest", []() {
+        constexpr int NumMessages = 64;
+        constexpr std::size_t Capacity = 8;
+
+        auto collector = std::make_shared<CollectingSink<Char>>();
+        auto async_sink
+            = std::make_shared<AsyncSinkType>(collector, Capacity, OverflowPolicy::DropOldest);
+        auto log = LoggerType::create();
+        log->add_sink(async_sink);
+
+        collector->block();
+        for (int i = 0; i < NumMessages; ++i) {
+            log->info(numbered<Char>(i));
+        }
+        collector->release();
+        async_sink->flush();
+
+        const auto messages = collector->messages();
+        expect(async_sink->dropped(), greater(0U));
+        expect(messages.size() + async_sink->dropped(), equal_to(NumMessages));
+        // The newest records must survive
+        expect(messages.back(), equal_to(numbered<Char>(NumMessages - 1)));
+        expect(messages.size(), greater_equal(Capacity));
+    });
+
+    // Test blocking overflow policy with concurrent producers
+    _.test("block_concurrent", []() {
+        constexpr int NumThreads = 8;
+        constexpr int IterationsPerThread = 2000;
+        constexpr std::size_t Capacity = 64;
+
+        auto collector = std::make_shared<CollectingSink<Char>>();
+        auto async_sink
+            = std::make_shared<AsyncSinkType>(collector, Capacity, OverflowPolicy::Block);
+        auto log = LoggerType::create();
+        log->add_sink(async_sink);
+
+        std::latch start_latch(NumThreads);
+        std::vector<std::thread> threads;
+        threads.reserve(NumThreads);
+        for (int i = 0; i < NumThreads; ++i) {
+            threads.emplace_back([&]() {
+                start_latch.arrive_and_wait();
+                for (int j = 0; j < IterationsPerThread; ++j) {
+                    log->info(numbered<Char>(j));
+                    if (j % 500 == 0) {
+                        async_sink->flush();
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        async_sink->flush();
+
+        expect(collector->messages().size(), equal_to(NumThreads * IterationsPerThread));
+        expect(async_sink->dropped(), equal_to(0U));
+    });
+
+    // Test that deferred format arguments are copied and formatted on the backend thread
+    _.test("deferred_format", []() {
+        constexpr int NumMessages = 100;
+
+        auto collector = std::make_shared<CollectingSink<Char>>();
+        auto async_sink = std::make_shared<AsyncSinkType>(collector, 16);
+        auto log = LoggerType::create();
+        log->set_deferred_format(true);
+        log->add_sink(async_sink);
+
+        static constexpr std::array<Char, 3> FmtMessage{'{', '}', '\0'};
+        for (int i = 0; i < NumMessages; ++i) {
+            // Temporary string is destroyed before the backend formats the message
+            log->info(FmtMessage.data(), numbered<Char>(i));
+        }
+        async_sink->flush();
+
+        const auto messages = collector->messages();
+        expect(messages.size(), equal_to(NumMessages));
+        for (int i = 0; i < NumMessages; ++i) {
+            expect(messages[i], equal_to(numbered<Char>(i)));
+        }
+        expect(collector->deferred(), equal_to(NumMessages));
+    });
+
+    // Test that errors on the backend thread are reported by flush()
+    _.test("flush_rethrows", []() {
+        auto collector = std::make_shared<CollectingSink<Char>>();
+        auto async_sink = std::make_shared<AsyncSinkType>(collector);
+        auto log = LoggerType::create();
+        log->add_sink(async_sink);
+
+        collector->set_throw(true);
+        log->info(numbered<Char>(0));
+        expect([&]() { async_sink->flush(); }, thrown<std::runtime_error>());
+
+        // Error is reported only once
+        collector->set_throw(false);
+        log->info(numbered<Char>(1));
+        async_sink->flush();
+        expect(collector->messages().size(), equal_to(1U));
+    });
+});
+
+} // namespace
@@ -0,0 +1,191 @@
+#include "slimlog/backtrace.h"
+#include "slimlog/common.h"
+#include "slimlog/format.h"
+#include "slimlog/location.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/callback_sink.h"
+#include "slimlog/util/string.h"
+
+// Test helpers
+#include "helpers/common.h"
+
+#include <mettle.hpp>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// IWYU pragma: no_include <memory>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> BacktraceTests("backtrace", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using StringView = std::basic_string_view<Char>;
+    using Entry = std::pair<Level, std::basic_string<Char>>;
+
+    static constexpr std::array<Char, 3> FmtMessage{'{', '}', '\0'};
+
+    const auto collect = [](std::vector<Entry>& entries) {
+        return [&entries](Level level, const Location& /*location*/, StringView message) {
+            entries.emplace_back(level, message);
+        };
+    };
+
+    // Test that suppressed records are emitted before the triggering record
+    _.test("trigger", [collect]() {
+        std::vector<Entry> entries;
+        auto log = LoggerType::create(Level::Info);
+        log->template add_sink<CallbackSink>(collect(entries));
+        log->enable_backtrace(3, Level::Debug, Level::Error);
+
+        for (int i = 0; i < 5; ++i) {
+            log->debug(numbered<Char>(i));
+        }
+        log->trace(numbered<Char>(5));
+        log->info(numbered<Char>(6));
+        log->warning(numbered<Char>(7));
+        expect(
+            entries,
+            equal_to(std::vector<Entry>{
+                {Level::Info, numbered<Char>(6)}, {Level::Warning, numbered<Char>(7)}}));
+
+        // Only the last records fitting the capacity are kept
+        entries.clear();
+        log->error(numbered<Char>(8));
+        expect(
+            entries,
+            equal_to(std::vector<Entry>{
+                {Level::Debug, numbered<Char>(2)},
+                {Level::Debug, numbered<Char>(3)},
+                {Level::Debug, numbered<Char>(4)},
+                {Level::Error, numbered<Char>(8)}}));
+
+        // Backtrace is cleared after the dump
+        entries.clear();
+        log->fatal(numbered<Char>(9));
+        expect(entries, equal_to(std::vector<Entry>{{Level::Fatal, numbered<Char>(9)}}));
+    });
+
+    // Test that formatted messages are stored and formatted on dump
+    _.test("formatted", [collect]() {
+        for (const bool deferred : {false, true}) {
+            std::vector<Entry> entries;
+            auto log = LoggerType::create(Level::Info);
+            log->template add_sink<CallbackSink>(collect(entries));
+            log->set_deferred_format(deferred);
+            log->enable_backtrace(4);
+
+            const auto message = numbered<Char>(1);
+            log->debug(FmtMessage.data(), message);
+            log->trace(FmtMessage.data(), 42);
+            expect(entries.empty(), equal_to(true));
+
+            log->error(FmtMessage.data(), message);
+            expect(
+                entries,
+                equal_to(std::vector<Entry>{
+                    {Level::Debug, message},
+                    {Level::Trace, from_utf8<Char>("42")},
+                    {Level::Error, message}}));
+        }
+    });
+
+    // Test that sinks may log through the same logger while the backtrace is dumped
+    _.test("nested_log", []() {
+        std::vector<Entry> entries;
+        auto log = LoggerType::create(Level::Info);
+        auto* logger = log.get();
+        log->template add_sink<CallbackSink>(
+            [&entries, logger](Level level, const Location& /*location*/, StringView message) {
+                entries.emplace_back(level, message);
+                if (level == Level::Debug) {
+                    logger->debug(numbered<Char>(10));
+                }
+            });
+        log->enable_backtrace(4);
+
+        log->debug(numbered<Char>(1));
+        log->error(numbered<Char>(2));
+        expect(
+            entries,
+            equal_to(std::vector<Entry>{
+                {Level::Debug, numbered<Char>(1)}, {Level::Error, numbered<Char>(2)}}));
+
+        // Record logged by the sink during the dump is stored for the next one
+        entries.clear();
+        log->dump_backtrace();
+        expect(entries, equal_to(std::vector<Entry>{{Level::Debug, numbered<Char>(10)}}));
+    });
+
+    // Test that the ring may be dumped again while it is being dumped
+    _.test("nested_dump", []() {
+        using String = std::basic_string<Char>;
+        Backtrace<Char, ThreadingPolicy> backtrace;
+        backtrace.enable(4, Level::Debug, Level::Error);
+        const auto push = [&backtrace](int index) {
+            const auto message = numbered<Char>(index);
+            Record<Char> record;
+            record.message = CachedStringView<Char>(message);
+            record.level = Level::Debug;
+            backtrace.push(record);
+        };
+
+        std::vector<String> dumped;
+        const auto collect = [&dumped](const Record<Char>& record) {
+            dumped.emplace_back(record.message);
+        };
+        push(1);
+        backtrace.dump([&](const Record<Char>& record) {
+            collect(record);
+            // Spare ring is taken by the outer dump
+            push(10);
+            backtrace.dump(collect);
+        });
+        expect(dumped, equal_to(std::vector<String>{numbered<Char>(1), numbered<Char>(10)}));
+
+        // Rings are reused after the dumps
+        dumped.clear();
+        push(2);
+        push(3);
+        backtrace.dump(collect);
+        expect(dumped, equal_to(std::vector<String>{numbered<Char>(2), numbered<Char>(3)}));
+        expect(backtrace.size(), equal_to(0U));
+    });
+
+    // Test manual dump and disabling the backtrace
+    _.test("dump_and_disable", [collect]() {
+        std::vector<Entry> entries;
+        auto log = LoggerType::create(Level::Warning);
+        log->template add_sink<CallbackSink>(collect(entries));
+        log->enable_backtrace(8, Level::Info, Level::Fatal);
+
+        log->info(numbered<Char>(1));
+        log->error(numbered<Char>(2));
+        expect(entries, equal_to(std::vector<Entry>{{Level::Error, numbered<Char>(2)}}));
+
+        entries.clear();
+        log->dump_backtrace();
+        expect(entries, equal_to(std::vector<Entry>{{Level::Info, numbered<Char>(1)}}));
+
+        entries.clear();
+        log->info(numbered<Char>(3));
+        log->disable_backtrace();
+        log->info(numbered<Char>(4));
+        log->fatal(numbered<Char>(5));
+        log->dump_backtrace();
+        expect(entries, equal_to(std::vector<Entry>{{Level::Fatal, numbered<Char>(5)}}));
+    });
+});
+
+} // namespace
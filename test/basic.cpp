@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <cstddef>
 #include <filesystem>
 #include <initializer_list>
 #include <string>
@@ -456,6 +457,75 @@ const suite<SLIMLOG_CHAR_THREADING_TYPES> Basic("basic", type_only, [](auto& _)
         }
     });
 
+    // Test that all sinks receive the same timestamp from the logger time function
+    _.test("time_func", []() {
+        StreamCapturer<Char> cap_out1;
+        StreamCapturer<Char> cap_out2;
+
+        const auto pattern = from_utf8<Char>("{time:%Y/%d/%m %T} {nsec} #{thread}: {message}");
+
+        auto log = LoggerType::create();
+        log->template add_sink<OStreamSink>(cap_out1, pattern);
+        log->template add_sink<OStreamSink>(cap_out2, pattern);
+        log->set_time_func(time_mock);
+
+        PatternFields<Char> fields;
+        fields.thread_id = util::os::thread_id();
+        fields.time = time_mock().first;
+        fields.nsec = time_mock().second;
+
+        for (const auto& message : unicode_strings<Char>()) {
+            log->info(message);
+            fields.message = message;
+            const auto expected = pattern_format<Char>(pattern, fields) + Char{'\n'};
+            expect(cap_out1.read(), equal_to(expected));
+            expect(cap_out2.read(), equal_to(expected));
+        }
+    });
+
+    // Test that sinks with equal patterns format each message once
+    _.test("shared_pattern", []() {
+        StreamCapturer<Char> cap_out1;
+        StreamCapturer<Char> cap_out2;
+        StreamCapturer<Char> cap_out3;
+
+        static std::size_t calls = 0;
+        const auto time_func = []() {
+            ++calls;
+            return time_mock();
+        };
+
+        const auto pattern = from_utf8<Char>("{time:%T} [{level}] {message}");
+        auto log = LoggerType::create();
+        auto sink1 = log->template add_sink<OStreamSink>(cap_out1, pattern);
+        auto sink2 = log->template add_sink<OStreamSink>(cap_out2, pattern);
+        auto sink3 = log->template add_sink<OStreamSink>(cap_out3, pattern);
+        sink1->set_time_func(time_func);
+        sink2->set_time_func(time_func);
+        sink3->set_time_func(time_func);
+
+        PatternFields<Char> fields;
+        fields.time = time_mock().first;
+        fields.level = from_utf8<Char>("INFO");
+        fields.message = from_utf8<Char>("Shared message");
+
+        log->info(fields.message);
+        const auto expected = pattern_format<Char>(pattern, fields) + Char{'\n'};
+        expect(cap_out1.read(), equal_to(expected));
+        expect(cap_out2.read(), equal_to(expected));
+        expect(cap_out3.read(), equal_to(expected));
+        expect(calls, equal_to(1U));
+
+        // Sink with different level names formats the message on its own
+        sink3->set_levels(std::make_pair(Level::Info, from_utf8<Char>("Information")));
+        log->info(fields.message);
+        expect(cap_out1.read(), equal_to(expected));
+        expect(cap_out2.read(), equal_to(expected));
+        fields.level = from_utf8<Char>("Information");
+        expect(cap_out3.read(), equal_to(pattern_format<Char>(pattern, fields) + Char{'\n'}));
+        expect(calls, equal_to(3U));
+    });
+
     // Test with simple {time} format (no format specified)
     _.test("simple_time_pattern", []() {
         StreamCapturer<Char> cap_out;
@@ -528,6 +598,47 @@ const suite<SLIMLOG_CHAR_THREADING_TYPES> Basic("basic", type_only, [](auto& _)
         }
     });
 
+    // Test deferred formatting of basic argument types
+    _.test("deferred_format", []() {
+        StreamCapturer<Char> cap_out;
+        std::basic_string<Char> captured_message;
+
+        auto log = LoggerType::create();
+        log->template add_sink<OStreamSink>(cap_out, from_utf8<Char>("{message}"));
+        log->template add_sink<CallbackSink>(
+            [&](Level /*level*/, const Location& /*location*/, StringView message) {
+                captured_message = message;
+            });
+
+        expect(log->deferred_format(), equal_to(false));
+        log->set_deferred_format(true);
+        expect(log->deferred_format(), equal_to(true));
+
+        static constexpr std::array<Char, 29> FmtMessage{
+            '{', '}', ' ', '{', ':', '>', '5', '}', ' ', '{', ':', '.', '2', 'f', '}',
+            ' ', '{', '}', ' ', '{', '}', ' ', '{', '}', ' ', '{', '}', '!', '\0'};
+        for (const auto& message : unicode_strings<Char>()) {
+            const StringView message_view{message};
+            const auto* message_ptr = message.c_str();
+            log->info(FmtMessage.data(), 42, Char{'x'}, 10.0 / 3, message, message_view, message_ptr, true);
+
+            const auto expected =
+#ifdef SLIMLOG_FMTLIB
+                fmt::format(
+#else
+                std::format(
+#endif
+                    FmtMessage.data(), 42, Char{'x'}, 10.0 / 3, message, message_view, message_ptr, true);
+            expect(cap_out.read(), equal_to(expected + Char{'\n'}));
+            expect(captured_message, equal_to(expected));
+        }
+
+        static constexpr std::array<Char, 3> FmtNull{'{', '}', '\0'};
+        log->info(FmtNull.data(), nullptr);
+        expect(cap_out.read(), equal_to(from_utf8<Char>("0x0\n")));
+        expect(captured_message, equal_to(from_utf8<Char>("0x0")));
+    });
+
     // Test logger hierarchy and message propagation
     _.test("logger_hierarchy", []() {
         StreamCapturer<Char> cap_root;
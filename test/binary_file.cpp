@@ -0,0 +1,273 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/pattern.h"
+#include "slimlog/record.h"
+#include "slimlog/sinks/binary_file_sink.h"
+#include "slimlog/sinks/callback_sink.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/file_capturer.h"
+
+#include <mettle.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <latch>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+using namespace std::chrono_literals;
+
+// Converts an ASCII string literal to a format string of any character type
+template<typename Char, std::size_t N>
+consteval auto literal(const char (&str)[N]) -> std::array<Char, N> // NOLINT(*-avoid-c-arrays)
+{
+    std::array<Char, N> result{};
+    std::copy(std::begin(str), std::end(str), result.begin());
+    return result;
+}
+
+// Messages of all records in the file
+template<typename Char>
+auto decoded(const std::string& filename) -> std::vector<std::basic_string<Char>>
+{
+    std::vector<std::basic_string<Char>> messages;
+    const BinaryLogReader reader(filename);
+    const auto count = reader.read<Char>(
+        [&messages](const Record<Char>& record) { messages.emplace_back(record.message); });
+    expect(count, equal_to(messages.size()));
+    return messages;
+}
+
+std::pair<std::chrono::sys_seconds, std::size_t> fake_time; // NOLINT(*-non-const-global-*)
+
+auto get_fake_time() -> std::pair<std::chrono::sys_seconds, std::size_t>
+{
+    return fake_time;
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> BinaryFile("binary_file", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = BinaryFileSink<Char, ThreadingPolicy>;
+    using String = std::basic_string<Char>;
+    using StringView = std::basic_string_view<Char>;
+
+    static auto log_filename = get_log_filename<Char>("binary_file");
+
+    // Test that typed arguments are decoded into the same text as formatted by the logger
+    _.test("format", []() {
+        std::filesystem::remove(log_filename);
+        std::vector<String> expected;
+        {
+            auto log = LoggerType::create();
+            log->set_deferred_format(true);
+            log->add_sink(std::make_shared<SinkType>(log_filename));
+            log->template add_sink<CallbackSink>(
+                [&expected](Level /*level*/, const Location& /*location*/, StringView message) {
+                    expected.emplace_back(message);
+                });
+
+            static constexpr auto Integers = literal<Char>("{} {} {} {} {}");
+            static constexpr auto Floats = literal<Char>("{:08.3f}|{:.2e}|{}|{}");
+            static constexpr auto Aligned = literal<Char>("{:>6}|{:<4}|{:^7}|");
+            static constexpr auto Indexed = literal<Char>("{1}-{0} {{literal}} {0}");
+            static constexpr auto Dynamic = literal<Char>("[{:{}}] [{:.{}f}]");
+            static constexpr auto Bases = literal<Char>("{:#x} {:b} {:o} {:+}");
+            static constexpr auto Pointers = literal<Char>("{} {}");
+            const String text = from_utf8<Char>("text");
+            const auto* pointer = reinterpret_cast<const void*>(0x1234); // NOLINT(*-cast)
+
+            log->info(Integers.data(), -42, 42U, std::int64_t{-1234567890123}, 'c' == 'c', 7);
+            log->info(Floats.data(), 3.14159, 2.5F, -0.0, 1e300);
+            log->info(Aligned.data(), Char{'x'}, text, -5);
+            log->info(Indexed.data(), 1, 2);
+            log->info(Dynamic.data(), 7, 5, 3.14159, 2);
+            log->info(Bases.data(), 255, 5U, std::uint16_t{8}, std::int8_t{3});
+            log->info(Pointers.data(), pointer, nullptr);
+            for (const auto& message : unicode_strings<Char>()) {
+                log->info(Pointers.data(), message, StringView{message}.substr(1));
+            }
+        }
+
+        expect(expected.size(), equal_to(7 + unicode_strings<Char>().size()));
+        expect(decoded<Char>(log_filename), equal_to(expected));
+    });
+
+    // Test that plain messages and record fields are stored
+    _.test("fields", []() {
+        std::filesystem::remove(log_filename);
+        const std::vector<std::pair<std::chrono::sys_seconds, std::size_t>> times{
+            {std::chrono::sys_seconds{1700000000s}, 123456789},
+            {std::chrono::sys_seconds{1700000000s}, 123456790},
+            {std::chrono::sys_seconds{1700000100s}, 0},
+            {std::chrono::sys_seconds{1600000000s}, 999999999},
+        };
+        {
+            auto log = LoggerType::create(from_utf8<Char>("binary"), Level::Trace);
+            log->set_time_func(get_fake_time);
+            log->add_sink(std::make_shared<SinkType>(log_filename, 64));
+            for (std::size_t i = 0; i < times.size(); ++i) {
+                fake_time = times[i];
+                log->message(static_cast<Level>(i), numbered<Char>(static_cast<int>(i)));
+            }
+            auto child = LoggerType::create(log, from_utf8<Char>("child"));
+            child->info(from_utf8<Char>("From child"));
+        }
+
+        const BinaryLogReader reader(log_filename);
+        expect(reader.char_size(), equal_to(sizeof(Char)));
+        const Pattern<Char> pattern(from_utf8<Char>("{category} [{level}] {message}"));
+        std::vector<String> lines;
+        reader.read<Char>([&](const Record<Char>& record) {
+            if (lines.size() < times.size()) {
+                expect(record.time, equal_to(times[lines.size()]));
+            }
+            const std::string_view filename = record.filename;
+            expect(filename.ends_with("binary_file.cpp"), equal_to(true));
+            expect(record.line, greater(0U));
+            FormatBuffer<Char, 256> buffer;
+            pattern.format(buffer, record);
+            lines.emplace_back(buffer.data(), buffer.size());
+        });
+        expect(
+            lines,
+            equal_to(std::vector<String>{
+                from_utf8<Char>("binary [FATAL] Message 0"),
+                from_utf8<Char>("binary [ERROR] Message 1"),
+                from_utf8<Char>("binary [WARN] Message 2"),
+                from_utf8<Char>("binary [INFO] Message 3"),
+                from_utf8<Char>("child [INFO] From child"),
+            }));
+    });
+
+    // Test that static strings are written once and records stay small
+    _.test("dictionary", []() {
+        constexpr int Iterations = 1000;
+        static constexpr auto Format = literal<Char>("Benchmark message #{}");
+        std::filesystem::remove(log_filename);
+        std::size_t bytes = 0;
+        {
+            auto log = LoggerType::create();
+            log->set_deferred_format(true);
+            auto sink = std::make_shared<SinkType>(log_filename);
+            log->add_sink(sink);
+            for (int i = 0; i < Iterations; ++i) {
+                log->info(Format.data(), i);
+            }
+            sink->flush();
+            bytes = sink->stats().bytes;
+            expect(sink->stats().syscalls, equal_to(2U));
+        }
+
+        const auto data = read_bytes(log_filename);
+        expect(data.size(), equal_to(bytes));
+        expect(bytes, less(std::size_t{Iterations} * 16));
+        const StringView format{Format.data(), Format.size() - 1};
+        const std::string format_bytes(
+            reinterpret_cast<const char*>(format.data()), // NOLINT(*-reinterpret-cast)
+            format.size() * sizeof(Char));
+        const auto first = data.find(format_bytes);
+        expect(first, not_equal_to(std::string::npos));
+        expect(data.find(format_bytes, first + 1), equal_to(std::string::npos));
+        expect(decoded<Char>(log_filename).size(), equal_to(std::size_t{Iterations}));
+    });
+
+    // Test that a cut file keeps the complete records
+    _.test("truncated", []() {
+        std::filesystem::remove(log_filename);
+        std::vector<String> expected;
+        {
+            auto log = LoggerType::create();
+            log->add_sink(std::make_shared<SinkType>(log_filename));
+            for (int i = 0; i < 100; ++i) {
+                log->info(numbered<Char>(i));
+                expected.push_back(numbered<Char>(i));
+            }
+        }
+        std::filesystem::resize_file(log_filename, std::filesystem::file_size(log_filename) - 3);
+        expected.pop_back();
+        expect(decoded<Char>(log_filename), equal_to(expected));
+    });
+
+    // Test that reopening the file appends a segment with its own dictionary
+    _.test("reopen", []() {
+        static constexpr auto Format = literal<Char>("Run {} message {}");
+        std::filesystem::remove(log_filename);
+        std::vector<String> expected;
+        for (int run = 0; run < 3; ++run) {
+            auto log = LoggerType::create();
+            log->set_deferred_format(run % 2 == 0);
+            log->add_sink(std::make_shared<SinkType>(log_filename));
+            log->template add_sink<CallbackSink>(
+                [&expected](Level /*level*/, const Location& /*location*/, StringView message) {
+                    expected.emplace_back(message);
+                });
+            for (int i = 0; i < 10; ++i) {
+                log->info(Format.data(), run, i);
+            }
+        }
+        expect(expected.size(), equal_to(30U));
+        expect(decoded<Char>(log_filename), equal_to(expected));
+    });
+
+    // Test that concurrent writers do not lose or mix records
+    _.test("concurrent", []() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 2000;
+            static constexpr auto Format = literal<Char>("Message {}");
+
+            std::filesystem::remove(log_filename);
+            {
+                auto log = LoggerType::create();
+                log->set_deferred_format(true);
+                log->add_sink(std::make_shared<SinkType>(log_filename, 1024));
+
+                std::latch start(NumThreads);
+                std::vector<std::thread> threads;
+                threads.reserve(NumThreads);
+                for (int i = 0; i < NumThreads; ++i) {
+                    threads.emplace_back([&log, &start, i]() {
+                        start.arrive_and_wait();
+                        for (int j = 0; j < Iterations; ++j) {
+                            log->info(Format.data(), (i * Iterations) + j);
+                        }
+                    });
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            auto messages = decoded<Char>(log_filename);
+            std::vector<String> expected;
+            for (int i = 0; i < NumThreads * Iterations; ++i) {
+                expected.push_back(numbered<Char>(i));
+            }
+            std::ranges::sort(messages);
+            std::ranges::sort(expected);
+            expect(messages, equal_to(expected));
+        }
+    });
+});
+
+} // namespace
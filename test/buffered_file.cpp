@@ -0,0 +1,215 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/buffered_file_sink.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/file_capturer.h"
+
+#include <mettle.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <latch>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// IWYU pragma: no_include <utility>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> BufferedFile("buffered_file", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = BufferedFileSink<Char, ThreadingPolicy>;
+    using namespace std::chrono_literals;
+
+    static auto log_filename = get_log_filename<Char>("buffered_file");
+    std::filesystem::remove(log_filename);
+
+    // Test that lines are written only on flush, with a single system call
+    _.test("flush", []() {
+        auto log = LoggerType::create();
+        FileCapturer<Char> cap_file(log_filename, true);
+        auto sink = std::make_shared<SinkType>(
+            cap_file.path().string(), BufferedFileOptions{.capacity = 4096, .flush_interval = 0ms});
+        log->add_sink(sink);
+        expect(sink->capacity(), equal_to(std::size_t{4096}));
+
+        std::basic_string<Char> expected;
+        for (int i = 0; i < 3; ++i) {
+            log->info(numbered<Char>(i));
+            expected += numbered<Char>(i) + Char{'\n'};
+        }
+        expect(cap_file.read(), equal_to(std::basic_string<Char>{}));
+        expect(sink->stats().syscalls, equal_to(0U));
+
+        sink->flush();
+        expect(cap_file.read(), equal_to(expected));
+        expect(sink->stats().syscalls, equal_to(1U));
+        expect(sink->stats().bytes, equal_to(expected.size() * sizeof(Char)));
+
+        // Flushing an empty buffer does not issue a system call
+        sink->flush();
+        expect(sink->stats().syscalls, equal_to(1U));
+    });
+
+    // Test that a full buffer is written together with the line that does not fit
+    _.test("overflow", []() {
+        auto log = LoggerType::create();
+        FileCapturer<Char> cap_file(log_filename, true);
+        auto sink = std::make_shared<SinkType>(
+            cap_file.path().string(), BufferedFileOptions{.capacity = 1, .flush_interval = 0ms});
+        log->add_sink(sink);
+        expect(sink->capacity(), equal_to(SinkType::Alignment));
+
+        const std::basic_string<Char> line((SinkType::Alignment / sizeof(Char) / 3) - 1, Char{'x'});
+        std::basic_string<Char> expected;
+        for (int i = 0; i < 4; ++i) {
+            log->info(line);
+            expected += line + Char{'\n'};
+        }
+        // Three lines fit into the buffer, the fourth one triggers the write
+        expect(cap_file.read(), equal_to(expected));
+        expect(sink->stats().syscalls, equal_to(1U));
+
+        // Line larger than the buffer is written directly
+        const std::basic_string<Char> large(SinkType::Alignment, Char{'y'});
+        log->info(large);
+        expect(cap_file.read(), equal_to(large + Char{'\n'}));
+    });
+
+    // Test that the flush interval is checked on the next message
+    _.test("interval", []() {
+        auto log = LoggerType::create();
+        FileCapturer<Char> cap_file(log_filename, true);
+        auto sink = std::make_shared<SinkType>(
+            cap_file.path().string(), BufferedFileOptions{.capacity = 4096, .flush_interval = 1ms});
+        log->add_sink(sink);
+
+        log->info(numbered<Char>(1));
+        expect(cap_file.read(), equal_to(std::basic_string<Char>{}));
+        std::this_thread::sleep_for(5ms);
+        log->info(numbered<Char>(2));
+        expect(
+            cap_file.read(),
+            equal_to(numbered<Char>(1) + Char{'\n'} + numbered<Char>(2) + Char{'\n'}));
+    });
+
+    // Test that buffered lines are written on destruction
+    _.test("destructor", []() {
+        FileCapturer<Char> cap_file(log_filename, true);
+        {
+            auto log = LoggerType::create();
+            log->template add_sink<BufferedFileSink>(cap_file.path().string());
+            log->info(numbered<Char>(1));
+        }
+        expect(cap_file.read(), equal_to(numbered<Char>(1) + Char{'\n'}));
+    });
+
+    // Test that concurrent writers do not lose or mix lines
+    _.test("concurrent", []() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 2000;
+
+            auto log = LoggerType::create();
+            FileCapturer<Char> cap_file(log_filename, true);
+            auto sink = std::make_shared<SinkType>(
+                cap_file.path().string(),
+                BufferedFileOptions{.capacity = 8192, .flush_interval = 0ms});
+            log->add_sink(sink);
+
+            std::latch start(NumThreads);
+            std::vector<std::thread> threads;
+            threads.reserve(NumThreads);
+            for (int i = 0; i < NumThreads; ++i) {
+                threads.emplace_back([&log, &sink, &start, i]() {
+                    start.arrive_and_wait();
+                    for (int j = 0; j < Iterations; ++j) {
+                        log->info(numbered<Char>((i * Iterations) + j));
+                        if (j % 500 == 0) {
+                            sink->flush();
+                        }
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            sink->flush();
+
+            std::vector<std::basic_string<Char>> lines;
+            const auto output = cap_file.read();
+            std::size_t begin = 0;
+            for (auto end = output.find(Char{'\n'}); end != std::basic_string<Char>::npos;
+                 end = output.find(Char{'\n'}, begin)) {
+                lines.push_back(output.substr(begin, end - begin));
+                begin = end + 1;
+            }
+            expect(begin, equal_to(output.size()));
+
+            std::vector<std::basic_string<Char>> expected;
+            for (int i = 0; i < NumThreads * Iterations; ++i) {
+                expected.push_back(numbered<Char>(i));
+            }
+            std::ranges::sort(lines);
+            std::ranges::sort(expected);
+            expect(lines, equal_to(expected));
+        }
+    });
+
+    // Test that flush() returns only after the lines logged before it are written
+    _.test("concurrent_flush", []() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 50;
+
+            auto log = LoggerType::create();
+            FileCapturer<Char> cap_file(log_filename, true);
+            const auto path = cap_file.path().string();
+            auto sink = std::make_shared<SinkType>(
+                path, BufferedFileOptions{.capacity = 4096, .flush_interval = 0ms});
+            log->add_sink(sink);
+
+            std::atomic<int> missing{0};
+            std::latch start(NumThreads);
+            std::vector<std::thread> threads;
+            threads.reserve(NumThreads);
+            for (int i = 0; i < NumThreads; ++i) {
+                threads.emplace_back([&log, &sink, &start, &missing, &path, i]() {
+                    start.arrive_and_wait();
+                    for (int j = 0; j < Iterations; ++j) {
+                        const auto message = numbered<Char>((i * Iterations) + j);
+                        log->info(message);
+                        sink->flush();
+                        const auto line = to_bytes(message + Char{'\n'}).substr(bom_size<Char>());
+                        if (read_bytes(path).find(line) == std::string::npos) {
+                            missing.fetch_add(1);
+                        }
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            expect(missing.load(), equal_to(0));
+        }
+    });
+});
+
+} // namespace
@@ -0,0 +1,258 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/category_file_sink.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/file_capturer.h"
+
+#include <mettle.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <latch>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+using namespace std::chrono_literals;
+
+// Lines of the file, after the byte order mark of wide characters
+template<typename Char>
+auto read_lines(const std::string& filename) -> std::vector<std::basic_string<Char>>
+{
+    const auto bytes = read_bytes(filename);
+    std::basic_string<Char> text(bytes.size() / sizeof(Char), Char{});
+    std::memcpy(text.data(), bytes.data(), text.size() * sizeof(Char));
+    if constexpr (sizeof(Char) > 1) {
+        expect(text.empty() || text.front() == static_cast<Char>(0xFEFF), equal_to(true));
+        text.erase(0, text.empty() ? 0 : 1);
+    }
+
+    std::vector<std::basic_string<Char>> lines;
+    std::size_t begin = 0;
+    for (auto end = text.find(Char{'\n'}); end != std::basic_string<Char>::npos;
+         end = text.find(Char{'\n'}, begin)) {
+        lines.push_back(text.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    expect(begin, equal_to(text.size()));
+    return lines;
+}
+
+std::pair<std::chrono::sys_seconds, std::size_t> fake_time; // NOLINT(*-non-const-global-*)
+
+auto get_fake_time() -> std::pair<std::chrono::sys_seconds, std::size_t>
+{
+    return fake_time;
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> CategoryFile("category_file", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = CategoryFileSink<Char, ThreadingPolicy>;
+    using String = std::basic_string<Char>;
+
+    static const auto log_path = get_log_filename<Char>("category_file_{category}");
+
+    // Creates the sink after removing the files of the categories
+    const auto make_sink = [](const std::vector<std::string_view>& categories,
+                              const CategoryFileOptions& options = {}) {
+        auto sink = std::make_shared<SinkType>(log_path, options);
+        for (const auto category : categories) {
+            std::filesystem::remove(sink->filename(from_utf8<Char>(category)));
+        }
+        return sink;
+    };
+
+    // Test that the file names are made from the path and the category
+    _.test("filename", []() {
+        const SinkType sink(log_path);
+        expect(
+            sink.filename(from_utf8<Char>("net/http")),
+            equal_to(get_log_filename<Char>("category_file_net_http")));
+        const SinkType plain("logs/app.log");
+        expect(plain.filename(from_utf8<Char>("db")), equal_to("logs/app.log.db"));
+        expect(plain.filename(from_utf8<Char>("été")), equal_to("logs/app.log.été"));
+    });
+
+    // Test that each category is written to its own file
+    _.test("routing", [make_sink]() {
+        auto sink = make_sink({"main", "child", "other"});
+        {
+            auto log = LoggerType::create(from_utf8<Char>("main"));
+            log->add_sink(sink);
+            auto child = LoggerType::create(log, from_utf8<Char>("child"));
+            // Same text at another address goes to the same file
+            auto other = LoggerType::create(from_utf8<Char>("other"));
+            auto other_copy = LoggerType::create(from_utf8<Char>("other"));
+            other->add_sink(sink);
+            other_copy->add_sink(sink);
+
+            for (int i = 0; i < 10; ++i) {
+                log->info(numbered<Char>(i));
+                child->info(numbered<Char>(i + 100));
+                (i % 2 == 0 ? other : other_copy)->info(numbered<Char>(i + 200));
+            }
+            expect(sink->open_files(), equal_to(3U));
+        }
+        sink->flush();
+
+        const auto check = [&sink](std::string_view category, int first) {
+            std::vector<String> expected;
+            for (int i = first; i < first + 10; ++i) {
+                expected.push_back(numbered<Char>(i));
+            }
+            expect(
+                read_lines<Char>(sink->filename(from_utf8<Char>(category))), equal_to(expected));
+        };
+        check("main", 0);
+        check("child", 100);
+        check("other", 200);
+        expect(sink->stats().opens, equal_to(3U));
+        expect(sink->stats().evictions, equal_to(0U));
+    });
+
+    // Test that the least recently used file is closed and reopened for append
+    _.test("eviction", [make_sink]() {
+        auto sink = make_sink({"a", "b", "c"}, {.max_open_files = 2});
+        std::vector<std::shared_ptr<LoggerType>> loggers;
+        for (const auto* category : {"a", "b", "c"}) {
+            loggers.push_back(LoggerType::create(from_utf8<Char>(category)));
+            loggers.back()->add_sink(sink);
+        }
+
+        // Each record of the round robin evicts the least recently used file
+        for (int i = 0; i < 9; ++i) {
+            loggers.at(i % 3)->info(numbered<Char>(i));
+            expect(sink->open_files(), less_equal(2U));
+        }
+        expect(sink->stats().opens, equal_to(9U));
+        expect(sink->stats().evictions, equal_to(7U));
+
+        // Recently used files stay open
+        loggers.at(2)->info(numbered<Char>(9));
+        loggers.at(2)->info(numbered<Char>(10));
+        expect(sink->stats().opens, equal_to(9U));
+        sink->flush();
+
+        expect(
+            read_lines<Char>(sink->filename(from_utf8<Char>("a"))),
+            equal_to(std::vector<String>{numbered<Char>(0), numbered<Char>(3), numbered<Char>(6)}));
+        expect(
+            read_lines<Char>(sink->filename(from_utf8<Char>("c"))),
+            equal_to(std::vector<String>{
+                numbered<Char>(2),
+                numbered<Char>(5),
+                numbered<Char>(8),
+                numbered<Char>(9),
+                numbered<Char>(10)}));
+    });
+
+    // Test that files unused for the idle timeout are closed
+    _.test("idle", [make_sink]() {
+        auto sink = make_sink({"busy", "idle"}, {.idle_timeout = 10s});
+        auto busy = LoggerType::create(from_utf8<Char>("busy"));
+        auto idle = LoggerType::create(from_utf8<Char>("idle"));
+        busy->set_time_func(get_fake_time);
+        idle->set_time_func(get_fake_time);
+        busy->add_sink(sink);
+        idle->add_sink(sink);
+
+        const std::chrono::sys_seconds start{1700000000s};
+        fake_time = {start, 0};
+        idle->info(numbered<Char>(0));
+        for (int i = 1; i < 10; ++i) {
+            fake_time = {start + std::chrono::seconds(i), 0};
+            busy->info(numbered<Char>(i));
+        }
+        expect(sink->open_files(), equal_to(2U));
+
+        fake_time = {start + 10s, 0};
+        busy->info(numbered<Char>(10));
+        expect(sink->open_files(), equal_to(1U));
+        expect(sink->stats().evictions, equal_to(1U));
+        // The lines were written when the file was closed
+        expect(
+            read_lines<Char>(sink->filename(from_utf8<Char>("idle"))),
+            equal_to(std::vector<String>{numbered<Char>(0)}));
+    });
+
+    // Test that lines are written in buffer-sized batches
+    _.test("batching", [make_sink]() {
+        constexpr int Iterations = 1000;
+        auto sink = make_sink({"batch"}, {.buffer_size = 4096});
+        auto log = LoggerType::create(from_utf8<Char>("batch"));
+        log->add_sink(sink);
+        for (int i = 0; i < Iterations; ++i) {
+            log->info(numbered<Char>(i));
+        }
+        expect(sink->stats().syscalls, greater(0U));
+        expect(sink->stats().syscalls, less(sink->stats().bytes / 2048));
+        sink->flush();
+
+        const auto lines = read_lines<Char>(sink->filename(from_utf8<Char>("batch")));
+        expect(lines.size(), equal_to(std::size_t{Iterations}));
+        expect(lines.back(), equal_to(numbered<Char>(Iterations - 1)));
+        expect(
+            sink->stats().bytes,
+            equal_to(std::filesystem::file_size(sink->filename(from_utf8<Char>("batch")))));
+    });
+
+    // Test that concurrent writers keep the lines of each category together
+    _.test("concurrent", [make_sink]() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 1000;
+            auto sink = make_sink(
+                {"t0", "t1", "t2", "t3", "t4", "t5", "t6", "t7"},
+                {.max_open_files = 3, .buffer_size = 1024});
+            {
+                std::latch start(NumThreads);
+                std::vector<std::thread> threads;
+                threads.reserve(NumThreads);
+                for (int i = 0; i < NumThreads; ++i) {
+                    threads.emplace_back([&sink, &start, i]() {
+                        auto log = LoggerType::create(from_utf8<Char>("t" + std::to_string(i)));
+                        log->add_sink(sink);
+                        start.arrive_and_wait();
+                        for (int j = 0; j < Iterations; ++j) {
+                            log->info(numbered<Char>(j));
+                        }
+                    });
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            }
+            sink->flush();
+            expect(sink->open_files(), less_equal(3U));
+
+            for (int i = 0; i < NumThreads; ++i) {
+                const auto lines = read_lines<Char>(
+                    sink->filename(from_utf8<Char>("t" + std::to_string(i))));
+                expect(lines.size(), equal_to(std::size_t{Iterations}));
+                for (int j = 0; j < Iterations; ++j) {
+                    expect(lines.at(static_cast<std::size_t>(j)), equal_to(numbered<Char>(j)));
+                }
+            }
+        }
+    });
+});
+
+} // namespace
@@ -0,0 +1,236 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/compressed_file_sink.h"
+#include "slimlog/util/lz4.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/file_capturer.h"
+
+#include <mettle.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <latch>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// IWYU pragma: no_include <utility>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+// Decompressed contents of the file
+auto decompressed(const std::string& data) -> std::string
+{
+    std::vector<std::byte> output;
+    const auto* begin = reinterpret_cast<const std::byte*>(data.data()); // NOLINT(*-cast)
+    expect(util::lz4::decompress_frames({begin, data.size()}, output), equal_to(true));
+    std::string result(output.size(), '\0');
+    std::memcpy(result.data(), output.data(), output.size());
+    return result;
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> CompressedFile("compressed_file", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = CompressedFileSink<Char, ThreadingPolicy>;
+    using String = std::basic_string<Char>;
+
+    static auto log_filename = get_log_filename<Char>("compressed_file");
+
+    // Test that the file is a complete LZ4 frame after destruction
+    _.test("frame", []() {
+        std::filesystem::remove(log_filename);
+        String expected;
+        {
+            auto log = LoggerType::create();
+            auto sink = std::make_shared<SinkType>(log_filename);
+            log->add_sink(sink);
+            expect(sink->block_size(), equal_to(util::lz4::MinBlockSize));
+
+            for (int i = 0; i < 1000; ++i) {
+                log->info(numbered<Char>(i));
+                expected += numbered<Char>(i) + Char{'\n'};
+            }
+            sink->flush();
+            const auto stats = sink->stats();
+            expect(stats.blocks, greater_equal(1U));
+            expect(stats.input_bytes, equal_to(to_bytes(expected).size()));
+            expect(stats.ratio(), greater(2.0));
+        }
+
+        const auto data = read_bytes(log_filename);
+        // Magic, version 1 with independent blocks, 64 KiB blocks, header checksum
+        expect(data.substr(0, 7), equal_to(std::string("\x04\x22\x4D\x18\x60\x40\x82", 7)));
+        expect(data.substr(data.size() - 4), equal_to(std::string(4, '\0')));
+        expect(decompressed(data), equal_to(to_bytes(expected)));
+    });
+
+    // Test lines crossing block boundaries with flushes at arbitrary points
+    _.test("blocks", []() {
+        std::filesystem::remove(log_filename);
+        String expected;
+        {
+            auto log = LoggerType::create();
+            auto sink = std::make_shared<SinkType>(log_filename, CompressedFileOptions{1, 1});
+            log->add_sink(sink);
+            expect(sink->block_size(), equal_to(util::lz4::MinBlockSize));
+
+            for (int i = 0; i < 20000; ++i) {
+                log->info(numbered<Char>(i));
+                expected += numbered<Char>(i) + Char{'\n'};
+                if (i % 3001 == 0) {
+                    sink->flush();
+                    expect(decompressed(read_bytes(log_filename)), equal_to(to_bytes(expected)));
+                }
+            }
+            const String large(util::lz4::MinBlockSize, Char{'x'});
+            log->info(large);
+            expected += large + Char{'\n'};
+        }
+        expect(decompressed(read_bytes(log_filename)), equal_to(to_bytes(expected)));
+    });
+
+    // Test that a file cut in the middle of a block keeps the complete blocks
+    _.test("truncated", []() {
+        std::filesystem::remove(log_filename);
+        String expected;
+        {
+            auto log = LoggerType::create();
+            auto sink = std::make_shared<SinkType>(log_filename);
+            log->add_sink(sink);
+            for (int i = 0; i < 30000; ++i) {
+                log->info(numbered<Char>(i));
+                expected += numbered<Char>(i) + Char{'\n'};
+            }
+            sink->flush();
+            expect(sink->stats().blocks, greater(2U));
+        }
+
+        auto data = read_bytes(log_filename);
+        data.resize(data.size() - 20);
+        const auto output = decompressed(data);
+        expect(output.size() % util::lz4::MinBlockSize, equal_to(0U));
+        expect(output.size(), greater(0U));
+        expect(to_bytes(expected).starts_with(output), equal_to(true));
+    });
+
+    // Test that reopening the file appends a new frame
+    _.test("reopen", []() {
+        std::filesystem::remove(log_filename);
+        String expected;
+        for (int run = 0; run < 3; ++run) {
+            auto log = LoggerType::create();
+            log->template add_sink<CompressedFileSink>(log_filename);
+            for (int i = 0; i < 100; ++i) {
+                log->info(numbered<Char>((run * 100) + i));
+                expected += numbered<Char>((run * 100) + i) + Char{'\n'};
+            }
+        }
+        expect(decompressed(read_bytes(log_filename)), equal_to(to_bytes(expected)));
+    });
+
+    // Test that a frame left open by a crashed writer is completed on reopening
+    _.test("crash", []() {
+        std::filesystem::remove(log_filename);
+        String expected;
+        {
+            auto log = LoggerType::create();
+            auto sink = std::make_shared<SinkType>(log_filename);
+            log->add_sink(sink);
+            for (int i = 0; i < 30000; ++i) {
+                log->info(numbered<Char>(i));
+                expected += numbered<Char>(i) + Char{'\n'};
+            }
+        }
+
+        // Drop the end mark and leave a partial block, as a killed process would
+        auto data = read_bytes(log_filename);
+        data.resize(data.size() - 4);
+        data += std::string{'\x10', '\x00', '\x00', '\x00', 'x', 'y'};
+        {
+            std::ofstream file(log_filename, std::ios::binary | std::ios::trunc);
+            file << data;
+        }
+
+        for (int run = 0; run < 2; ++run) {
+            auto log = LoggerType::create();
+            log->template add_sink<CompressedFileSink>(log_filename);
+            for (int i = 0; i < 100; ++i) {
+                log->info(numbered<Char>(i));
+                expected += numbered<Char>(i) + Char{'\n'};
+            }
+        }
+        expect(decompressed(read_bytes(log_filename)), equal_to(to_bytes(expected)));
+    });
+
+    // Test that concurrent writers do not lose or mix lines
+    _.test("concurrent", []() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 2000;
+
+            std::filesystem::remove(log_filename);
+            {
+                auto log = LoggerType::create();
+                auto sink = std::make_shared<SinkType>(log_filename, CompressedFileOptions{1, 2});
+                log->add_sink(sink);
+
+                std::latch start(NumThreads);
+                std::vector<std::thread> threads;
+                threads.reserve(NumThreads);
+                for (int i = 0; i < NumThreads; ++i) {
+                    threads.emplace_back([&log, &sink, &start, i]() {
+                        start.arrive_and_wait();
+                        for (int j = 0; j < Iterations; ++j) {
+                            log->info(numbered<Char>((i * Iterations) + j));
+                            if (j % 500 == 0) {
+                                sink->flush();
+                            }
+                        }
+                    });
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            const auto data = decompressed(read_bytes(log_filename));
+            const auto skip = sizeof(Char) > 1 ? sizeof(Char) : 0;
+            String output((data.size() - skip) / sizeof(Char), Char{});
+            std::memcpy(output.data(), data.data() + skip, output.size() * sizeof(Char));
+
+            std::vector<String> lines;
+            std::size_t begin = 0;
+            for (auto end = output.find(Char{'\n'}); end != String::npos;
+                 end = output.find(Char{'\n'}, begin)) {
+                lines.push_back(output.substr(begin, end - begin));
+                begin = end + 1;
+            }
+            expect(begin, equal_to(output.size()));
+
+            std::vector<String> expected;
+            for (int i = 0; i < NumThreads * Iterations; ++i) {
+                expected.push_back(numbered<Char>(i));
+            }
+            std::ranges::sort(lines);
+            std::ranges::sort(expected);
+            expect(lines, equal_to(expected));
+        }
+    });
+});
+
+} // namespace
@@ -0,0 +1,168 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/direct_file_sink.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/file_capturer.h"
+
+#include <mettle.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <latch>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// IWYU pragma: no_include <utility>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> DirectFile("direct_file", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = DirectFileSink<Char, ThreadingPolicy>;
+    using String = std::basic_string<Char>;
+
+    static auto log_filename = get_log_filename<Char>("direct_file");
+
+    // Test that the incomplete last block is written on flush and rewritten later
+    _.test("partial", []() {
+        std::filesystem::remove(log_filename);
+        String expected;
+        {
+            auto log = LoggerType::create();
+            auto sink = std::make_shared<SinkType>(log_filename);
+            log->add_sink(sink);
+            expect(sink->capacity(), equal_to(DirectFileOptions{}.capacity));
+
+            for (int i = 0; i < 3; ++i) {
+                log->info(numbered<Char>(i));
+                expected += numbered<Char>(i) + Char{'\n'};
+            }
+            expect(std::filesystem::file_size(log_filename), equal_to(0U));
+            sink->flush();
+            expect(read_bytes(log_filename), equal_to(to_bytes(expected)));
+
+            for (int i = 3; i < 5; ++i) {
+                log->info(numbered<Char>(i));
+                expected += numbered<Char>(i) + Char{'\n'};
+            }
+            sink->flush();
+            sink->flush();
+            expect(read_bytes(log_filename), equal_to(to_bytes(expected)));
+
+            log->info(numbered<Char>(5));
+            expected += numbered<Char>(5) + Char{'\n'};
+        }
+        // Buffered lines are written on destruction
+        expect(read_bytes(log_filename), equal_to(to_bytes(expected)));
+    });
+
+    // Test lines crossing block and buffer boundaries with flushes at arbitrary points
+    _.test("blocks", []() {
+        std::filesystem::remove(log_filename);
+        String expected;
+        {
+            auto log = LoggerType::create();
+            auto sink = std::make_shared<SinkType>(log_filename, DirectFileOptions{.capacity = 1});
+            log->add_sink(sink);
+            expect(sink->capacity(), equal_to(SinkType::Alignment));
+
+            for (int i = 0; i < 1000; ++i) {
+                log->info(numbered<Char>(i));
+                expected += numbered<Char>(i) + Char{'\n'};
+                if (i % 7 == 0) {
+                    sink->flush();
+                    expect(read_bytes(log_filename), equal_to(to_bytes(expected)));
+                }
+            }
+            const String large(3 * SinkType::Alignment, Char{'x'});
+            log->info(large);
+            expected += large + Char{'\n'};
+        }
+        expect(read_bytes(log_filename), equal_to(to_bytes(expected)));
+    });
+
+    // Test that an existing file ending with an incomplete block is appended to
+    _.test("reopen", []() {
+        std::filesystem::remove(log_filename);
+        String expected;
+        for (int run = 0; run < 3; ++run) {
+            auto log = LoggerType::create();
+            log->template add_sink<DirectFileSink>(log_filename);
+            for (int i = 0; i < 100; ++i) {
+                log->info(numbered<Char>((run * 100) + i));
+                expected += numbered<Char>((run * 100) + i) + Char{'\n'};
+            }
+        }
+        expect(read_bytes(log_filename), equal_to(to_bytes(expected)));
+    });
+
+    // Test that concurrent writers do not lose or mix lines
+    _.test("concurrent", []() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 2000;
+
+            std::filesystem::remove(log_filename);
+            {
+                auto log = LoggerType::create();
+                auto sink = std::make_shared<SinkType>(
+                    log_filename, DirectFileOptions{.capacity = 8192});
+                log->add_sink(sink);
+
+                std::latch start(NumThreads);
+                std::vector<std::thread> threads;
+                threads.reserve(NumThreads);
+                for (int i = 0; i < NumThreads; ++i) {
+                    threads.emplace_back([&log, &sink, &start, i]() {
+                        start.arrive_and_wait();
+                        for (int j = 0; j < Iterations; ++j) {
+                            log->info(numbered<Char>((i * Iterations) + j));
+                            if (j % 500 == 0) {
+                                sink->flush();
+                            }
+                        }
+                    });
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            std::vector<String> lines;
+            FileCapturer<Char> cap_file(log_filename);
+            cap_file.rewind();
+            const auto output = cap_file.read();
+            std::size_t begin = 0;
+            for (auto end = output.find(Char{'\n'}); end != String::npos;
+                 end = output.find(Char{'\n'}, begin)) {
+                lines.push_back(output.substr(begin, end - begin));
+                begin = end + 1;
+            }
+            expect(begin, equal_to(output.size()));
+
+            std::vector<String> expected;
+            for (int i = 0; i < NumThreads * Iterations; ++i) {
+                expected.push_back(numbered<Char>(i));
+            }
+            std::ranges::sort(lines);
+            std::ranges::sort(expected);
+            expect(lines, equal_to(expected));
+        }
+    });
+});
+
+} // namespace
@@ -0,0 +1,153 @@
+#include "slimlog/common.h"
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/buffered_file_sink.h"
+#include "slimlog/sinks/file_sink.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/file_capturer.h"
+
+#include <mettle.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <latch>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+// Time returned by the logger time function
+std::chrono::sys_seconds fake_time; // NOLINT(*-avoid-non-const-global-variables)
+std::size_t fake_nsec = 0; // NOLINT(*-avoid-non-const-global-variables)
+
+auto get_fake_time() -> std::pair<std::chrono::sys_seconds, std::size_t>
+{
+    return {fake_time, fake_nsec};
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> Durability("durability", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = FileSink<Char, ThreadingPolicy>;
+    using namespace std::chrono_literals;
+
+    static auto log_filename = get_log_filename<Char>("durability");
+
+    // Test that records of the configured level or more severe are synced
+    _.test("level", []() {
+        auto log = LoggerType::create();
+        FileCapturer<Char> cap_file(log_filename, true);
+        auto sink = std::make_shared<SinkType>(cap_file.path().string());
+        log->add_sink(sink);
+
+        log->error(numbered<Char>(1));
+        expect(sink->syncs(), equal_to(0U));
+
+        sink->set_durability({.level = Level::Error});
+        log->info(numbered<Char>(2));
+        log->warning(numbered<Char>(3));
+        expect(sink->syncs(), equal_to(0U));
+        log->error(numbered<Char>(4));
+        expect(sink->syncs(), equal_to(1U));
+        log->fatal(numbered<Char>(5));
+        expect(sink->syncs(), equal_to(2U));
+
+        // Sync flushes the stream
+        expect(cap_file.read().empty(), equal_to(false));
+    });
+
+    // Test that the interval is checked against the record time
+    _.test("interval", []() {
+        auto log = LoggerType::create();
+        log->set_time_func(get_fake_time);
+        FileCapturer<Char> cap_file(log_filename, true);
+        auto sink = std::make_shared<SinkType>(cap_file.path().string());
+        log->add_sink(sink);
+        sink->set_durability({.interval = 1000ms});
+
+        fake_time = std::chrono::sys_seconds{1000s};
+        fake_nsec = 0;
+        log->info(numbered<Char>(1));
+        fake_nsec = 500000000;
+        log->info(numbered<Char>(2));
+        fake_nsec = 999999999;
+        log->info(numbered<Char>(3));
+        expect(sink->syncs(), equal_to(0U));
+
+        // Interval is counted from the first unsynced record
+        fake_time += 1s;
+        fake_nsec = 0;
+        log->info(numbered<Char>(4));
+        expect(sink->syncs(), equal_to(1U));
+
+        // The next record starts a new interval
+        fake_time += 10s;
+        log->info(numbered<Char>(5));
+        expect(sink->syncs(), equal_to(1U));
+        fake_time += 1s;
+        log->info(numbered<Char>(6));
+        expect(sink->syncs(), equal_to(2U));
+    });
+
+    // Test that the policy applies to derived file sinks, flushing their own buffers
+    _.test("buffered", []() {
+        auto log = LoggerType::create();
+        FileCapturer<Char> cap_file(log_filename, true);
+        auto sink = std::make_shared<BufferedFileSink<Char, ThreadingPolicy>>(
+            cap_file.path().string(), BufferedFileOptions{.capacity = 4096, .flush_interval = 0ms});
+        log->add_sink(sink);
+        sink->set_durability({.level = Level::Error});
+
+        log->info(numbered<Char>(1));
+        expect(cap_file.read().empty(), equal_to(true));
+        log->error(numbered<Char>(2));
+        expect(sink->syncs(), equal_to(1U));
+        expect(
+            cap_file.read(),
+            equal_to(numbered<Char>(1) + Char{'\n'} + numbered<Char>(2) + Char{'\n'}));
+    });
+
+    // Test that concurrent syncs are coalesced
+    _.test("group_commit", []() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 100;
+
+            auto log = LoggerType::create();
+            FileCapturer<Char> cap_file(log_filename, true);
+            auto sink = std::make_shared<SinkType>(cap_file.path().string());
+            log->add_sink(sink);
+            sink->set_durability({.level = Level::Error});
+
+            std::latch start(NumThreads);
+            std::vector<std::thread> threads;
+            threads.reserve(NumThreads);
+            for (int i = 0; i < NumThreads; ++i) {
+                threads.emplace_back([&log, &start, i]() {
+                    start.arrive_and_wait();
+                    log->error(numbered<Char>(i));
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            expect(sink->syncs(), greater_equal(1U));
+            expect(sink->syncs(), less(static_cast<unsigned>(NumThreads / 2)));
+        }
+    });
+});
+
+} // namespace
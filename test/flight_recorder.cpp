@@ -0,0 +1,263 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/pattern.h"
+#include "slimlog/record.h"
+#include "slimlog/sinks/flight_recorder_sink.h"
+
+// Test helpers
+#include "helpers/common.h"
+
+#include <mettle.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <latch>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// IWYU pragma: no_include <functional>
+// IWYU pragma: no_include <utility>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+// Messages of all records in the ring
+template<typename Char>
+auto recovered(const std::string& filename) -> std::vector<std::basic_string<Char>>
+{
+    std::vector<std::basic_string<Char>> messages;
+    const FlightRecorderReader reader(filename);
+    const auto count = reader.read<Char>(
+        [&messages](const Record<Char>& record) { messages.emplace_back(record.message); });
+    expect(count, equal_to(messages.size()));
+    return messages;
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> FlightRecorder("flight_recorder", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = FlightRecorderSink<Char, ThreadingPolicy>;
+    using String = std::basic_string<Char>;
+
+    static auto log_filename = get_log_filename<Char>("flight_recorder");
+
+    // Test that records are recovered with all fields and formatted with a pattern
+    _.test("recover", []() {
+        std::filesystem::remove(log_filename);
+        {
+            auto log = LoggerType::create(from_utf8<Char>("recorder"));
+            auto sink = std::make_shared<SinkType>(log_filename, 64 * 1024);
+            log->add_sink(sink);
+            expect(sink->capacity(), equal_to(64U * 1024));
+            for (int i = 0; i < 100; ++i) {
+                log->warning(numbered<Char>(i));
+            }
+            static constexpr std::array<Char, 9> Format{
+                'V', 'a', 'l', 'u', 'e', ' ', '{', '}', '\0'};
+            log->info(FormatString<Char, int>(Format.data()), 42);
+            for (const auto& message : unicode_strings<Char>()) {
+                log->error(message);
+            }
+            sink->flush();
+        }
+
+        const FlightRecorderReader reader(log_filename);
+        expect(reader.char_size(), equal_to(sizeof(Char)));
+        const Pattern<Char> pattern(from_utf8<Char>("{category} {level}: {message}"));
+        std::vector<String> lines;
+        reader.read<Char>([&](const Record<Char>& record) {
+            expect(record.line, greater(0U));
+            const std::string_view filename = record.filename;
+            expect(filename.ends_with("flight_recorder.cpp"), equal_to(true));
+            FormatBuffer<Char, 256> buffer;
+            pattern.format(buffer, record);
+            lines.emplace_back(buffer.data(), buffer.size());
+        });
+
+        std::vector<String> expected;
+        for (int i = 0; i < 100; ++i) {
+            expected.push_back(from_utf8<Char>("recorder WARN: ") + numbered<Char>(i));
+        }
+        expected.push_back(from_utf8<Char>("recorder INFO: Value 42"));
+        for (const auto& message : unicode_strings<Char>()) {
+            expected.push_back(from_utf8<Char>("recorder ERROR: ") + message);
+        }
+        expect(lines, equal_to(expected));
+    });
+
+    // Test that a full ring keeps the most recent records in order
+    _.test("wrap", []() {
+        std::filesystem::remove(log_filename);
+        {
+            auto log = LoggerType::create();
+            log->add_sink(std::make_shared<SinkType>(log_filename, 4096));
+            for (int i = 0; i < 1000; ++i) {
+                log->info(numbered<Char>(i));
+            }
+        }
+
+        const auto messages = recovered<Char>(log_filename);
+        expect(messages.size(), greater(10U));
+        expect(messages.size(), less(1000U));
+        const auto first = 1000 - static_cast<int>(messages.size());
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            expect(messages[i], equal_to(numbered<Char>(first + static_cast<int>(i))));
+        }
+    });
+
+    // Test that a message larger than the ring is truncated
+    _.test("truncate", []() {
+        std::filesystem::remove(log_filename);
+        const String large(10000, Char{'x'});
+        {
+            auto log = LoggerType::create();
+            log->add_sink(std::make_shared<SinkType>(log_filename, 4096));
+            log->info(large);
+            log->info(numbered<Char>(1));
+        }
+
+        const auto messages = recovered<Char>(log_filename);
+        expect(messages.size(), equal_to(2U));
+        expect(messages[0].size(), less(2048U / sizeof(Char)));
+        expect(large.starts_with(messages[0]), equal_to(true));
+        expect(messages[1], equal_to(numbered<Char>(1)));
+    });
+
+    // Test that a corrupted record is skipped
+    _.test("corrupt", []() {
+        std::filesystem::remove(log_filename);
+        {
+            auto log = LoggerType::create();
+            log->add_sink(std::make_shared<SinkType>(log_filename, 4096));
+            for (int i = 0; i < 10; ++i) {
+                log->info(numbered<Char>(i));
+            }
+        }
+
+        const auto message = numbered<Char>(4);
+        std::string bytes(message.size() * sizeof(Char), '\0');
+        std::memcpy(bytes.data(), message.data(), bytes.size());
+        std::fstream file(log_filename, std::ios::in | std::ios::out | std::ios::binary);
+        std::string data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        const auto offset = data.find(bytes);
+        expect(offset, not_equal_to(std::string::npos));
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.put('m');
+        file.close();
+
+        auto expected = std::vector<String>();
+        for (int i = 0; i < 10; ++i) {
+            if (i != 4) {
+                expected.push_back(numbered<Char>(i));
+            }
+        }
+        expect(recovered<Char>(log_filename), equal_to(expected));
+    });
+
+    // Test that reopening the ring continues after the last record
+    _.test("reopen", []() {
+        std::filesystem::remove(log_filename);
+        std::vector<String> expected;
+        for (int run = 0; run < 3; ++run) {
+            auto log = LoggerType::create();
+            log->add_sink(std::make_shared<SinkType>(log_filename, 64 * 1024));
+            for (int i = 0; i < 10; ++i) {
+                log->info(numbered<Char>((run * 10) + i));
+                expected.push_back(numbered<Char>((run * 10) + i));
+            }
+        }
+        expect(recovered<Char>(log_filename), equal_to(expected));
+
+        // Ring of another size starts over
+        {
+            auto log = LoggerType::create();
+            log->add_sink(std::make_shared<SinkType>(log_filename, 8192));
+            log->info(numbered<Char>(100));
+        }
+        expect(recovered<Char>(log_filename), equal_to(std::vector<String>{numbered<Char>(100)}));
+    });
+
+#ifndef _WIN32
+    // Test that records survive a killed process
+    _.test("crash", []() {
+        std::filesystem::remove(log_filename);
+        const auto pid = fork();
+        if (pid == 0) {
+            auto log = LoggerType::create();
+            log->add_sink(std::make_shared<SinkType>(log_filename, 64 * 1024));
+            for (int i = 0; i < 100; ++i) {
+                log->info(numbered<Char>(i));
+            }
+            std::raise(SIGKILL);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        expect(WIFSIGNALED(status), equal_to(true));
+
+        std::vector<String> expected;
+        for (int i = 0; i < 100; ++i) {
+            expected.push_back(numbered<Char>(i));
+        }
+        expect(recovered<Char>(log_filename), equal_to(expected));
+    });
+#endif
+
+    // Test that concurrent writers do not lose or mix records
+    _.test("concurrent", []() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 2000;
+
+            std::filesystem::remove(log_filename);
+            {
+                auto log = LoggerType::create();
+                log->add_sink(std::make_shared<SinkType>(log_filename));
+
+                std::latch start(NumThreads);
+                std::vector<std::thread> threads;
+                threads.reserve(NumThreads);
+                for (int i = 0; i < NumThreads; ++i) {
+                    threads.emplace_back([&log, &start, i]() {
+                        start.arrive_and_wait();
+                        for (int j = 0; j < Iterations; ++j) {
+                            log->info(numbered<Char>((i * Iterations) + j));
+                        }
+                    });
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            auto messages = recovered<Char>(log_filename);
+            std::vector<String> expected;
+            for (int i = 0; i < NumThreads * Iterations; ++i) {
+                expected.push_back(numbered<Char>(i));
+            }
+            std::ranges::sort(messages);
+            std::ranges::sort(expected);
+            expect(messages, equal_to(expected));
+        }
+    });
+});
+
+} // namespace
@@ -127,6 +127,19 @@ auto from_utf8(T&& str) -> std::basic_string<Char>
     return slimlog::util::unicode::from_utf8<Char>(std::forward<T>(str));
 }
 
+/**
+ * @brief Creates a numbered test message, e.g. "Message 1".
+ *
+ * @tparam Char The character type for the message.
+ * @param number Message number.
+ * @return Message string.
+ */
+template<typename Char>
+auto numbered(int number) -> std::basic_string<Char>
+{
+    return from_utf8<Char>("Message " + std::to_string(number));
+}
+
 /**
  * @brief Returns a collection of test strings with various Unicode characters.
  *
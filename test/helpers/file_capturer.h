@@ -4,7 +4,9 @@
 
 #include <array>
 #include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iterator>
@@ -76,6 +78,12 @@ public:
         return from_utf8<Char>(std::string{StreamIterator(m_file), StreamIterator()});
     }
 
+    void rewind()
+    {
+        m_file.clear();
+        m_file.seekg(0);
+    }
+
     void remove_file()
     {
         m_file.close();
@@ -207,3 +215,62 @@ private:
     std::ifstream m_file;
     BOM m_bom = BOM::None;
 };
+
+/**
+ * @brief Reads the whole file as text, skipping the byte order mark.
+ *
+ * @tparam Char The character type of the file contents.
+ * @param filename File name.
+ * @return File contents.
+ */
+template<typename Char>
+auto read_file(const std::string& filename) -> std::basic_string<Char>
+{
+    FileCapturer<Char> cap_file(filename);
+    cap_file.rewind();
+    return cap_file.read();
+}
+
+/**
+ * @brief Reads raw contents of the file.
+ *
+ * @param filename File name.
+ * @return File contents as bytes.
+ */
+inline auto read_bytes(const std::string& filename) -> std::string
+{
+    std::ifstream file(filename, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+/**
+ * @brief Gets the size of the byte order mark written by file sinks.
+ *
+ * @tparam Char The character type of the file contents.
+ * @return BOM size in bytes, zero for single-byte characters.
+ */
+template<typename Char>
+auto bom_size() -> std::size_t
+{
+    return sizeof(Char) > 1 ? sizeof(Char) : 0;
+}
+
+/**
+ * @brief Converts the text to raw file contents written by file sinks.
+ *
+ * @tparam Char The character type of the text.
+ * @param text Text to convert.
+ * @return BOM in native byte order followed by the text, as bytes.
+ */
+template<typename Char>
+auto to_bytes(const std::basic_string<Char>& text) -> std::string
+{
+    std::basic_string<Char> data;
+    if constexpr (sizeof(Char) > 1) {
+        data.push_back(static_cast<Char>(0xFEFF)); // NOLINT(*-magic-numbers)
+    }
+    data += text;
+    std::string result(data.size() * sizeof(Char), '\0');
+    std::memcpy(result.data(), data.data(), result.size());
+    return result;
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Datagram socket standing in for a local daemon like syslog or journald
+class DatagramReceiver {
+public:
+    explicit DatagramReceiver(std::string path)
+        : m_path(std::move(path))
+    {
+        ::unlink(m_path.c_str());
+        m_fd = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+        ::sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::copy(m_path.begin(), m_path.end(), std::begin(address.sun_path));
+        // NOLINTNEXTLINE(*-reinterpret-cast)
+        const auto* addr = reinterpret_cast<::sockaddr*>(&address);
+        if (m_fd < 0 || ::bind(m_fd, addr, sizeof(address)) != 0) {
+            throw std::runtime_error("Error binding socket " + m_path);
+        }
+    }
+
+    ~DatagramReceiver()
+    {
+        ::close(m_fd);
+        ::unlink(m_path.c_str());
+    }
+
+    DatagramReceiver(const DatagramReceiver&) = delete;
+    DatagramReceiver(DatagramReceiver&&) = delete;
+    auto operator=(const DatagramReceiver&) -> DatagramReceiver& = delete;
+    auto operator=(DatagramReceiver&&) -> DatagramReceiver& = delete;
+
+    [[nodiscard]] auto path() const -> const std::string&
+    {
+        return m_path;
+    }
+
+    // Waits for the next datagram
+    auto receive(int timeout_ms = 5000) -> std::string
+    {
+        auto datagram = try_receive(timeout_ms);
+        if (!datagram) {
+            throw std::runtime_error("No datagram received on " + m_path);
+        }
+        return std::move(*datagram);
+    }
+
+    // Gets the next datagram if one arrives within the timeout,
+    // or the contents of a file passed instead of the data
+    auto try_receive(int timeout_ms = 0) -> std::optional<std::string>
+    {
+        ::pollfd fd{m_fd, POLLIN, 0};
+        if (::poll(&fd, 1, timeout_ms) <= 0) {
+            return std::nullopt;
+        }
+        std::vector<char> buffer(MaxDatagram);
+        ::iovec iov{buffer.data(), buffer.size()};
+        union {
+            ::cmsghdr header;
+            std::array<char, CMSG_SPACE(sizeof(int))> data;
+        } control{};
+        ::msghdr message{};
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = control.data.data();
+        message.msg_controllen = sizeof(control.data);
+        const auto size = ::recvmsg(m_fd, &message, 0);
+        if (size < 0) {
+            throw std::runtime_error("Error receiving from " + m_path);
+        }
+
+        m_seals = -1;
+        const ::cmsghdr* header = CMSG_FIRSTHDR(&message);
+        if (header == nullptr || header->cmsg_type != SCM_RIGHTS) {
+            return std::string(buffer.data(), static_cast<std::size_t>(size));
+        }
+        int file = -1;
+        std::memcpy(&file, CMSG_DATA(header), sizeof(file));
+#ifdef F_GET_SEALS
+        m_seals = ::fcntl(file, F_GET_SEALS); // NOLINT(*-vararg)
+#endif
+        std::string contents;
+        for (::off_t offset = 0;;) {
+            const auto read = ::pread(file, buffer.data(), buffer.size(), offset);
+            if (read <= 0) {
+                break;
+            }
+            contents.append(buffer.data(), static_cast<std::size_t>(read));
+            offset += read;
+        }
+        ::close(file);
+        return contents;
+    }
+
+    // Seals of the file passed with the last datagram, -1 if there was none
+    [[nodiscard]] auto seals() const -> int
+    {
+        return m_seals;
+    }
+
+private:
+    static constexpr std::size_t MaxDatagram = 256 * 1024;
+
+    std::string m_path;
+    int m_fd = -1;
+    int m_seals = -1;
+};
+
+// Stream socket listening on a loopback TCP port or a Unix domain path,
+// standing in for a log collector
+class StreamListener {
+public:
+    // Listens on an ephemeral loopback TCP port, or on the path if given
+    explicit StreamListener(std::string path = {})
+        : m_path(std::move(path))
+    {
+        if (m_path.empty()) {
+            m_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            ::sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            ::socklen_t size = sizeof(address);
+            // NOLINTNEXTLINE(*-reinterpret-cast)
+            auto* addr = reinterpret_cast<::sockaddr*>(&address);
+            if (m_fd < 0 || ::bind(m_fd, addr, size) != 0 || ::getsockname(m_fd, addr, &size) != 0
+                || ::listen(m_fd, 4) != 0) {
+                throw std::runtime_error("Error listening on loopback");
+            }
+            m_address = "127.0.0.1:" + std::to_string(ntohs(address.sin_port));
+        } else {
+            ::unlink(m_path.c_str());
+            m_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            ::sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            std::copy(m_path.begin(), m_path.end(), std::begin(address.sun_path));
+            // NOLINTNEXTLINE(*-reinterpret-cast)
+            const auto* addr = reinterpret_cast<::sockaddr*>(&address);
+            if (m_fd < 0 || ::bind(m_fd, addr, sizeof(address)) != 0 || ::listen(m_fd, 4) != 0) {
+                throw std::runtime_error("Error listening on " + m_path);
+            }
+            m_address = "unix:" + m_path;
+        }
+    }
+
+    ~StreamListener()
+    {
+        disconnect();
+        ::close(m_fd);
+        if (!m_path.empty()) {
+            ::unlink(m_path.c_str());
+        }
+    }
+
+    StreamListener(const StreamListener&) = delete;
+    StreamListener(StreamListener&&) = delete;
+    auto operator=(const StreamListener&) -> StreamListener& = delete;
+    auto operator=(StreamListener&&) -> StreamListener& = delete;
+
+    // Address in the form accepted by the socket sink
+    [[nodiscard]] auto address() const -> const std::string&
+    {
+        return m_address;
+    }
+
+    // Waits for the next connection, closing the previous one
+    auto accept(int timeout_ms = 5000) -> void
+    {
+        disconnect();
+        ::pollfd fd{m_fd, POLLIN, 0};
+        if (::poll(&fd, 1, timeout_ms) <= 0
+            || (m_connection = ::accept(m_fd, nullptr, nullptr)) < 0) {
+            throw std::runtime_error("No connection on " + m_address);
+        }
+    }
+
+    // Closes the current connection
+    auto disconnect() -> void
+    {
+        if (m_connection >= 0) {
+            ::close(m_connection);
+            m_connection = -1;
+        }
+    }
+
+    // Reads from the current connection until the size is received,
+    // the peer closes the connection or nothing arrives within the timeout
+    auto receive(std::size_t size, int timeout_ms = 5000) -> std::string
+    {
+        std::string data;
+        std::vector<char> buffer(64 * 1024);
+        while (data.size() < size) {
+            ::pollfd fd{m_connection, POLLIN, 0};
+            if (::poll(&fd, 1, timeout_ms) <= 0) {
+                break;
+            }
+            const auto read = ::read(m_connection, buffer.data(), buffer.size());
+            if (read <= 0) {
+                break;
+            }
+            data.append(buffer.data(), static_cast<std::size_t>(read));
+        }
+        return data;
+    }
+
+private:
+    std::string m_path;
+    std::string m_address;
+    int m_fd = -1;
+    int m_connection = -1;
+};
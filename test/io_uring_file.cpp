@@ -0,0 +1,166 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/io_uring_file_sink.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/file_capturer.h"
+
+#include <mettle.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <latch>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// IWYU pragma: no_include <utility>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> IoUringFile("io_uring_file", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = IoUringFileSink<Char, ThreadingPolicy>;
+    using String = std::basic_string<Char>;
+
+    static auto log_filename = get_log_filename<Char>("io_uring_file");
+
+    // Test that buffered lines are written on flush
+    _.test("flush", []() {
+        auto log = LoggerType::create();
+        FileCapturer<Char> cap_file(log_filename, true);
+        auto sink = std::make_shared<SinkType>(cap_file.path().string());
+        log->add_sink(sink);
+
+        String expected;
+        for (int i = 0; i < 3; ++i) {
+            log->info(numbered<Char>(i));
+            expected += numbered<Char>(i) + Char{'\n'};
+        }
+        sink->flush();
+        expect(cap_file.read(), equal_to(expected));
+        if (sink->active()) {
+            expect(sink->stats().bytes, equal_to(expected.size() * sizeof(Char)));
+        }
+    });
+
+    // Test that full buffers are submitted in order while others are being filled
+    _.test("buffers", []() {
+        auto log = LoggerType::create();
+        FileCapturer<Char> cap_file(log_filename, true);
+        auto sink = std::make_shared<SinkType>(
+            cap_file.path().string(), IoUringFileOptions{.queue_depth = 2, .buffer_size = 1});
+        log->add_sink(sink);
+
+        String expected;
+        for (int i = 0; i < 2000; ++i) {
+            log->info(numbered<Char>(i));
+            expected += numbered<Char>(i) + Char{'\n'};
+        }
+        // Line larger than a buffer spans several of them
+        const String large(3 * SinkType::Alignment, Char{'x'});
+        log->info(large);
+        expected += large + Char{'\n'};
+        sink->flush();
+        expect(cap_file.read(), equal_to(expected));
+        if (sink->active()) {
+            // Each full buffer is submitted with a single system call
+            const auto stats = sink->stats();
+            expect(stats.bytes, equal_to(expected.size() * sizeof(Char)));
+            expect(stats.bytes_per_syscall(), greater(0.0));
+        }
+    });
+
+    // Test that the sink works without registered buffers and file
+    _.test("unregistered", []() {
+        auto log = LoggerType::create();
+        FileCapturer<Char> cap_file(log_filename, true);
+        auto sink = std::make_shared<SinkType>(
+            cap_file.path().string(),
+            IoUringFileOptions{.buffer_size = 1, .register_buffers = false, .register_file = false});
+        log->add_sink(sink);
+
+        String expected;
+        for (int i = 0; i < 1000; ++i) {
+            log->info(numbered<Char>(i));
+            expected += numbered<Char>(i) + Char{'\n'};
+        }
+        sink->flush();
+        expect(cap_file.read(), equal_to(expected));
+    });
+
+    // Test that buffered lines are written on destruction
+    _.test("destructor", []() {
+        FileCapturer<Char> cap_file(log_filename, true);
+        {
+            auto log = LoggerType::create();
+            log->template add_sink<IoUringFileSink>(cap_file.path().string());
+            log->info(numbered<Char>(1));
+        }
+        expect(cap_file.read(), equal_to(numbered<Char>(1) + Char{'\n'}));
+    });
+
+    // Test that concurrent writers do not lose or mix lines
+    _.test("concurrent", []() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 2000;
+
+            auto log = LoggerType::create();
+            FileCapturer<Char> cap_file(log_filename, true);
+            auto sink = std::make_shared<SinkType>(
+                cap_file.path().string(), IoUringFileOptions{.queue_depth = 4, .buffer_size = 1});
+            log->add_sink(sink);
+
+            std::latch start(NumThreads);
+            std::vector<std::thread> threads;
+            threads.reserve(NumThreads);
+            for (int i = 0; i < NumThreads; ++i) {
+                threads.emplace_back([&log, &sink, &start, i]() {
+                    start.arrive_and_wait();
+                    for (int j = 0; j < Iterations; ++j) {
+                        log->info(numbered<Char>((i * Iterations) + j));
+                        if (j % 500 == 0) {
+                            sink->flush();
+                        }
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            sink->flush();
+
+            std::vector<String> lines;
+            const auto output = cap_file.read();
+            std::size_t begin = 0;
+            for (auto end = output.find(Char{'\n'}); end != String::npos;
+                 end = output.find(Char{'\n'}, begin)) {
+                lines.push_back(output.substr(begin, end - begin));
+                begin = end + 1;
+            }
+            expect(begin, equal_to(output.size()));
+
+            std::vector<String> expected;
+            for (int i = 0; i < NumThreads * Iterations; ++i) {
+                expected.push_back(numbered<Char>(i));
+            }
+            std::ranges::sort(lines);
+            std::ranges::sort(expected);
+            expect(lines, equal_to(expected));
+        }
+    });
+});
+
+} // namespace
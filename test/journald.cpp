@@ -0,0 +1,211 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/journald_sink.h"
+#include "slimlog/util/os.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/socket_receiver.h"
+
+#include <mettle.hpp>
+
+#include <fcntl.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+// Fields of a journal entry in the native protocol
+auto parse_fields(std::string_view data) -> std::map<std::string, std::string>
+{
+    std::map<std::string, std::string> fields;
+    while (!data.empty()) {
+        const auto end = data.find_first_of("=\n");
+        if (end == std::string_view::npos) {
+            throw std::runtime_error("Truncated field: " + std::string(data));
+        }
+        const std::string name(data.substr(0, end));
+        if (data[end] == '=') {
+            const auto newline = data.find('\n', end);
+            fields[name] = data.substr(end + 1, newline - end - 1);
+            data.remove_prefix(newline + 1);
+        } else {
+            // Binary value with its size as 64-bit little endian
+            std::uint64_t size = 0;
+            for (std::size_t i = 0; i < 8; ++i) {
+                size |= std::uint64_t{static_cast<unsigned char>(data.at(end + 1 + i))} << (i * 8);
+            }
+            fields[name] = data.substr(end + 9, size);
+            if (data.at(end + 9 + size) != '\n') {
+                throw std::runtime_error("Missing newline after field " + name);
+            }
+            data.remove_prefix(end + 10 + size);
+        }
+    }
+    return fields;
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> Journald("journald", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = JournaldSink<Char, ThreadingPolicy>;
+
+    static const auto socket_path = get_log_filename<Char>("journald") + ".sock";
+
+    const auto options = []() {
+        JournaldOptions options;
+        options.path = socket_path;
+        options.identifier = "my app";
+        return options;
+    };
+
+    // Test that the record fields are sent as journal fields
+    _.test("fields", [options]() {
+        DatagramReceiver receiver(socket_path);
+        auto log = LoggerType::create(from_utf8<Char>("journal"), Level::Trace);
+        auto sink = std::make_shared<SinkType>(options());
+        log->add_sink(sink);
+
+        const auto line = std::to_string(__LINE__ + 1);
+        log->info(numbered<Char>(0));
+        auto fields = parse_fields(receiver.receive());
+        expect(fields.size(), equal_to(8U));
+        expect(fields["MESSAGE"], equal_to("Message 0"));
+        expect(fields["PRIORITY"], equal_to("6"));
+        expect(fields["SYSLOG_IDENTIFIER"], equal_to("my app"));
+        expect(fields["CATEGORY"], equal_to("journal"));
+        expect(fields["CODE_FILE"].ends_with("journald.cpp"), equal_to(true));
+        expect(fields["CODE_LINE"], equal_to(line));
+        expect(fields["CODE_FUNC"].empty(), equal_to(false));
+        expect(fields["TID"], equal_to(std::to_string(util::os::thread_id())));
+
+        const std::vector<std::pair<Level, std::string>> priorities{
+            {Level::Fatal, "2"},
+            {Level::Error, "3"},
+            {Level::Warning, "4"},
+            {Level::Debug, "7"},
+            {Level::Trace, "7"},
+        };
+        for (const auto& [level, priority] : priorities) {
+            log->message(level, numbered<Char>(1));
+            expect(parse_fields(receiver.receive())["PRIORITY"], equal_to(priority));
+        }
+        expect(sink->stats().syscalls, equal_to(6U));
+        expect(sink->stats().memory_files, equal_to(0U));
+    });
+
+    // Test that values spanning lines and text of any character type are sent
+    _.test("multiline", [options]() {
+        DatagramReceiver receiver(socket_path);
+        auto log = LoggerType::create(from_utf8<Char>("caf\xC3\xA9\nbar"));
+        auto custom_options = options();
+        custom_options.category_field = "LOGGER_2";
+        log->add_sink(std::make_shared<SinkType>(custom_options));
+
+        log->info(from_utf8<Char>("First line\nSecond \xF0\x9F\x98\x80 line\n"));
+        auto fields = parse_fields(receiver.receive());
+        expect(fields["MESSAGE"], equal_to("First line\nSecond \xF0\x9F\x98\x80 line\n"));
+        expect(fields["LOGGER_2"], equal_to("caf\xC3\xA9\nbar"));
+        expect(fields.contains("CATEGORY"), equal_to(false));
+    });
+
+    // Test that invalid field names and a missing socket are reported
+    _.test("errors", [options]() {
+        {
+            const DatagramReceiver receiver(socket_path);
+            for (const auto* name : {"", "lower", "_TRUSTED", "1ST", "WITH SPACE"}) {
+                auto invalid_options = options();
+                invalid_options.category_field = name;
+                expect(
+                    [&invalid_options]() { SinkType sink(invalid_options); },
+                    thrown<std::invalid_argument>());
+            }
+        }
+        expect([options]() { SinkType sink(options()); }, thrown<std::system_error>());
+    });
+
+    // Test that records too large for a datagram are passed in a sealed memory file
+    _.test("memory_file", [options]() {
+#ifdef __linux__
+        DatagramReceiver receiver(socket_path);
+        auto log = LoggerType::create();
+        auto sink = std::make_shared<SinkType>(options());
+        log->add_sink(sink);
+
+        const std::string large(std::size_t{1024} * 1024, 'x');
+        log->info(from_utf8<Char>(large));
+        const auto data = receiver.receive();
+        expect(receiver.seals() & F_SEAL_WRITE, equal_to(F_SEAL_WRITE));
+        expect(parse_fields(data)["MESSAGE"], equal_to(large));
+        expect(sink->stats().memory_files, equal_to(1U));
+        expect(sink->stats().bytes, equal_to(data.size()));
+
+        log->info(numbered<Char>(0));
+        expect(parse_fields(receiver.receive())["MESSAGE"], equal_to("Message 0"));
+        expect(receiver.seals(), equal_to(-1));
+        expect(sink->stats().memory_files, equal_to(1U));
+#endif
+    });
+
+    // Test that concurrent records arrive as whole entries
+    _.test("concurrent", [options]() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 500;
+            DatagramReceiver receiver(socket_path);
+            auto log = LoggerType::create();
+            log->add_sink(std::make_shared<SinkType>(options()));
+
+            std::vector<std::string> datagrams;
+            std::thread reader([&receiver, &datagrams]() {
+                for (int i = 0; i < NumThreads * Iterations; ++i) {
+                    datagrams.push_back(receiver.receive());
+                }
+            });
+            std::latch start(NumThreads);
+            std::vector<std::thread> threads;
+            threads.reserve(NumThreads);
+            for (int i = 0; i < NumThreads; ++i) {
+                threads.emplace_back([&log, &start, i]() {
+                    start.arrive_and_wait();
+                    for (int j = 0; j < Iterations; ++j) {
+                        log->info(numbered<Char>((i * Iterations) + j));
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            reader.join();
+
+            std::vector<int> counts(NumThreads * Iterations);
+            for (const auto& datagram : datagrams) {
+                const auto message = parse_fields(datagram)["MESSAGE"];
+                ++counts.at(std::stoul(message.substr(8)));
+            }
+            expect(std::ranges::count(counts, 1), equal_to(NumThreads * Iterations));
+        }
+    });
+});
+
+} // namespace
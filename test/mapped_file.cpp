@@ -0,0 +1,175 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/mapped_file_sink.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/file_capturer.h"
+
+#include <mettle.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <latch>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// IWYU pragma: no_include <utility>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> MappedFile("mapped_file", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = MappedFileSink<Char, ThreadingPolicy>;
+    using String = std::basic_string<Char>;
+
+    static auto log_filename = get_log_filename<Char>("mapped_file");
+
+    // Test that the file is extended by chunks and truncated to the written length
+    _.test("truncate", []() {
+        std::filesystem::remove(log_filename);
+        String expected;
+        {
+            auto log = LoggerType::create();
+            auto sink = std::make_shared<SinkType>(
+                log_filename, MappedFileOptions{.chunk_size = 1024 * 1024});
+            log->add_sink(sink);
+            for (int i = 0; i < 3; ++i) {
+                log->info(numbered<Char>(i));
+                expected += numbered<Char>(i) + Char{'\n'};
+            }
+            sink->flush();
+            expect(std::filesystem::file_size(log_filename), equal_to(1024U * 1024U));
+            expect(sink->mappings(), equal_to(1U));
+        }
+        expect(
+            std::filesystem::file_size(log_filename),
+            equal_to(bom_size<Char>() + (expected.size() * sizeof(Char))));
+        expect(read_file<Char>(log_filename), equal_to(expected));
+
+        // Reopened file is appended to
+        {
+            auto log = LoggerType::create();
+            log->template add_sink<MappedFileSink>(log_filename);
+            log->info(numbered<Char>(3));
+            expected += numbered<Char>(3) + Char{'\n'};
+        }
+        expect(read_file<Char>(log_filename), equal_to(expected));
+    });
+
+    // Test that the padding left by an abnormal termination is removed on reopening
+    _.test("padding", []() {
+        std::filesystem::remove(log_filename);
+        String expected;
+        {
+            auto log = LoggerType::create();
+            log->template add_sink<MappedFileSink>(log_filename);
+            log->info(numbered<Char>(0));
+            expected += numbered<Char>(0) + Char{'\n'};
+        }
+        // File is not truncated if the process is killed
+        std::filesystem::resize_file(log_filename, 64 * 1024);
+
+        {
+            auto log = LoggerType::create();
+            log->template add_sink<MappedFileSink>(log_filename);
+            log->info(numbered<Char>(1));
+            expected += numbered<Char>(1) + Char{'\n'};
+        }
+        expect(
+            std::filesystem::file_size(log_filename),
+            equal_to(bom_size<Char>() + (expected.size() * sizeof(Char))));
+        expect(read_file<Char>(log_filename), equal_to(expected));
+    });
+
+    // Test that lines crossing chunk boundaries and lines larger than a chunk are kept intact
+    _.test("chunks", []() {
+        std::filesystem::remove(log_filename);
+        String expected;
+        std::uint64_t mappings = 0;
+        {
+            auto log = LoggerType::create();
+            auto sink = std::make_shared<SinkType>(
+                log_filename, MappedFileOptions{.chunk_size = 1});
+            log->add_sink(sink);
+            for (int i = 0; i < 1000; ++i) {
+                log->info(numbered<Char>(i));
+                expected += numbered<Char>(i) + Char{'\n'};
+            }
+            const String large(64 * 1024, Char{'x'});
+            log->info(large);
+            log->info(numbered<Char>(1000));
+            expected += large + Char{'\n'} + numbered<Char>(1000) + Char{'\n'};
+            mappings = sink->mappings();
+        }
+        expect(mappings, greater(2U));
+        expect(read_file<Char>(log_filename), equal_to(expected));
+    });
+
+    // Test that concurrent writers do not lose or mix lines
+    _.test("concurrent", []() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 2000;
+
+            std::filesystem::remove(log_filename);
+            {
+                auto log = LoggerType::create();
+                auto sink = std::make_shared<SinkType>(
+                    log_filename, MappedFileOptions{.chunk_size = 8192});
+                log->add_sink(sink);
+
+                std::latch start(NumThreads);
+                std::vector<std::thread> threads;
+                threads.reserve(NumThreads);
+                for (int i = 0; i < NumThreads; ++i) {
+                    threads.emplace_back([&log, &sink, &start, i]() {
+                        start.arrive_and_wait();
+                        for (int j = 0; j < Iterations; ++j) {
+                            log->info(numbered<Char>((i * Iterations) + j));
+                            if (j % 500 == 0) {
+                                sink->flush();
+                            }
+                        }
+                    });
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            std::vector<String> lines;
+            const auto output = read_file<Char>(log_filename);
+            std::size_t begin = 0;
+            for (auto end = output.find(Char{'\n'}); end != String::npos;
+                 end = output.find(Char{'\n'}, begin)) {
+                lines.push_back(output.substr(begin, end - begin));
+                begin = end + 1;
+            }
+            expect(begin, equal_to(output.size()));
+
+            std::vector<String> expected;
+            for (int i = 0; i < NumThreads * Iterations; ++i) {
+                expected.push_back(numbered<Char>(i));
+            }
+            std::ranges::sort(lines);
+            std::ranges::sort(expected);
+            expect(lines, equal_to(expected));
+        }
+    });
+});
+
+} // namespace
@@ -1,5 +1,6 @@
 #include "slimlog/format.h"
 #include "slimlog/logger.h"
+#include "slimlog/sinks/callback_sink.h"
 #include "slimlog/sinks/file_sink.h"
 #include "slimlog/sinks/null_sink.h"
 #include "slimlog/sinks/ostream_sink.h"
@@ -13,6 +14,7 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
 #include <latch>
@@ -166,6 +168,44 @@ const suite<SLIMLOG_CHAR_TYPES> Multithread("multithread", type_only, [](auto& _
         expect(total_operations.load(), equal_to(NumThreads * IterationsPerThread));
     });
 
+    // Test that replacing sinks waits for readers still using the old ones
+    _.test("sink_update_waits_for_readers", []() {
+        using namespace std::chrono_literals;
+
+        auto log = Logger<Char, MultiThreadedPolicy>::create();
+
+        std::atomic<bool> inside{false};
+        std::atomic<bool> release{false};
+        log->template add_sink<CallbackSink>(
+            [&](Level /*level*/, const Location& /*location*/, std::basic_string_view<Char> /*message*/) {
+                inside.store(true);
+                while (!release.load()) {
+                    std::this_thread::yield();
+                }
+            });
+
+        std::thread reader([&]() { log->info(from_utf8<Char>("Pinned message")); });
+        while (!inside.load()) {
+            std::this_thread::yield();
+        }
+
+        std::atomic<bool> added{false};
+        std::thread writer([&]() {
+            log->template add_sink<NullSink>();
+            added.store(true);
+        });
+
+        // The old sink list must outlive the reader holding it
+        std::this_thread::sleep_for(100ms);
+        const bool added_while_pinned = added.load();
+
+        release.store(true);
+        reader.join();
+        writer.join();
+        expect(added_while_pinned, equal_to(false));
+        expect(added.load(), equal_to(true));
+    });
+
     // Test concurrent level changes and message filtering
     _.test("concurrent_level_changes", []() {
         constexpr int NumThreads = 4;
@@ -2,6 +2,8 @@
 
 #include "slimlog/common.h"
 #include "slimlog/format.h"
+#include "slimlog/threading.h"
+#include "slimlog/util/os.h"
 
 // Test helpers
 #include "helpers/common.h"
@@ -12,11 +14,13 @@
 #include <chrono>
 #include <initializer_list>
 #include <latch>
+#include <memory>
 #include <random>
 #include <source_location>
 #include <string>
 #include <string_view>
 #include <thread>
+#include <utility>
 #include <vector>
 
 // IWYU pragma: no_include <functional>
@@ -47,7 +51,9 @@ auto create_test_record(
            CachedStringView<char>{location.file_name()},
            CachedStringView<char>{location.function_name()},
            location.line(),
-           level};
+           level,
+           {},
+           util::os::thread_id()};
     return record;
 }
 
@@ -231,6 +237,34 @@ const suite<SLIMLOG_CHAR_TYPES> PatternTests("pattern", type_only, [](auto& _) {
         expect(StringView(buffer.data(), buffer.size()), equal_to(expected));
     });
 
+    // Test that the timestamp is taken from the record unless overridden
+    _.test("record_time", []() {
+        const auto pattern_str = from_utf8<Char>("{time:%Y-%m-%d %H:%M:%S}.{nsec} {message}");
+        PatternType pattern(pattern_str);
+
+        BufferType buffer;
+        auto record = create_test_record<Char>();
+        record.time = time_mock();
+        pattern.format(buffer, record);
+
+        PatternFields<Char> fields;
+        fields.time = time_mock().first;
+        fields.nsec = time_mock().second;
+        fields.message = record.message;
+        expect(
+            StringView(buffer.data(), buffer.size()),
+            equal_to(pattern_format<Char>(pattern_str, fields)));
+
+        // Time function overrides the record timestamp
+        buffer.clear();
+        record.time = {};
+        pattern.set_time_func(time_mock);
+        pattern.format(buffer, record);
+        expect(
+            StringView(buffer.data(), buffer.size()),
+            equal_to(pattern_format<Char>(pattern_str, fields)));
+    });
+
     // Test time components
     _.test("time_components", []() {
         const auto pattern_str = from_utf8<Char>("{msec}ms {usec}us {nsec}ns");
@@ -417,6 +451,97 @@ const suite<SLIMLOG_CHAR_TYPES> PatternTests("pattern", type_only, [](auto& _) {
         expect(StringView(buffer.data(), buffer.size()), equal_to(pattern_str));
     });
 
+    // Test that the cached timestamp text is refreshed when the second changes
+    _.test("time_cache", []() {
+        const auto first_str = from_utf8<Char>("{time:%H:%M:%S}.{msec:03}.{usec:06} {message}");
+        const auto second_str = from_utf8<Char>("{time:%Y/%m/%d} {message}");
+        PatternType first(first_str);
+        PatternType second(second_str);
+
+        auto record = create_test_record<Char>();
+        const auto check = [&record]<typename ThreadingPolicy>(
+                               PatternType& pattern, StringView pattern_str) {
+            BufferType buffer;
+            pattern.template format<ThreadingPolicy>(buffer, record);
+
+            PatternFields<Char> fields;
+            fields.time = record.time.first;
+            fields.nsec = record.time.second;
+            fields.message = record.message;
+            expect(
+                StringView(buffer.data(), buffer.size()),
+                equal_to(pattern_format<Char>(pattern_str, fields)));
+        };
+
+        constexpr std::size_t Nsec = 1'234'567;
+        for (const auto seconds : {100, 100, 101, 100, 5000}) {
+            record.time = {std::chrono::sys_seconds{std::chrono::seconds{seconds}}, Nsec};
+            check.template operator()<SingleThreadedPolicy>(first, first_str);
+            check.template operator()<SingleThreadedPolicy>(second, second_str);
+            check.template operator()<MultiThreadedPolicy>(first, first_str);
+            check.template operator()<MultiThreadedPolicy>(second, second_str);
+        }
+
+        // Recompiled pattern must not reuse the text rendered with old specs
+        first.set_pattern(second_str);
+        check.template operator()<MultiThreadedPolicy>(first, second_str);
+        check.template operator()<SingleThreadedPolicy>(first, second_str);
+    });
+
+    // Test the same fields with and without format specs, and copies of the pattern
+    _.test("mixed_specs", []() {
+        const auto pattern_str = from_utf8<Char>(
+            "{{{level}|{level:>6}}} {line}|{line:>6} {thread}|{thread:x} {msec}|{msec:04}");
+        auto source = std::make_unique<PatternType>(pattern_str);
+        const PatternType pattern(*source);
+        source.reset();
+
+        BufferType buffer;
+        auto record = create_test_record<Char>();
+        record.time = time_mock();
+        PatternType(pattern).format(buffer, record);
+
+        PatternFields<Char> fields;
+        fields.level = from_utf8<Char>("INFO");
+        fields.line = record.line;
+        fields.thread_id = record.thread_id;
+        fields.nsec = time_mock().second;
+        expect(
+            StringView(buffer.data(), buffer.size()),
+            equal_to(pattern_format<Char>(pattern_str, fields)));
+    });
+
+    // Test that equal patterns are interned into a single object
+    _.test("intern", []() {
+        const auto pattern_str = from_utf8<Char>("[{level}] {category}: {message}");
+        const auto first = PatternType::intern(PatternType(pattern_str));
+        const auto second = PatternType::intern(PatternType(pattern_str));
+        expect(first.get(), equal_to(second.get()));
+        expect(first->id(), equal_to(second->id()));
+
+        // Copies keep the identifier, modifications change it
+        PatternType copy(*first);
+        expect(copy.id(), equal_to(first->id()));
+        copy.set_levels(std::make_pair(Level::Info, from_utf8<Char>("Information")));
+        expect(copy.id(), not_equal_to(first->id()));
+        expect(copy == *first, equal_to(false));
+
+        const auto third = PatternType::intern(copy);
+        expect(third.get(), not_equal_to(first.get()));
+
+        // Same contents compare equal regardless of the identifier
+        PatternType restored(pattern_str);
+        restored.set_levels(std::make_pair(Level::Info, from_utf8<Char>("Information")));
+        expect(restored.id(), not_equal_to(third->id()));
+        expect(restored == *third, equal_to(true));
+        expect(PatternType::intern(restored).get(), equal_to(third.get()));
+
+        PatternType timed(pattern_str);
+        timed.set_time_func(time_mock);
+        expect(timed == *first, equal_to(false));
+        expect(PatternType::intern(timed).get(), not_equal_to(first.get()));
+    });
+
     // Test concurrent formatting, ensure CachedFormatter thread-safety
     _.test("pattern_thread_safety", []() {
         constexpr int NumThreads = 8;
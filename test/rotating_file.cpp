@@ -0,0 +1,225 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/rotating_file_sink.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/file_capturer.h"
+
+#include <mettle.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <latch>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// IWYU pragma: no_include <utility>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> RotatingFile("rotating_file", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = RotatingFileSink<Char, ThreadingPolicy>;
+    using String = std::basic_string<Char>;
+
+    static auto log_filename = get_log_filename<Char>("rotating_file");
+    static const auto cleanup = []() {
+        std::filesystem::remove(log_filename);
+        std::filesystem::remove(log_filename + ".next");
+        std::filesystem::remove(log_filename + ".old");
+        for (int i = 1; i <= 100; ++i) {
+            std::filesystem::remove(log_filename + '.' + std::to_string(i));
+        }
+    };
+    // Size of "Message N\n"
+    static const auto line_size = 10 * sizeof(Char);
+
+    // Test that files are rotated by size and old backups are removed
+    _.test("rotate", []() {
+        cleanup();
+        {
+            auto log = LoggerType::create();
+            auto sink
+                = std::make_shared<SinkType>(log_filename, bom_size<Char>() + (3 * line_size), 2);
+            log->add_sink(sink);
+            expect(std::filesystem::exists(log_filename + ".next"), equal_to(true));
+
+            for (int i = 0; i < 10; ++i) {
+                log->info(numbered<Char>(i));
+            }
+            sink->flush();
+            expect(sink->rotations(), equal_to(3U));
+            expect(sink->backup_name(2), equal_to(log_filename + ".2"));
+        }
+
+        const auto lines = [](int first, int count) {
+            String result;
+            for (int i = first; i < first + count; ++i) {
+                result += numbered<Char>(i) + Char{'\n'};
+            }
+            return result;
+        };
+        expect(read_file<Char>(log_filename), equal_to(lines(9, 1)));
+        expect(read_file<Char>(log_filename + ".1"), equal_to(lines(6, 3)));
+        expect(read_file<Char>(log_filename + ".2"), equal_to(lines(3, 3)));
+        expect(std::filesystem::exists(log_filename + ".3"), equal_to(false));
+        // Prepared file is removed with the sink
+        expect(std::filesystem::exists(log_filename + ".next"), equal_to(false));
+    });
+
+    // Test rotation without backups and manual rotation
+    _.test("no_backups", []() {
+        cleanup();
+        auto log = LoggerType::create();
+        auto sink = std::make_shared<SinkType>(log_filename, 1024 * line_size, 0);
+        log->add_sink(sink);
+
+        log->info(numbered<Char>(1));
+        sink->rotate();
+        log->info(numbered<Char>(2));
+        sink->flush();
+        expect(read_file<Char>(log_filename), equal_to(numbered<Char>(2) + Char{'\n'}));
+        expect(std::filesystem::exists(log_filename + ".1"), equal_to(false));
+    });
+
+    // Test that an existing file exceeding the limit is rotated on construction
+    _.test("oversized", []() {
+        cleanup();
+        {
+            auto log = LoggerType::create();
+            log->template add_sink<RotatingFileSink>(log_filename, 1024 * line_size, 1);
+            log->info(numbered<Char>(1));
+        }
+
+        auto log = LoggerType::create();
+        auto sink = std::make_shared<SinkType>(log_filename, line_size, 1);
+        log->add_sink(sink);
+        expect(sink->rotations(), equal_to(1U));
+        expect(read_file<Char>(log_filename + ".1"), equal_to(numbered<Char>(1) + Char{'\n'}));
+        expect(read_file<Char>(log_filename), equal_to(String{}));
+    });
+
+    // Test that a failed rotation is retried by the next write
+    _.test("failed_rotation", []() {
+        cleanup();
+        const auto line = [](int index) { return numbered<Char>(index) + Char{'\n'}; };
+        {
+            auto log = LoggerType::create();
+            log->add_sink(std::make_shared<SinkType>(log_filename, bom_size<Char>() + line_size, 2));
+            log->info(numbered<Char>(0));
+        }
+
+        auto log = LoggerType::create();
+        auto sink = std::make_shared<SinkType>(log_filename, bom_size<Char>() + line_size, 2);
+        log->add_sink(sink);
+        // Missing prepared file makes the final rename fail after the backups were shifted
+        std::filesystem::remove(log_filename + ".next");
+        expect([&log]() { log->info(numbered<Char>(1)); }, thrown<std::system_error>());
+        expect(sink->rotations(), equal_to(0U));
+        sink->flush();
+        expect(read_file<Char>(log_filename), equal_to(line(1)));
+        expect(read_file<Char>(log_filename + ".1"), equal_to(line(0)));
+        expect(std::filesystem::exists(log_filename + ".2"), equal_to(false));
+
+        log->info(numbered<Char>(2));
+        expect(sink->rotations(), equal_to(1U));
+        sink->flush();
+        expect(read_file<Char>(log_filename), equal_to(String{}));
+        expect(read_file<Char>(log_filename + ".1"), equal_to(line(1) + line(2)));
+        expect(read_file<Char>(log_filename + ".2"), equal_to(line(0)));
+    });
+
+    // Test that the new file takes the place of an externally removed one
+    _.test("deleted", []() {
+        cleanup();
+        const auto line = [](int index) { return numbered<Char>(index) + Char{'\n'}; };
+        auto log = LoggerType::create();
+        auto sink = std::make_shared<SinkType>(log_filename, bom_size<Char>() + (2 * line_size), 2);
+        log->add_sink(sink);
+        log->info(numbered<Char>(1));
+        log->info(numbered<Char>(2));
+        expect(sink->rotations(), equal_to(1U));
+
+        std::filesystem::remove(log_filename);
+        log->info(numbered<Char>(3));
+        log->info(numbered<Char>(4));
+        expect(sink->rotations(), equal_to(2U));
+        log->info(numbered<Char>(5));
+        sink->flush();
+        expect(read_file<Char>(log_filename), equal_to(line(5)));
+        expect(read_file<Char>(log_filename + ".1"), equal_to(line(1) + line(2)));
+        expect(std::filesystem::exists(log_filename + ".2"), equal_to(false));
+    });
+
+    // Test that a zero size limit rotates the file on every write
+    _.test("zero_size", []() {
+        cleanup();
+        auto log = LoggerType::create();
+        auto sink = std::make_shared<SinkType>(log_filename, 0, 3);
+        log->add_sink(sink);
+        expect(sink->rotations(), equal_to(1U));
+
+        log->info(numbered<Char>(1));
+        log->info(numbered<Char>(2));
+        sink->flush();
+        expect(sink->rotations(), equal_to(3U));
+        expect(read_file<Char>(log_filename + ".1"), equal_to(numbered<Char>(2) + Char{'\n'}));
+        expect(read_file<Char>(log_filename + ".2"), equal_to(numbered<Char>(1) + Char{'\n'}));
+    });
+
+    // Test that lines are not lost when rotating concurrently
+    _.test("concurrent", []() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 250;
+            constexpr std::size_t MaxFiles = 100;
+
+            cleanup();
+            auto log = LoggerType::create();
+            auto sink = std::make_shared<SinkType>(log_filename, 64 * line_size, MaxFiles);
+            log->add_sink(sink);
+
+            std::latch start(NumThreads);
+            std::vector<std::thread> threads;
+            threads.reserve(NumThreads);
+            for (int i = 0; i < NumThreads; ++i) {
+                threads.emplace_back([&log, &start, i]() {
+                    start.arrive_and_wait();
+                    for (int j = 0; j < Iterations; ++j) {
+                        log->info(numbered<Char>((i * Iterations) + j));
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            sink->flush();
+            expect(sink->rotations(), greater(0U));
+            expect(sink->rotations(), less_equal(MaxFiles));
+
+            auto output = read_file<Char>(log_filename);
+            for (std::size_t i = 1; i <= sink->rotations(); ++i) {
+                output += read_file<Char>(sink->backup_name(i));
+            }
+            const auto line_count = std::ranges::count(output, Char{'\n'});
+            expect(line_count, equal_to(NumThreads * Iterations));
+            cleanup();
+        }
+    });
+});
+
+} // namespace
@@ -0,0 +1,301 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/seek_index.h"
+#include "slimlog/sinks/buffered_file_sink.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/file_capturer.h"
+
+#include <mettle.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <latch>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+using namespace std::chrono_literals;
+
+constexpr std::chrono::sys_seconds BaseTime{1700000000s};
+
+// Number of a message created by numbered()
+template<typename Char>
+auto number_of(const std::basic_string<Char>& message) -> int
+{
+    int number = 0;
+    for (const auto chr : message.substr(8)) {
+        number = (number * 10) + static_cast<int>(chr - Char{'0'});
+    }
+    return number;
+}
+
+// Lines of a part of the log file
+template<typename Char>
+auto lines_of(std::string_view bytes) -> std::vector<std::basic_string<Char>>
+{
+    std::basic_string<Char> text(bytes.size() / sizeof(Char), Char{});
+    std::memcpy(text.data(), bytes.data(), text.size() * sizeof(Char));
+    std::vector<std::basic_string<Char>> lines;
+    std::size_t begin = 0;
+    for (auto end = text.find(Char{'\n'}); end != std::basic_string<Char>::npos;
+         end = text.find(Char{'\n'}, begin)) {
+        lines.push_back(text.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    expect(begin, equal_to(text.size()));
+    return lines;
+}
+
+// Lines of the found ranges of the log file
+template<typename Char>
+auto found_lines(const std::string& data, const std::vector<SeekIndex::Range>& ranges)
+    -> std::vector<std::basic_string<Char>>
+{
+    std::vector<std::basic_string<Char>> lines;
+    for (const auto& range : ranges) {
+        const auto range_lines = lines_of<Char>(std::string_view(data).substr(
+            static_cast<std::size_t>(range.offset), static_cast<std::size_t>(range.size)));
+        lines.insert(lines.end(), range_lines.begin(), range_lines.end());
+    }
+    return lines;
+}
+
+std::pair<std::chrono::sys_seconds, std::size_t> fake_time; // NOLINT(*-non-const-global-*)
+
+auto get_fake_time() -> std::pair<std::chrono::sys_seconds, std::size_t>
+{
+    return fake_time;
+}
+
+auto seconds(int number) -> SeekIndex::Time
+{
+    return BaseTime + std::chrono::seconds(number);
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> SeekIndexSuite("seek_index", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = BufferedFileSink<Char, ThreadingPolicy>;
+    using String = std::basic_string<Char>;
+
+    static auto log_filename = get_log_filename<Char>("seek_index");
+    static const std::size_t bom_size = sizeof(Char) > 1 ? sizeof(Char) : 0;
+
+    const auto remove_files = []() {
+        std::filesystem::remove(log_filename);
+        std::filesystem::remove(SeekIndex::path(log_filename));
+    };
+
+    // One record per second, the 500th one is an error
+    const auto write_records = [remove_files]() {
+        remove_files();
+        auto log = LoggerType::create();
+        log->set_time_func(get_fake_time);
+        auto sink = std::make_shared<SinkType>(
+            log_filename, BufferedFileOptions{.capacity = 4096, .flush_interval = 0ms});
+        sink->enable_index(4096);
+        log->add_sink(sink);
+        for (int i = 0; i < 5000; ++i) {
+            fake_time = {BaseTime + std::chrono::seconds(i), 0};
+            log->message(i == 500 ? Level::Error : Level::Info, numbered<Char>(i));
+        }
+    };
+
+    // Test that blocks cover the file and describe their records
+    _.test("blocks", [write_records]() {
+        write_records();
+
+        const auto data = read_bytes(log_filename);
+        const SeekIndex index(log_filename);
+        expect(index.char_size(), equal_to(sizeof(Char)));
+        expect(index.log_size(), equal_to(data.size()));
+        expect(index.entries().size(), greater(4U));
+
+        std::uint64_t offset = bom_size;
+        int number = 0;
+        for (const auto& entry : index.entries()) {
+            expect(entry.offset, equal_to(offset));
+            offset += entry.size;
+            const auto lines = lines_of<Char>(std::string_view(data).substr(
+                static_cast<std::size_t>(entry.offset), entry.size));
+            expect(lines.front(), equal_to(numbered<Char>(number)));
+            expect(entry.min_time, equal_to(seconds(number).time_since_epoch().count()));
+            const auto last = number + static_cast<int>(lines.size()) - 1;
+            expect(entry.max_time, equal_to(seconds(last).time_since_epoch().count()));
+            const auto error = number <= 500 && last >= 500;
+            expect(entry.levels, equal_to(error ? 0b1010U : 0b1000U));
+            number = last + 1;
+        }
+        expect(offset, equal_to(data.size()));
+        expect(number, equal_to(5000));
+    });
+
+    // Test that only the blocks of the time window and level are found
+    _.test("find", [write_records]() {
+        write_records();
+
+        const auto data = read_bytes(log_filename);
+        const SeekIndex index(log_filename);
+        const auto window = index.find(seconds(300), seconds(310));
+        expect(window.size(), equal_to(1U));
+        expect(window.front().size, less(data.size() / 4));
+        const auto lines = found_lines<Char>(data, window);
+        for (int i = 300; i <= 310; ++i) {
+            expect(std::ranges::count(lines, numbered<Char>(i)), equal_to(1));
+        }
+
+        const auto errors
+            = index.find(SeekIndex::Time::min(), SeekIndex::Time::max(), Level::Error);
+        expect(errors.size(), equal_to(1U));
+        const auto error_lines = found_lines<Char>(data, errors);
+        expect(std::ranges::count(error_lines, numbered<Char>(500)), equal_to(1));
+        expect(
+            index.find(SeekIndex::Time::min(), SeekIndex::Time::max(), Level::Fatal),
+            equal_to(std::vector<SeekIndex::Range>{}));
+        expect(
+            index.find(seconds(6000), seconds(7000)), equal_to(std::vector<SeekIndex::Range>{}));
+
+        // Everything matches, the ranges are merged
+        expect(
+            index.find(SeekIndex::Time::min(), SeekIndex::Time::max()),
+            equal_to(std::vector<SeekIndex::Range>{{bom_size, data.size() - bom_size}}));
+    });
+
+    // Test that data not covered by the index is always found
+    _.test("unindexed", [remove_files]() {
+        remove_files();
+        auto log = LoggerType::create();
+        log->set_time_func(get_fake_time);
+        // The second run writes no index, each run is one block
+        for (int run = 0; run < 3; ++run) {
+            auto sink = std::make_shared<SinkType>(
+                log_filename, BufferedFileOptions{.capacity = 4096, .flush_interval = 0ms});
+            if (run != 1) {
+                sink->enable_index(1);
+            }
+            log->add_sink(sink);
+            for (int i = 0; i < 10; ++i) {
+                fake_time = {BaseTime + std::chrono::seconds((run * 10) + i), 0};
+                log->info(numbered<Char>((run * 10) + i));
+            }
+            log->remove_sink(sink);
+        }
+
+        // Records of a block that is not complete yet
+        auto sink = std::make_shared<SinkType>(
+            log_filename, BufferedFileOptions{.capacity = 4096, .flush_interval = 0ms});
+        sink->enable_index();
+        log->add_sink(sink);
+        fake_time = {BaseTime + 100s, 0};
+        log->info(numbered<Char>(100));
+        sink->flush();
+
+        const auto data = read_bytes(log_filename);
+        const SeekIndex index(log_filename);
+        expect(index.entries().size(), equal_to(2U));
+        std::vector<String> expected;
+        for (int i = 0; i < 20; ++i) {
+            expected.push_back(numbered<Char>(i));
+        }
+        expected.push_back(numbered<Char>(100));
+        expect(found_lines<Char>(data, index.find(seconds(5), seconds(5))), equal_to(expected));
+        expected.erase(expected.begin(), expected.begin() + 10);
+        for (int i = 20; i < 30; ++i) {
+            expected.insert(expected.end() - 1, numbered<Char>(i));
+        }
+        expect(found_lines<Char>(data, index.find(seconds(25), seconds(25))), equal_to(expected));
+    });
+
+    // Test that the index cannot be enabled once records were logged
+    _.test("late_enable", [remove_files]() {
+        remove_files();
+        auto log = LoggerType::create();
+        auto sink = std::make_shared<SinkType>(
+            log_filename, BufferedFileOptions{.capacity = 4096, .flush_interval = 0ms});
+        log->add_sink(sink);
+        log->info(numbered<Char>(1));
+        expect([&sink]() { sink->enable_index(); }, thrown<std::logic_error>());
+        sink->flush();
+        expect([&sink]() { sink->enable_index(); }, thrown<std::logic_error>());
+        expect(std::filesystem::exists(SeekIndex::path(log_filename)), equal_to(false));
+    });
+
+    // Test that concurrent writers account their records to the right blocks
+    _.test("concurrent", [remove_files]() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 2000;
+            static constexpr std::array<Level, 4> Levels{
+                Level::Fatal, Level::Error, Level::Warning, Level::Info};
+
+            remove_files();
+            {
+                auto log = LoggerType::create();
+                auto sink = std::make_shared<SinkType>(
+                    log_filename, BufferedFileOptions{.capacity = 4096, .flush_interval = 0ms});
+                sink->enable_index(1);
+                log->add_sink(sink);
+
+                std::latch start(NumThreads);
+                std::vector<std::thread> threads;
+                threads.reserve(NumThreads);
+                for (int i = 0; i < NumThreads; ++i) {
+                    threads.emplace_back([&log, &start, i]() {
+                        start.arrive_and_wait();
+                        for (int j = 0; j < Iterations; ++j) {
+                            // The level is derived from the message number
+                            const auto number = (i * Iterations) + j;
+                            log->message(
+                                Levels.at(number % Levels.size()), numbered<Char>(number));
+                        }
+                    });
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            const auto data = read_bytes(log_filename);
+            const SeekIndex index(log_filename);
+            std::size_t count = 0;
+            std::uint64_t offset = bom_size;
+            for (const auto& entry : index.entries()) {
+                expect(entry.offset, equal_to(offset));
+                offset += entry.size;
+                std::uint32_t levels = 0;
+                for (const auto& line : lines_of<Char>(std::string_view(data).substr(
+                         static_cast<std::size_t>(entry.offset), entry.size))) {
+                    const auto number = number_of(line);
+                    levels |= 1U << static_cast<unsigned>(Levels.at(number % Levels.size()));
+                    ++count;
+                }
+                expect(entry.levels, equal_to(levels));
+            }
+            expect(offset, equal_to(data.size()));
+            expect(count, equal_to(std::size_t{NumThreads} * Iterations));
+        }
+    });
+});
+
+} // namespace
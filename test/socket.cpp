@@ -0,0 +1,247 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/socket_sink.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/socket_receiver.h"
+
+#include <mettle.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+// Records of the stream with the newline framing
+auto expected_lines(int first, int last) -> std::string
+{
+    std::string result;
+    for (int i = first; i < last; ++i) {
+        result += "Message " + std::to_string(i) + '\n';
+    }
+    return result;
+}
+
+// Records of the stream with the length prefix framing
+auto parse_frames(std::string_view data) -> std::vector<std::string>
+{
+    std::vector<std::string> frames;
+    while (data.size() >= 4) {
+        std::uint32_t length = 0;
+        for (std::size_t i = 0; i < 4; ++i) {
+            length = (length << 8U) | static_cast<unsigned char>(data[i]);
+        }
+        frames.emplace_back(data.substr(4, length));
+        data.remove_prefix(std::min<std::size_t>(data.size(), 4 + length));
+    }
+    return frames;
+}
+
+// Waits until the condition holds or a few seconds passed
+template<typename Condition>
+auto wait_until(Condition condition) -> bool
+{
+    for (int i = 0; i < 500 && !condition(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    return condition();
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> Socket("socket", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = SocketSink<Char, ThreadingPolicy>;
+
+    static const auto socket_path = get_log_filename<Char>("socket") + ".sock";
+
+    // Only batches and flushes send the records
+    const auto options = []() {
+        SocketOptions options;
+        options.flush_interval = std::chrono::seconds{10};
+        options.min_backoff = std::chrono::milliseconds{10};
+        options.max_backoff = std::chrono::milliseconds{20};
+        options.shutdown_timeout = std::chrono::milliseconds{100};
+        return options;
+    };
+
+    // Test that records are sent in one write per flush over TCP
+    _.test("newline", [options]() {
+        StreamListener listener;
+        auto log = LoggerType::create();
+        auto sink = std::make_shared<SinkType>(listener.address(), options());
+        log->add_sink(sink);
+
+        for (int i = 0; i < 100; ++i) {
+            log->info(numbered<Char>(i));
+        }
+        sink->flush();
+        const auto expected = expected_lines(0, 100);
+        expect(sink->stats().syscalls, equal_to(1U));
+        expect(sink->stats().bytes, equal_to(expected.size()));
+        expect(sink->stats().connects, equal_to(1U));
+
+        listener.accept();
+        expect(listener.receive(expected.size()), equal_to(expected));
+        expect(sink->stats().dropped, equal_to(0U));
+    });
+
+    // Test that records spanning lines keep their boundaries with the length prefix
+    _.test("length_prefix", [options]() {
+        StreamListener listener(socket_path);
+        auto log = LoggerType::create();
+        auto custom_options = options();
+        custom_options.framing = SocketFraming::LengthPrefix;
+        auto sink = std::make_shared<SinkType>(listener.address(), custom_options);
+        log->add_sink(sink);
+
+        const std::vector<std::string> records{"First\nSecond", "", "caf\xC3\xA9 \xF0\x9F\x98\x80"};
+        std::size_t size = 0;
+        for (const auto& record : records) {
+            log->info(from_utf8<Char>(record));
+            size += 4 + record.size();
+        }
+        sink->flush();
+        listener.accept();
+        expect(parse_frames(listener.receive(size)), equal_to(records));
+    });
+
+    // Test that a full batch is sent without a flush
+    _.test("batch", [options]() {
+        StreamListener listener;
+        auto log = LoggerType::create();
+        auto custom_options = options();
+        custom_options.batch_size = 1024;
+        auto sink = std::make_shared<SinkType>(listener.address(), custom_options);
+        log->add_sink(sink);
+
+        const auto expected = expected_lines(0, 200);
+        for (int i = 0; i < 200; ++i) {
+            log->info(numbered<Char>(i));
+        }
+        listener.accept();
+        const auto received = listener.receive(1024);
+        expect(received.size() >= 1024, equal_to(true));
+        expect(expected.starts_with(received), equal_to(true));
+        expect(sink->stats().syscalls < 200, equal_to(true));
+    });
+
+    // Test that records wait while the collector is down and are sent after it starts
+    _.test("reconnect", [options]() {
+        auto log = LoggerType::create();
+        auto sink = std::make_shared<SinkType>("unix:" + socket_path, options());
+        log->add_sink(sink);
+
+        for (int i = 0; i < 10; ++i) {
+            log->info(numbered<Char>(i));
+        }
+        sink->flush();
+        expect(sink->stats().connects, equal_to(0U));
+
+        StreamListener listener(socket_path);
+        expect(wait_until([&sink]() { return sink->stats().connects == 1; }), equal_to(true));
+        sink->flush();
+        listener.accept();
+        auto expected = expected_lines(0, 10);
+        expect(listener.receive(expected.size()), equal_to(expected));
+
+        // Records after the collector closed the connection are sent over a new one
+        listener.disconnect();
+        log->info(numbered<Char>(10));
+        sink->flush();
+        expect(sink->stats().connects, equal_to(2U));
+        listener.accept();
+        expected = expected_lines(10, 11);
+        expect(listener.receive(expected.size()), equal_to(expected));
+        expect(sink->stats().dropped, equal_to(0U));
+    });
+
+    // Test that a collector which does not read makes records drop instead of blocking
+    _.test("stalled", [options]() {
+        constexpr int Count = 50000;
+        StreamListener listener(socket_path);
+        auto log = LoggerType::create();
+        auto custom_options = options();
+        custom_options.batch_size = std::size_t{16} * 1024;
+        custom_options.spill_size = std::size_t{64} * 1024;
+        custom_options.flush_interval = std::chrono::milliseconds{10};
+        auto sink = std::make_shared<SinkType>(listener.address(), custom_options);
+        log->add_sink(sink);
+
+        for (int i = 0; i < Count; ++i) {
+            log->info(numbered<Char>(i));
+        }
+        sink->flush();
+        const auto dropped = sink->stats().dropped;
+        expect(dropped > 0, equal_to(true));
+
+        // Waiting records are sent once the collector reads, in order and whole
+        listener.accept();
+        const auto received = listener.receive(std::string::npos, 500);
+        expect(std::ranges::count(received, '\n') + dropped, equal_to(std::uint64_t{Count}));
+        expect(received.ends_with('\n'), equal_to(true));
+        expect(expected_lines(0, Count).starts_with(received.substr(0, 4096)), equal_to(true));
+        expect(sink->stats().dropped, equal_to(dropped));
+    });
+
+    // Test that concurrent records arrive whole
+    _.test("concurrent", [options]() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 500;
+            StreamListener listener;
+            auto log = LoggerType::create();
+            auto custom_options = options();
+            custom_options.batch_size = 4096;
+            auto sink = std::make_shared<SinkType>(listener.address(), custom_options);
+            log->add_sink(sink);
+
+            std::latch start(NumThreads);
+            std::vector<std::thread> threads;
+            threads.reserve(NumThreads);
+            for (int i = 0; i < NumThreads; ++i) {
+                threads.emplace_back([&log, &start, i]() {
+                    start.arrive_and_wait();
+                    for (int j = 0; j < Iterations; ++j) {
+                        log->info(numbered<Char>((i * Iterations) + j));
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            sink->flush();
+
+            listener.accept();
+            const auto size = expected_lines(0, NumThreads * Iterations).size();
+            const auto received = listener.receive(size);
+            expect(received.size(), equal_to(size));
+            std::vector<int> counts(NumThreads * Iterations);
+            for (std::size_t pos = 0; pos < received.size();) {
+                const auto end = received.find('\n', pos);
+                ++counts.at(std::stoul(received.substr(pos + 8, end - pos - 8)));
+                pos = end + 1;
+            }
+            expect(std::ranges::count(counts, 1), equal_to(NumThreads * Iterations));
+        }
+    });
+});
+
+} // namespace
@@ -0,0 +1,262 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/syslog_sink.h"
+#include "slimlog/util/os.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/socket_receiver.h"
+
+#include <mettle.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <latch>
+#include <memory>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// IWYU pragma: no_include <functional>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+using namespace std::chrono_literals;
+
+std::pair<std::chrono::sys_seconds, std::size_t> fake_time; // NOLINT(*-non-const-global-*)
+
+// Sets the local time zone for the lifetime of the object
+class ScopedTimeZone {
+public:
+    explicit ScopedTimeZone(const char* zone)
+    {
+        if (const char* previous = std::getenv("TZ")) { // NOLINT(concurrency-mt-unsafe)
+            m_previous = previous;
+        }
+        ::setenv("TZ", zone, 1); // NOLINT(concurrency-mt-unsafe)
+        ::tzset();
+    }
+
+    ScopedTimeZone(const ScopedTimeZone&) = delete;
+    ScopedTimeZone(ScopedTimeZone&&) = delete;
+    auto operator=(const ScopedTimeZone&) -> ScopedTimeZone& = delete;
+    auto operator=(ScopedTimeZone&&) -> ScopedTimeZone& = delete;
+
+    ~ScopedTimeZone()
+    {
+        if (m_previous) {
+            ::setenv("TZ", m_previous->c_str(), 1); // NOLINT(concurrency-mt-unsafe)
+        } else {
+            ::unsetenv("TZ"); // NOLINT(concurrency-mt-unsafe)
+        }
+        ::tzset();
+    }
+
+private:
+    std::optional<std::string> m_previous;
+};
+
+auto get_fake_time() -> std::pair<std::chrono::sys_seconds, std::size_t>
+{
+    return fake_time;
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> Syslog("syslog", type_only, [](auto& _) {
+    using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+    using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+    using LoggerType = Logger<Char, ThreadingPolicy>;
+    using SinkType = SyslogSink<Char, ThreadingPolicy>;
+
+    static const auto socket_path = get_log_filename<Char>("syslog") + ".sock";
+    static const auto header = " test-host my_app " + std::to_string(util::os::process_id())
+        + " - - ";
+
+    const auto options = []() {
+        SyslogOptions options;
+        options.path = socket_path;
+        options.hostname = "test-host";
+        options.app_name = "my app";
+        return options;
+    };
+
+    // Test that the header fields and the priority of each level are sent
+    _.test("format", [options]() {
+        const ScopedTimeZone time_zone("UTC");
+        DatagramReceiver receiver(socket_path);
+        auto log = LoggerType::create(Level::Trace);
+        log->set_time_func(get_fake_time);
+        auto sink = std::make_shared<SinkType>(options());
+        log->add_sink(sink);
+
+        fake_time = {std::chrono::sys_seconds{1700000000s}, 123456789};
+        log->info(numbered<Char>(0));
+        expect(
+            receiver.receive(),
+            equal_to("<14>1 2023-11-14T22:13:20.123456+00:00" + header + "Message 0"));
+
+        fake_time = {std::chrono::sys_seconds{1700000001s}, 5000};
+        log->info(numbered<Char>(1));
+        expect(
+            receiver.receive(),
+            equal_to("<14>1 2023-11-14T22:13:21.000005+00:00" + header + "Message 1"));
+
+        const std::vector<std::pair<Level, std::string>> priorities{
+            {Level::Fatal, "<10>"},
+            {Level::Error, "<11>"},
+            {Level::Warning, "<12>"},
+            {Level::Debug, "<15>"},
+            {Level::Trace, "<15>"},
+        };
+        for (const auto& [level, priority] : priorities) {
+            log->message(level, numbered<Char>(2));
+            expect(
+                receiver.receive(),
+                equal_to(priority + "1 2023-11-14T22:13:21.000005+00:00" + header + "Message 2"));
+        }
+
+        // Facility of local use 0, messages in UTF-8
+        auto local_options = options();
+        local_options.facility = 16;
+        local_options.hostname = "h\xC3\xA9 st";
+        log->remove_sink(sink);
+        log->add_sink(std::make_shared<SinkType>(local_options));
+        log->warning(from_utf8<Char>("Caf\xC3\xA9 \xF0\x9F\x98\x80"));
+        const auto local_header = " h___st my_app " + std::to_string(util::os::process_id())
+            + " - - ";
+        expect(
+            receiver.receive(),
+            equal_to(
+                "<132>1 2023-11-14T22:13:21.000005+00:00" + local_header
+                + "Caf\xC3\xA9 \xF0\x9F\x98\x80"));
+        expect(sink->stats().syscalls, equal_to(7U));
+    });
+
+    // Test that the timestamp carries the offset of the local time zone
+    _.test("time_zone", [options]() {
+        DatagramReceiver receiver(socket_path);
+        auto log = LoggerType::create();
+        log->set_time_func(get_fake_time);
+        log->add_sink(std::make_shared<SinkType>(options()));
+
+        // Record time is the local time
+        {
+            const ScopedTimeZone time_zone("XYZ-5:30");
+            fake_time = {std::chrono::sys_seconds{1700000000s}, 0};
+            log->info(numbered<Char>(0));
+            expect(
+                receiver.receive(),
+                equal_to("<14>1 2023-11-14T22:13:20.000000+05:30" + header + "Message 0"));
+        }
+        {
+            const ScopedTimeZone time_zone("XYZ3");
+            fake_time = {std::chrono::sys_seconds{1700000100s}, 0};
+            log->info(numbered<Char>(1));
+            expect(
+                receiver.receive(),
+                equal_to("<14>1 2023-11-14T22:15:00.000000-03:00" + header + "Message 1"));
+        }
+    });
+
+    // Test that a missing socket is reported
+    _.test("missing", [options]() {
+        { const DatagramReceiver receiver(socket_path); }
+        expect([options]() { SinkType sink(options()); }, thrown<std::system_error>());
+    });
+
+    // Test that records are dropped instead of blocking on a full socket buffer
+    _.test("nonblocking", [options]() {
+        constexpr int Iterations = 5000;
+        DatagramReceiver receiver(socket_path);
+        auto log = LoggerType::create();
+        auto nonblocking_options = options();
+        nonblocking_options.nonblocking = true;
+        auto sink = std::make_shared<SinkType>(nonblocking_options);
+        log->add_sink(sink);
+        for (int i = 0; i < Iterations; ++i) {
+            log->info(numbered<Char>(i));
+        }
+
+        const auto stats = sink->stats();
+        expect(stats.dropped, greater(0U));
+        expect(stats.syscalls + stats.dropped, equal_to(std::uint64_t{Iterations}));
+        std::uint64_t received = 0;
+        while (receiver.try_receive()) {
+            ++received;
+        }
+        expect(received, equal_to(stats.syscalls));
+    });
+
+    // Test that the socket is connected again after the daemon restarts
+    _.test("reconnect", [options]() {
+        auto log = LoggerType::create();
+        std::shared_ptr<SinkType> sink;
+        {
+            DatagramReceiver receiver(socket_path);
+            sink = std::make_shared<SinkType>(options());
+            log->add_sink(sink);
+            log->info(numbered<Char>(0));
+            expect(receiver.receive().ends_with("Message 0"), equal_to(true));
+        }
+
+        DatagramReceiver receiver(socket_path);
+        log->info(numbered<Char>(1));
+        expect(receiver.receive().ends_with("Message 1"), equal_to(true));
+        expect(sink->stats().syscalls, equal_to(2U));
+    });
+
+    // Test that concurrent records arrive as whole datagrams
+    _.test("concurrent", [options]() {
+        if constexpr (std::is_same_v<ThreadingPolicy, MultiThreadedPolicy>) {
+            constexpr int NumThreads = 8;
+            constexpr int Iterations = 500;
+            DatagramReceiver receiver(socket_path);
+            auto log = LoggerType::create();
+            auto sink = std::make_shared<SinkType>(options());
+            log->add_sink(sink);
+
+            std::vector<std::string> datagrams;
+            std::thread reader([&receiver, &datagrams]() {
+                for (int i = 0; i < NumThreads * Iterations; ++i) {
+                    datagrams.push_back(receiver.receive());
+                }
+            });
+            std::latch start(NumThreads);
+            std::vector<std::thread> threads;
+            threads.reserve(NumThreads);
+            for (int i = 0; i < NumThreads; ++i) {
+                threads.emplace_back([&log, &start, i]() {
+                    start.arrive_and_wait();
+                    for (int j = 0; j < Iterations; ++j) {
+                        log->info(numbered<Char>((i * Iterations) + j));
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            reader.join();
+
+            std::vector<int> counts(NumThreads * Iterations);
+            for (const auto& datagram : datagrams) {
+                const auto pos = datagram.find(header + "Message ");
+                expect(pos, not_equal_to(std::string::npos));
+                ++counts.at(std::stoul(datagram.substr(pos + header.size() + 8)));
+            }
+            expect(std::ranges::count(counts, 1), equal_to(NumThreads * Iterations));
+        }
+    });
+});
+
+} // namespace
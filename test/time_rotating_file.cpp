@@ -0,0 +1,181 @@
+#include "slimlog/format.h"
+#include "slimlog/logger.h"
+#include "slimlog/sinks/time_rotating_file_sink.h"
+#include "slimlog/util/os.h"
+
+// Test helpers
+#include "helpers/common.h"
+#include "helpers/file_capturer.h"
+
+#include <mettle.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+// IWYU pragma: no_include <functional>
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+using namespace mettle;
+using namespace slimlog;
+
+// Time returned by the logger time function
+std::chrono::sys_seconds fake_time; // NOLINT(*-avoid-non-const-global-variables)
+
+auto get_fake_time() -> std::pair<std::chrono::sys_seconds, std::size_t>
+{
+    return {fake_time, 0};
+}
+
+// Builds "app.YYYYMMDD-HH.log"
+auto hour_filename(std::chrono::sys_seconds time) -> std::string
+{
+    const auto days = std::chrono::floor<std::chrono::days>(time);
+    const std::chrono::year_month_day date{days};
+    const auto hours = std::chrono::floor<std::chrono::hours>(time - days).count();
+    std::array<char, 32> buffer{};
+    std::ignore = std::snprintf(
+        buffer.data(),
+        buffer.size(),
+        "app.%04d%02u%02u-%02d.log",
+        static_cast<int>(date.year()),
+        static_cast<unsigned>(date.month()),
+        static_cast<unsigned>(date.day()),
+        static_cast<int>(hours));
+    return buffer.data();
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+const suite<SLIMLOG_CHAR_THREADING_TYPES> TimeRotatingFile(
+    "time_rotating_file", type_only, [](auto& _) {
+        using Char = typename mettle::fixture_type_t<decltype(_)>::Char;
+        using ThreadingPolicy = typename mettle::fixture_type_t<decltype(_)>::ThreadingPolicy;
+        using LoggerType = Logger<Char, ThreadingPolicy>;
+        using SinkType = TimeRotatingFileSink<Char, ThreadingPolicy>;
+        using namespace std::chrono_literals;
+        namespace fs = std::filesystem;
+
+        static const fs::path directory = get_log_filename<Char>("time_rotating_file") + ".d";
+        static const auto pattern = (directory / "app.{time:%Y%m%d-%H}.log").string();
+        static const auto message = [](std::string_view text) { return from_utf8<Char>(text); };
+
+        // Test that files are split on hour boundaries taken from the record time
+        _.test("split", []() {
+            fs::remove_all(directory);
+            fs::create_directories(directory);
+
+            // Start a day ahead, so that the first record does not belong to the initial file
+            const auto hour = std::chrono::floor<std::chrono::hours>(util::os::local_time().first)
+                + 24h;
+            fake_time = hour + 15min;
+
+            auto log = LoggerType::create();
+            log->set_time_func(get_fake_time);
+            auto sink = std::make_shared<SinkType>(pattern, 1h, FileRetention{});
+            log->add_sink(sink);
+            const auto initial = sink->filename();
+
+            log->info(message("first"));
+            const auto first = sink->filename();
+            expect(first, not_equal_to(initial));
+
+            fake_time = hour + 59min + 59s;
+            log->info(message("second"));
+            expect(sink->filename(), equal_to(first));
+
+            fake_time = hour + 1h;
+            log->info(message("third"));
+            const auto second = sink->filename();
+            expect(second, not_equal_to(first));
+
+            // Records from the past go to the current file
+            fake_time = hour;
+            log->info(message("fourth"));
+            expect(sink->filename(), equal_to(second));
+            sink->flush();
+
+            expect(read_file<Char>(first), equal_to(message("first\nsecond\n")));
+            expect(read_file<Char>(second), equal_to(message("third\nfourth\n")));
+            expect(fs::path(second).filename().string(), equal_to(hour_filename(hour + 1h)));
+        });
+
+        // Test that old files are removed by age and total size in the background
+        _.test("retention", []() {
+            fs::remove_all(directory);
+            fs::create_directories(directory);
+
+            const auto now = fs::file_time_type::clock::now();
+            const auto create = [&now](std::string_view name, auto age) {
+                std::ofstream(directory / name) << std::string(100, 'x');
+                fs::last_write_time(directory / name, now - age);
+            };
+            create("app.20000101-01.log", 48h);
+            create("app.20000101-02.log", 30min);
+            create("app.20000101-03.log", 20min);
+            create("app.20000101-04.log", 10min);
+            create("other.log", 48h);
+
+            {
+                auto sink = std::make_shared<SinkType>(pattern, 1h, FileRetention{24h, 250});
+                sink->wait_retention();
+                // The expired file and the oldest files exceeding the size are removed
+                expect(fs::exists(directory / "app.20000101-01.log"), equal_to(false));
+                expect(fs::exists(directory / "app.20000101-02.log"), equal_to(false));
+                expect(fs::exists(directory / "app.20000101-03.log"), equal_to(true));
+                expect(fs::exists(directory / "app.20000101-04.log"), equal_to(true));
+                expect(fs::exists(directory / "other.log"), equal_to(true));
+                expect(fs::exists(sink->filename()), equal_to(true));
+            }
+            fs::remove_all(directory);
+        });
+
+        // Test that retention keeps files whose names do not match the whole pattern
+        _.test("retention_unrelated_files", []() {
+            fs::remove_all(directory);
+            fs::create_directories(directory);
+
+            const auto now = fs::file_time_type::clock::now();
+            const auto create = [&now](std::string_view name) {
+                std::ofstream(directory / name) << std::string(100, 'x');
+                fs::last_write_time(directory / name, now - 48h);
+            };
+            create("2000-01-01.log");
+            create("other.log");
+            create("2000-01-01.log.bak");
+            create("app.2000-01-01.log");
+
+            {
+                const auto day_pattern = (directory / "{time:%Y-%m-%d}.log").string();
+                auto sink = std::make_shared<SinkType>(day_pattern, 24h, FileRetention{24h, 0});
+                sink->wait_retention();
+                expect(fs::exists(directory / "2000-01-01.log"), equal_to(false));
+                expect(fs::exists(directory / "other.log"), equal_to(true));
+                expect(fs::exists(directory / "2000-01-01.log.bak"), equal_to(true));
+                expect(fs::exists(directory / "app.2000-01-01.log"), equal_to(true));
+                expect(fs::exists(sink->filename()), equal_to(true));
+            }
+
+            create("app.other.log");
+            create("app.20000101-01.log");
+            {
+                auto sink = std::make_shared<SinkType>(pattern, 1h, FileRetention{24h, 0});
+                sink->wait_retention();
+                expect(fs::exists(directory / "app.20000101-01.log"), equal_to(false));
+                expect(fs::exists(directory / "app.other.log"), equal_to(true));
+                expect(fs::exists(directory / "app.2000-01-01.log"), equal_to(true));
+            }
+            fs::remove_all(directory);
+        });
+    });
+
+} // namespace
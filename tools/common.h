@@ -0,0 +1,176 @@
+/**
+ * @file common.h
+ * @brief Helpers shared by the command-line tools.
+ */
+
+#pragma once
+
+#include "slimlog/common.h"
+#include "slimlog/format.h"
+#include "slimlog/pattern.h"
+#include "slimlog/record.h"
+#include "slimlog/util/unicode.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace slimlog::tools {
+
+/** @brief Pattern used if none is given. */
+inline constexpr std::string_view DefaultPattern
+    = "{time}.{usec:06} [{level}] <{thread}> {category}: {message} ({file}:{line})";
+
+/**
+ * @brief Command-line options.
+ */
+struct Options {
+    std::string_view pattern = DefaultPattern;
+    std::string_view filename;
+};
+
+/**
+ * @brief Formats the records and prints them to the standard output.
+ *
+ * @tparam Char Character type the file was written with.
+ * @tparam Reader Reader type, FlightRecorderReader or BinaryLogReader.
+ * @param reader Loaded file.
+ * @param options Command-line options.
+ * @return Number of printed records.
+ */
+template<typename Char, typename Reader>
+auto print_records(const Reader& reader, const Options& options) -> std::size_t
+{
+    const Pattern<Char> pattern(util::unicode::from_utf8<Char>(options.pattern));
+    FormatBuffer<Char, DefaultSinkBufferSize> buffer;
+    std::string line;
+    return reader.template read<Char>([&](const Record<Char>& record) {
+        buffer.clear();
+        pattern.format(buffer, record);
+        line.clear();
+        util::unicode::append_utf8(line, buffer.data(), buffer.size());
+        line.push_back('\n');
+        std::cout << line;
+    });
+}
+
+/**
+ * @brief Tool option taking a value.
+ */
+struct Option {
+    std::string_view name; ///< Option name, e.g. `--pattern`.
+    std::string_view usage; ///< Usage line describing the option.
+    std::function<void(std::string_view)> parse; ///< Handler of the option value.
+};
+
+/**
+ * @brief Prints the usage message.
+ *
+ * @param program Program name.
+ * @param description Tool description.
+ * @param options Options of the tool.
+ */
+inline auto print_usage(
+    std::string_view program, std::string_view description, std::span<const Option> options)
+    -> void
+{
+    std::cout << "Usage: " << program << " [options] FILE\n" << description << '\n';
+    for (const auto& option : options) {
+        std::cout << "  " << option.usage << '\n';
+    }
+}
+
+/**
+ * @brief Parses the command-line arguments, exits on `--help` or without a file name.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments.
+ * @param description Tool description for the usage message.
+ * @param options Options of the tool.
+ * @return File name argument.
+ */
+inline auto parse_arguments(
+    int argc,
+    char* argv[], // NOLINT(*-avoid-c-arrays)
+    std::string_view description,
+    std::span<const Option> options) -> std::string_view
+{
+    std::string_view filename;
+    const std::vector<std::string_view> args(argv + 1, argv + argc);
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--help") {
+            print_usage(argv[0], description, options);
+            std::exit(EXIT_SUCCESS); // NOLINT(concurrency-*)
+        }
+        const auto option = std::ranges::find(options, args[i], &Option::name);
+        if (option != options.end() && i + 1 < args.size()) {
+            option->parse(args[++i]);
+        } else if (!args[i].starts_with("--") && filename.empty()) {
+            filename = args[i];
+        } else {
+            throw std::invalid_argument("Unknown option: " + std::string(args[i]));
+        }
+    }
+    if (filename.empty()) {
+        print_usage(argv[0], description, options);
+        std::exit(EXIT_FAILURE); // NOLINT(concurrency-*)
+    }
+    return filename;
+}
+
+// NOLINTNEXTLINE(*-avoid-c-arrays)
+inline auto parse_options(int argc, char* argv[], std::string_view description) -> Options
+{
+    Options options;
+    const std::string usage
+        = "--pattern PATTERN  Record pattern, default: " + std::string(DefaultPattern);
+    const std::array<Option, 1> list{
+        Option{"--pattern", usage, [&options](std::string_view value) {
+                   options.pattern = value;
+               }}};
+    options.filename = parse_arguments(argc, argv, description, list);
+    return options;
+}
+
+/**
+ * @brief Runs a tool printing the records of a log file.
+ *
+ * @tparam Reader Reader type, FlightRecorderReader or BinaryLogReader.
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments.
+ * @param description Tool description for the usage message.
+ * @return Exit code.
+ */
+template<typename Reader>
+auto run(int argc, char* argv[], std::string_view description) -> int // NOLINT(*-c-arrays)
+{
+    try {
+        const auto options = parse_options(argc, argv, description);
+        const Reader reader(options.filename);
+        std::size_t count = 0;
+        if (reader.char_size() == sizeof(char)) {
+            count = print_records<char>(reader, options);
+        } else if (reader.char_size() == sizeof(wchar_t)) {
+            count = print_records<wchar_t>(reader, options);
+        } else {
+            throw std::runtime_error(
+                "Unsupported character size: " + std::to_string(reader.char_size()));
+        }
+        std::cerr << count << " records\n";
+    } catch (const std::exception& error) {
+        std::cerr << "Error: " << error.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+} // namespace slimlog::tools
@@ -0,0 +1,9 @@
+#include "slimlog/sinks/binary_file_sink.h"
+
+#include "common.h"
+
+auto main(int argc, char* argv[]) -> int // NOLINT(*-avoid-c-arrays)
+{
+    return slimlog::tools::run<slimlog::BinaryLogReader>(
+        argc, argv, "Prints the records of a binary log file as text.");
+}
@@ -0,0 +1,9 @@
+#include "slimlog/sinks/flight_recorder_sink.h"
+
+#include "common.h"
+
+auto main(int argc, char* argv[]) -> int // NOLINT(*-avoid-c-arrays)
+{
+    return slimlog::tools::run<slimlog::FlightRecorderReader>(
+        argc, argv, "Prints the records of a flight recorder ring, oldest first.");
+}
@@ -0,0 +1,172 @@
+#include "slimlog/common.h"
+#include "slimlog/seek_index.h"
+#include "slimlog/util/os.h"
+
+#include "common.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace {
+
+using slimlog::Level;
+using slimlog::SeekIndex;
+
+/** @brief Accepted level names, in the order of the levels. */
+constexpr std::array<std::string_view, 6> LevelNames
+    = {"fatal", "error", "warning", "info", "debug", "trace"};
+
+struct Options {
+    SeekIndex::Time from = SeekIndex::Time::min();
+    SeekIndex::Time to = SeekIndex::Time::max();
+    Level level = Level::Trace;
+    std::string_view filename;
+};
+
+// Parses the time as displayed by the {time} pattern field
+auto parse_time(std::string_view str) -> SeekIndex::Time
+{
+    namespace chrono = std::chrono;
+    // Separators preceding the fields, 'T' is also accepted before the hours
+    constexpr std::string_view Separators = " -- ::";
+    std::array<int, 6> fields{};
+    const auto* ptr = str.data();
+    const auto* end = str.data() + str.size(); // NOLINT(*-pointer-arithmetic)
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        if (i > 0) {
+            if (ptr == end || (*ptr != Separators[i] && !(i == 3 && *ptr == 'T'))) {
+                throw std::invalid_argument("Invalid time: " + std::string(str));
+            }
+            ++ptr; // NOLINT(*-pointer-arithmetic)
+        }
+        const auto result = std::from_chars(ptr, end, fields[i]);
+        if (result.ec != std::errc{}) {
+            throw std::invalid_argument("Invalid time: " + std::string(str));
+        }
+        ptr = result.ptr;
+    }
+
+    chrono::nanoseconds fraction{0};
+    if (ptr != end && *ptr == '.') {
+        std::int64_t scale = 100'000'000;
+        // NOLINTNEXTLINE(*-pointer-arithmetic)
+        for (++ptr; ptr != end && *ptr >= '0' && *ptr <= '9'; ++ptr) {
+            fraction += chrono::nanoseconds((*ptr - '0') * scale);
+            scale /= 10;
+        }
+    }
+    const chrono::year_month_day date{
+        chrono::year(fields[0]),
+        chrono::month(static_cast<unsigned>(fields[1])),
+        chrono::day(static_cast<unsigned>(fields[2]))};
+    if (ptr != end || !date.ok()) {
+        throw std::invalid_argument("Invalid time: " + std::string(str));
+    }
+    return chrono::sys_days(date) + chrono::hours(fields[3]) + chrono::minutes(fields[4])
+        + chrono::seconds(fields[5]) + fraction;
+}
+
+auto parse_level(std::string_view str) -> Level
+{
+    std::string name(str);
+    std::ranges::transform(name, name.begin(), [](char chr) {
+        return chr >= 'A' && chr <= 'Z' ? static_cast<char>(chr - 'A' + 'a') : chr;
+    });
+    if (name == "warn") {
+        return Level::Warning;
+    }
+    const auto it = std::ranges::find(LevelNames, name);
+    if (it == LevelNames.end()) {
+        throw std::invalid_argument("Unknown level: " + std::string(str));
+    }
+    return static_cast<Level>(it - LevelNames.begin());
+}
+
+// NOLINTNEXTLINE(*-avoid-c-arrays)
+auto parse_options(int argc, char* argv[]) -> Options
+{
+    Options options;
+    const std::array<slimlog::tools::Option, 3> list{
+        slimlog::tools::Option{
+            "--from",
+            "--from TIME    Earliest record time, YYYY-MM-DD HH:MM:SS[.fraction]",
+            [&options](std::string_view value) { options.from = parse_time(value); }},
+        slimlog::tools::Option{
+            "--to",
+            "--to TIME      Latest record time",
+            [&options](std::string_view value) { options.to = parse_time(value); }},
+        slimlog::tools::Option{
+            "--level",
+            "--level LEVEL  Least severe level: fatal, error, warning, info, debug, trace",
+            [&options](std::string_view value) { options.level = parse_level(value); }}};
+    options.filename = slimlog::tools::parse_arguments(
+        argc,
+        argv,
+        "Prints the blocks of a log file which may contain matching records,\n"
+        "using the seek index written by BufferedFileSink::enable_index().",
+        list);
+    return options;
+}
+
+// Maps the range and copies it to the standard output, only its pages are read
+auto print_range(int fd, const SeekIndex::Range& range) -> void
+{
+    const auto granularity = slimlog::util::os::map_granularity();
+    const auto start = range.offset - (range.offset % granularity);
+    const auto size = static_cast<std::size_t>(range.offset + range.size - start);
+    const auto* data
+        = static_cast<const char*>(slimlog::util::os::map_file_readonly(fd, start, size));
+    if (data == nullptr) {
+        throw std::system_error({errno, std::system_category()}, "Error mapping log file");
+    }
+    // NOLINTNEXTLINE(*-pointer-arithmetic)
+    const auto written = std::fwrite(data + (range.offset - start), 1, range.size, stdout);
+    slimlog::util::os::unmap_file(data, size);
+    if (written != range.size) {
+        throw std::system_error({errno, std::system_category()}, "Error writing output");
+    }
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int // NOLINT(*-avoid-c-arrays)
+{
+    try {
+        const auto options = parse_options(argc, argv);
+        const SeekIndex index(options.filename);
+        const auto ranges = index.find(options.from, options.to, options.level);
+
+        const std::unique_ptr<FILE, int (*)(FILE*)> file(
+            std::fopen(std::string(options.filename).c_str(), "rb"), std::fclose);
+        if (!file) {
+            throw std::system_error({errno, std::system_category()}, "Error opening log file");
+        }
+        const auto fd = slimlog::util::os::file_descriptor(file.get());
+        std::uint64_t bytes = 0;
+        for (const auto& range : ranges) {
+            print_range(fd, range);
+            bytes += range.size;
+        }
+        std::fflush(stdout);
+        std::cerr << bytes << " of " << index.log_size() << " bytes in " << ranges.size()
+                  << " ranges\n";
+    } catch (const std::exception& error) {
+        std::cerr << "Error: " << error.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}